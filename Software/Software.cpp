@@ -9,6 +9,7 @@
 #include "src/battery/BATTERIES.h"
 #include "src/charger/CHARGERS.h"
 #include "src/communication/Transmitter.h"
+#include "src/communication/can/can_replay.h"
 #include "src/communication/can/comm_can.h"
 #include "src/communication/contactorcontrol/comm_contactorcontrol.h"
 #include "src/communication/equipmentstopbutton/comm_equipmentstopbutton.h"
@@ -16,6 +17,7 @@
 #include "src/communication/precharge_control/precharge_control.h"
 #include "src/communication/rs485/comm_rs485.h"
 #include "src/datalayer/datalayer.h"
+#include "src/datalayer/datalayer_snapshot.h"
 #include "src/devboard/display/display.h"
 #include "src/devboard/mqtt/mqtt.h"
 #include "src/devboard/sdcard/sdcard.h"
@@ -533,6 +535,9 @@ void core_loop(void*) {
         inverter->update_values();
       }
 
+      // Hand the other core a coherent copy of this update
+      datalayer_snapshot.publish(battery3 ? 3 : (battery2 ? 2 : 1));
+
       if (datalayer.system.info.performance_measurement_active) {
         END_TIME_MEASUREMENT_MAX(values, datalayer.system.status.time_values_us);
       }
@@ -545,6 +550,9 @@ void core_loop(void*) {
     for (auto& transmitter : transmitters) {
       transmitter->transmit(currentMillis);
     }
+    transmit_scheduled_can_frames(currentMillis);
+    transmit_replayed_can_frames();
+    transmit_queued_can_frames();
 
     if (datalayer.system.info.performance_measurement_active) {
       END_TIME_MEASUREMENT_MAX(cantx, datalayer.system.status.time_cantx_us);
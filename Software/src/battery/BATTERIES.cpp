@@ -154,6 +154,8 @@ bool user_selected_second_battery = false;
 bool user_selected_triple_battery = false;
 
 Battery* create_battery(BatteryType type) {
+  datalayer_extended.select(type);
+
   switch (type) {
     case BatteryType::None:
       return nullptr;
@@ -283,7 +285,7 @@ void setup_battery() {
         battery2 = new CmfaEvBattery(&datalayer.battery2, nullptr, can_config.battery_double);
         break;
       case BatteryType::KiaHyundai64:
-        battery2 = new KiaHyundai64Battery(&datalayer.battery2, &datalayer_extended.KiaHyundai64_2,
+        battery2 = new KiaHyundai64Battery(&datalayer.battery2, &datalayer_extended.KiaHyundai64[1],
                                            &datalayer.system.status.battery2_allowed_contactor_closing,
                                            can_config.battery_double);
         break;
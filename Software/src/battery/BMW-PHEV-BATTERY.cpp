@@ -108,7 +108,7 @@ bool BmwPhevBattery::isStale(int16_t currentValue, uint16_t& lastValue, unsigned
   return (currentTime - lastChangeTime >= STALE_PERIOD);
 }
 
-static uint8_t calculateCRC(CAN_frame rx_frame, uint8_t length, uint8_t initial_value) {
+static uint8_t calculateCRC(const CAN_frame& rx_frame, uint8_t length, uint8_t initial_value) {
   uint8_t crc = initial_value;
   for (uint8_t j = 1; j < length; j++) {  //start at 1, since 0 is the CRC
     crc = crc8_table_SAE_J1850_ZER0[(crc ^ static_cast<uint8_t>(rx_frame.data.u8[j])) % 256];
@@ -408,7 +408,7 @@ void BmwPhevBattery::update_values() {  //This function maps all the values fetc
     datalayer.battery.info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
   }
 }
-void BmwPhevBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void BmwPhevBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
 
   //battery_awake = true; //look for specific messages
   switch (rx_frame.ID) {
@@ -14,7 +14,7 @@ uint8_t reverse_bits(uint8_t byte) {
 }
 
 /** CRC8, both inverted, poly 0x31 **/
-uint8_t calculateCRC(CAN_frame CAN) {
+uint8_t calculateCRC(const CAN_frame& CAN) {
   uint8_t crc = 0;
   for (size_t i = 0; i < CAN.DLC; i++) {
     uint8_t reversed_byte = reverse_bits(CAN.data.u8[i]);
@@ -32,7 +32,7 @@ uint8_t calculateCRC(CAN_frame CAN) {
   return crc;
 }
 
-void BmwSbox::handle_incoming_can_frame(CAN_frame rx_frame) {
+void BmwSbox::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   unsigned long currentTime = millis();
   if (rx_frame.ID == 0x200) {
     ShuntLastSeen = currentTime;
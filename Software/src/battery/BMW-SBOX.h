@@ -11,7 +11,7 @@ class BmwSbox : public CanShunt {
  public:
   void setup();
   void transmit_can(unsigned long currentMillis);
-  void handle_incoming_can_frame(CAN_frame rx_frame);
+  void handle_incoming_can_frame(const CAN_frame& rx_frame);
   static constexpr const char* Name = "BMW SBOX";
 
  private:
@@ -5,6 +5,8 @@
 #include "../../src/devboard/utils/types.h"
 #include "../../src/devboard/webserver/BatteryHtmlRenderer.h"
 
+class UdsPollScheduler;
+
 enum class BatteryType {
   None = 0,
   BmwI3 = 2,
@@ -72,6 +74,8 @@ extern battery_chemistry_enum user_selected_battery_chemistry;
 // Defines the interface to call battery specific functionality.
 class Battery {
  public:
+  virtual ~Battery() = default;
+
   virtual void setup(void) = 0;
   virtual void update_values() = 0;
 
@@ -130,6 +134,9 @@ class Battery {
 
   virtual BatteryHtmlRenderer& get_status_renderer() { return defaultRenderer; }
 
+  // Batteries polling diagnostic values return their scheduler, so the refresh rates can be shown
+  virtual const UdsPollScheduler* get_poll_scheduler() { return nullptr; }
+
  private:
   BatteryDefaultRenderer defaultRenderer;
 };
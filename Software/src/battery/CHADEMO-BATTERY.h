@@ -22,7 +22,7 @@ class ChademoBattery : public CanBattery {
   }
 
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
   virtual void transmit_can(unsigned long currentMillis);
 
@@ -39,13 +39,13 @@ class ChademoBattery : public CanBattery {
   gpio_num_t pin2, pin10, pin4, pin7, pin_lock, precharge, positive_contactor;
   ChademoBatteryHtmlRenderer renderer;
 
-  void process_vehicle_charging_minimums(CAN_frame rx_frame);
-  void process_vehicle_charging_maximums(CAN_frame rx_frame);
-  void process_vehicle_charging_session(CAN_frame rx_frame);
-  void process_vehicle_charging_limits(CAN_frame rx_frame);
-  void process_vehicle_discharge_estimate(CAN_frame rx_frame);
-  void process_vehicle_dynamic_control(CAN_frame rx_frame);
-  void process_vehicle_vendor_ID(CAN_frame rx_frame);
+  void process_vehicle_charging_minimums(const CAN_frame& rx_frame);
+  void process_vehicle_charging_maximums(const CAN_frame& rx_frame);
+  void process_vehicle_charging_session(const CAN_frame& rx_frame);
+  void process_vehicle_charging_limits(const CAN_frame& rx_frame);
+  void process_vehicle_discharge_estimate(const CAN_frame& rx_frame);
+  void process_vehicle_dynamic_control(const CAN_frame& rx_frame);
+  void process_vehicle_vendor_ID(const CAN_frame& rx_frame);
   void evse_init();
   void update_evse_capabilities(CAN_frame& f);
   void update_evse_status(CAN_frame& f);
@@ -230,7 +230,7 @@ void EcmpBattery::update_values() {
   }
 }
 
-void EcmpBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void EcmpBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x2D4:  //MysteryVan 50/75kWh platform (TBMU 100ms periodic)
       datalayer.battery.status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -780,7 +780,7 @@ void EcmpBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
       } else {  //Normal PID polling ongoing
 
         if (rx_frame.data.u8[0] == 0x10) {  //Multiframe response, send ACK
-          transmit_can_frame(&ECMP_ACK);
+          transmit_can_frame(&ECMP_ACK, CAN_TX_DIAGNOSTIC);
           //Multiframe has the poll reply slightly different location
           incoming_poll = (rx_frame.data.u8[3] << 8) | rx_frame.data.u8[4];
         }
@@ -1166,7 +1166,7 @@ void EcmpBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
   }
 }
 
-uint8_t checksum_calc(uint8_t counter, CAN_frame rx_frame) {
+uint8_t checksum_calc(uint8_t counter, const CAN_frame& rx_frame) {
   // Confirmed working on IDs 0F0,0F2,17B,31B,31D,31E,3A2(special),3A3,112,351
   // Sum of frame ID nibbles + Sum all nibbles of data bytes (frames 0–6 and high nibble of frame7)
   int sum = ((rx_frame.ID >> 8) & 0xF) + ((rx_frame.ID >> 4) & 0xF) + (rx_frame.ID & 0xF);
@@ -1293,7 +1293,7 @@ void EcmpBattery::transmit_can(unsigned long currentMillis) {
         if (HighPrecisionCurrentSampling) {
           ECMP_POLL.data.u8[2] = (uint8_t)((PID_CURRENT & 0xFF00) >> 8);
           ECMP_POLL.data.u8[3] = (uint8_t)(PID_CURRENT & 0x00FF);
-          transmit_can_frame(&ECMP_POLL);
+          transmit_can_frame(&ECMP_POLL, CAN_TX_DIAGNOSTIC);
           HighPrecisionCurrentSampling = 0;
         } else {
           HighPrecisionCurrentSampling = 1;
@@ -1649,7 +1649,7 @@ void EcmpBattery::transmit_can(unsigned long currentMillis) {
               poll_state = PID_WELD_CHECK;
               break;
           }
-          transmit_can_frame(&ECMP_POLL);
+          transmit_can_frame(&ECMP_POLL, CAN_TX_DIAGNOSTIC);
         }
       }
     }
@@ -89,7 +89,7 @@ void FordMachEBattery::update_values() {
   }
 }
 
-void FordMachEBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void FordMachEBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {  //These frames are transmitted by the battery
     case 0x07a:           //10ms
       datalayer.battery.status.CAN_battery_still_alive = CAN_STILL_ALIVE;
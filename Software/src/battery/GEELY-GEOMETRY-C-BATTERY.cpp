@@ -126,7 +126,7 @@ void GeelyGeometryCBattery::update_values() {
   datalayer_geometryc->unknown8 = poll_unknown8;
 }
 
-bool is_message_corrupt(CAN_frame* rx_frame) {
+bool is_message_corrupt(const CAN_frame* rx_frame) {
   uint8_t crc = 0xFF;  // Initial value
   for (uint8_t j = 0; j < 7; j++) {
     crc = crctable_geely_geometryC[crc ^ rx_frame->data.u8[j]];
@@ -135,7 +135,7 @@ bool is_message_corrupt(CAN_frame* rx_frame) {
   return crc != rx_frame->data.u8[7];
 }
 
-void GeelyGeometryCBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void GeelyGeometryCBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x0B0:  //10ms
       datalayer_battery->status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -439,7 +439,7 @@ void GeelyGeometryCBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
   }
 }
 
-uint8_t calc_crc8_geely(CAN_frame* rx_frame) {
+uint8_t calc_crc8_geely(const CAN_frame* rx_frame) {
   uint8_t crc = 0xFF;  // Initial value
 
   for (uint8_t j = 0; j < 7; j++) {
@@ -38,7 +38,7 @@ void HyundaiIoniq28Battery::
   }
 }
 
-void HyundaiIoniq28Battery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void HyundaiIoniq28Battery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x4DE:
       startedUp = true;
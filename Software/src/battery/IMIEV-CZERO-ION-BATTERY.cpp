@@ -83,7 +83,7 @@ void ImievCZeroIonBattery::
   }
 }
 
-void ImievCZeroIonBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void ImievCZeroIonBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x374:  //BMU message, 10ms - SOC
       datalayer.battery.status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -99,7 +99,7 @@ void JaguarIpaceBattery::update_values() {
   }
 }
 
-void JaguarIpaceBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void JaguarIpaceBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
 
   switch (rx_frame.ID) {  // These messages are periodically transmitted by the battery
     case 0x080:
@@ -18,15 +18,15 @@ class KiaHyundai64Battery : public CanBattery {
   }
 
   // Use the default constructor to create the first or single battery.
-  KiaHyundai64Battery() : renderer(&datalayer_extended.KiaHyundai64) {
+  KiaHyundai64Battery() : renderer(&datalayer_extended.KiaHyundai64[0]) {
     datalayer_battery = &datalayer.battery;
     allows_contactor_closing = &datalayer.system.status.battery_allows_contactor_closing;
     contactor_closing_allowed = nullptr;
-    datalayer_battery_extended = &datalayer_extended.KiaHyundai64;
+    datalayer_battery_extended = &datalayer_extended.KiaHyundai64[0];
   }
 
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
   virtual void transmit_can(unsigned long currentMillis);
   static constexpr const char* Name = "Kia/Hyundai 64/40kWh battery";
@@ -75,7 +75,7 @@ void KiaHyundaiHybridBattery::
   }
 }
 
-void KiaHyundaiHybridBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void KiaHyundaiHybridBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x5F1:
       break;
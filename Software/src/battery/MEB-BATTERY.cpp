@@ -45,7 +45,7 @@ const int RX_DEFAULT = 0xE000;
  * @see https://www.autosar.org/fileadmin/user_upload/standards/classic/4-3/AUTOSAR_SWS_CRCLibrary.pdf
  * @see https://web.archive.org/web/20221105210302/https://www.autosar.org/fileadmin/user_upload/standards/classic/4-3/AUTOSAR_SWS_CRCLibrary.pdf
  */
-uint8_t vw_crc_calc(uint8_t* inputBytes, uint8_t length, uint32_t address) {
+uint8_t vw_crc_calc(const uint8_t* inputBytes, uint8_t length, uint32_t address) {
 
   const uint8_t poly = 0x2F;
   const uint8_t xor_output = 0xFF;
@@ -306,7 +306,7 @@ void MebBattery::
   datalayer_extended.meb.charging_active = charging_active;
 }
 
-void MebBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void MebBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   last_can_msg_timestamp = millis();
   if (first_can_msg == 0) {
     logging.printf("MEB: First CAN msg received\n");
@@ -753,15 +753,21 @@ void MebBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
         BMS_voltage = ((rx_frame.data.u8[7] << 4) + ((rx_frame.data.u8[6] & 0xF0) >> 4));
       }
       break;
+    case 0x1C40007B:  // Someone else is polling the BMS, stop our own polling for a while
+      poller.hold_off(millis(), POLL_HOLD_OFF_MS);
+      break;
     case 0x1C42007B:                      // Reply from battery
       if (rx_frame.data.u8[0] == 0x10) {  //PID header
-        transmit_can_frame(&MEB_ACK_FRAME);
+        transmit_can_frame(&MEB_ACK_FRAME, CAN_TX_DIAGNOSTIC);
       }
       if (rx_frame.DLC == 8) {
         pid_reply = (rx_frame.data.u8[2] << 8) + rx_frame.data.u8[3];
       } else {  //12 or 24bit message has reply in other location
         pid_reply = (rx_frame.data.u8[3] << 8) + rx_frame.data.u8[4];
       }
+      if ((rx_frame.data.u8[0] >> 4) <= 1) {  // Single or first frame, the start of a response
+        poller.response(pid_reply, millis());
+      }
 
       switch (pid_reply) {
         case PID_SOC:
@@ -1060,129 +1066,24 @@ void MebBattery::transmit_can(unsigned long currentMillis) {
     transmit_can_frame(&MEB_1B0000B9);
     transmit_can_frame(&MEB_1B000010);
     transmit_can_frame(&MEB_1B000046);
+  }
 
-    switch (poll_pid) {
-      case PID_SOC:
-        MEB_POLLING_FRAME.data.u8[2] = (uint8_t)(PID_SOC >> 8);  // High byte
-        MEB_POLLING_FRAME.data.u8[3] = (uint8_t)PID_SOC;         // Low byte
-        poll_pid = PID_VOLTAGE;
-        break;
-      case PID_VOLTAGE:
-        MEB_POLLING_FRAME.data.u8[2] = (uint8_t)(PID_VOLTAGE >> 8);
-        MEB_POLLING_FRAME.data.u8[3] = (uint8_t)PID_VOLTAGE;
-        poll_pid = PID_CURRENT;
-        break;
-      case PID_CURRENT:
-        MEB_POLLING_FRAME.data.u8[2] = (uint8_t)(PID_CURRENT >> 8);
-        MEB_POLLING_FRAME.data.u8[3] = (uint8_t)PID_CURRENT;
-        poll_pid = PID_MAX_TEMP;
-        break;
-      case PID_MAX_TEMP:
-        MEB_POLLING_FRAME.data.u8[2] = (uint8_t)(PID_MAX_TEMP >> 8);
-        MEB_POLLING_FRAME.data.u8[3] = (uint8_t)PID_MAX_TEMP;
-        poll_pid = PID_MIN_TEMP;
-        break;
-      case PID_MIN_TEMP:
-        MEB_POLLING_FRAME.data.u8[2] = (uint8_t)(PID_MIN_TEMP >> 8);
-        MEB_POLLING_FRAME.data.u8[3] = (uint8_t)PID_MIN_TEMP;
-        poll_pid = PID_TEMP_POINT_1;
-        break;
-      case PID_TEMP_POINT_1:
-      case PID_TEMP_POINT_2:
-      case PID_TEMP_POINT_3:
-      case PID_TEMP_POINT_4:
-      case PID_TEMP_POINT_5:
-      case PID_TEMP_POINT_6:
-      case PID_TEMP_POINT_7:
-      case PID_TEMP_POINT_8:
-      case PID_TEMP_POINT_9:
-      case PID_TEMP_POINT_10:
-      case PID_TEMP_POINT_11:
-      case PID_TEMP_POINT_12:
-      case PID_TEMP_POINT_13:
-      case PID_TEMP_POINT_14:
-      case PID_TEMP_POINT_15:
-      case PID_TEMP_POINT_16:
-      case PID_TEMP_POINT_17:
-        MEB_POLLING_FRAME.data.u8[2] = (uint8_t)(poll_pid >> 8);
-        MEB_POLLING_FRAME.data.u8[3] = (uint8_t)poll_pid;
-        poll_pid = poll_pid + 1;
-        break;
-      case PID_TEMP_POINT_18:
-        MEB_POLLING_FRAME.data.u8[2] = (uint8_t)(poll_pid >> 8);
-        MEB_POLLING_FRAME.data.u8[3] = (uint8_t)poll_pid;
-        poll_pid = PID_MAX_CHARGE_VOLTAGE;
-        break;
-      case PID_MAX_CHARGE_VOLTAGE:
-        MEB_POLLING_FRAME.data.u8[2] = (uint8_t)(PID_MAX_CHARGE_VOLTAGE >> 8);
-        MEB_POLLING_FRAME.data.u8[3] = (uint8_t)PID_MAX_CHARGE_VOLTAGE;
-        poll_pid = PID_MIN_DISCHARGE_VOLTAGE;
-        break;
-      case PID_MIN_DISCHARGE_VOLTAGE:
-        MEB_POLLING_FRAME.data.u8[2] = (uint8_t)(PID_MIN_DISCHARGE_VOLTAGE >> 8);
-        MEB_POLLING_FRAME.data.u8[3] = (uint8_t)PID_MIN_DISCHARGE_VOLTAGE;
-        poll_pid = PID_ENERGY_COUNTERS;
-        break;
-      case PID_ENERGY_COUNTERS:
-        MEB_POLLING_FRAME.data.u8[2] = (uint8_t)(PID_ENERGY_COUNTERS >> 8);
-        MEB_POLLING_FRAME.data.u8[3] = (uint8_t)PID_ENERGY_COUNTERS;
-        poll_pid = PID_ALLOWED_CHARGE_POWER;
-        break;
-      case PID_ALLOWED_CHARGE_POWER:
-        MEB_POLLING_FRAME.data.u8[2] = (uint8_t)(PID_ALLOWED_CHARGE_POWER >> 8);
-        MEB_POLLING_FRAME.data.u8[3] = (uint8_t)PID_ALLOWED_CHARGE_POWER;
-        poll_pid = PID_ALLOWED_DISCHARGE_POWER;
-        break;
-      case PID_ALLOWED_DISCHARGE_POWER:
-        MEB_POLLING_FRAME.data.u8[2] = (uint8_t)(PID_ALLOWED_DISCHARGE_POWER >> 8);
-        MEB_POLLING_FRAME.data.u8[3] = (uint8_t)PID_ALLOWED_DISCHARGE_POWER;
-        poll_pid = PID_CELLVOLTAGE_CELL_1;  // Start polling cell voltages
-        break;
-      // Cell Voltage Cases.
-      // Most of these are handled in the default case.
-      case PID_CELLVOLTAGE_CELL_1:
-        MEB_POLLING_FRAME.data.u8[2] = (uint8_t)(PID_CELLVOLTAGE_CELL_1 >> 8);
-        MEB_POLLING_FRAME.data.u8[3] = (uint8_t)PID_CELLVOLTAGE_CELL_1;
-        poll_pid = PID_CELLVOLTAGE_CELL_2;
-        break;
-      case PID_CELLVOLTAGE_CELL_84:
-        MEB_POLLING_FRAME.data.u8[3] = (uint8_t)PID_CELLVOLTAGE_CELL_84;
-        if (datalayer.battery.info.number_of_cells > 84) {
-          if (nof_cells_determined) {
-            poll_pid = PID_CELLVOLTAGE_CELL_85;
-          } else {
-            poll_pid = PID_CELLVOLTAGE_CELL_97;
-          }
-        } else {
-          poll_pid = PID_SOC;
-        }
-        break;
-      case PID_CELLVOLTAGE_CELL_96:
-        MEB_POLLING_FRAME.data.u8[3] = (uint8_t)PID_CELLVOLTAGE_CELL_96;
-        if (datalayer.battery.info.number_of_cells > 96)
-          poll_pid = PID_CELLVOLTAGE_CELL_97;
-        else
-          poll_pid = PID_SOC;
-        break;
-      case PID_CELLVOLTAGE_CELL_108:
-        MEB_POLLING_FRAME.data.u8[3] = (uint8_t)PID_CELLVOLTAGE_CELL_108;
-        poll_pid = PID_SOC;
-        break;
-      default:
-        if (poll_pid >= PID_CELLVOLTAGE_CELL_1 && poll_pid <= PID_CELLVOLTAGE_CELL_108) {
-          // The general case for cell voltages (some specific cases handled above)
-          MEB_POLLING_FRAME.data.u8[3] = (uint8_t)poll_pid;
-          // Poll the next cell next
-          poll_pid = poll_pid + 1;
-        } else {
-          // Out-of-range PID, go back to the start
-          poll_pid = PID_SOC;
-        }
-        break;
-    }
-    if (first_can_msg > 0 && currentMillis > first_can_msg + 1000) {
-      transmit_can_frame(&MEB_POLLING_FRAME);
+  if (nof_cells_determined && !cell_polling_configured) {
+    // Back to the normal order for the cells used to find the cell count, and only poll the cells the pack has
+    poller.add(PID_CELLVOLTAGE_CELL_85, CELL_POLL_PERIOD_MS, UdsPollScheduler::PRIORITY_LOW);
+    poller.add(PID_CELLVOLTAGE_CELL_97, CELL_POLL_PERIOD_MS, UdsPollScheduler::PRIORITY_LOW);
+    poller.add(PID_CELLVOLTAGE_CELL_108, CELL_POLL_PERIOD_MS, UdsPollScheduler::PRIORITY_LOW);
+    for (int pid = PID_CELLVOLTAGE_CELL_1; pid <= PID_CELLVOLTAGE_CELL_108; pid++) {
+      poller.set_enabled(pid, pid - PID_CELLVOLTAGE_CELL_1 < datalayer.battery.info.number_of_cells);
     }
+    cell_polling_configured = true;
+  }
+
+  uint16_t pid;
+  if (first_can_msg > 0 && currentMillis > first_can_msg + 1000 && poller.next(currentMillis, pid)) {
+    MEB_POLLING_FRAME.data.u8[2] = (uint8_t)(pid >> 8);  // High byte
+    MEB_POLLING_FRAME.data.u8[3] = (uint8_t)pid;         // Low byte
+    transmit_can_frame(&MEB_POLLING_FRAME, CAN_TX_DIAGNOSTIC);
   }
 
   // Send 500ms CAN Message
@@ -1273,4 +1174,26 @@ void MebBattery::setup(void) {  // Performs one time setup at startup
   datalayer.battery.info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
   datalayer.battery.info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
   datalayer.battery.info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
+
+  // What the control loop uses is refreshed every few seconds, limits and counters less often
+  poller.add(PID_SOC, FAST_POLL_PERIOD_MS, UdsPollScheduler::PRIORITY_HIGH);
+  poller.add(PID_VOLTAGE, FAST_POLL_PERIOD_MS, UdsPollScheduler::PRIORITY_HIGH);
+  poller.add(PID_CURRENT, FAST_POLL_PERIOD_MS, UdsPollScheduler::PRIORITY_HIGH);
+  poller.add(PID_MAX_TEMP, FAST_POLL_PERIOD_MS, UdsPollScheduler::PRIORITY_HIGH);
+  poller.add(PID_MIN_TEMP, FAST_POLL_PERIOD_MS, UdsPollScheduler::PRIORITY_HIGH);
+  poller.add(PID_ALLOWED_CHARGE_POWER, FAST_POLL_PERIOD_MS, UdsPollScheduler::PRIORITY_HIGH);
+  poller.add(PID_ALLOWED_DISCHARGE_POWER, FAST_POLL_PERIOD_MS, UdsPollScheduler::PRIORITY_HIGH);
+  for (int pid = PID_TEMP_POINT_1; pid <= PID_TEMP_POINT_18; pid++) {
+    poller.add(pid, 10000, UdsPollScheduler::PRIORITY_NORMAL);
+  }
+  poller.add(PID_MAX_CHARGE_VOLTAGE, 30000, UdsPollScheduler::PRIORITY_NORMAL);
+  poller.add(PID_MIN_DISCHARGE_VOLTAGE, 30000, UdsPollScheduler::PRIORITY_NORMAL);
+  poller.add(PID_ENERGY_COUNTERS, 60000, UdsPollScheduler::PRIORITY_LOW);
+  for (int pid = PID_CELLVOLTAGE_CELL_1; pid <= PID_CELLVOLTAGE_CELL_108; pid++) {
+    poller.add(pid, CELL_POLL_PERIOD_MS, UdsPollScheduler::PRIORITY_LOW);
+  }
+  // Until the cell count is known, the cells that tell 84S, 96S and 108S packs apart go first
+  poller.add(PID_CELLVOLTAGE_CELL_85, CELL_POLL_PERIOD_MS, UdsPollScheduler::PRIORITY_HIGH);
+  poller.add(PID_CELLVOLTAGE_CELL_97, CELL_POLL_PERIOD_MS, UdsPollScheduler::PRIORITY_HIGH);
+  poller.add(PID_CELLVOLTAGE_CELL_108, CELL_POLL_PERIOD_MS, UdsPollScheduler::PRIORITY_HIGH);
 }
@@ -1,5 +1,6 @@
 #ifndef MEB_BATTERY_H
 #define MEB_BATTERY_H
+#include "../communication/can/uds_poll_scheduler.h"
 #include "CanBattery.h"
 #include "MEB-HTML.h"
 
@@ -19,7 +20,7 @@ class MebBattery : public CanBattery {
   }
 
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
   virtual void transmit_can(unsigned long currentMillis);
   bool supports_real_BMS_status() { return true; }
@@ -27,6 +28,7 @@ class MebBattery : public CanBattery {
   static constexpr const char* Name = "Volkswagen Group MEB platform via CAN-FD";
 
   BatteryHtmlRenderer& get_status_renderer() { return renderer; }
+  const UdsPollScheduler* get_poll_scheduler() { return &poller; }
 
  private:
   MebHtmlRenderer renderer;
@@ -201,8 +203,15 @@ class MebBattery : public CanBattery {
   uint8_t counter_0F7 = 0;
   uint8_t counter_3b5 = 0;
 
-  uint32_t poll_pid = PID_CELLVOLTAGE_CELL_85;  // We start here to quickly determine the cell size of the pack.
+  // Limits, temperatures, counters and 108 cells
+  static const int POLLED_PIDS = 28 + 108;
+  static const uint32_t POLL_HOLD_OFF_MS = 100000;  // Pause while another tester is polling the BMS
+  static const uint16_t FAST_POLL_PERIOD_MS = 2000;
+  static const uint16_t CELL_POLL_PERIOD_MS = 30000;
+  UdsPollScheduler::Entry poll_entries[POLLED_PIDS];
+  UdsPollScheduler poller{poll_entries, POLLED_PIDS, 10};
   bool nof_cells_determined = false;
+  bool cell_polling_configured = false;
   uint32_t pid_reply = 0;
   uint16_t battery_soc_polled = 0;
   uint16_t battery_voltage_polled = 1480;
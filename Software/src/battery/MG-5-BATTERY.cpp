@@ -212,7 +212,7 @@ void Mg5Battery::
   }
 }
 
-void Mg5Battery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void Mg5Battery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   //datalayer.battery.status.CAN_battery_still_alive = CAN_STILL_ALIVE;
   switch (rx_frame.ID) {
     case 0x297: {                                                          //BMS state
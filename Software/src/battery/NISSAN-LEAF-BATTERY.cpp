@@ -1,4 +1,5 @@
 #include "NISSAN-LEAF-BATTERY.h"
+#include <Arduino.h>
 #include <cstring>  //For unit test
 #include "../charger/CHARGERS.h"
 #include "../charger/CanCharger.h"
@@ -212,7 +213,7 @@ void NissanLeafBattery::
   }
 }
 
-void NissanLeafBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void NissanLeafBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x1DB:
       if (is_message_corrupt(rx_frame)) {
@@ -315,8 +316,9 @@ void NissanLeafBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
       LEAF_battery_Type = ZE1_BATTERY;
       break;
     case 0x79B:
-      stop_battery_query = true;             //Someone is trying to read data with Leafspy, stop our own polling!
-      hold_off_with_polling_10seconds = 10;  //Polling is paused for 100s
+      //Someone is trying to read data with Leafspy, stop our own polling for 100s!
+      poller.hold_off(millis(), POLL_HOLD_OFF_MS);
+      diag.cancel();
       break;
     case 0x7BB:
 
@@ -337,228 +339,118 @@ void NissanLeafBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
       }
 #endif
 
-      if (stop_battery_query) {  //Leafspy is active, stop our own polling
-        break;
-      }
-
-      //First check which group data we are getting
-      if (rx_frame.data.u8[0] == 0x10) {  //First message of a group
-        group_7bb = rx_frame.data.u8[3];
-      }
-
-      transmit_can_frame(&LEAF_NEXT_LINE_REQUEST);  //Request the next frame for the group
-
-      if (group_7bb == 0x01)  //High precision SOC, Current, voltages etc.
-      {
-        if (rx_frame.data.u8[0] == 0x10) {  //First frame
-          //High precision Battery_current_1 resides here, but has been deemed unusable by 62kWh owners
-        }
-        if (rx_frame.data.u8[0] == 0x21) {  //Second frame
-          //High precision Battery_current_2 resides here, but has been deemed unusable by 62kWh owners
-        }
-
-        if (rx_frame.data.u8[0] == 0x23) {  // Fourth frame
-          battery_insulation = (uint16_t)((rx_frame.data.u8[5] << 8) | rx_frame.data.u8[6]);
-        }
+      // Complete groups are passed to handle_group_response(). While Leafspy is active, no request of ours
+      // is running and its responses are ignored.
+      diag.handle_frame(rx_frame, millis());
+      break;
+    default:
+      break;
+  }
+}
 
-        if (rx_frame.data.u8[0] == 0x24) {  // Fifth frame
-          battery_HX = (uint16_t)((rx_frame.data.u8[4] << 8) | rx_frame.data.u8[5]) / 102.4;
-        }
-      }
+void NissanLeafBattery::handle_group_response(const uint8_t* data, size_t length) {
+  // Positive response 61 <group>, followed by the group data
+  if (length < 2 || data[0] != 0x61) {
+    return;
+  }
+  const uint8_t group = data[1];
+  poller.response(group, millis());
 
-      if (group_7bb == 0x02)  //Cell Voltages
-      {
-        if (rx_frame.data.u8[0] == 0x10) {  //first frame is anomalous
-          battery_request_idx = 0;
-          battery_cell_voltages[battery_request_idx++] = (rx_frame.data.u8[4] << 8) | rx_frame.data.u8[5];
-          battery_cell_voltages[battery_request_idx++] = (rx_frame.data.u8[6] << 8) | rx_frame.data.u8[7];
-          break;
-        }
-        if (rx_frame.data.u8[6] == 0xFF && rx_frame.data.u8[0] == 0x2C) {  //Last frame
-          //Last frame does not contain any cell data, calculate the result
+  if (group == 0x01 && length >= 32) {  //High precision SOC, Current, voltages etc.
+    //High precision Battery_current_1 and Battery_current_2 reside here, but have been deemed unusable by 62kWh owners
+    battery_insulation = (uint16_t)((data[24] << 8) | data[25]);
+    battery_HX = (uint16_t)((data[30] << 8) | data[31]) / 102.4;
+  }
 
-          //Map all cell voltages to the global array
-          memcpy(datalayer_battery->status.cell_voltages_mV, battery_cell_voltages, 96 * sizeof(uint16_t));
+  if (group == 0x02 && length >= 2 + 96 * 2) {  //Cell Voltages
+    for (uint8_t i = 0; i < 96; i++) {
+      battery_cell_voltages[i] = (data[2 + 2 * i] << 8) | data[3 + 2 * i];
+    }
 
-          //calculate min/max voltages
-          battery_min_max_voltage[0] = 9999;
-          battery_min_max_voltage[1] = 0;
-          for (battery_cellcounter = 0; battery_cellcounter < 96; battery_cellcounter++) {
-            if (battery_min_max_voltage[0] > battery_cell_voltages[battery_cellcounter])
-              battery_min_max_voltage[0] = battery_cell_voltages[battery_cellcounter];
-            if (battery_min_max_voltage[1] < battery_cell_voltages[battery_cellcounter])
-              battery_min_max_voltage[1] = battery_cell_voltages[battery_cellcounter];
-          }
+    //Map all cell voltages to the global array
+    memcpy(datalayer_battery->status.cell_voltages_mV, battery_cell_voltages, 96 * sizeof(uint16_t));
+
+    //calculate min/max voltages
+    battery_min_max_voltage[0] = 9999;
+    battery_min_max_voltage[1] = 0;
+    for (battery_cellcounter = 0; battery_cellcounter < 96; battery_cellcounter++) {
+      if (battery_min_max_voltage[0] > battery_cell_voltages[battery_cellcounter])
+        battery_min_max_voltage[0] = battery_cell_voltages[battery_cellcounter];
+      if (battery_min_max_voltage[1] < battery_cell_voltages[battery_cellcounter])
+        battery_min_max_voltage[1] = battery_cell_voltages[battery_cellcounter];
+    }
 
-          datalayer_battery->status.cell_max_voltage_mV = battery_min_max_voltage[1];
-          datalayer_battery->status.cell_min_voltage_mV = battery_min_max_voltage[0];
+    datalayer_battery->status.cell_max_voltage_mV = battery_min_max_voltage[1];
+    datalayer_battery->status.cell_min_voltage_mV = battery_min_max_voltage[0];
+  }
 
-          break;
-        }
+  if (group == 0x04 && length >= 13) {  //Temperatures
+    battery_temp_raw_1 = (data[2] << 8) | data[3];
+    battery_temp_raw_2 = (data[5] << 8) | data[6];
+    battery_temp_raw_3 = (data[8] << 8) | data[9];
+    battery_temp_raw_4 = (data[11] << 8) | data[12];
 
-        if ((rx_frame.data.u8[0] % 2) == 0) {  //even frames
-          battery_cell_voltages[battery_request_idx++] |= rx_frame.data.u8[1];
-          battery_cell_voltages[battery_request_idx++] = (rx_frame.data.u8[2] << 8) | rx_frame.data.u8[3];
-          battery_cell_voltages[battery_request_idx++] = (rx_frame.data.u8[4] << 8) | rx_frame.data.u8[5];
-          battery_cell_voltages[battery_request_idx++] = (rx_frame.data.u8[6] << 8) | rx_frame.data.u8[7];
-        } else {  //odd frames
-          battery_cell_voltages[battery_request_idx++] = (rx_frame.data.u8[1] << 8) | rx_frame.data.u8[2];
-          battery_cell_voltages[battery_request_idx++] = (rx_frame.data.u8[3] << 8) | rx_frame.data.u8[4];
-          battery_cell_voltages[battery_request_idx++] = (rx_frame.data.u8[5] << 8) | rx_frame.data.u8[6];
-          battery_cell_voltages[battery_request_idx] = (rx_frame.data.u8[7] << 8);
-        }
+    //All values read, let's figure out the min/max!
+    if (battery_temp_raw_3 == 65535) {  //We are on a 2013+ pack that only has three temp sensors.
+      //Start with finding max value
+      battery_temp_raw_max = battery_temp_raw_1;
+      if (battery_temp_raw_2 > battery_temp_raw_max) {
+        battery_temp_raw_max = battery_temp_raw_2;
       }
-
-      if (group_7bb == 0x04) {              //Temperatures
-        if (rx_frame.data.u8[0] == 0x10) {  //First message
-          battery_temp_raw_1 = (rx_frame.data.u8[4] << 8) | rx_frame.data.u8[5];
-          battery_temp_raw_2_highnibble = rx_frame.data.u8[7];
-        }
-        if (rx_frame.data.u8[0] == 0x21) {  //Second message
-          battery_temp_raw_2 = (battery_temp_raw_2_highnibble << 8) | rx_frame.data.u8[1];
-          battery_temp_raw_3 = (rx_frame.data.u8[3] << 8) | rx_frame.data.u8[4];
-          battery_temp_raw_4 = (rx_frame.data.u8[6] << 8) | rx_frame.data.u8[7];
-        }
-        if (rx_frame.data.u8[0] == 0x22) {  //Third message
-          //All values read, let's figure out the min/max!
-
-          if (battery_temp_raw_3 == 65535) {  //We are on a 2013+ pack that only has three temp sensors.
-            //Start with finding max value
-            battery_temp_raw_max = battery_temp_raw_1;
-            if (battery_temp_raw_2 > battery_temp_raw_max) {
-              battery_temp_raw_max = battery_temp_raw_2;
-            }
-            if (battery_temp_raw_4 > battery_temp_raw_max) {
-              battery_temp_raw_max = battery_temp_raw_4;
-            }
-            //Then find min
-            battery_temp_raw_min = battery_temp_raw_1;
-            if (battery_temp_raw_2 < battery_temp_raw_min) {
-              battery_temp_raw_min = battery_temp_raw_2;
-            }
-            if (battery_temp_raw_4 < battery_temp_raw_min) {
-              battery_temp_raw_min = battery_temp_raw_4;
-            }
-          } else {  //All 4 temp sensors available on 2011-2012
-            //Start with finding max value
-            battery_temp_raw_max = battery_temp_raw_1;
-            if (battery_temp_raw_2 > battery_temp_raw_max) {
-              battery_temp_raw_max = battery_temp_raw_2;
-            }
-            if (battery_temp_raw_3 > battery_temp_raw_max) {
-              battery_temp_raw_max = battery_temp_raw_3;
-            }
-            if (battery_temp_raw_4 > battery_temp_raw_max) {
-              battery_temp_raw_max = battery_temp_raw_4;
-            }
-            //Then find min
-            battery_temp_raw_min = battery_temp_raw_1;
-            if (battery_temp_raw_2 < battery_temp_raw_min) {
-              battery_temp_raw_min = battery_temp_raw_2;
-            }
-            if (battery_temp_raw_3 < battery_temp_raw_min) {
-              battery_temp_raw_min = battery_temp_raw_2;
-            }
-            if (battery_temp_raw_4 < battery_temp_raw_min) {
-              battery_temp_raw_min = battery_temp_raw_4;
-            }
-          }
-        }
+      if (battery_temp_raw_4 > battery_temp_raw_max) {
+        battery_temp_raw_max = battery_temp_raw_4;
       }
-
-      if (group_7bb == 0x06)  //Balancing resistor status
-      {
-        if (rx_frame.data.u8[0] == 0x10) {  //First frame (10 1A 61 06 [14 55 55 51])
-          for (int i = 0; i < 8; i++) {
-            // Byte 4 - 7 (bits 0-31)
-            for (int byte_i = 0; byte_i < 4; byte_i++) {
-              battery_balancing_shunts[byte_i * 8 + i] = (rx_frame.data.u8[4 + byte_i] & (1 << i)) >> i;
-            }
-          }
-        }
-        if (rx_frame.data.u8[0] == 0x21) {  // Second frame (21 [50 55 41 2B 56 54 15])
-          for (int i = 0; i < 8; i++) {
-            // Byte 1 to 7 (bits 32-87)
-            for (int byte_i = 0; byte_i < 7; byte_i++) {
-              battery_balancing_shunts[32 + byte_i * 8 + i] = (rx_frame.data.u8[1 + byte_i] & (1 << i)) >> i;
-            }
-          }
-        }
-        if (rx_frame.data.u8[0] == 0x22) {  //Third frame (22 51 FF FF FF FF FF FF)
-          for (int i = 0; i < 8; i++) {
-            // Byte 1 (bits 88-95)
-            battery_balancing_shunts[88 + i] = (rx_frame.data.u8[1] & (1 << i)) >> i;
-          }
-          memcpy(datalayer_battery->status.cell_balancing_status, battery_balancing_shunts, 96 * sizeof(bool));
-        }
-
-        if (rx_frame.data.u8[0] == 0x23) {  //Fourth frame (23 FF FF FF FF FF FF FF)
-        }
+      //Then find min
+      battery_temp_raw_min = battery_temp_raw_1;
+      if (battery_temp_raw_2 < battery_temp_raw_min) {
+        battery_temp_raw_min = battery_temp_raw_2;
       }
-
-      if (group_7bb == 0x83)  //BatteryPartNumber
-      {
-        if (rx_frame.data.u8[0] == 0x10) {  //First frame (101A6183334E4B32)
-          BatteryPartNumber[0] = rx_frame.data.u8[4];
-          BatteryPartNumber[1] = rx_frame.data.u8[5];
-          BatteryPartNumber[2] = rx_frame.data.u8[6];
-          BatteryPartNumber[3] = rx_frame.data.u8[7];
-        }
-        if (rx_frame.data.u8[0] == 0x21) {  //Second frame (2141524205170000)
-          BatteryPartNumber[4] = rx_frame.data.u8[1];
-          BatteryPartNumber[5] = rx_frame.data.u8[2];
-          BatteryPartNumber[6] = rx_frame.data.u8[3];
-        }
-        if (rx_frame.data.u8[0] == 0x22) {  //Third frame (2200000002101311)
-        }
-
-        if (rx_frame.data.u8[0] == 0x23) {  //Fourth frame (23000000000080FF)
-        }
+      if (battery_temp_raw_4 < battery_temp_raw_min) {
+        battery_temp_raw_min = battery_temp_raw_4;
       }
-      if (group_7bb == 0x84) {              //BatterySerialNumber
-        if (rx_frame.data.u8[0] == 0x10) {  //First frame (10 16 61 84 32 33 30 55)
-          BatterySerialNumber[0] = rx_frame.data.u8[7];
-        }
-        if (rx_frame.data.u8[0] == 0x21) {  //Second frame (21 4B 31 31 39 32 45 30)
-          BatterySerialNumber[1] = rx_frame.data.u8[1];
-          BatterySerialNumber[2] = rx_frame.data.u8[2];
-          BatterySerialNumber[3] = rx_frame.data.u8[3];
-          BatterySerialNumber[4] = rx_frame.data.u8[4];
-          BatterySerialNumber[5] = rx_frame.data.u8[5];
-          BatterySerialNumber[6] = rx_frame.data.u8[6];
-          BatterySerialNumber[7] = rx_frame.data.u8[7];
-        }
-        if (rx_frame.data.u8[0] == 0x22) {  //Third frame (22 30 31 34 38 32 20 A0)
-          BatterySerialNumber[8] = rx_frame.data.u8[1];
-          BatterySerialNumber[9] = rx_frame.data.u8[2];
-          BatterySerialNumber[10] = rx_frame.data.u8[3];
-          BatterySerialNumber[11] = rx_frame.data.u8[4];
-          BatterySerialNumber[12] = rx_frame.data.u8[5];
-          BatterySerialNumber[13] = rx_frame.data.u8[6];
-          BatterySerialNumber[14] = rx_frame.data.u8[7];
-        }
-        if (rx_frame.data.u8[0] == 0x23) {  //Fourth frame (23 00 00 00 00 00 00 00)
-        }
+    } else {  //All 4 temp sensors available on 2011-2012
+      //Start with finding max value
+      battery_temp_raw_max = battery_temp_raw_1;
+      if (battery_temp_raw_2 > battery_temp_raw_max) {
+        battery_temp_raw_max = battery_temp_raw_2;
       }
-
-      if (group_7bb == 0x90) {              //BMSIDcode
-        if (rx_frame.data.u8[0] == 0x10) {  //First frame (100A619044434131)
-          BMSIDcode[0] = rx_frame.data.u8[4];
-          BMSIDcode[1] = rx_frame.data.u8[5];
-          BMSIDcode[2] = rx_frame.data.u8[6];
-          BMSIDcode[3] = rx_frame.data.u8[7];
-        }
-        if (rx_frame.data.u8[0] == 0x21) {  //Second frame (2130303535FFFFFF)
-          BMSIDcode[4] = rx_frame.data.u8[1];
-          BMSIDcode[5] = rx_frame.data.u8[2];
-          BMSIDcode[6] = rx_frame.data.u8[3];
-          BMSIDcode[7] = rx_frame.data.u8[4];
-        }
+      if (battery_temp_raw_3 > battery_temp_raw_max) {
+        battery_temp_raw_max = battery_temp_raw_3;
+      }
+      if (battery_temp_raw_4 > battery_temp_raw_max) {
+        battery_temp_raw_max = battery_temp_raw_4;
+      }
+      //Then find min
+      battery_temp_raw_min = battery_temp_raw_1;
+      if (battery_temp_raw_2 < battery_temp_raw_min) {
+        battery_temp_raw_min = battery_temp_raw_2;
       }
+      if (battery_temp_raw_3 < battery_temp_raw_min) {
+        battery_temp_raw_min = battery_temp_raw_2;
+      }
+      if (battery_temp_raw_4 < battery_temp_raw_min) {
+        battery_temp_raw_min = battery_temp_raw_4;
+      }
+    }
+  }
 
-      break;
-    default:
-      break;
+  if (group == 0x06 && length >= 14) {  //Balancing resistor status, one bit per cell from byte 2 on
+    for (uint8_t i = 0; i < 96; i++) {
+      battery_balancing_shunts[i] = (data[2 + i / 8] >> (i % 8)) & 1;
+    }
+    memcpy(datalayer_battery->status.cell_balancing_status, battery_balancing_shunts, 96 * sizeof(bool));
+  }
+
+  if (group == 0x83 && length >= 2 + sizeof(BatteryPartNumber)) {  //BatteryPartNumber
+    memcpy(BatteryPartNumber, data + 2, sizeof(BatteryPartNumber));
+  }
+
+  if (group == 0x84 && length >= 5 + sizeof(BatterySerialNumber)) {  //BatterySerialNumber
+    memcpy(BatterySerialNumber, data + 5, sizeof(BatterySerialNumber));
+  }
+
+  if (group == 0x90 && length >= 2 + sizeof(BMSIDcode)) {  //BMSIDcode
+    memcpy(BMSIDcode, data + 2, sizeof(BMSIDcode));
   }
 }
 
@@ -568,10 +460,11 @@ void NissanLeafBattery::transmit_can(unsigned long currentMillis) {
     // Transmitting towards battery is halted while BMS is being reset
     previousMillis10 = currentMillis;
     previousMillis100 = currentMillis;
-    previousMillis10s = currentMillis;
     return;
   }
 
+  diag.update(currentMillis);
+
   if (battery_can_alive) {
 
     //Send 10ms message
@@ -771,30 +664,17 @@ void NissanLeafBattery::transmit_can(unsigned long currentMillis) {
       }
     }
 
-    //Send 10s CAN messages
-    if (currentMillis - previousMillis10s >= INTERVAL_10_S) {
-      previousMillis10s = currentMillis;
-
-      //Every 10s, ask diagnostic data from the battery. Don't ask if someone is already polling on the bus (Leafspy?)
-      if (!stop_battery_query) {
-
-        // Move to the next group
-        PIDindex = (PIDindex + 1) % 7;  // 7 = amount of elements in the PIDgroups[]
-        LEAF_GROUP_REQUEST.data.u8[2] = PIDgroups[PIDindex];
-
-        transmit_can_frame(&LEAF_GROUP_REQUEST);
-      }
-
-      if (hold_off_with_polling_10seconds > 0) {
-        hold_off_with_polling_10seconds--;
-      } else {
-        stop_battery_query = false;
-      }
+    // Ask for the next diagnostic group that is due. The scheduler holds off while someone else
+    // is polling on the bus (Leafspy?)
+    uint16_t group;
+    if (!diag.busy() && poller.next(currentMillis, group)) {
+      const uint8_t group_request[2] = {0x21, (uint8_t)group};
+      diag.request(group_request, sizeof(group_request), currentMillis);
     }
   }
 }
 
-uint8_t NissanLeafBattery::calculate_crc(CAN_frame& rx_frame) {
+uint8_t NissanLeafBattery::calculate_crc(const CAN_frame& rx_frame) {
   uint8_t crc = 0;
   for (uint8_t j = 0; j < 7; j++) {
     crc = crctable_nissan_leaf[(crc ^ static_cast<uint8_t>(rx_frame.data.u8[j])) % 256];
@@ -802,7 +682,7 @@ uint8_t NissanLeafBattery::calculate_crc(CAN_frame& rx_frame) {
   return crc;
 }
 
-bool NissanLeafBattery::is_message_corrupt(CAN_frame rx_frame) {
+bool NissanLeafBattery::is_message_corrupt(const CAN_frame& rx_frame) {
   uint8_t crc = calculate_crc(rx_frame);
   return crc != rx_frame.data.u8[7];
 }
@@ -842,8 +722,7 @@ uint16_t Temp_fromRAW_to_F(uint16_t temperature) {  //This function feels horrib
 
 void NissanLeafBattery::clearSOH(void) {
 #ifndef SMALL_FLASH_DEVICE
-  stop_battery_query = true;
-  hold_off_with_polling_10seconds = 10;  // Active battery polling is paused for 100 seconds
+  poller.hold_off(millis(), POLL_HOLD_OFF_MS);  // Active battery polling is paused for 100 seconds
 
   switch (stateMachineClearSOH) {
     case 0:  // Wait until polling actually stops
@@ -1035,4 +914,20 @@ void NissanLeafBattery::setup(void) {  // Performs one time setup at startup
   datalayer_battery->info.max_cell_voltage_mV = MAX_CELL_VOLTAGE_MV;
   datalayer_battery->info.min_cell_voltage_mV = MIN_CELL_VOLTAGE_MV;
   datalayer_battery->info.max_cell_voltage_deviation_mV = MAX_CELL_DEVIATION_MV;
+
+  // The LBC sends all lines of a group in one go, without a flow control frame per line
+  diag.set_flow_control(0, 0);
+  diag.on_response([this](const uint8_t* data, size_t length) { handle_group_response(data, length); });
+
+  // Cell voltages and temperatures every 10 s, the rest less often and the serial numbers rarely
+  poller.add(0x02, 10000, UdsPollScheduler::PRIORITY_HIGH);  // Cell voltages
+  poller.add(0x04, 10000, UdsPollScheduler::PRIORITY_HIGH);  // Temperatures
+  poller.add(0x01, 30000, UdsPollScheduler::PRIORITY_NORMAL);  // Insulation and internal resistance
+  poller.add(0x06, 30000, UdsPollScheduler::PRIORITY_NORMAL);  // Balancing shunts
+  poller.add(0x83, 300000, UdsPollScheduler::PRIORITY_LOW);  // Part number
+  poller.add(0x84, 300000, UdsPollScheduler::PRIORITY_LOW);  // Serial number
+  poller.add(0x90, 300000, UdsPollScheduler::PRIORITY_LOW);  // BMS ID code
+  // Responses can take as long as the ISO-TP timeout
+  poller.set_timeout(IsoTpSession::DEFAULT_TIMEOUT_MS + 500);
+  poller.hold_off(millis(), 20000);  // Paused for 20 seconds on startup
 }
@@ -1,6 +1,8 @@
 #ifndef NISSAN_LEAF_BATTERY_H
 #define NISSAN_LEAF_BATTERY_H
 
+#include "../communication/can/isotp.h"
+#include "../communication/can/uds_poll_scheduler.h"
 #include "../datalayer/datalayer.h"
 #include "../datalayer/datalayer_extended.h"
 #include "CanBattery.h"
@@ -28,7 +30,11 @@ class NissanLeafBattery : public CanBattery {
   }
 
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
+  // The IDs handle_incoming_can_frame() reacts to, all other frames are dropped before reaching it
+  std::vector<uint32_t> can_ids() override {
+    return {0x1C2, 0x1DB, 0x1DC, 0x1ED, 0x380, 0x55B, 0x59E, 0x5BC, 0x5BF, 0x5C0, 0x5EB, 0x79B, 0x7BB};
+  }
   virtual void update_values();
   virtual void transmit_can(unsigned long currentMillis);
 
@@ -42,9 +48,10 @@ class NissanLeafBattery : public CanBattery {
   }
 
   BatteryHtmlRenderer& get_status_renderer() { return renderer; }
+  const UdsPollScheduler* get_poll_scheduler() { return &poller; }
   static constexpr const char* Name = "Nissan LEAF battery";
 
-  uint8_t calculate_crc(CAN_frame& frame);
+  uint8_t calculate_crc(const CAN_frame& frame);
 
  private:
   static const int MAX_PACK_VOLTAGE_DV = 4040;  //5000 = 500.0V
@@ -55,7 +62,8 @@ class NissanLeafBattery : public CanBattery {
 
   NissanLeafHtmlRenderer renderer;
 
-  bool is_message_corrupt(CAN_frame rx_frame);
+  bool is_message_corrupt(const CAN_frame& rx_frame);
+  void handle_group_response(const uint8_t* data, size_t length);
   void clearSOH(void);
 
   DATALAYER_BATTERY_TYPE* datalayer_battery;
@@ -68,7 +76,6 @@ class NissanLeafBattery : public CanBattery {
   unsigned long previousMillis40 = 0;   // will store last time a 40ms CAN Message was send
   unsigned long previousMillis100 = 0;  // will store last time a 100ms CAN Message was send
   unsigned long previousMillis500 = 0;  // will store last time a 500ms CAN Message was send
-  unsigned long previousMillis10s = 0;  // will store last time a 1s CAN Message was send
   uint8_t mprun10r = 0;                 //counter 0-20 for 0x1F2 message
   uint8_t mprun10 = 0;                  //counter 0-3
   uint8_t mprun100 = 0;                 //counter 0-3
@@ -118,19 +125,14 @@ class NissanLeafBattery : public CanBattery {
                         .DLC = 6,
                         .ID = 0x626,
                         .data = {0x02, 0x00, 0xff, 0x1d, 0x20, 0x00}};
-  // Active polling messages
-  uint8_t PIDgroups[7] = {0x01, 0x02, 0x04, 0x06, 0x83, 0x84, 0x90};
-  uint8_t PIDindex = 0;
-  CAN_frame LEAF_GROUP_REQUEST = {.FD = false,
-                                  .ext_ID = false,
-                                  .DLC = 8,
-                                  .ID = 0x79B,
-                                  .data = {2, 0x21, 1, 0, 0, 0, 0, 0}};
-  CAN_frame LEAF_NEXT_LINE_REQUEST = {.FD = false,
-                                      .ext_ID = false,
-                                      .DLC = 8,
-                                      .ID = 0x79B,
-                                      .data = {0x30, 1, 0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}};
+  // Active polling of the groups 0x01, 0x02, 0x04, 0x06, 0x83, 0x84 and 0x90, at most one request per second
+  static const uint32_t POLL_HOLD_OFF_MS = 100000;  // Pause while Leafspy is polling, or the SOH is reset
+  UdsPollScheduler::Entry poll_entries[7];
+  UdsPollScheduler poller{poll_entries, 7, 1};
+  // Group requests (21 <group>) go to 0x79B, the multi-frame responses come back on 0x7BB
+  uint8_t diag_response[256];
+  IsoTpSession diag{0x79B, 0x7BB, diag_response, sizeof(diag_response),
+                    [this](const CAN_frame& frame) { transmit_can_frame(&frame, CAN_TX_DIAGNOSTIC); }};
 
   // The Li-ion battery controller only accepts a multi-message query. In fact, the LBC transmits many
   // groups: the first one contains lots of High Voltage battery data as SOC, currents, and voltage; the second
@@ -171,18 +173,13 @@ class NissanLeafBattery : public CanBattery {
   bool battery_Batt_Heater_Mail_Send_Request = false;  //Stores info when a heat request is happening
 
   // Nissan LEAF battery data from polled CAN messages
-  uint8_t battery_request_idx = 0;
-  uint8_t group_7bb = 0;
-  bool stop_battery_query = true;
-  uint8_t hold_off_with_polling_10seconds = 2;  //Paused for 20 seconds on startup
-  uint16_t battery_cell_voltages[96];           //array with all the cellvoltages
-  bool battery_balancing_shunts[96];            //array with all the balancing resistors
+  uint16_t battery_cell_voltages[96];  //array with all the cellvoltages
+  bool battery_balancing_shunts[96];   //array with all the balancing resistors
   uint8_t battery_cellcounter = 0;
   uint16_t battery_min_max_voltage[2];  //contains cell min[0] and max[1] values in mV
   uint16_t battery_HX = 0;              //Internal resistance
   uint16_t battery_insulation = 0;      //Insulation resistance
   uint16_t battery_temp_raw_1 = 718;
-  uint8_t battery_temp_raw_2_highnibble = 0;
   uint16_t battery_temp_raw_2 = 718;
   uint16_t battery_temp_raw_3 = 718;  //This measurement not available on 2013+
   uint16_t battery_temp_raw_4 = 718;
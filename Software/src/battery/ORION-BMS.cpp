@@ -64,7 +64,7 @@ void OrionBms::update_values() {
   }
 }
 
-void OrionBms::handle_incoming_can_frame(CAN_frame rx_frame) {
+void OrionBms::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x356:
       datalayer.battery.status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -45,7 +45,7 @@ void PylonBattery::update_values() {
   datalayer_battery->info.min_design_voltage_dV = discharge_cutoff_voltage;
 }
 
-void PylonBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void PylonBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   // Handle EMUS extended ID frames for cell monitoring
   if (rx_frame.ID == EMUS_BASE_ID) {
     // EMUS configuration frame containing cell count
@@ -51,7 +51,7 @@ void RenaultTwizyBattery::update_values() {
       max_value(cell_temperatures_dC, sizeof(cell_temperatures_dC) / sizeof(*cell_temperatures_dC));
 }
 
-void RenaultTwizyBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void RenaultTwizyBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x155:
       datalayer.battery.status.CAN_battery_still_alive = CAN_STILL_ALIVE;
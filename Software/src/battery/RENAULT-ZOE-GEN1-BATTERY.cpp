@@ -68,7 +68,7 @@ void RenaultZoeGen1Battery::
   }
 }
 
-void RenaultZoeGen1Battery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void RenaultZoeGen1Battery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x155:  //10ms - Charging power, current and SOC - Confirmed sent by: Fluence ZE40, Zoe 22/41kWh, Kangoo 33kWh
       datalayer_battery->status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -23,7 +23,7 @@ https://github.com/ljames28/Renault-Zoe-PH2-ZE50-Canbus-LBC-Information?tab=read
 https://github.com/fesch/CanZE/tree/master/app/src/main/assets/ZOE_Ph2
 */
 
-uint8_t RenaultZoeGen2Battery::calculate_crc_zoe(CAN_frame& rx_frame, uint8_t crc_xor) {
+uint8_t RenaultZoeGen2Battery::calculate_crc_zoe(const CAN_frame& rx_frame, uint8_t crc_xor) {
   uint8_t crc = 0;  //init value 0x00
   for (uint8_t j = 0; j < 7; j++) {
     crc = crc8_table_SAE_J1850_ZER0[(crc ^ static_cast<uint8_t>(rx_frame.data.u8[j])) & 0xFF];
@@ -31,7 +31,7 @@ uint8_t RenaultZoeGen2Battery::calculate_crc_zoe(CAN_frame& rx_frame, uint8_t cr
   return crc ^ crc_xor;
 }
 
-bool RenaultZoeGen2Battery::is_message_corrupt(CAN_frame rx_frame, uint8_t crc_xor) {
+bool RenaultZoeGen2Battery::is_message_corrupt(const CAN_frame& rx_frame, uint8_t crc_xor) {
   uint8_t crc = calculate_crc_zoe(rx_frame, crc_xor);
   return crc != rx_frame.data.u8[7];
 }
@@ -129,7 +129,7 @@ void RenaultZoeGen2Battery::update_values() {
   datalayer_extended.zoePH2.battery_soc_max = battery_soc_max;
 }
 
-void RenaultZoeGen2Battery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void RenaultZoeGen2Battery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x0F8:
       datalayer_battery->status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -24,7 +24,7 @@ class RenaultZoeGen2Battery : public CanBattery {
     datalayer_zoePH2 = &datalayer_extended.zoePH2;
   }
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
   virtual void transmit_can(unsigned long currentMillis);
   static constexpr const char* Name = "Renault Zoe Gen2 50kWh";
@@ -35,7 +35,7 @@ class RenaultZoeGen2Battery : public CanBattery {
 
   BatteryHtmlRenderer& get_status_renderer() { return renderer; }
 
-  uint8_t calculate_crc_zoe(CAN_frame& frame, uint8_t crc_xor);
+  uint8_t calculate_crc_zoe(const CAN_frame& frame, uint8_t crc_xor);
 
  private:
   RenaultZoeGen2HtmlRenderer renderer;
@@ -46,7 +46,7 @@ class RenaultZoeGen2Battery : public CanBattery {
   // If not null, this battery decides when the contactor can be closed and writes the value here.
   bool* allows_contactor_closing;
 
-  bool is_message_corrupt(CAN_frame rx_frame, uint8_t crc_xor);
+  bool is_message_corrupt(const CAN_frame& rx_frame, uint8_t crc_xor);
 
   static const int MAX_PACK_VOLTAGE_DV = 4100;  //5000 = 500.0V
   static const int MIN_PACK_VOLTAGE_DV = 3000;
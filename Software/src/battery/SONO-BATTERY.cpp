@@ -33,7 +33,7 @@ void SonoBattery::
   datalayer.battery.status.temperature_max_dC = temperatureMax;
 }
 
-void SonoBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void SonoBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x100:
       datalayer.battery.status.CAN_battery_still_alive = CAN_STILL_ALIVE;
@@ -111,21 +111,22 @@ void SonoBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
   }
 }
 void SonoBattery::transmit_can(unsigned long currentMillis) {
+  // All frames are cyclic and sent by the CAN scheduler, see setup()
+}
+
+void SonoBattery::setup(void) {  // Performs one time setup at startup
   // Send 100ms CAN Message
-  if (currentMillis - previousMillis100 >= INTERVAL_100_MS) {
-    previousMillis100 = currentMillis;
+  schedule_can_frame(&SONO_400, INTERVAL_100_MS, [this]() {
     //VCU Command message
     SONO_400.data.u8[0] = 0x15;  //Charging enabled bit01, dischargign enabled bit23, dc charging bit45
 
     if (datalayer.battery.status.bms_status == FAULT) {
       SONO_400.data.u8[0] = 0x14;  //Charging DISABLED
     }
-    transmit_can_frame(&SONO_400);
-  }
+    return true;
+  });
   // Send 1000ms CAN Message
-  if (currentMillis - previousMillis1000 >= INTERVAL_1_S) {
-    previousMillis1000 = currentMillis;
-
+  schedule_can_frame(&SONO_401, INTERVAL_1_S, [this]() {
     //Time and date
     //Let's see if the battery is happy with just getting seconds incrementing
     SONO_401.data.u8[0] = 25;       //Year
@@ -135,11 +136,9 @@ void SonoBattery::transmit_can(unsigned long currentMillis) {
     SONO_401.data.u8[4] = 15;       //Minute
     SONO_401.data.u8[5] = seconds;  //Second
     seconds = (seconds + 1) % 61;
-    transmit_can_frame(&SONO_401);
-  }
-}
+    return true;
+  });
 
-void SonoBattery::setup(void) {  // Performs one time setup at startup
   strncpy(datalayer.system.info.battery_protocol, Name, 63);
   datalayer.system.info.battery_protocol[63] = '\0';
   datalayer.battery.info.number_of_cells = 96;
@@ -6,7 +6,7 @@
 class SonoBattery : public CanBattery {
  public:
   virtual void setup(void);
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
   virtual void update_values();
   virtual void transmit_can(unsigned long currentMillis);
   static constexpr const char* Name = "Sono Motors Sion 64kWh LFP ";
@@ -18,9 +18,6 @@ class SonoBattery : public CanBattery {
   static const int MAX_CELL_VOLTAGE_MV = 3800;  //Battery is put into emergency stop if one cell goes over this value
   static const int MIN_CELL_VOLTAGE_MV = 2700;  //Battery is put into emergency stop if one cell goes below this value
 
-  unsigned long previousMillis100 = 0;   // will store last time a 100ms CAN Message was send
-  unsigned long previousMillis1000 = 0;  // will store last time a 1000ms CAN Message was send
-
   uint8_t seconds = 0;
   uint8_t functionalsafetybitmask = 0;
   uint16_t batteryVoltage = 3700;
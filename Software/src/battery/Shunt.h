@@ -15,7 +15,7 @@ class CanShunt : public Transmitter, CanReceiver {
  public:
   virtual void setup() = 0;
   virtual void transmit_can(unsigned long currentMillis) = 0;
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame) = 0;
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame) = 0;
 
   // The name of the comm interface the shunt is using.
   virtual const char* interface_name() { return getCANInterfaceName(can_config.shunt); }
@@ -26,7 +26,7 @@ class CanShunt : public Transmitter, CanReceiver {
     }
   }
 
-  void receive_can_frame(CAN_frame* frame) { handle_incoming_can_frame(*frame); }
+  void receive_can_frame(const CAN_frame& frame) { handle_incoming_can_frame(frame); }
 
  protected:
   CAN_Interface can_interface;
@@ -885,7 +885,7 @@ void TeslaBattery::
                  (battery_dcdcLvBusVolt * 0.0390625), (battery_dcdcLvOutputCurrent * 0.1));
 }
 
-void TeslaBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void TeslaBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   static uint8_t mux = 0;
   static uint16_t temp = 0;
   static bool mux0_read = false;
@@ -18,7 +18,12 @@ class TeslaBattery : public CanBattery {
   // Use the default constructor to create the first or single battery.
   TeslaBattery() { allows_contactor_closing = &datalayer.system.status.battery_allows_contactor_closing; }
 
-  virtual void handle_incoming_can_frame(CAN_frame rx_frame);
+  virtual void handle_incoming_can_frame(const CAN_frame& rx_frame);
+  // The IDs handle_incoming_can_frame() reacts to, all other frames are dropped before reaching it
+  std::vector<uint32_t> can_ids() override {
+    return {0x132, 0x20A, 0x212, 0x224, 0x252, 0x292, 0x2A4, 0x2B4, 0x2C4, 0x2D2, 0x300, 0x310,
+            0x312, 0x320, 0x332, 0x352, 0x392, 0x3AA, 0x3C4, 0x3D2, 0x401, 0x612, 0x72A, 0x7AA};
+  }
   virtual void update_values();
   virtual void transmit_can(unsigned long currentMillis);
 
@@ -34,7 +34,7 @@ void ThinkBattery::update_values() {
   }
 }
 
-void ThinkBattery::handle_incoming_can_frame(CAN_frame rx_frame) {
+void ThinkBattery::handle_incoming_can_frame(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x300:
       datalayer.battery.status.CAN_battery_still_alive = CAN_STILL_ALIVE;
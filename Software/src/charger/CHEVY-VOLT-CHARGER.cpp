@@ -22,7 +22,7 @@
  */
 
 /* We are mostly sending out not receiving */
-void ChevyVoltCharger::map_can_frame_to_variable(CAN_frame rx_frame) {
+void ChevyVoltCharger::map_can_frame_to_variable(const CAN_frame& rx_frame) {
   uint16_t charger_stat_HVcur_temp = 0;
   uint16_t charger_stat_HVvol_temp = 0;
   uint16_t charger_stat_LVcur_temp = 0;
@@ -39,7 +39,7 @@ static uint8_t calculate_checksum_nibble(CAN_frame* frame) {
   return sum;
 }
 
-void NissanLeafCharger::map_can_frame_to_variable(CAN_frame rx_frame) {
+void NissanLeafCharger::map_can_frame_to_variable(const CAN_frame& rx_frame) {
 
   switch (rx_frame.ID) {
     case 0x679:  // This message fires once when charging cable is plugged in
@@ -13,7 +13,7 @@ class NissanLeafCharger : public CanCharger {
   const char* name() { return Name; }
   static constexpr const char* Name = "Nissan LEAF 2013-2024 PDM charger";
 
-  void map_can_frame_to_variable(CAN_frame rx_frame);
+  void map_can_frame_to_variable(const CAN_frame& rx_frame);
   void transmit_can(unsigned long currentMillis);
 
   float outputPowerDC() { return static_cast<float>(datalayer.charger.charger_stat_HVcur * 100); }
@@ -1,11 +1,17 @@
 #ifndef _CANRECEIVER_H
 #define _CANRECEIVER_H
 
+#include <vector>
 #include "../../devboard/utils/types.h"
 
 class CanReceiver {
  public:
-  virtual void receive_can_frame(CAN_frame* rx_frame) = 0;
+  virtual void receive_can_frame(const CAN_frame& rx_frame) = 0;
+
+  // The CAN IDs this receiver handles. Collected when the CAN interfaces are
+  // initialized, frames with other IDs are then never delivered. An empty list
+  // means all frames on the interface are wanted.
+  virtual std::vector<uint32_t> can_ids() { return {}; }
 };
 
 #endif
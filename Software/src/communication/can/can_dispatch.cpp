@@ -0,0 +1,77 @@
+#include "can_dispatch.h"
+#include "CanReceiver.h"
+
+bool CanDispatchTable::add(CanReceiver* receiver, const std::vector<uint32_t>& ids) {
+  if (count >= MAX_RECEIVERS) {
+    return false;
+  }
+
+  const uint8_t bit = 1 << count;
+  receivers[count++] = receiver;
+
+  if (ids.empty()) {
+    wildcard_mask |= bit;
+    return true;
+  }
+
+  for (uint32_t id : ids) {
+    if (id < STANDARD_ID_COUNT) {
+      if (!standard_ids) {
+        standard_ids.reset(new uint8_t[STANDARD_ID_COUNT]());
+      }
+      standard_ids[id] |= bit;
+    } else {
+      extended_ids[id] |= bit;
+    }
+  }
+  return true;
+}
+
+void CanDispatchTable::clear() {
+  for (auto& receiver : receivers) {
+    receiver = nullptr;
+  }
+  count = 0;
+  wildcard_mask = 0;
+  standard_ids.reset();
+  extended_ids.clear();
+}
+
+void CanDispatchTable::collect_ids(std::vector<uint32_t>& ids) const {
+  if (standard_ids) {
+    for (uint32_t id = 0; id < STANDARD_ID_COUNT; id++) {
+      if (standard_ids[id]) {
+        ids.push_back(id);
+      }
+    }
+  }
+  for (const auto& it : extended_ids) {
+    ids.push_back(it.first);
+  }
+}
+
+uint8_t CanDispatchTable::receivers_for(uint32_t id) const {
+  uint8_t mask = wildcard_mask;
+
+  if (id < STANDARD_ID_COUNT) {
+    if (standard_ids) {
+      mask |= standard_ids[id];
+    }
+  } else if (!extended_ids.empty()) {
+    auto it = extended_ids.find(id);
+    if (it != extended_ids.end()) {
+      mask |= it->second;
+    }
+  }
+  return mask;
+}
+
+void CanDispatchTable::dispatch(const CAN_frame& rx_frame) const {
+  uint8_t mask = receivers_for(rx_frame.ID);
+
+  for (uint8_t i = 0; mask != 0; i++, mask >>= 1) {
+    if (mask & 1) {
+      receivers[i]->receive_can_frame(rx_frame);
+    }
+  }
+}
@@ -0,0 +1,56 @@
+#ifndef _CAN_DISPATCH_H_
+#define _CAN_DISPATCH_H_
+
+#include <stdint.h>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "../../devboard/utils/types.h"
+
+class CanReceiver;
+
+// Routes received frames on one CAN interface to the receivers that consume them.
+// Standard (11-bit) IDs are looked up in a direct-indexed table, extended (29-bit)
+// IDs in a hash map. Frames no receiver has asked for are dropped without any
+// virtual call. Receivers that declare no IDs get every frame on the interface.
+class CanDispatchTable {
+ public:
+  // Largest number of receivers one interface can serve (battery x3, inverter, charger, shunt)
+  static constexpr uint8_t MAX_RECEIVERS = 8;
+  // Number of direct-indexed entries, one per possible 11-bit ID
+  static constexpr uint16_t STANDARD_ID_COUNT = 0x800;
+
+  // Adds a receiver. An empty ID list means the receiver wants all frames.
+  // Returns false if the table is full.
+  bool add(CanReceiver* receiver, const std::vector<uint32_t>& ids);
+
+  // Removes all receivers and frees the lookup tables
+  void clear();
+
+  // Passes the frame on to every receiver interested in its ID, in registration order
+  void dispatch(const CAN_frame& rx_frame) const;
+
+  // True if at least one receiver would get a frame with this ID
+  bool is_wanted(uint32_t id) const { return receivers_for(id) != 0; }
+
+  // True if a receiver takes every frame, so no ID can be filtered out
+  bool accepts_all() const { return wildcard_mask != 0; }
+
+  uint8_t receiver_count() const { return count; }
+
+  // Appends the IDs the receivers declared, e.g. to program the controller's acceptance filters
+  void collect_ids(std::vector<uint32_t>& ids) const;
+
+ private:
+  uint8_t receivers_for(uint32_t id) const;
+
+  CanReceiver* receivers[MAX_RECEIVERS] = {nullptr};
+  uint8_t count = 0;
+  // Bit n set means receivers[n] gets the frame
+  uint8_t wildcard_mask = 0;
+  // Allocated only once a receiver declares a standard ID
+  std::unique_ptr<uint8_t[]> standard_ids;
+  std::unordered_map<uint32_t, uint8_t> extended_ids;
+};
+
+#endif
@@ -0,0 +1,118 @@
+#include "can_filters.h"
+#include <algorithm>
+
+static uint32_t id_bits(bool extended) {
+  return extended ? 0x1FFFFFFF : CAN_MAX_STANDARD_ID;
+}
+
+uint32_t CanAcceptanceFilter::accepted_count() const {
+  return 1UL << __builtin_popcount(id_bits(extended) & ~mask);
+}
+
+// The narrowest filter that passes everything either of the two does
+static CanAcceptanceFilter merge(const CanAcceptanceFilter& a, const CanAcceptanceFilter& b) {
+  const uint32_t mask = a.mask & b.mask & ~(a.id ^ b.id);
+  return {a.id & mask, mask, a.extended};
+}
+
+bool merge_can_filters(const std::vector<uint32_t>& ids, uint8_t max_filters,
+                       std::vector<CanAcceptanceFilter>& filters) {
+  std::vector<uint32_t> unique_ids(ids);
+  std::sort(unique_ids.begin(), unique_ids.end());
+  unique_ids.erase(std::unique(unique_ids.begin(), unique_ids.end()), unique_ids.end());
+
+  filters.clear();
+  for (uint32_t id : unique_ids) {
+    const bool extended = id > CAN_MAX_STANDARD_ID;
+    filters.push_back({id, id_bits(extended), extended});
+  }
+
+  while (filters.size() > max_filters) {
+    size_t best_a = 0;
+    size_t best_b = 0;
+    int64_t best_cost = INT64_MAX;
+
+    for (size_t a = 0; a < filters.size(); a++) {
+      for (size_t b = a + 1; b < filters.size(); b++) {
+        if (filters[a].extended != filters[b].extended) {
+          continue;
+        }
+        // Extra IDs let through by the merge. Negative if one filter already covered the other.
+        const int64_t cost = (int64_t)merge(filters[a], filters[b]).accepted_count() - filters[a].accepted_count() -
+                             filters[b].accepted_count();
+        if (cost < best_cost) {
+          best_cost = cost;
+          best_a = a;
+          best_b = b;
+        }
+      }
+    }
+
+    if (best_cost == INT64_MAX) {
+      return false;  // Only filters of different formats left
+    }
+    filters[best_a] = merge(filters[best_a], filters[best_b]);
+    filters.erase(filters.begin() + best_b);
+  }
+  return true;
+}
+
+// Gives the selected filters their common mask and returns how many IDs they then let through
+static uint64_t apply_shared_mask(const std::vector<CanAcceptanceFilter>& filters, uint32_t selection,
+                                  std::vector<CanAcceptanceFilter>& group) {
+  uint32_t mask = id_bits(filters[0].extended);
+  for (size_t i = 0; i < filters.size(); i++) {
+    if (selection & (1 << i)) {
+      mask &= filters[i].mask;
+    }
+  }
+
+  group.clear();
+  for (size_t i = 0; i < filters.size(); i++) {
+    if (!(selection & (1 << i))) {
+      continue;
+    }
+    const CanAcceptanceFilter filter = {filters[i].id & mask, mask, filters[i].extended};
+    const bool duplicate = std::any_of(group.begin(), group.end(),
+                                       [&](const CanAcceptanceFilter& other) { return other.id == filter.id; });
+    if (!duplicate) {
+      group.push_back(filter);
+    }
+  }
+  return group.empty() ? 0 : (uint64_t)group.size() * group[0].accepted_count();
+}
+
+bool merge_can_filters_shared_masks(const std::vector<uint32_t>& ids, uint8_t first_group_size,
+                                    uint8_t second_group_size, std::vector<CanAcceptanceFilter>& first_group,
+                                    std::vector<CanAcceptanceFilter>& second_group) {
+  std::vector<CanAcceptanceFilter> filters;
+  if (!merge_can_filters(ids, first_group_size + second_group_size, filters) || filters.empty()) {
+    return false;
+  }
+  for (const auto& filter : filters) {
+    if (filter.extended != filters[0].extended) {
+      return false;  // One mask cannot serve both formats
+    }
+  }
+
+  // At most a handful of filters, so simply try every way of splitting them between the two masks
+  const uint32_t all = (1 << filters.size()) - 1;
+  uint64_t best_cost = UINT64_MAX;
+  std::vector<CanAcceptanceFilter> first;
+  std::vector<CanAcceptanceFilter> second;
+
+  for (uint32_t selection = 1; selection <= all; selection++) {
+    const uint8_t in_first = __builtin_popcount(selection);
+    if (in_first > first_group_size || filters.size() - in_first > second_group_size) {
+      continue;
+    }
+    const uint64_t cost =
+        apply_shared_mask(filters, selection, first) + apply_shared_mask(filters, all & ~selection, second);
+    if (cost < best_cost) {
+      best_cost = cost;
+      first_group = first;
+      second_group = second.empty() ? first : second;
+    }
+  }
+  return best_cost != UINT64_MAX;
+}
@@ -0,0 +1,36 @@
+#ifndef _CAN_FILTERS_H_
+#define _CAN_FILTERS_H_
+
+#include <stdint.h>
+#include <vector>
+
+// One hardware acceptance filter. A frame of the filter's format passes if
+// (frame ID & mask) == (id & mask), so cleared mask bits are "don't care".
+struct CanAcceptanceFilter {
+  uint32_t id;
+  uint32_t mask;
+  bool extended;
+
+  // Number of IDs of the filter's format that pass
+  uint32_t accepted_count() const;
+};
+
+// Highest standard (11-bit) ID. Larger IDs are programmed as extended filters.
+static constexpr uint32_t CAN_MAX_STANDARD_ID = 0x7FF;
+
+// Reduces the IDs to at most max_filters filters, each with its own mask, that let all of them
+// through. Filters are merged pairwise, always picking the pair whose merge lets the fewest
+// extra IDs pass. Standard and extended filters are never merged with each other.
+// Returns false if the IDs cannot be covered with max_filters filters.
+bool merge_can_filters(const std::vector<uint32_t>& ids, uint8_t max_filters,
+                       std::vector<CanAcceptanceFilter>& filters);
+
+// As merge_can_filters, for controllers with two masks each shared by a group of filters, like
+// the MCP2515 (RXM0 for filters 0-1, RXM1 for filters 2-5). All filters in a group are returned
+// with the same mask. Neither group is left empty, so a single filter is repeated in both.
+// Returns false if the IDs mix standard and extended frames or need too many filters.
+bool merge_can_filters_shared_masks(const std::vector<uint32_t>& ids, uint8_t first_group_size,
+                                    uint8_t second_group_size, std::vector<CanAcceptanceFilter>& first_group,
+                                    std::vector<CanAcceptanceFilter>& second_group);
+
+#endif
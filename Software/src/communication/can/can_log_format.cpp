@@ -0,0 +1,279 @@
+#include "can_log_format.h"
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+static void put_le(uint8_t* out, uint64_t value, uint8_t bytes) {
+  for (uint8_t i = 0; i < bytes; i++) {
+    out[i] = (uint8_t)(value >> (8 * i));
+  }
+}
+
+static uint64_t get_le(const uint8_t* in, uint8_t bytes) {
+  uint64_t value = 0;
+  for (uint8_t i = 0; i < bytes; i++) {
+    value |= (uint64_t)in[i] << (8 * i);
+  }
+  return value;
+}
+
+size_t CanLogEncoder::encode(const CAN_frame& frame, CAN_Interface interface, frameDirection direction,
+                             int64_t timestamp_us, uint8_t* out) {
+  size_t size = 0;
+
+  int64_t delta_us = timestamp_us - last_timestamp_us;
+  if (!synced || delta_us < 0 || delta_us > UINT16_MAX) {
+    out[size++] = CAN_LOG_TIME_BASE;
+    put_le(out + size, (uint64_t)timestamp_us, 8);
+    size += 8;
+    delta_us = 0;
+    synced = true;
+  }
+  last_timestamp_us = timestamp_us;
+
+  const uint8_t dlc = frame.DLC > 64 ? 64 : frame.DLC;
+  out[size++] = (direction == MSG_TX ? CAN_LOG_FLAG_TX : 0) | (frame.ext_ID ? CAN_LOG_FLAG_EXT_ID : 0) |
+                (frame.FD ? CAN_LOG_FLAG_FD : 0) | ((interface & 0x03) << CAN_LOG_INTERFACE_SHIFT);
+  put_le(out + size, (uint64_t)delta_us, 2);
+  size += 2;
+  put_le(out + size, frame.ID, 4);
+  size += 4;
+  out[size++] = dlc;
+  memcpy(out + size, frame.data.u8, dlc);
+  return size + dlc;
+}
+
+size_t CanLogDecoder::next(const uint8_t* data, size_t size, CanLogRecord& record) {
+  size_t used = 0;
+
+  while (used < size) {
+    const uint8_t flags = data[used];
+
+    if (flags == CAN_LOG_TIME_BASE) {
+      if (size - used < CAN_LOG_TIME_BASE_SIZE) {
+        return 0;
+      }
+      timestamp_us = (int64_t)get_le(data + used + 1, 8);
+      used += CAN_LOG_TIME_BASE_SIZE;
+      continue;
+    }
+
+    if (flags & 0xE0) {
+      invalid = true;
+      return 0;
+    }
+    if (size - used < CAN_LOG_FRAME_HEADER_SIZE) {
+      return 0;
+    }
+    const uint8_t dlc = data[used + 7];
+    if (dlc > 64) {
+      invalid = true;
+      return 0;
+    }
+    if (size - used < CAN_LOG_FRAME_HEADER_SIZE + dlc) {
+      return 0;
+    }
+
+    timestamp_us += get_le(data + used + 1, 2);
+    record = {};
+    record.frame.ID = (uint32_t)get_le(data + used + 3, 4);
+    record.frame.DLC = dlc;
+    record.frame.ext_ID = flags & CAN_LOG_FLAG_EXT_ID;
+    record.frame.FD = flags & CAN_LOG_FLAG_FD;
+    memcpy(record.frame.data.u8, data + used + CAN_LOG_FRAME_HEADER_SIZE, dlc);
+    record.interface = (CAN_Interface)((flags >> CAN_LOG_INTERFACE_SHIFT) & 0x03);
+    record.direction = (flags & CAN_LOG_FLAG_TX) ? MSG_TX : MSG_RX;
+    record.timestamp_us = timestamp_us;
+    return used + CAN_LOG_FRAME_HEADER_SIZE + dlc;
+  }
+  return 0;
+}
+
+size_t format_can_log_line(const CanLogRecord& record, char* out, size_t size) {
+  const CAN_frame& frame = record.frame;
+
+  // Multiplying the interface by two puts TX and RX on different buses in SavvyCAN, as in the webserver log
+  int length = snprintf(out, size, "(%lu.%06lu) %s%d %lX [%u] ", (unsigned long)(record.timestamp_us / 1000000),
+                        (unsigned long)(record.timestamp_us % 1000000), record.direction == MSG_RX ? "RX" : "TX",
+                        (int)(record.interface * 2) + (record.direction == MSG_RX ? 0 : 1), (unsigned long)frame.ID,
+                        frame.DLC);
+
+  for (uint8_t i = 0; i < frame.DLC && length < (int)size; i++) {
+    length += snprintf(out + length, size - length, i < frame.DLC - 1 ? "%02X " : "%02X", frame.data.u8[i]);
+  }
+  if (length < (int)size) {
+    length += snprintf(out + length, size - length, "\n");
+  }
+  return length < (int)size ? length : size - 1;
+}
+
+static bool is_space(char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+static int hex_value(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  return -1;
+}
+
+bool parse_can_log_line(const char* line, size_t length, CanLogRecord& record) {
+  const char* p = line;
+  const char* end = line + length;
+  auto skip_spaces = [&]() {
+    while (p < end && is_space(*p)) {
+      p++;
+    }
+  };
+
+  record = {};
+
+  // Timestamp in seconds, e.g. (12.345678)
+  skip_spaces();
+  if (p == end || *p++ != '(') {
+    return false;
+  }
+  int64_t seconds = 0;
+  const char* digits = p;
+  while (p < end && *p >= '0' && *p <= '9') {
+    seconds = seconds * 10 + (*p++ - '0');
+  }
+  if (p == digits) {
+    return false;
+  }
+  int64_t micros = 0;
+  int64_t scale = 100000;
+  if (p < end && *p == '.') {
+    p++;
+    while (p < end && *p >= '0' && *p <= '9') {
+      micros += (*p++ - '0') * scale;
+      scale /= 10;
+    }
+  }
+  if (p == end || *p++ != ')') {
+    return false;
+  }
+  record.timestamp_us = seconds * 1000000 + micros;
+
+  // RX or TX with the bus number, which is twice the interface plus one for TX
+  skip_spaces();
+  if (end - p < 3 || (p[0] != 'R' && p[0] != 'T') || p[1] != 'X') {
+    return false;
+  }
+  record.direction = p[0] == 'R' ? MSG_RX : MSG_TX;
+  p += 2;
+  int bus = 0;
+  while (p < end && *p >= '0' && *p <= '9') {
+    bus = bus * 10 + (*p++ - '0');
+  }
+  record.interface = (CAN_Interface)std::min(bus / 2, (int)NO_CAN_INTERFACE - 1);
+
+  // ID in hex, extended when written with more than three digits
+  skip_spaces();
+  digits = p;
+  while (p < end && hex_value(*p) >= 0) {
+    record.frame.ID = (record.frame.ID << 4) | hex_value(*p++);
+  }
+  if (p == digits || p - digits > 8) {
+    return false;
+  }
+  record.frame.ext_ID = p - digits > 3 || record.frame.ID > 0x7FF;
+
+  // [DLC] and the data bytes
+  skip_spaces();
+  if (p == end || *p++ != '[') {
+    return false;
+  }
+  uint32_t dlc = 0;
+  while (p < end && *p >= '0' && *p <= '9') {
+    dlc = dlc * 10 + (*p++ - '0');
+  }
+  if (p == end || *p++ != ']' || dlc > 64) {
+    return false;
+  }
+  record.frame.DLC = dlc;
+  record.frame.FD = dlc > 8;
+
+  for (uint8_t i = 0; i < dlc; i++) {
+    skip_spaces();
+    if (end - p < 2 || hex_value(p[0]) < 0 || hex_value(p[1]) < 0) {
+      return false;
+    }
+    record.frame.data.u8[i] = (hex_value(p[0]) << 4) | hex_value(p[1]);
+    p += 2;
+  }
+  return true;
+}
+
+void CanLogTextImporter::end_line(const std::function<void(const CanLogRecord&)>& on_frame) {
+  CanLogRecord record;
+  if (overlong) {
+    skipped++;
+  } else if (parse_can_log_line(line, length, record)) {
+    on_frame(record);
+  } else {
+    // Blank lines are fine
+    size_t i = 0;
+    while (i < length && is_space(line[i])) {
+      i++;
+    }
+    if (i < length) {
+      skipped++;
+    }
+  }
+  length = 0;
+  overlong = false;
+}
+
+void CanLogTextImporter::feed(const char* data, size_t size,
+                              const std::function<void(const CanLogRecord&)>& on_frame) {
+  for (size_t i = 0; i < size; i++) {
+    if (data[i] == '\n') {
+      end_line(on_frame);
+    } else if (length < sizeof(line)) {
+      line[length++] = data[i];
+    } else {
+      overlong = true;
+    }
+  }
+}
+
+void CanLogTextImporter::finish(const std::function<void(const CanLogRecord&)>& on_frame) {
+  if (length > 0 || overlong) {
+    end_line(on_frame);
+  }
+}
+
+bool CanLogTextReader::next(CanLogRecord& record) {
+  const size_t used = decoder.next(records.data() + offset, records.size() - offset, record);
+  offset += used;
+  return used != 0;
+}
+
+size_t CanLogTextReader::read(char* out, size_t size) {
+  size_t written = 0;
+
+  while (written < size) {
+    if (line_offset == line_length) {
+      CanLogRecord record;
+      if (!next(record)) {
+        break;
+      }
+      line_length = format_can_log_line(record, line, sizeof(line));
+      line_offset = 0;
+    }
+
+    const size_t length = std::min(line_length - line_offset, size - written);
+    memcpy(out + written, line + line_offset, length);
+    line_offset += length;
+    written += length;
+  }
+  return written;
+}
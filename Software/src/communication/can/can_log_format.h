@@ -0,0 +1,121 @@
+#ifndef _CAN_LOG_FORMAT_H_
+#define _CAN_LOG_FORMAT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "../../devboard/utils/types.h"
+
+// Compact binary CAN log. A log file starts with CAN_LOG_MAGIC, followed by records:
+//
+//   Frame:     flags (1), time since previous frame in us (2), ID (4), DLC (1), DLC data bytes
+//   Time base: CAN_LOG_TIME_BASE (1), absolute time in us (8)
+//
+// All values are little-endian. A time base comes before the first frame of every session, and
+// whenever the gap to the previous frame does not fit in the delta or frames were lost in between.
+// test/utils/canlog_convert turns a log into the candump-style text SavvyCAN reads.
+
+#define CAN_LOG_MAGIC "BECANLG1"
+static constexpr size_t CAN_LOG_MAGIC_SIZE = 8;
+
+// Flag bits of a frame record
+static constexpr uint8_t CAN_LOG_FLAG_TX = 0x01;
+static constexpr uint8_t CAN_LOG_FLAG_EXT_ID = 0x02;
+static constexpr uint8_t CAN_LOG_FLAG_FD = 0x04;
+static constexpr uint8_t CAN_LOG_INTERFACE_SHIFT = 3;  // Two bits of CAN_Interface
+static constexpr uint8_t CAN_LOG_TIME_BASE = 0x80;
+
+static constexpr size_t CAN_LOG_FRAME_HEADER_SIZE = 8;
+static constexpr size_t CAN_LOG_TIME_BASE_SIZE = 9;
+
+struct CanLogRecord {
+  CAN_frame frame;
+  CAN_Interface interface;
+  frameDirection direction;
+  int64_t timestamp_us;
+};
+
+class CanLogEncoder {
+ public:
+  // Largest number of bytes encode() writes for one frame
+  static constexpr size_t MAX_RECORD_SIZE = CAN_LOG_TIME_BASE_SIZE + CAN_LOG_FRAME_HEADER_SIZE + 64;
+
+  // Writes the records for one frame to out, which must hold MAX_RECORD_SIZE bytes. Returns the bytes written.
+  size_t encode(const CAN_frame& frame, CAN_Interface interface, frameDirection direction, int64_t timestamp_us,
+                uint8_t* out);
+
+  // Starts the next frame with a time base, e.g. because records written since the last one were lost
+  void resync() { synced = false; }
+
+ private:
+  bool synced = false;
+  int64_t last_timestamp_us = 0;
+};
+
+class CanLogDecoder {
+ public:
+  // start_us is the time of the frame before the first record, for logs that do not begin with a time base
+  explicit CanLogDecoder(int64_t start_us = 0) : timestamp_us(start_us) {}
+
+  // Decodes records from data until a frame is complete. Returns the bytes used, or 0 if data
+  // ends before the frame does or holds something that is not a record (see failed()).
+  size_t next(const uint8_t* data, size_t size, CanLogRecord& record);
+
+  bool failed() const { return invalid; }
+
+ private:
+  int64_t timestamp_us;
+  bool invalid = false;
+};
+
+// Formats a frame as one line of text like the webserver CAN log, e.g. "(12.345678) RX0 1DB [8] 01 02 ...\n".
+// Returns the length, at most 64 * 3 + 48 characters.
+size_t format_can_log_line(const CanLogRecord& record, char* out, size_t size);
+
+// Parses one line of candump-style text as written by format_can_log_line, without its newline.
+// Returns false if the line does not hold a frame.
+bool parse_can_log_line(const char* line, size_t length, CanLogRecord& record);
+
+// Splits text arriving in pieces, e.g. an upload, into lines and parses them
+class CanLogTextImporter {
+ public:
+  // Calls on_frame for every complete line of data that holds a frame
+  void feed(const char* data, size_t size, const std::function<void(const CanLogRecord&)>& on_frame);
+  // Parses what is left after the last newline
+  void finish(const std::function<void(const CanLogRecord&)>& on_frame);
+
+  // Lines that were not empty but held no frame, or were too long for one
+  uint32_t skipped_lines() const { return skipped; }
+
+ private:
+  void end_line(const std::function<void(const CanLogRecord&)>& on_frame);
+
+  char line[256];
+  size_t length = 0;
+  bool overlong = false;
+  uint32_t skipped = 0;
+};
+
+// Turns a copy of binary records into log text a piece at a time, e.g. to fill the chunks of a web response
+class CanLogTextReader {
+ public:
+  CanLogTextReader(std::vector<uint8_t>&& data, int64_t start_us) : records(std::move(data)), decoder(start_us) {}
+
+  // Writes up to size bytes of text to out. Returns the bytes written, 0 once all frames are read.
+  size_t read(char* out, size_t size);
+
+ private:
+  bool next(CanLogRecord& record);
+
+  std::vector<uint8_t> records;
+  size_t offset = 0;
+  CanLogDecoder decoder;
+  // The line being written, when it did not fit in the previous read
+  char line[256];
+  size_t line_length = 0;
+  size_t line_offset = 0;
+};
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef _CAN_LOG_RING_H_
+#define _CAN_LOG_RING_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "can_log_format.h"
+
+// Keeps the most recent frames as binary CanLogEncoder records in SIZE bytes, dropping the
+// oldest ones as new ones arrive. Adding a frame is a short encode and copy, text is only
+// produced from a copy() when someone asks for it. Not thread safe.
+template <size_t SIZE>
+class CanLogRing {
+  static_assert(SIZE >= 2 * CanLogEncoder::MAX_RECORD_SIZE, "CanLogRing too small for its records");
+
+ public:
+  void push(const CAN_frame& frame, CAN_Interface interface, frameDirection direction, int64_t timestamp_us) {
+    uint8_t record[CanLogEncoder::MAX_RECORD_SIZE];
+    const size_t size = encoder.encode(frame, interface, direction, timestamp_us, record);
+
+    make_room(size);
+    memcpy(buffer + head, record, size);
+    head += size;
+    count++;
+  }
+
+  void clear() {
+    head = tail = end = 0;
+    wrapped = false;
+    count = 0;
+    tail_timestamp_us = 0;
+    encoder.resync();
+  }
+
+  // Copies the records, oldest first. Decode them with a CanLogDecoder started at start_us.
+  // Returns the number of frames.
+  uint32_t copy(std::vector<uint8_t>& records, int64_t& start_us) const {
+    records.clear();
+    if (wrapped) {
+      records.reserve(end - tail + head);
+      records.insert(records.end(), buffer + tail, buffer + end);
+    }
+    records.insert(records.end(), buffer + (wrapped ? 0 : tail), buffer + head);
+    start_us = tail_timestamp_us;
+    return count;
+  }
+
+  uint32_t frames() const { return count; }
+
+ private:
+  // Records are never split. Once the end is reached, writing continues at the start and
+  // [tail, end) followed by [0, head) holds the frames, otherwise [tail, head) does.
+  void make_room(size_t size) {
+    while (true) {
+      if (!wrapped) {
+        if (SIZE - head >= size) {
+          return;
+        }
+        end = head;
+        head = 0;
+        wrapped = true;
+      } else if (tail - head >= size) {
+        return;
+      } else {
+        drop_oldest();
+      }
+    }
+  }
+
+  void drop_oldest() {
+    // The time of the dropped frame is what the delta of the next one refers to
+    CanLogDecoder decoder(tail_timestamp_us);
+    CanLogRecord record;
+    const size_t used = decoder.next(buffer + tail, end - tail, record);
+    if (used == 0) {
+      tail = end;  // Not a record, which cannot happen unless memory got overwritten
+    } else {
+      tail += used;
+      tail_timestamp_us = record.timestamp_us;
+      count--;
+    }
+
+    if (tail == end) {
+      tail = 0;
+      end = 0;
+      wrapped = false;
+    }
+  }
+
+  uint8_t buffer[SIZE];
+  size_t head = 0;
+  size_t tail = 0;
+  size_t end = 0;
+  bool wrapped = false;
+  uint32_t count = 0;
+  int64_t tail_timestamp_us = 0;
+  CanLogEncoder encoder;
+};
+
+#endif
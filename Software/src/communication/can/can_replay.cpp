@@ -0,0 +1,325 @@
+#include "can_replay.h"
+#include <LittleFS.h>
+#include <esp_timer.h>
+#include <string.h>
+#include "../../datalayer/datalayer.h"
+#include "../../devboard/utils/logging.h"
+#include "can_log_format.h"
+#include "comm_can.h"
+
+// Time from starting a replay to its first frame, to have the next frames read by then
+#define CAN_REPLAY_LEAD_US 10000
+// Frames read ahead of the core task
+#define CAN_REPLAY_QUEUE_SIZE 32
+
+static bool filesystem_mounted = false;
+
+static File import_file;
+// Set when the flash is full, nothing more is stored then
+static bool import_failed = false;
+static bool import_binary = false;
+static bool import_first_chunk = false;
+static uint32_t import_frames = 0;
+static CanLogEncoder import_encoder;
+static CanLogTextImporter import_text;
+
+// A frame read from the log, for the core task to send when it is due
+struct ReplayFrame {
+  CAN_frame frame;
+  int64_t due_us;
+  // From the start of the pass to due_us
+  int64_t offset_us;
+};
+
+static QueueHandle_t replay_queue = nullptr;
+static volatile bool replay_running = false;
+static volatile bool replay_stop = false;
+static CAN_Interface replay_interface = CAN_NATIVE;
+static float replay_speed = 1.0f;
+static CanReplayReport report;
+
+static bool mount_filesystem() {
+  if (!filesystem_mounted) {
+    // Formats the partition on first use
+    filesystem_mounted = LittleFS.begin(true);
+    if (!filesystem_mounted) {
+      logging.println("CAN replay: mounting flash file system failed");
+    }
+  }
+  return filesystem_mounted;
+}
+
+bool can_replay_import_begin() {
+  if (replay_running || !mount_filesystem()) {
+    return false;
+  }
+  import_file = LittleFS.open(CAN_REPLAY_FILE, "w");
+  if (!import_file) {
+    return false;
+  }
+  if (import_file.write((const uint8_t*)CAN_LOG_MAGIC, CAN_LOG_MAGIC_SIZE) != CAN_LOG_MAGIC_SIZE) {
+    can_replay_import_abort();
+    return false;
+  }
+  import_failed = false;
+  import_first_chunk = true;
+  import_binary = false;
+  import_frames = 0;
+  import_encoder.resync();
+  import_text = CanLogTextImporter();
+  return true;
+}
+
+// Returns false if the record did not fit in flash
+static bool import_record(const CanLogRecord& record) {
+  if (import_failed) {
+    return false;
+  }
+  uint8_t buffer[CanLogEncoder::MAX_RECORD_SIZE];
+  const size_t size =
+      import_encoder.encode(record.frame, record.interface, record.direction, record.timestamp_us, buffer);
+  if (import_file.write(buffer, size) != size) {
+    import_failed = true;
+    return false;
+  }
+  import_frames++;
+  return true;
+}
+
+bool can_replay_import(const uint8_t* data, size_t size) {
+  if (!import_file) {
+    return false;
+  }
+
+  if (import_first_chunk) {
+    import_first_chunk = false;
+    if (size >= CAN_LOG_MAGIC_SIZE && memcmp(data, CAN_LOG_MAGIC, CAN_LOG_MAGIC_SIZE) == 0) {
+      // Already binary, store it as it is
+      import_binary = true;
+      data += CAN_LOG_MAGIC_SIZE;
+      size -= CAN_LOG_MAGIC_SIZE;
+    }
+  }
+
+  if (import_binary) {
+    return import_file.write(data, size) == size;
+  }
+  // The importer goes on to the end of the chunk, import_record stores nothing more after a failed write
+  import_text.feed((const char*)data, size, import_record);
+  return !import_failed;
+}
+
+// A partial or damaged log would replay as if it were complete
+static void discard_import(const char* reason) {
+  LittleFS.remove(CAN_REPLAY_FILE);
+  logging.printf("CAN replay: %s\n", reason);
+}
+
+bool can_replay_import_end(uint32_t& frames) {
+  frames = 0;
+  if (!import_file) {
+    return false;
+  }
+  if (!import_binary) {
+    import_text.finish(import_record);
+    if (import_failed) {
+      can_replay_import_abort();
+      return false;
+    }
+    logging.printf("CAN replay: stored %u frames, skipped %u lines\n", (unsigned)import_frames,
+                   (unsigned)import_text.skipped_lines());
+    import_file.close();
+    frames = import_frames;
+    return true;
+  }
+  import_file.close();
+
+  // Count the frames of a binary upload, which also checks that it decodes
+  File file = LittleFS.open(CAN_REPLAY_FILE, "r");
+  uint8_t buffer[512];
+  size_t fill = 0;
+  CanLogDecoder decoder;
+  CanLogRecord record;
+  import_frames = 0;
+  file.seek(CAN_LOG_MAGIC_SIZE);
+  while (true) {
+    const size_t read = file.read(buffer + fill, sizeof(buffer) - fill);
+    fill += read;
+    size_t offset = 0;
+    size_t used;
+    while ((used = decoder.next(buffer + offset, fill - offset, record)) > 0) {
+      offset += used;
+      import_frames++;
+    }
+    memmove(buffer, buffer + offset, fill - offset);
+    fill -= offset;
+    if (read == 0 || decoder.failed()) {
+      break;
+    }
+  }
+  file.close();
+  // A record cut short at the end is left in the buffer
+  if (decoder.failed() || fill != 0) {
+    discard_import("binary log is damaged or truncated");
+    return false;
+  }
+  logging.printf("CAN replay: stored %u frames\n", (unsigned)import_frames);
+  frames = import_frames;
+  return true;
+}
+
+bool can_replay_import_abort() {
+  if (!import_file) {
+    return false;
+  }
+  import_file.close();
+  discard_import("upload failed, flash file system full?");
+  return true;
+}
+
+uint32_t can_replay_skipped_lines() {
+  return import_binary ? 0 : import_text.skipped_lines();
+}
+
+// Waits for room in the queue. Returns false if stopped meanwhile.
+static bool queue_frame(const ReplayFrame& item) {
+  while (xQueueSend(replay_queue, &item, pdMS_TO_TICKS(100)) != pdTRUE) {
+    if (replay_stop) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void transmit_replayed_can_frames() {
+  if (!replay_running) {
+    return;
+  }
+  ReplayFrame item;
+  while (xQueuePeek(replay_queue, &item, 0) == pdTRUE && item.due_us <= esp_timer_get_time()) {
+    if (xQueueReceive(replay_queue, &item, 0) != pdTRUE) {
+      return;
+    }
+    const int64_t now_us = esp_timer_get_time();
+    transmit_can_frame_to_interface(&item.frame, replay_interface, CAN_TX_DIAGNOSTIC);
+    report.add(item.due_us, now_us);
+    report.intended_duration_us = item.offset_us;
+    report.achieved_duration_us = now_us - (item.due_us - item.offset_us);
+  }
+}
+
+// Queues the frames of one pass through the log. Returns false if stopped or the log is damaged.
+static bool replay_pass(File& file) {
+  uint8_t buffer[512];
+  size_t fill = 0;
+  size_t offset = 0;
+  CanLogDecoder decoder;
+  CanLogRecord record;
+  bool first = true;
+  int64_t log_start_us = 0;
+  int64_t replay_start_us = 0;
+
+  file.seek(CAN_LOG_MAGIC_SIZE);
+  while (!replay_stop) {
+    const size_t used = decoder.next(buffer + offset, fill - offset, record);
+    if (used == 0) {
+      if (decoder.failed()) {
+        logging.println("CAN replay: log is damaged, stopping");
+        return false;
+      }
+      // Read on, keeping the incomplete record
+      memmove(buffer, buffer + offset, fill - offset);
+      fill -= offset;
+      offset = 0;
+      const size_t read = file.read(buffer + fill, sizeof(buffer) - fill);
+      if (read == 0) {
+        break;
+      }
+      fill += read;
+      continue;
+    }
+    offset += used;
+
+    if (first) {
+      // Start once the previous pass is sent, to keep the gap between the two
+      while (uxQueueMessagesWaiting(replay_queue) > 0) {
+        if (replay_stop) {
+          return false;
+        }
+        vTaskDelay(pdMS_TO_TICKS(1));
+      }
+      first = false;
+      log_start_us = record.timestamp_us;
+      replay_start_us = esp_timer_get_time() + CAN_REPLAY_LEAD_US;
+    }
+    ReplayFrame item;
+    item.frame = record.frame;
+    item.offset_us = (int64_t)((record.timestamp_us - log_start_us) / replay_speed);
+    item.due_us = replay_start_us + item.offset_us;
+
+    // Sent as a frame of the chosen interface, whichever one it was logged on
+    item.frame.FD = replay_interface == CANFD_NATIVE || replay_interface == CANFD_ADDON_MCP2518;
+    if (!queue_frame(item)) {
+      return false;
+    }
+  }
+  return !replay_stop;
+}
+
+static void can_replay_task(void* param) {
+  File file = LittleFS.open(CAN_REPLAY_FILE, "r");
+  if (file) {
+    while (replay_pass(file) && datalayer.system.info.loop_playback) {
+    }
+    file.close();
+  }
+
+  // Give the core task time to send what is still queued, unless stopped
+  while (!replay_stop && uxQueueMessagesWaiting(replay_queue) > 0) {
+    vTaskDelay(pdMS_TO_TICKS(10));
+  }
+  xQueueReset(replay_queue);
+
+  logging.printf("CAN replay: %u frames, timing error mean %lld us, max %lld us\n", (unsigned)report.frames,
+                 (long long)report.mean_error_us(), (long long)report.max_error_us);
+  replay_running = false;
+  vTaskDelete(NULL);
+}
+
+bool start_can_replay(CAN_Interface interface, float speed) {
+  if (replay_running || !mount_filesystem() || !LittleFS.exists(CAN_REPLAY_FILE)) {
+    return false;
+  }
+  if (replay_queue == nullptr) {
+    replay_queue = xQueueCreate(CAN_REPLAY_QUEUE_SIZE, sizeof(ReplayFrame));
+    if (replay_queue == nullptr) {
+      return false;
+    }
+  }
+
+  replay_interface = interface;
+  replay_speed = speed > 0 ? speed : 1.0f;
+  report = CanReplayReport();
+  report.speed = replay_speed;
+  replay_stop = false;
+  replay_running = true;
+
+  if (xTaskCreatePinnedToCore(can_replay_task, "CAN_Replay", 4096, NULL, 1, NULL, 1) != pdPASS) {
+    replay_running = false;
+    return false;
+  }
+  return true;
+}
+
+void stop_can_replay() {
+  datalayer.system.info.loop_playback = false;
+  replay_stop = true;
+}
+
+bool can_replay_running() {
+  return replay_running;
+}
+
+const CanReplayReport& get_can_replay_report() {
+  return report;
+}
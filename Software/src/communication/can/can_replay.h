@@ -0,0 +1,57 @@
+#ifndef _CAN_REPLAY_H_
+#define _CAN_REPLAY_H_
+
+#include <stdint.h>
+#include "../../devboard/utils/types.h"
+
+// Uploaded CAN logs are parsed once into the binary format of can_log_format.h and kept in flash.
+// Replay then streams the frames from there in a task of its own, which queues them for the core
+// task. The core task sends each at its original offset from the first one, divided by the speed.
+// All sending happens there, so pacing is to within one core loop iteration (1 ms), not to the
+// microsecond. The report shows the error actually achieved.
+
+#define CAN_REPLAY_FILE "/canreplay.bin"
+
+// Timing of the last replay, comparing when frames were sent to when they should have been
+struct CanReplayReport {
+  float speed = 1.0f;
+  uint32_t frames = 0;
+  int64_t intended_duration_us = 0;
+  int64_t achieved_duration_us = 0;
+  int64_t total_error_us = 0;
+  int64_t max_error_us = 0;
+
+  void add(int64_t intended_us, int64_t sent_us) {
+    const int64_t error_us = sent_us > intended_us ? sent_us - intended_us : intended_us - sent_us;
+    total_error_us += error_us;
+    if (error_us > max_error_us) {
+      max_error_us = error_us;
+    }
+    frames++;
+  }
+
+  int64_t mean_error_us() const { return frames > 0 ? total_error_us / frames : 0; }
+};
+
+// Upload, either candump-style text or a binary log, e.g. canlog.bin from the SD card, in pieces
+bool can_replay_import_begin();
+bool can_replay_import(const uint8_t* data, size_t size);
+// Gives the number of frames stored. Returns false if they did not all fit in flash, or a binary log does not
+// decode to its end, nothing is kept then.
+bool can_replay_import_end(uint32_t& frames);
+// Ends a failed upload and removes what was stored of it. Returns false if no upload was open.
+bool can_replay_import_abort();
+// Lines of the last text upload that held no frame
+uint32_t can_replay_skipped_lines();
+
+// Repeats while datalayer.system.info.loop_playback is set. Returns false if a replay is running
+// already or no log has been uploaded.
+bool start_can_replay(CAN_Interface interface, float speed);
+void stop_can_replay();
+bool can_replay_running();
+// Sends the replayed frames that are due. Core task only, call every loop.
+void transmit_replayed_can_frames();
+
+const CanReplayReport& get_can_replay_report();
+
+#endif
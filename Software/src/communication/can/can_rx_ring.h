@@ -0,0 +1,59 @@
+#ifndef _CAN_RX_RING_H_
+#define _CAN_RX_RING_H_
+
+#include <stdint.h>
+#include <atomic>
+#include "../../devboard/utils/types.h"
+
+// Fixed-size lock-free ring carrying received frames from one producer (a CAN RX
+// task) to one consumer (the core loop). Neither side ever blocks or allocates.
+// SIZE must be a power of two.
+template <uint16_t SIZE>
+class CanRxRing {
+  static_assert(SIZE > 0 && (SIZE & (SIZE - 1)) == 0, "CanRxRing size must be a power of two");
+
+ public:
+  // Producer only. Returns false, and counts the frame as dropped, if the ring is full.
+  bool push(const CAN_frame& frame, int64_t timestamp_us) {
+    const uint32_t head = write_index.load(std::memory_order_relaxed);
+    if (head - read_index.load(std::memory_order_acquire) >= SIZE) {
+      dropped_frames.store(dropped_frames.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      return false;
+    }
+
+    CAN_rx_frame& entry = entries[head & (SIZE - 1)];
+    entry.frame = frame;
+    entry.timestamp_us = timestamp_us;
+    write_index.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer only. Returns false if the ring is empty.
+  bool pop(CAN_rx_frame& entry) {
+    const uint32_t tail = read_index.load(std::memory_order_relaxed);
+    if (tail == write_index.load(std::memory_order_acquire)) {
+      return false;
+    }
+
+    entry = entries[tail & (SIZE - 1)];
+    read_index.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Frames currently waiting. Exact from either side, approximate from elsewhere.
+  uint16_t count() const {
+    return write_index.load(std::memory_order_acquire) - read_index.load(std::memory_order_acquire);
+  }
+
+  // Frames lost because the consumer fell behind
+  uint32_t dropped() const { return dropped_frames.load(std::memory_order_relaxed); }
+
+ private:
+  CAN_rx_frame entries[SIZE];
+  // Free-running counters, wrapping is harmless as only their difference is used
+  std::atomic<uint32_t> write_index{0};
+  std::atomic<uint32_t> read_index{0};
+  std::atomic<uint32_t> dropped_frames{0};
+};
+
+#endif
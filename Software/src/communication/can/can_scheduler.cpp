@@ -0,0 +1,73 @@
+#include "can_scheduler.h"
+
+uint16_t CanScheduler::add(CAN_frame* frame, CAN_Interface interface, uint16_t period_ms, CAN_TX_Priority priority,
+                           BeforeSend before_send) {
+  if (period_ms == 0) {
+    period_ms = 1;
+  }
+
+  const uint16_t phase_ms = best_phase(interface, period_ms);
+  entries.push_back({frame, interface, priority, period_ms, phase_ms, epoch_ms + phase_ms, before_send});
+  return phase_ms;
+}
+
+uint16_t CanScheduler::load_at(CAN_Interface interface, uint16_t slot) const {
+  uint16_t load = 0;
+  for (const auto& entry : entries) {
+    if (entry.interface == interface && slot % entry.period_ms == entry.phase_ms) {
+      load++;
+    }
+  }
+  return load;
+}
+
+// Picks the offset whose busiest slot is the least busy, breaking ties on the total
+// number of frames already due in its slots. Periods longer than the wheel only
+// occupy the slot of their offset.
+uint16_t CanScheduler::best_phase(CAN_Interface interface, uint16_t period_ms) const {
+  const uint16_t candidates = period_ms < WHEEL_MS ? period_ms : WHEEL_MS;
+  uint16_t best = 0;
+  uint16_t best_peak = UINT16_MAX;
+  uint32_t best_total = UINT32_MAX;
+
+  for (uint16_t phase = 0; phase < candidates; phase++) {
+    uint16_t peak = 0;
+    uint32_t total = 0;
+    for (uint16_t slot = phase; slot < WHEEL_MS; slot += period_ms) {
+      const uint16_t load = load_at(interface, slot);
+      peak = load > peak ? load : peak;
+      total += load;
+    }
+    if (peak < best_peak || (peak == best_peak && total < best_total)) {
+      best = phase;
+      best_peak = peak;
+      best_total = total;
+    }
+  }
+  return best;
+}
+
+void CanScheduler::transmit(unsigned long currentMillis, SendFunction send) {
+  if (!started) {
+    started = true;
+    epoch_ms = currentMillis;
+    for (auto& entry : entries) {
+      entry.next_due_ms = epoch_ms + entry.phase_ms;
+    }
+  }
+
+  for (auto& entry : entries) {
+    if ((long)(currentMillis - entry.next_due_ms) < 0) {
+      continue;
+    }
+
+    // Skip periods missed while the loop was stalled rather than sending them in a burst
+    do {
+      entry.next_due_ms += entry.period_ms;
+    } while ((long)(currentMillis - entry.next_due_ms) >= 0);
+
+    if (!entry.before_send || entry.before_send()) {
+      send(entry.frame, entry.interface, entry.priority);
+    }
+  }
+}
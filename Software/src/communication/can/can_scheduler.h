@@ -0,0 +1,54 @@
+#ifndef _CAN_SCHEDULER_H_
+#define _CAN_SCHEDULER_H_
+
+#include <stdint.h>
+#include <functional>
+#include <vector>
+#include "../../devboard/utils/types.h"
+
+// Sends registered cyclic frames at a fixed period. Each frame gets a phase offset
+// within its period, chosen when it is added so that the number of frames due on
+// the same millisecond of the same interface stays as low as possible. Frames of
+// the battery, inverter and charger are thereby spread out instead of all being
+// handed to the CAN controller on the same core loop iteration.
+class CanScheduler {
+ public:
+  // Phases are planned over this many milliseconds, the common multiple of the usual periods
+  static constexpr uint16_t WHEEL_MS = 1000;
+
+  // Called before each send. Returns false to skip this period, e.g. for frames only sent in some states.
+  typedef std::function<bool(void)> BeforeSend;
+  typedef bool (*SendFunction)(const CAN_frame* frame, CAN_Interface interface, CAN_TX_Priority priority);
+
+  // Adds a frame to send every period_ms. The frame is sent from its own storage, so the owner
+  // can keep updating its contents. Returns the phase offset the frame was given.
+  uint16_t add(CAN_frame* frame, CAN_Interface interface, uint16_t period_ms, CAN_TX_Priority priority,
+               BeforeSend before_send = nullptr);
+
+  // Sends the frames that are due. Called every core loop iteration.
+  void transmit(unsigned long currentMillis, SendFunction send);
+
+  // Number of frames due on the given millisecond of the wheel
+  uint16_t load_at(CAN_Interface interface, uint16_t slot) const;
+
+  size_t size() const { return entries.size(); }
+
+ private:
+  struct Entry {
+    CAN_frame* frame;
+    CAN_Interface interface;
+    CAN_TX_Priority priority;
+    uint16_t period_ms;
+    uint16_t phase_ms;
+    unsigned long next_due_ms;
+    BeforeSend before_send;
+  };
+
+  uint16_t best_phase(CAN_Interface interface, uint16_t period_ms) const;
+
+  std::vector<Entry> entries;
+  bool started = false;
+  unsigned long epoch_ms = 0;
+};
+
+#endif
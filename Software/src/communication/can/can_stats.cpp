@@ -0,0 +1,122 @@
+#include "can_stats.h"
+
+static uint16_t table_index(uint32_t id, CAN_Interface interface, frameDirection direction) {
+  // Fibonacci hashing spreads the clustered IDs of one ECU over the table
+  const uint32_t key = id ^ ((uint32_t)interface << 29) ^ ((uint32_t)direction << 28);
+  return (key * 2654435761u) >> 16;
+}
+
+void CanTrafficStats::set_bit_rate(CAN_Interface interface, uint32_t bit_rate) {
+  if (interface < NO_CAN_INTERFACE) {
+    bit_rates[interface] = bit_rate;
+  }
+}
+
+CanTrafficStats::Entry* CanTrafficStats::find_or_add(uint32_t id, CAN_Interface interface, frameDirection direction) {
+  uint16_t index = table_index(id, interface, direction) & (TABLE_SIZE - 1);
+
+  // Linear probing. Entries are never removed individually, so the first free slot ends the search.
+  for (uint16_t probes = 0; probes < TABLE_SIZE; probes++) {
+    Entry& entry = table[index];
+    if (!entry.used) {
+      entry.used = true;
+      entry.id = id;
+      entry.interface = interface;
+      entry.direction = direction;
+      used_entries++;
+      return &entry;
+    }
+    if (entry.id == id && entry.interface == interface && entry.direction == direction) {
+      return &entry;
+    }
+    index = (index + 1) & (TABLE_SIZE - 1);
+  }
+  return nullptr;
+}
+
+void CanTrafficStats::record(const CAN_frame& frame, CAN_Interface interface, frameDirection direction,
+                             int64_t timestamp_us) {
+  if (interface >= NO_CAN_INTERFACE) {
+    return;
+  }
+  window_bits[interface] += frame_bits(frame);
+
+  Entry* entry = find_or_add(frame.ID, interface, direction);
+  if (entry == nullptr) {
+    untracked++;
+    return;
+  }
+
+  if (entry->count == 0) {
+    entry->first_us = timestamp_us;
+  } else {
+    const uint32_t gap_us = (uint32_t)(timestamp_us - entry->last_us);
+    if (entry->count == 1 || gap_us < entry->min_gap_us) {
+      entry->min_gap_us = gap_us;
+    }
+    if (gap_us > entry->max_gap_us) {
+      entry->max_gap_us = gap_us;
+    }
+  }
+  entry->last_us = timestamp_us;
+  entry->count++;
+  entry->window_count++;
+}
+
+void CanTrafficStats::update(int64_t now_us) {
+  if (window_start_us == 0) {
+    window_start_us = now_us;
+    return;
+  }
+  const int64_t elapsed_us = now_us - window_start_us;
+  if (elapsed_us < WINDOW_US) {
+    return;
+  }
+
+  for (uint8_t i = 0; i < NO_CAN_INTERFACE; i++) {
+    if (bit_rates[i] != 0) {
+      const int64_t load = (int64_t)window_bits[i] * 100 * 1000000 / ((int64_t)bit_rates[i] * elapsed_us);
+      bus_load[i] = load > 100 ? 100 : (uint8_t)load;
+    }
+    window_bits[i] = 0;
+  }
+
+  for (auto& entry : table) {
+    if (entry.used) {
+      entry.rate_hz = (uint16_t)((int64_t)entry.window_count * 1000000 / elapsed_us);
+      entry.window_count = 0;
+    }
+  }
+  window_start_us = now_us;
+}
+
+void CanTrafficStats::clear() {
+  for (auto& entry : table) {
+    entry = {};
+  }
+  used_entries = 0;
+  untracked = 0;
+  for (uint8_t i = 0; i < NO_CAN_INTERFACE; i++) {
+    window_bits[i] = 0;
+    bus_load[i] = 0;
+  }
+  window_start_us = 0;
+}
+
+uint16_t CanTrafficStats::frame_bits(const CAN_frame& frame) {
+  const uint16_t data_bits = 8 * frame.DLC;
+
+  if (!frame.FD) {
+    // Stuffing applies to the 34 (standard) or 54 (extended) bits from SOF to the CRC plus the data,
+    // at most one stuff bit per four bits. The unstuffed rest adds 47 or 67 bits including interframe space.
+    const uint16_t stuffed_bits = (frame.ext_ID ? 54 : 34) + data_bits;
+    return (frame.ext_ID ? 67 : 47) + data_bits + (stuffed_bits - 1) / 4;
+  }
+
+  // Arbitration phase, ACK, EOF and interframe space at the nominal rate
+  const uint16_t nominal_bits = (frame.ext_ID ? 36 : 17) + 13;
+  // ESI, DLC, data, CRC with its fixed stuff bits, and CRC delimiter at the data rate
+  const uint16_t fd_bits = 5 + data_bits + (frame.DLC > 16 ? 26 : 22) + 1;
+  const uint16_t stuff_bits = (nominal_bits + fd_bits) / 5;
+  return nominal_bits + (fd_bits + stuff_bits) / FD_DATA_RATE_FACTOR;
+}
@@ -0,0 +1,74 @@
+#ifndef _CAN_STATS_H_
+#define _CAN_STATS_H_
+
+#include <stdint.h>
+#include "../../devboard/utils/types.h"
+
+// Traffic statistics per interface, direction and CAN ID, plus an estimated load per bus.
+// Entries live in a fixed-size open-addressing table, so recording a frame never allocates
+// and the statistics can stay enabled in production. Once the table is full, frames of new
+// IDs only count towards the bus load and untracked_frames().
+class CanTrafficStats {
+ public:
+  // Number of (interface, direction, ID) entries that can be tracked. Must be a power of two.
+  static constexpr uint16_t TABLE_SIZE = 128;
+  // Rates and bus load are computed over windows of this length
+  static constexpr int64_t WINDOW_US = 1000000;
+
+  struct Entry {
+    uint32_t id;
+    uint8_t interface;
+    uint8_t direction;
+    bool used;
+    // Frames seen in the last complete window, i.e. per second
+    uint16_t rate_hz;
+    uint16_t window_count;
+    uint32_t count;
+    // Time between consecutive frames
+    uint32_t min_gap_us;
+    uint32_t max_gap_us;
+    int64_t first_us;
+    int64_t last_us;
+
+    uint32_t mean_gap_us() const { return count > 1 ? (uint32_t)((last_us - first_us) / (count - 1)) : 0; }
+  };
+
+  // Bit rate of the interface in bit/s, needed for its bus load. Zero for interfaces not in use.
+  void set_bit_rate(CAN_Interface interface, uint32_t bit_rate);
+  uint32_t bit_rate(CAN_Interface interface) const { return bit_rates[interface]; }
+
+  void record(const CAN_frame& frame, CAN_Interface interface, frameDirection direction, int64_t timestamp_us);
+
+  // Closes the current window once it is complete, updating rates and bus load. Call regularly.
+  void update(int64_t now_us);
+
+  // Bus load over the last complete window, in percent of the bit rate
+  uint8_t bus_load_percent(CAN_Interface interface) const { return bus_load[interface]; }
+
+  const Entry& entry(uint16_t index) const { return table[index]; }
+  uint16_t size() const { return used_entries; }
+  uint32_t untracked_frames() const { return untracked; }
+
+  void clear();
+
+  // Bits the frame takes on the bus at the nominal bit rate, assuming worst-case bit stuffing.
+  // The data phase of CAN FD frames is scaled down by FD_DATA_RATE_FACTOR.
+  static uint16_t frame_bits(const CAN_frame& frame);
+
+  // Data phase bit rate of CAN FD frames relative to the nominal bit rate, as set up in comm_can
+  static constexpr uint8_t FD_DATA_RATE_FACTOR = 4;
+
+ private:
+  Entry* find_or_add(uint32_t id, CAN_Interface interface, frameDirection direction);
+
+  Entry table[TABLE_SIZE] = {};
+  uint16_t used_entries = 0;
+  uint32_t untracked = 0;
+
+  uint32_t bit_rates[NO_CAN_INTERFACE] = {0};
+  uint32_t window_bits[NO_CAN_INTERFACE] = {0};
+  uint8_t bus_load[NO_CAN_INTERFACE] = {0};
+  int64_t window_start_us = 0;
+};
+
+#endif
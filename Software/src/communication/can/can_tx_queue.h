@@ -0,0 +1,68 @@
+#ifndef _CAN_TX_QUEUE_H_
+#define _CAN_TX_QUEUE_H_
+
+#include <stdint.h>
+#include "../../devboard/utils/types.h"
+
+// Frames waiting for room in a CAN controller's transmit buffers, one fixed-size
+// FIFO per priority class. The front is always the oldest frame of the most
+// important class that has any. Used from the core task only.
+template <uint8_t SIZE>
+class CanTxQueue {
+ public:
+  struct Entry {
+    CAN_frame frame;
+    int64_t queued_us;  // esp_timer_get_time() when the frame was queued
+    CAN_TX_Priority priority;
+  };
+
+  // Returns false, leaving the queue unchanged, if the frame's class is full
+  bool push(const CAN_frame& frame, CAN_TX_Priority priority, int64_t queued_us) {
+    Fifo& fifo = fifos[priority];
+    if (fifo.count >= SIZE) {
+      return false;
+    }
+    Entry& entry = fifo.entries[(fifo.head + fifo.count) % SIZE];
+    entry.frame = frame;
+    entry.queued_us = queued_us;
+    entry.priority = priority;
+    fifo.count++;
+    return true;
+  }
+
+  // The next frame to send, or nullptr if nothing is queued
+  const Entry* front() const {
+    for (const Fifo& fifo : fifos) {
+      if (fifo.count > 0) {
+        return &fifo.entries[fifo.head];
+      }
+    }
+    return nullptr;
+  }
+
+  // Removes the frame returned by front()
+  void pop() {
+    for (Fifo& fifo : fifos) {
+      if (fifo.count > 0) {
+        fifo.head = (fifo.head + 1) % SIZE;
+        fifo.count--;
+        return;
+      }
+    }
+  }
+
+  bool empty() const { return front() == nullptr; }
+
+  uint8_t count(CAN_TX_Priority priority) const { return fifos[priority].count; }
+
+ private:
+  struct Fifo {
+    Entry entries[SIZE];
+    uint8_t head = 0;
+    uint8_t count = 0;
+  };
+
+  Fifo fifos[CAN_TX_PRIORITY_COUNT];
+};
+
+#endif
@@ -3,15 +3,26 @@
 #include "../../lib/pierremolinaro-acan-esp32/ACAN_ESP32.h"
 #include "../../lib/pierremolinaro-acan2515/ACAN2515.h"
 #include "CanReceiver.h"
+#include "can_dispatch.h"
+#include "can_filters.h"
+#include "can_log_ring.h"
+#include "can_replay.h"
+#include "can_rx_ring.h"
+#include "can_scheduler.h"
+#include "can_stats.h"
+#include "can_tx_queue.h"
 #include "comm_can.h"
 #include "src/datalayer/datalayer.h"
+#include "src/datalayer/datalayer_snapshot.h"
 #include "src/devboard/safety/safety.h"
 #include "src/devboard/sdcard/sdcard.h"
 #include "src/devboard/utils/logging.h"
 
 #include <esp_private/periph_ctrl.h>
+#include <esp_timer.h>
 
 #include <algorithm>
+#include <atomic>
 #include <map>
 
 // The spare ESP32 SPI buses are called HSPI and VSPI, whereas on a ESP32S3
@@ -38,17 +49,52 @@ struct CanReceiverRegistration {
 
 static std::multimap<CAN_Interface, CanReceiverRegistration> can_receivers;
 
+// Per-interface ID lookup, built from can_receivers once all receivers exist
+static CanDispatchTable can_dispatch[NO_CAN_INTERFACE];
+
+// Cyclic frames registered by the protocols
+static CanScheduler can_scheduler;
+
+// Per-ID traffic and bus load, fed by every received and transmitted frame. Only the core task writes
+// them, other tasks read coherent copies through read_can_traffic_stats().
+static Seqlock<CanTrafficStats> can_stats;
+
+// Frames for the webserver CAN log, allocated when the log is first opened. The core loop never
+// waits for the mutex, frames arriving while the webserver copies the ring are skipped.
+static CanLogRing<CAN_WEB_LOG_SIZE>* can_web_log = nullptr;
+static SemaphoreHandle_t can_web_log_mutex = nullptr;
+
 volatile bool send_ok_native = 0;
 volatile bool send_ok_2515 = 0;
 volatile bool send_ok_2518 = 0;
 
-void map_can_frame_to_variable(CAN_frame* rx_frame, CAN_Interface interface);
+void map_can_frame_to_variable(const CAN_frame& rx_frame, CAN_Interface interface, int64_t timestamp_us);
+
+// Both CAN-FD interfaces are served by the MCP2518
+static CAN_Interface controller_interface(CAN_Interface interface) {
+  return interface == CANFD_NATIVE ? CANFD_ADDON_MCP2518 : interface;
+}
+static void start_can_rx_tasks();
+static void start_can_tx_queues();
 
 void register_can_receiver(CanReceiver* receiver, CAN_Interface interface, CAN_Speed speed) {
   can_receivers.insert({interface, {receiver, speed}});
   DEBUG_PRINTF("CAN receiver registered, total: %d\n", can_receivers.size());
 }
 
+void schedule_can_frame(CAN_frame* frame, CAN_Interface interface, uint16_t period_ms, CAN_TX_Priority priority,
+                        std::function<bool(void)> before_send) {
+  can_scheduler.add(frame, interface, period_ms, priority, before_send);
+}
+
+void transmit_scheduled_can_frames(unsigned long currentMillis) {
+  can_scheduler.transmit(currentMillis, transmit_can_frame_to_interface);
+}
+
+void read_can_traffic_stats(CanTrafficStats& out) {
+  can_stats.read(out);
+}
+
 uint32_t init_native_can(CAN_Speed speed, gpio_num_t tx_pin, gpio_num_t rx_pin);
 
 ACAN_ESP32_Settings* settingsespcan = nullptr;
@@ -68,12 +114,144 @@ uint8_t user_selected_canfd_addon_crystal_frequency_mhz = 0;
 ACAN2517FD* canfd;
 ACAN2517FDSettings* settings2517;
 bool use_canfd_as_can = false;
+bool use_can_rx_tasks = false;
 bool native_can_initialized = false;
 //CAN logging filter settings
 uint16_t user_selected_CAN_ID_cutoff_filter = 0;  //Messages below this ID will not be logged in webserver
+uint8_t user_selected_can_rx_budget = CAN_RX_BUDGET;
+
+// Collect the IDs each registered receiver handles into the per-interface dispatch tables.
+// Done at init rather than at registration, as receivers register from their base class
+// constructors before the derived class can report its IDs.
+static void build_can_dispatch_tables() {
+  for (auto& table : can_dispatch) {
+    table.clear();
+  }
+
+  for (auto& it : can_receivers) {
+    if (it.first >= NO_CAN_INTERFACE) {
+      continue;
+    }
+    if (!can_dispatch[it.first].add(it.second.receiver, it.second.receiver->can_ids())) {
+      logging.printf("Too many CAN receivers on %s\n", getCANInterfaceName(it.first));
+    }
+    const CAN_Interface interface = controller_interface(it.first);
+    const uint32_t bit_rate = (int)it.second.speed * 1000UL;
+    can_stats.write([interface, bit_rate](CanTrafficStats& stats) { stats.set_bit_rate(interface, bit_rate); });
+  }
+}
+
+// Hardware acceptance filters. The IDs declared by the receivers of each controller are merged
+// into the masks and filters it offers, so frames nobody handles are dropped by the controller
+// instead of costing an interrupt, an SPI transfer and a copy each. A controller is left open if
+// any of its receivers wants all frames. While frames are logged or replayed all controllers are
+// opened, so the logs show all traffic on the bus.
+static std::vector<uint32_t> native_filter_ids;
+static std::vector<uint32_t> mcp2515_filter_ids;
+static std::vector<uint32_t> mcp2518_filter_ids;
+static bool can_filters_enabled = false;
+// Set by stop_can() until restart_can(), the drivers must not be reconfigured meanwhile
+static bool can_stopped = false;
+static ACAN_ESP32_Filter native_can_filter = ACAN_ESP32_Filter::acceptAll();
+
+static bool can_wants_all_frames() {
+  return datalayer.system.info.CAN_usb_logging_active || datalayer.system.info.CAN_SD_logging_active ||
+         datalayer.system.info.can_logging_active || can_replay_running();
+}
+
+// Collects the IDs wanted on the interfaces served by one controller. Empty if it has to take all frames.
+static std::vector<uint32_t> wanted_can_ids(std::initializer_list<CAN_Interface> interfaces) {
+  std::vector<uint32_t> ids;
+  for (auto interface : interfaces) {
+    if (can_dispatch[interface].accepts_all()) {
+      return {};
+    }
+    can_dispatch[interface].collect_ids(ids);
+  }
+  return ids;
+}
+
+// The TWAI controller has room for two standard filters, or one extended filter
+static ACAN_ESP32_Filter native_acceptance_filter() {
+  std::vector<CanAcceptanceFilter> filters;
+  if (!can_filters_enabled || native_filter_ids.empty() || !merge_can_filters(native_filter_ids, 2, filters) ||
+      filters[0].extended != filters.back().extended) {
+    return ACAN_ESP32_Filter::acceptAll();
+  }
+
+  if (filters[0].extended) {
+    merge_can_filters(native_filter_ids, 1, filters);
+    return ACAN_ESP32_Filter::singleExtendedFilter(ACAN_ESP32_Filter::dataAndRemote, filters[0].id,
+                                                   ~filters[0].mask & 0x1FFFFFFF);
+  }
+  if (filters.size() == 1) {
+    return ACAN_ESP32_Filter::singleStandardFilter(ACAN_ESP32_Filter::dataAndRemote, filters[0].id,
+                                                   ~filters[0].mask & CAN_MAX_STANDARD_ID);
+  }
+  return ACAN_ESP32_Filter::dualStandardFilter(ACAN_ESP32_Filter::dataAndRemote, filters[0].id,
+                                               ~filters[0].mask & CAN_MAX_STANDARD_ID, ACAN_ESP32_Filter::dataAndRemote,
+                                               filters[1].id, ~filters[1].mask & CAN_MAX_STANDARD_ID);
+}
+
+static ACAN2515Mask mcp2515_mask(const CanAcceptanceFilter& filter) {
+  return filter.extended ? extended2515Mask(filter.mask) : standard2515Mask(filter.mask, 0, 0);
+}
+
+static ACAN2515AcceptanceFilter mcp2515_filter(const CanAcceptanceFilter& filter) {
+  return {filter.extended ? extended2515Filter(filter.id) : standard2515Filter(filter.id, 0, 0), nullptr};
+}
+
+// The MCP2515 has two masks, RXM0 shared by filters 0-1 and RXM1 by filters 2-5
+static void set_mcp2515_acceptance_filters() {
+  std::vector<CanAcceptanceFilter> first;
+  std::vector<CanAcceptanceFilter> second;
+  if (mcp2515_filter_ids.empty()) {
+    return;  // Left open by begin()
+  }
+  if (!can_filters_enabled || !merge_can_filters_shared_masks(mcp2515_filter_ids, 2, 4, first, second)) {
+    can2515->setFiltersOnTheFly();
+    return;
+  }
+
+  // Unused filter slots repeat the last filter of their group
+  const ACAN2515AcceptanceFilter filters[6] = {
+      mcp2515_filter(first[0]),  mcp2515_filter(first.back()),
+      mcp2515_filter(second[0]), mcp2515_filter(second[std::min<size_t>(1, second.size() - 1)]),
+      mcp2515_filter(second[std::min<size_t>(2, second.size() - 1)]), mcp2515_filter(second.back())};
+  const uint16_t errorCode = can2515->setFiltersOnTheFly(mcp2515_mask(first[0]), mcp2515_mask(second[0]), filters, 6);
+  if (errorCode != 0) {
+    logging.printf("MCP2515 acceptance filters rejected: 0x%X\n", errorCode);
+    can2515->setFiltersOnTheFly();
+  }
+}
+
+// The MCP2518FD takes up to 32 filters, each with its own mask
+static uint32_t begin_mcp2518() {
+  std::vector<CanAcceptanceFilter> filters;
+  if (!can_filters_enabled || mcp2518_filter_ids.empty() || !merge_can_filters(mcp2518_filter_ids, 32, filters)) {
+    return canfd->begin(*settings2517, [] { canfd->isr(); });
+  }
+
+  ACAN2517FDFilters canfd_filters;
+  for (const auto& filter : filters) {
+    canfd_filters.appendFilter(filter.extended ? kExtended : kStandard, filter.mask, filter.id, nullptr);
+  }
+  return canfd->begin(*settings2517, [] { canfd->isr(); }, canfd_filters);
+}
+
+static void prepare_can_acceptance_filters() {
+  native_filter_ids = wanted_can_ids({CAN_NATIVE});
+  mcp2515_filter_ids = wanted_can_ids({CAN_ADDON_MCP2515});
+  mcp2518_filter_ids = wanted_can_ids({CANFD_NATIVE, CANFD_ADDON_MCP2518});
+  can_filters_enabled = !can_wants_all_frames();
+  native_can_filter = native_acceptance_filter();
+}
 
 bool init_CAN() {
 
+  build_can_dispatch_tables();
+  prepare_can_acceptance_filters();
+
   if (user_selected_can_addon_crystal_frequency_mhz > 0) {
     QUARTZ_FREQUENCY = user_selected_can_addon_crystal_frequency_mhz * 1000000UL;
   } else {
@@ -172,6 +350,7 @@ bool init_CAN() {
     settings2515->mRequestedMode = ACAN2515Settings::NormalMode;
     const uint16_t errorCode2515 = can2515->begin(*settings2515, [] { can2515->isr(); });
     if (errorCode2515 == 0) {
+      set_mcp2515_acceptance_filters();
       logging.println("Can ok");
     } else {
       logging.print("Error Can: 0x");
@@ -209,7 +388,7 @@ bool init_CAN() {
     // ListenOnly / Normal20B / NormalFDs
     settings2517->mRequestedMode = use_canfd_as_can ? ACAN2517FDSettings::Normal20B : ACAN2517FDSettings::NormalFD;
 
-    const uint32_t errorCode2517 = canfd->begin(*settings2517, [] { canfd->isr(); });
+    const uint32_t errorCode2517 = begin_mcp2518();
     canfd->poll();
     if (errorCode2517 == 0) {
       logging.print("Bit Rate prescaler: ");
@@ -236,78 +415,429 @@ bool init_CAN() {
     }
   }
 
-  return true;
-}
-
-void transmit_can_frame_to_interface(const CAN_frame* tx_frame, CAN_Interface interface) {
-  if (!allowed_to_send_CAN) {
-    return;
+  if (use_can_rx_tasks) {
+    start_can_rx_tasks();
   }
-  print_can_frame(*tx_frame, interface, frameDirection(MSG_TX));
 
-  if (datalayer.system.info.CAN_SD_logging_active) {
-    add_can_frame_to_buffer(*tx_frame, frameDirection(MSG_TX));
-  }
+  start_can_tx_queues();
 
+  return true;
+}
+
+// Hands a frame to the CAN controller. Returns false if its transmit buffers are full.
+static bool send_frame_to_controller(const CAN_frame& tx_frame, CAN_Interface interface) {
   switch (interface) {
     case CAN_NATIVE: {
 
       CANMessage frame;
-      frame.id = tx_frame->ID;
-      frame.ext = tx_frame->ext_ID;
-      frame.len = tx_frame->DLC;
+      frame.id = tx_frame.ID;
+      frame.ext = tx_frame.ext_ID;
+      frame.len = tx_frame.DLC;
       for (uint8_t i = 0; i < frame.len; i++) {
-        frame.data[i] = tx_frame->data.u8[i];
+        frame.data[i] = tx_frame.data.u8[i];
       }
       send_ok_native = ACAN_ESP32::can.tryToSend(frame);
-
-      if (!send_ok_native) {
-        datalayer.system.info.can_native_send_fail = true;
-      }
-    } break;
+      return send_ok_native;
+    }
     case CAN_ADDON_MCP2515: {
       //Struct with ACAN2515 library format, needed to use the MCP2515 library for CAN2
       CANMessage MCP2515Frame;
-      MCP2515Frame.id = tx_frame->ID;
-      MCP2515Frame.ext = tx_frame->ext_ID;
-      MCP2515Frame.len = tx_frame->DLC;
+      MCP2515Frame.id = tx_frame.ID;
+      MCP2515Frame.ext = tx_frame.ext_ID;
+      MCP2515Frame.len = tx_frame.DLC;
       MCP2515Frame.rtr = false;
       for (uint8_t i = 0; i < MCP2515Frame.len; i++) {
-        MCP2515Frame.data[i] = tx_frame->data.u8[i];
+        MCP2515Frame.data[i] = tx_frame.data.u8[i];
       }
 
       send_ok_2515 = can2515->tryToSend(MCP2515Frame);
-      if (!send_ok_2515) {
-        datalayer.system.info.can_2515_send_fail = true;
-      }
-    } break;
+      return send_ok_2515;
+    }
     case CANFD_NATIVE:
     case CANFD_ADDON_MCP2518: {
       CANFDMessage MCP2518Frame;
-      if (tx_frame->FD) {
+      if (tx_frame.FD) {
         MCP2518Frame.type = CANFDMessage::CANFD_WITH_BIT_RATE_SWITCH;
       } else {  //Classic CAN message
         MCP2518Frame.type = CANFDMessage::CAN_DATA;
       }
-      MCP2518Frame.id = tx_frame->ID;
-      MCP2518Frame.ext = tx_frame->ext_ID;
-      MCP2518Frame.len = tx_frame->DLC;
+      MCP2518Frame.id = tx_frame.ID;
+      MCP2518Frame.ext = tx_frame.ext_ID;
+      MCP2518Frame.len = tx_frame.DLC;
       for (uint8_t i = 0; i < MCP2518Frame.len; i++) {
-        MCP2518Frame.data[i] = tx_frame->data.u8[i];
+        MCP2518Frame.data[i] = tx_frame.data.u8[i];
       }
       send_ok_2518 = canfd->tryToSend(MCP2518Frame);
-      if (!send_ok_2518) {
-        datalayer.system.info.can_2518_send_fail = true;
+      return send_ok_2518;
+    }
+    default:
+      // Invalid interface sent with function call. TODO: Raise event that coders messed up
+      return false;
+  }
+}
+
+static void set_can_send_fail(CAN_Interface interface) {
+  switch (interface) {
+    case CAN_NATIVE:
+      datalayer.system.info.can_native_send_fail = true;
+      break;
+    case CAN_ADDON_MCP2515:
+      datalayer.system.info.can_2515_send_fail = true;
+      break;
+    case CANFD_NATIVE:
+    case CANFD_ADDON_MCP2518:
+      datalayer.system.info.can_2518_send_fail = true;
+      break;
+    default:
+      break;
+  }
+}
+
+// Frames waiting for the controller, per interface. Both CAN-FD interfaces share the MCP2518 queue.
+static CanTxQueue<CAN_TX_QUEUE_SIZE>* can_tx_queues[NO_CAN_INTERFACE] = {nullptr};
+
+// Sends queued frames, most important first, until the controller is full again
+static void drain_can_tx_queue(CAN_Interface interface) {
+  CanTxQueue<CAN_TX_QUEUE_SIZE>* queue = can_tx_queues[interface];
+  const CanTxQueue<CAN_TX_QUEUE_SIZE>::Entry* entry;
+
+  while ((entry = queue->front()) != nullptr) {
+    if (!send_frame_to_controller(entry->frame, interface)) {
+      return;
+    }
+    const uint32_t waited_us = esp_timer_get_time() - entry->queued_us;
+    uint32_t& latency_max_us = datalayer.system.status.can_tx_latency_max_us[interface][entry->priority];
+    if (waited_us > latency_max_us) {
+      latency_max_us = waited_us;
+    }
+    queue->pop();
+  }
+}
+
+static void start_can_tx_queues() {
+  if (native_can_initialized) {
+    can_tx_queues[CAN_NATIVE] = new CanTxQueue<CAN_TX_QUEUE_SIZE>();
+  }
+  if (can2515) {
+    can_tx_queues[CAN_ADDON_MCP2515] = new CanTxQueue<CAN_TX_QUEUE_SIZE>();
+  }
+  if (canfd) {
+    can_tx_queues[CANFD_ADDON_MCP2518] = new CanTxQueue<CAN_TX_QUEUE_SIZE>();
+  }
+}
+
+void transmit_queued_can_frames() {
+  for (int i = 0; i < NO_CAN_INTERFACE; i++) {
+    if (can_tx_queues[i]) {
+      drain_can_tx_queue((CAN_Interface)i);
+    }
+  }
+}
+
+bool transmit_can_frame_to_interface(const CAN_frame* tx_frame, CAN_Interface interface, CAN_TX_Priority priority) {
+  if (!allowed_to_send_CAN) {
+    return false;
+  }
+  const int64_t timestamp_us = esp_timer_get_time();
+  print_can_frame(*tx_frame, interface, frameDirection(MSG_TX), timestamp_us);
+
+  if (datalayer.system.info.CAN_SD_logging_active) {
+    add_can_frame_to_buffer(*tx_frame, interface, frameDirection(MSG_TX), timestamp_us);
+  }
+
+  if (interface >= NO_CAN_INTERFACE) {
+    return false;
+  }
+  can_stats.write([tx_frame, interface, timestamp_us](CanTrafficStats& stats) {
+    stats.record(*tx_frame, controller_interface(interface), MSG_TX, timestamp_us);
+  });
+
+  const CAN_Interface queue_interface = controller_interface(interface);
+  CanTxQueue<CAN_TX_QUEUE_SIZE>* queue = can_tx_queues[queue_interface];
+
+  if (!queue) {
+    // Interface not started by init_CAN, nothing to queue for
+    if (!send_frame_to_controller(*tx_frame, interface)) {
+      set_can_send_fail(interface);
+      return false;
+    }
+    return true;
+  }
+
+  // Go straight to the controller unless older frames are still waiting
+  if (queue->empty() && send_frame_to_controller(*tx_frame, interface)) {
+    return true;
+  }
+
+  if (!queue->push(*tx_frame, priority, timestamp_us)) {
+    datalayer.system.status.can_tx_dropped[queue_interface][priority]++;
+    set_can_send_fail(interface);
+    return false;
+  }
+  drain_can_tx_queue(queue_interface);
+  return true;
+}
+
+// Keeps track of how far behind reception is on an interface. backlog is the number of frames
+// found waiting in the driver queue before draining it.
+static void update_can_rx_backlog(CAN_Interface interface, uint16_t backlog) {
+  if (backlog > datalayer.system.status.can_rx_backlog_max[interface]) {
+    datalayer.system.status.can_rx_backlog_max[interface] = backlog;
+  }
+}
+
+// Driver queue telemetry, sampled by whoever drains the interface before taking frames from it
+static void update_can_rx_statistics(CAN_Interface interface) {
+  switch (interface) {
+    case CAN_NATIVE:
+      update_can_rx_backlog(CAN_NATIVE, ACAN_ESP32::can.driverReceiveBufferCount());
+      if (ACAN_ESP32::can.driverReceiveBufferPeakCount() > ACAN_ESP32::can.driverReceiveBufferSize()) {
+        // The driver queue was full when a frame arrived, and it was lost
+        datalayer.system.status.can_rx_overflows[CAN_NATIVE]++;
+        ACAN_ESP32::can.resetDriverReceiveBufferPeakCount();
+      }
+      break;
+    case CAN_ADDON_MCP2515: {
+      const uint16_t backlog = can2515->receiveBufferCount();
+      update_can_rx_backlog(CAN_ADDON_MCP2515, backlog);
+      if (backlog >= can2515->receiveBufferSize()) {
+        // The driver discards frames silently once its queue is full, so count each time we find it full
+        datalayer.system.status.can_rx_overflows[CAN_ADDON_MCP2515]++;
+      }
+    } break;
+    case CANFD_ADDON_MCP2518: {
+      // The MCP2518 driver only reports its lifetime peak, not the current queue depth
+      update_can_rx_backlog(CANFD_ADDON_MCP2518, canfd->driverReceiveBufferPeakCount());
+      const uint8_t hardware_overflows = canfd->hardwareReceiveBufferOverflowCount();
+      if (hardware_overflows > 0) {
+        datalayer.system.status.can_rx_overflows[CANFD_ADDON_MCP2518] += hardware_overflows;
+        canfd->resetHardwareReceiveBufferOverflowCount();
       }
     } break;
     default:
-      // Invalid interface sent with function call. TODO: Raise event that coders messed up
       break;
   }
 }
 
+// Take one frame from the native CAN driver. Returns false if none is waiting.
+static bool read_frame_can_native(CAN_frame& rx_frame) {
+  CANMessage frame;
+
+  if (!ACAN_ESP32::can.available() || !ACAN_ESP32::can.receive(frame)) {
+    return false;
+  }
+
+  rx_frame.ID = frame.id;
+  rx_frame.ext_ID = frame.ext;
+  rx_frame.DLC = frame.len;
+  for (uint8_t i = 0; i < frame.len && i < 8; i++) {
+    rx_frame.data.u8[i] = frame.data[i];
+  }
+  return true;
+}
+
+// Take one frame from the MCP2515 add-on driver. Returns false if none is waiting.
+static bool read_frame_can_addon(CAN_frame& rx_frame) {
+  CANMessage MCP2515frame;  // Struct with ACAN2515 library format, needed to use the MCP2515 library
+
+  if (!can2515->available()) {
+    return false;
+  }
+  can2515->receive(MCP2515frame);
+
+  rx_frame.ID = MCP2515frame.id;
+  rx_frame.ext_ID = MCP2515frame.ext;
+  rx_frame.DLC = MCP2515frame.len;
+  for (uint8_t i = 0; i < MCP2515frame.len && i < 8; i++) {
+    rx_frame.data.u8[i] = MCP2515frame.data[i];
+  }
+  return true;
+}
+
+// Take one frame from the MCP2518 CAN-FD add-on driver. Returns false if none is waiting.
+static bool read_frame_canfd_addon(CAN_frame& rx_frame) {
+  CANFDMessage MCP2518frame;
+
+  if (!canfd->available()) {
+    return false;
+  }
+  canfd->receive(MCP2518frame);
+
+  rx_frame.ID = MCP2518frame.id;
+  rx_frame.ext_ID = MCP2518frame.ext;
+  rx_frame.DLC = MCP2518frame.len;
+  memcpy(rx_frame.data.u8, MCP2518frame.data, std::min(rx_frame.DLC, (uint8_t)64));
+  return true;
+}
+
+static bool read_frame(CAN_Interface interface, CAN_frame& rx_frame) {
+  switch (interface) {
+    case CAN_NATIVE:
+      return read_frame_can_native(rx_frame);
+    case CAN_ADDON_MCP2515:
+      return read_frame_can_addon(rx_frame);
+    case CANFD_ADDON_MCP2518:
+      return read_frame_canfd_addon(rx_frame);
+    default:
+      return false;
+  }
+}
+
+// Optional RX tasks. Each one moves frames from its driver into a lock-free ring every tick,
+// stamping them with the time they were taken from the driver. The core loop then consumes the
+// rings at its own pace, so a slow iteration no longer lets the driver queues overflow.
+// The tasks still poll: the drivers keep the reception time to themselves and signal frames
+// only to their own interrupt handlers, so a timestamp is up to a tick after the frame arrived.
+static CanRxRing<CAN_RX_RING_SIZE>* can_rx_rings[NO_CAN_INTERFACE] = {nullptr};
+static TaskHandle_t can_rx_tasks[NO_CAN_INTERFACE] = {nullptr};
+
+// The core task parks the RX tasks before it reconfigures or stops the drivers, see park_can_rx_tasks()
+static std::atomic<bool> can_rx_park_requested{false};
+// Given by each RX task once it is parked
+static SemaphoreHandle_t can_rx_parked = nullptr;
+static uint8_t can_rx_park_depth = 0;
+
+static void can_rx_task(void* parameter) {
+  const CAN_Interface interface = (CAN_Interface)(uintptr_t)parameter;
+  CanRxRing<CAN_RX_RING_SIZE>* ring = can_rx_rings[interface];
+  CAN_frame rx_frame;
+
+  while (true) {
+    if (can_rx_park_requested) {
+      // Between driver calls, so no driver or SPI lock is held while parked
+      xSemaphoreGive(can_rx_parked);
+      while (can_rx_park_requested) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      }
+      continue;
+    }
+
+    update_can_rx_statistics(interface);
+
+    while (read_frame(interface, rx_frame)) {
+      if (!ring->push(rx_frame, esp_timer_get_time())) {
+        // The core loop is not keeping up, the frame is lost
+        datalayer.system.status.can_rx_overflows[interface]++;
+      }
+    }
+    update_can_rx_backlog(interface, ring->count());
+
+    // The drivers fill their queues from interrupt context (native) or their own tasks (add-ons)
+    // and offer no per-frame notification, so check again on the next tick. A notification, as sent
+    // when parking, ends the wait early.
+    ulTaskNotifyTake(pdTRUE, 1);
+  }
+}
+
+// Stops the RX tasks from reading their drivers, and waits until each one is outside any driver call.
+// Suspending them instead could stop one inside a driver call, holding the SPI bus or a driver lock
+// that the reconfiguration then waits for forever. Calls nest, the tasks go on after the last
+// unpark_can_rx_tasks(). Core task only.
+static void park_can_rx_tasks() {
+  if (can_rx_park_depth++ > 0) {
+    return;
+  }
+  can_rx_park_requested = true;
+  for (auto& task : can_rx_tasks) {
+    if (task) {
+      xTaskNotifyGive(task);
+    }
+  }
+  for (auto& task : can_rx_tasks) {
+    if (task) {
+      xSemaphoreTake(can_rx_parked, portMAX_DELAY);
+    }
+  }
+}
+
+static void unpark_can_rx_tasks() {
+  if (can_rx_park_depth == 0 || --can_rx_park_depth > 0) {
+    return;
+  }
+  can_rx_park_requested = false;
+  for (auto& task : can_rx_tasks) {
+    if (task) {
+      xTaskNotifyGive(task);
+    }
+  }
+}
+
+static void start_can_rx_task(CAN_Interface interface, const char* name) {
+  can_rx_rings[interface] = new CanRxRing<CAN_RX_RING_SIZE>();
+  xTaskCreatePinnedToCore(can_rx_task, name, 2048, (void*)(uintptr_t)interface, TASK_CAN_RX_PRIO,
+                          &can_rx_tasks[interface], esp32hal->CORE_FUNCTION_CORE());
+}
+
+static void start_can_rx_tasks() {
+  can_rx_parked = xSemaphoreCreateCounting(NO_CAN_INTERFACE, 0);
+  if (native_can_initialized) {
+    start_can_rx_task(CAN_NATIVE, "can_rx_native");
+  }
+  if (can2515) {
+    start_can_rx_task(CAN_ADDON_MCP2515, "can_rx_2515");
+  }
+  if (canfd) {
+    start_can_rx_task(CANFD_ADDON_MCP2518, "can_rx_2518");
+  }
+}
+
+// Pass frames queued by an RX task on to the receivers, at most user_selected_can_rx_budget per call
+static void receive_frames_from_ring(CAN_Interface interface) {
+  CanRxRing<CAN_RX_RING_SIZE>* ring = can_rx_rings[interface];
+  CAN_rx_frame entry;
+
+  uint8_t count = 0;
+  while (count++ < user_selected_can_rx_budget && ring->pop(entry)) {
+    map_can_frame_to_variable(entry.frame, interface, entry.timestamp_us);
+    if (interface == CANFD_ADDON_MCP2518) {
+      map_can_frame_to_variable(entry.frame, CANFD_NATIVE, entry.timestamp_us);
+    }
+  }
+}
+
+// Opens the filters when CAN logging or replay starts, and closes them again when it ends. Polled from
+// the core task, as the drivers may only be reconfigured there.
+static void update_can_acceptance_filters() {
+  const bool enabled = !can_wants_all_frames();
+  // While stopped the drivers are ended, the change is made after restart_can()
+  if (enabled == can_filters_enabled || can_stopped) {
+    return;
+  }
+  can_filters_enabled = enabled;
+
+  park_can_rx_tasks();
+
+  if (native_can_initialized && !native_filter_ids.empty()) {
+    native_can_filter = native_acceptance_filter();
+    ACAN_ESP32::can.end();
+    ACAN_ESP32::can.begin(*settingsespcan, native_can_filter);
+  }
+  if (can2515 && !mcp2515_filter_ids.empty()) {
+    set_mcp2515_acceptance_filters();
+  }
+  if (canfd && !mcp2518_filter_ids.empty()) {
+    canfd->end();
+    begin_mcp2518();
+  }
+
+  unpark_can_rx_tasks();
+}
+
 // Receive functions
 void receive_can() {
+  update_can_acceptance_filters();
+  const int64_t now_us = esp_timer_get_time();
+  can_stats.write([now_us](CanTrafficStats& stats) { stats.update(now_us); });
+
+  if (use_can_rx_tasks) {
+    for (int i = 0; i < NO_CAN_INTERFACE; i++) {
+      if (can_rx_rings[i]) {
+        receive_frames_from_ring((CAN_Interface)i);
+      }
+    }
+    return;
+  }
+
   if (native_can_initialized) {
     receive_frame_can_native();  // Receive CAN messages from native CAN port
   }
@@ -321,69 +851,51 @@ void receive_can() {
   }
 }
 
-void receive_frame_can_native() {  // This section checks if we have a complete CAN message incoming on native CAN port
-  CANMessage frame;
+void receive_frame_can_native() {  // This section checks if we have complete CAN messages incoming on native CAN port
+  CAN_frame rx_frame;
 
-  if (ACAN_ESP32::can.available()) {
-    if (ACAN_ESP32::can.receive(frame)) {
+  update_can_rx_statistics(CAN_NATIVE);
 
-      CAN_frame rx_frame;
-      rx_frame.ID = frame.id;
-      rx_frame.ext_ID = frame.ext;
-      rx_frame.DLC = frame.len;
-      for (uint8_t i = 0; i < frame.len && i < 8; i++) {
-        rx_frame.data.u8[i] = frame.data[i];
-      }
-
-      //message incoming, pass it on to the handler
-      map_can_frame_to_variable(&rx_frame, CAN_NATIVE);
-    }
+  uint8_t count = 0;
+  while (count++ < user_selected_can_rx_budget && read_frame_can_native(rx_frame)) {
+    //message incoming, pass it on to the handler
+    map_can_frame_to_variable(rx_frame, CAN_NATIVE, esp_timer_get_time());
   }
 }
 
-void receive_frame_can_addon() {  // This section checks if we have a complete CAN message incoming on add-on CAN port
+void receive_frame_can_addon() {  // This section checks if we have complete CAN messages incoming on add-on CAN port
   CAN_frame rx_frame;             // Struct with our CAN format
-  CANMessage MCP2515frame;        // Struct with ACAN2515 library format, needed to use the MCP2515 library
 
-  if (can2515->available()) {
-    can2515->receive(MCP2515frame);
-
-    rx_frame.ID = MCP2515frame.id;
-    rx_frame.ext_ID = MCP2515frame.ext;
-    rx_frame.DLC = MCP2515frame.len;
-    for (uint8_t i = 0; i < MCP2515frame.len && i < 8; i++) {
-      rx_frame.data.u8[i] = MCP2515frame.data[i];
-    }
+  update_can_rx_statistics(CAN_ADDON_MCP2515);
 
+  uint8_t count = 0;
+  while (count++ < user_selected_can_rx_budget && read_frame_can_addon(rx_frame)) {
     //message incoming, pass it on to the handler
-    map_can_frame_to_variable(&rx_frame, CAN_ADDON_MCP2515);
+    map_can_frame_to_variable(rx_frame, CAN_ADDON_MCP2515, esp_timer_get_time());
   }
 }
 
-void receive_frame_canfd_addon() {  // This section checks if we have a complete CAN-FD message incoming
-  CANFDMessage MCP2518frame;
-  int count = 0;
-  while (canfd->available() && count++ < 16) {
-    canfd->receive(MCP2518frame);
-
-    CAN_frame rx_frame;
-    rx_frame.ID = MCP2518frame.id;
-    rx_frame.ext_ID = MCP2518frame.ext;
-    rx_frame.DLC = MCP2518frame.len;
-    memcpy(rx_frame.data.u8, MCP2518frame.data, std::min(rx_frame.DLC, (uint8_t)64));
+void receive_frame_canfd_addon() {  // This section checks if we have complete CAN-FD messages incoming
+  CAN_frame rx_frame;
+
+  update_can_rx_statistics(CANFD_ADDON_MCP2518);
+
+  uint8_t count = 0;
+  while (count++ < user_selected_can_rx_budget && read_frame_canfd_addon(rx_frame)) {
+    const int64_t timestamp_us = esp_timer_get_time();
     //message incoming, pass it on to the handler
-    map_can_frame_to_variable(&rx_frame, CANFD_ADDON_MCP2518);
-    map_can_frame_to_variable(&rx_frame, CANFD_NATIVE);
+    map_can_frame_to_variable(rx_frame, CANFD_ADDON_MCP2518, timestamp_us);
+    map_can_frame_to_variable(rx_frame, CANFD_NATIVE, timestamp_us);
   }
 }
 
 // Support functions
-void print_can_frame(CAN_frame frame, CAN_Interface interface, frameDirection msgDir) {
+void print_can_frame(const CAN_frame& frame, CAN_Interface interface, frameDirection msgDir, int64_t timestamp_us) {
 
   if (datalayer.system.info.CAN_usb_logging_active) {
     uint8_t i = 0;
     Serial.print("(");
-    Serial.print(millis() / 1000.0);
+    Serial.print(timestamp_us / 1000000.0, 6);
     if (msgDir == MSG_RX) {
       Serial.print(") RX");
       Serial.print((int)(interface * 2));
@@ -407,71 +919,74 @@ void print_can_frame(CAN_frame frame, CAN_Interface interface, frameDirection ms
 
   if (datalayer.system.info.can_logging_active) {  // If user clicked on CAN Logging page in webserver, start recording
     if (frame.ID > user_selected_CAN_ID_cutoff_filter) {  //Only log the message if CAN ID is higher than user set value
-      dump_can_frame(frame, interface, msgDir);
+      dump_can_frame(frame, interface, msgDir, timestamp_us);
     }
   }
 }
 
-void map_can_frame_to_variable(CAN_frame* rx_frame, CAN_Interface interface) {
+void map_can_frame_to_variable(const CAN_frame& rx_frame, CAN_Interface interface, int64_t timestamp_us) {
   if (interface !=
       CANFD_NATIVE) {  //Avoid printing twice due to receive_frame_canfd_addon sending to both FD interfaces
     //TODO: This check can be removed later when refactored to use inline functions for logging
-    print_can_frame(*rx_frame, interface, frameDirection(MSG_RX));
+    print_can_frame(rx_frame, interface, frameDirection(MSG_RX), timestamp_us);
   }
 
   if (datalayer.system.info.CAN_SD_logging_active) {
     if (interface !=
         CANFD_NATIVE) {  //Avoid printing twice due to receive_frame_canfd_addon sending to both FD interfaces
       //TODO: This check can be removed later when refactored to use inline functions for logging
-      add_can_frame_to_buffer(*rx_frame, frameDirection(MSG_RX));
+      add_can_frame_to_buffer(rx_frame, interface, frameDirection(MSG_RX), timestamp_us);
     }
   }
 
-  // Send the frame to all the receivers registered for this interface.
-  auto receivers = can_receivers.equal_range(interface);
+  if (interface != CANFD_NATIVE) {  // Counted once, as CANFD_ADDON_MCP2518
+    can_stats.write([&rx_frame, interface, timestamp_us](CanTrafficStats& stats) {
+      stats.record(rx_frame, interface, MSG_RX, timestamp_us);
+    });
+  }
 
-  for (auto it = receivers.first; it != receivers.second; ++it) {
-    auto& receiver = it->second;
-    receiver.receiver->receive_can_frame(rx_frame);
+  // Send the frame to the receivers registered for this interface that handle its ID.
+  if (interface < NO_CAN_INTERFACE) {
+    can_dispatch[interface].dispatch(rx_frame);
   }
 }
 
-void dump_can_frame(CAN_frame& frame, CAN_Interface interface, frameDirection msgDir) {
-  char* message_string = datalayer.system.info.logged_can_messages;
-  int offset = datalayer.system.info.logged_can_messages_offset;  // Keeps track of the current position in the buffer
-  size_t message_string_size = sizeof(datalayer.system.info.logged_can_messages);
-
-  if (offset + 128 > sizeof(datalayer.system.info.logged_can_messages)) {
-    // Not enough space, reset and start from the beginning
-    offset = 0;
+void dump_can_frame(const CAN_frame& frame, CAN_Interface interface, frameDirection msgDir, int64_t timestamp_us) {
+  if (can_web_log == nullptr || xSemaphoreTake(can_web_log_mutex, 0) != pdTRUE) {
+    return;
   }
-  unsigned long currentTime = millis();
-  // Add timestamp
-  offset += snprintf(message_string + offset, message_string_size - offset, "(%lu.%03lu) ", currentTime / 1000,
-                     currentTime % 1000);
-
-  // Add direction. Multiplying the interface by two ensures that SavvyCAN puts TX and RX in a different bus.
-  offset += snprintf(message_string + offset, message_string_size - offset, "%s%d ", (msgDir == MSG_RX) ? "RX" : "TX",
-                     (int)(interface * 2) + (msgDir == MSG_RX ? 0 : 1));
-
-  // Add ID and DLC
-  offset += snprintf(message_string + offset, message_string_size - offset, "%lX [%u] ", frame.ID, frame.DLC);
+  can_web_log->push(frame, interface, msgDir, timestamp_us);
+  xSemaphoreGive(can_web_log_mutex);
+}
 
-  // Add data bytes
-  for (uint8_t i = 0; i < frame.DLC; i++) {
-    if (i < frame.DLC - 1) {
-      offset += snprintf(message_string + offset, message_string_size - offset, "%02X ", frame.data.u8[i]);
-    } else {
-      offset += snprintf(message_string + offset, message_string_size - offset, "%02X", frame.data.u8[i]);
-    }
+void start_can_web_log() {
+  if (can_web_log == nullptr) {
+    can_web_log_mutex = xSemaphoreCreateMutex();
+    can_web_log = new CanLogRing<CAN_WEB_LOG_SIZE>();
   }
-  // Add linebreak
-  offset += snprintf(message_string + offset, message_string_size - offset, "\n");
+  if (!datalayer.system.info.can_logging_active) {
+    xSemaphoreTake(can_web_log_mutex, portMAX_DELAY);
+    can_web_log->clear();
+    xSemaphoreGive(can_web_log_mutex);
+  }
+  datalayer.system.info.can_logging_active = true;
+}
 
-  datalayer.system.info.logged_can_messages_offset = offset;  // Update offset in buffer
+uint32_t copy_can_web_log(std::vector<uint8_t>& records, int64_t& start_us) {
+  if (can_web_log == nullptr) {
+    records.clear();
+    return 0;
+  }
+  xSemaphoreTake(can_web_log_mutex, portMAX_DELAY);
+  const uint32_t frames = can_web_log->copy(records, start_us);
+  xSemaphoreGive(can_web_log_mutex);
+  return frames;
 }
 
 void stop_can() {
+  park_can_rx_tasks();
+  can_stopped = true;
+
   if (can_receivers.find(CAN_NATIVE) != can_receivers.end()) {
     ACAN_ESP32::can.end();
   }
@@ -489,18 +1004,22 @@ void stop_can() {
 
 void restart_can() {
   if (can_receivers.find(CAN_NATIVE) != can_receivers.end()) {
-    ACAN_ESP32::can.begin(*settingsespcan);
+    ACAN_ESP32::can.begin(*settingsespcan, native_can_filter);
   }
 
   if (can2515) {
     SPI2515.begin();
     can2515->begin(*settings2515, [] { can2515->isr(); });
+    set_mcp2515_acceptance_filters();
   }
 
   if (canfd) {
     SPI2517.begin();
-    canfd->begin(*settings2517, [] { canfd->isr(); });
+    begin_mcp2518();
   }
+
+  can_stopped = false;
+  unpark_can_rx_tasks();
 }
 
 // Initialize the native CAN interface with the given speed and pins.
@@ -523,7 +1042,7 @@ uint32_t init_native_can(CAN_Speed speed, gpio_num_t tx_pin, gpio_num_t rx_pin)
   settingsespcan->mRxPin = rx_pin;
 
   // (Re)start the CAN interface
-  return ACAN_ESP32::can.begin(*settingsespcan);
+  return ACAN_ESP32::can.begin(*settingsespcan, native_can_filter);
 }
 
 // Change the speed of the given CAN interface. Returns true if successful.
@@ -536,6 +1055,8 @@ bool change_can_speed(CAN_Interface interface, CAN_Speed speed) {
       logging.println(errorCode, HEX);
       return false;
     }
+    const uint32_t bit_rate = (int)speed * 1000UL;
+    can_stats.write([bit_rate](CanTrafficStats& stats) { stats.set_bit_rate(CAN_NATIVE, bit_rate); });
     return true;
   }
 
@@ -1,19 +1,59 @@
 #ifndef _COMM_CAN_H_
 #define _COMM_CAN_H_
 
+#include <functional>
+#include <vector>
 #include "../../devboard/utils/types.h"
 
 extern bool use_canfd_as_can;
+extern bool use_can_rx_tasks;
 extern uint8_t user_selected_can_addon_crystal_frequency_mhz;
 extern uint8_t user_selected_canfd_addon_crystal_frequency_mhz;
 extern uint16_t user_selected_CAN_ID_cutoff_filter;
+extern uint8_t user_selected_can_rx_budget;
 
-void dump_can_frame(CAN_frame& frame, CAN_Interface interface, frameDirection msgDir);
-void transmit_can_frame_to_interface(const CAN_frame* tx_frame, CAN_Interface interface);
+// Add a frame to the webserver CAN log, if it has been started
+void dump_can_frame(const CAN_frame& frame, CAN_Interface interface, frameDirection msgDir, int64_t timestamp_us);
+
+// Start logging frames for the webserver, clearing the log unless it is running already
+void start_can_web_log();
+
+// Copy the frames of the webserver CAN log as binary records, to be turned into text with a
+// CanLogTextReader started at start_us. Returns the number of frames.
+uint32_t copy_can_web_log(std::vector<uint8_t>& records, int64_t& start_us);
+// Send a frame, or queue it by priority if the controller's transmit buffers are full.
+// Returns false if it had to be dropped because its priority class is full as well.
+bool transmit_can_frame_to_interface(const CAN_frame* tx_frame, CAN_Interface interface,
+                                     CAN_TX_Priority priority = CAN_TX_SAFETY);
+
+// Hand queued frames to the controllers as room frees up, called once per core loop iteration
+void transmit_queued_can_frames();
+
+// Send a frame on the interface every period_ms, at a phase offset chosen to keep the bus load even.
+// The frame is read from its own storage on every send. before_send, if given, runs just before
+// and can update the frame or return false to skip that period.
+void schedule_can_frame(CAN_frame* frame, CAN_Interface interface, uint16_t period_ms, CAN_TX_Priority priority,
+                        std::function<bool(void)> before_send = nullptr);
+
+// Send the scheduled frames that are due, called once per core loop iteration
+void transmit_scheduled_can_frames(unsigned long currentMillis);
+
+class CanTrafficStats;
+// Copies the per-ID frame statistics and bus load of all interfaces, as one coherent update of the
+// core task. Safe to call from any task. The copy is several KB, so better not kept on the stack.
+void read_can_traffic_stats(CanTrafficStats& out);
 
 //These defines are not used if user updates values via Settings page
 #define CRYSTAL_FREQUENCY_MHZ 8
 #define CANFD_ADDON_CRYSTAL_FREQUENCY_MHZ ACAN2517FDSettings::OSC_40MHz
+// Maximum frames taken from each CAN interface per core loop iteration
+#define CAN_RX_BUDGET 16
+// Frames each CAN RX task can hold for the core loop, when RX tasks are enabled. Must be a power of two.
+#define CAN_RX_RING_SIZE 64
+// Bytes of binary frames kept for the webserver CAN log, about 1000 classic frames
+#define CAN_WEB_LOG_SIZE 16384
+// Frames each CAN interface can hold back per priority class while its controller is busy
+#define CAN_TX_QUEUE_SIZE 8
 
 class CanReceiver;
 
@@ -55,6 +95,7 @@ bool init_CAN();
 
 /**
  * @brief Receive CAN messages from all interfaces. Respective CanReceivers are called.
+ * With use_can_rx_tasks, frames are instead taken from the queues filled by the per-interface RX tasks.
  *
  * @param[in] void
  *
@@ -63,7 +104,8 @@ bool init_CAN();
 void receive_can();
 
 /**
- * @brief Receive CAN messages from CAN tranceiver natively installed on Lilygo hardware
+ * @brief Receive CAN messages from CAN tranceiver natively installed on Lilygo hardware.
+ * Drains up to user_selected_can_rx_budget frames per call.
  *
  * @param[in] void
  *
@@ -72,7 +114,7 @@ void receive_can();
 void receive_frame_can_native();
 
 /**
- * @brief Receive CAN messages from CAN addon chip
+ * @brief Receive CAN messages from CAN addon chip. Drains up to user_selected_can_rx_budget frames per call.
  *
  * @param[in] void
  *
@@ -81,7 +123,7 @@ void receive_frame_can_native();
 void receive_frame_can_addon();
 
 /**
- * @brief Receive CAN messages from CANFD addon chip
+ * @brief Receive CAN messages from CANFD addon chip. Drains up to user_selected_can_rx_budget frames per call.
  *
  * @param[in] void
  *
@@ -92,11 +134,11 @@ void receive_frame_canfd_addon();
 /**
  * @brief print CAN frames via USB
  *
- * @param[in] void
+ * @param[in] timestamp_us esp_timer_get_time() when the frame was received or sent
  *
  * @return void
  */
-void print_can_frame(CAN_frame frame, CAN_Interface interface, frameDirection msgDir);
+void print_can_frame(const CAN_frame& frame, CAN_Interface interface, frameDirection msgDir, int64_t timestamp_us);
 
 // Stop/pause CAN communication for all interfaces
 void stop_can();
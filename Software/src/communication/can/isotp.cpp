@@ -0,0 +1,224 @@
+#include "isotp.h"
+#include <string.h>
+#include <algorithm>
+
+// Protocol control information, the high nibble of the first byte
+static constexpr uint8_t PCI_SINGLE_FRAME = 0x0;
+static constexpr uint8_t PCI_FIRST_FRAME = 0x1;
+static constexpr uint8_t PCI_CONSECUTIVE_FRAME = 0x2;
+static constexpr uint8_t PCI_FLOW_CONTROL = 0x3;
+
+static constexpr uint8_t FLOW_CONTINUE = 0x0;
+static constexpr uint8_t FLOW_WAIT = 0x1;
+static constexpr uint8_t FLOW_OVERFLOW = 0x2;
+
+static constexpr uint8_t UDS_NEGATIVE_RESPONSE = 0x7F;
+static constexpr uint8_t UDS_RESPONSE_PENDING = 0x78;
+
+static bool reached(unsigned long currentMillis, unsigned long deadline) {
+  return (long)(currentMillis - deadline) >= 0;
+}
+
+// STmin as sent by the ECU, in whole milliseconds since we send from the 1 ms core loop
+static uint8_t st_min_to_ms(uint8_t st_min) {
+  if (st_min <= 0x7F) {
+    return st_min;
+  }
+  if (st_min >= 0xF1 && st_min <= 0xF9) {
+    return 1;  // 100-900 us
+  }
+  return 0x7F;  // Reserved values are to be treated as the maximum
+}
+
+IsoTpSession::IsoTpSession(uint32_t request_id, uint32_t response_id, uint8_t* buffer, size_t buffer_size,
+                           SendFunction send)
+    : request_id(request_id),
+      response_id(response_id),
+      buffer(buffer),
+      buffer_size(std::min(buffer_size, MAX_MESSAGE_SIZE)),
+      send_frame(send) {}
+
+void IsoTpSession::send(const uint8_t* data, uint8_t length) {
+  CAN_frame frame = {.FD = false, .ext_ID = request_id > 0x7FF, .DLC = 8, .ID = request_id, .data = {}};
+  memset(frame.data.u8, padding, 8);
+  memcpy(frame.data.u8, data, length);
+  send_frame(frame);
+}
+
+void IsoTpSession::send_flow_control() {
+  const uint8_t flow_control[3] = {(PCI_FLOW_CONTROL << 4) | FLOW_CONTINUE, rx_block_size, rx_st_min};
+  send(flow_control, sizeof(flow_control));
+}
+
+bool IsoTpSession::request(const uint8_t* data, size_t length, unsigned long currentMillis) {
+  if (busy() || length == 0 || length > buffer_size) {
+    return false;
+  }
+  deadline_ms = currentMillis + timeout_ms;
+
+  uint8_t frame[8];
+  if (length <= 7) {
+    frame[0] = (PCI_SINGLE_FRAME << 4) | length;
+    memcpy(frame + 1, data, length);
+    send(frame, length + 1);
+    state = State::WaitingResponse;
+    return true;
+  }
+
+  memmove(buffer, data, length);
+  tx_length = length;
+  frame[0] = (PCI_FIRST_FRAME << 4) | (length >> 8);
+  frame[1] = length & 0xFF;
+  memcpy(frame + 2, buffer, 6);
+  send(frame, 8);
+  tx_offset = 6;
+  tx_sequence = 1;
+  state = State::SendingWaitFlowControl;
+  return true;
+}
+
+void IsoTpSession::send_consecutive_frames(unsigned long currentMillis) {
+  while (state == State::SendingConsecutive && reached(currentMillis, tx_next_ms)) {
+    uint8_t frame[8];
+    const uint8_t length = std::min<size_t>(7, tx_length - tx_offset);
+    frame[0] = (PCI_CONSECUTIVE_FRAME << 4) | tx_sequence;
+    memcpy(frame + 1, buffer + tx_offset, length);
+    send(frame, length + 1);
+    tx_offset += length;
+    tx_sequence = (tx_sequence + 1) & 0x0F;
+
+    if (tx_offset >= tx_length) {
+      state = State::WaitingResponse;
+      deadline_ms = currentMillis + timeout_ms;
+      return;
+    }
+    if (tx_block_left > 0 && --tx_block_left == 0) {
+      // The ECU wants to send another flow control before the next block
+      state = State::SendingWaitFlowControl;
+      deadline_ms = currentMillis + timeout_ms;
+      return;
+    }
+    tx_next_ms = currentMillis + tx_st_min_ms;
+  }
+}
+
+void IsoTpSession::complete() {
+  // Idle before the handler runs, so that it can send the next request right away
+  state = State::Idle;
+  completed++;
+  if (response_handler) {
+    response_handler(buffer, rx_length);
+  }
+}
+
+void IsoTpSession::fail() {
+  state = State::Idle;
+  failed++;
+}
+
+bool IsoTpSession::handle_frame(const CAN_frame& frame, unsigned long currentMillis) {
+  if (frame.ID != response_id) {
+    return false;
+  }
+  const uint8_t* data = frame.data.u8;
+  const uint8_t pci = data[0] >> 4;
+
+  if (pci == PCI_FLOW_CONTROL) {
+    if (state != State::SendingWaitFlowControl) {
+      return true;
+    }
+    switch (data[0] & 0x0F) {
+      case FLOW_CONTINUE:
+        tx_block_left = data[1];  // 0 is no limit
+        tx_st_min_ms = st_min_to_ms(data[2]);
+        tx_next_ms = currentMillis;
+        state = State::SendingConsecutive;
+        send_consecutive_frames(currentMillis);
+        break;
+      case FLOW_WAIT:
+        deadline_ms = currentMillis + timeout_ms;
+        break;
+      default:  // FLOW_OVERFLOW or invalid
+        fail();
+        break;
+    }
+    return true;
+  }
+
+  switch (pci) {
+    case PCI_SINGLE_FRAME: {
+      const uint8_t length = data[0] & 0x0F;
+      if (state != State::WaitingResponse && state != State::Receiving) {
+        break;
+      }
+      if (length == 0 || length > 7 || length > frame.DLC - 1 || length > buffer_size) {
+        fail();
+        break;
+      }
+      if (length >= 3 && data[1] == UDS_NEGATIVE_RESPONSE && data[3] == UDS_RESPONSE_PENDING) {
+        // The ECU needs more time, the actual response follows
+        state = State::WaitingResponse;
+        deadline_ms = currentMillis + timeout_ms;
+        break;
+      }
+      memcpy(buffer, data + 1, length);
+      rx_length = length;
+      complete();
+      break;
+    }
+    case PCI_FIRST_FRAME: {
+      if (state != State::WaitingResponse && state != State::Receiving) {
+        break;
+      }
+      rx_length = ((data[0] & 0x0F) << 8) | data[1];
+      if (rx_length > buffer_size || rx_length < 8) {
+        const uint8_t overflow[3] = {(PCI_FLOW_CONTROL << 4) | FLOW_OVERFLOW, 0, 0};
+        send(overflow, sizeof(overflow));
+        fail();
+        break;
+      }
+      memcpy(buffer, data + 2, 6);
+      rx_offset = 6;
+      rx_sequence = 1;
+      rx_block_left = rx_block_size;
+      state = State::Receiving;
+      deadline_ms = currentMillis + timeout_ms;
+      send_flow_control();
+      break;
+    }
+    case PCI_CONSECUTIVE_FRAME: {
+      if (state != State::Receiving) {
+        break;
+      }
+      if ((data[0] & 0x0F) != rx_sequence) {
+        fail();
+        break;
+      }
+      const size_t length = std::min<size_t>(7, rx_length - rx_offset);
+      memcpy(buffer + rx_offset, data + 1, length);
+      rx_offset += length;
+      rx_sequence = (rx_sequence + 1) & 0x0F;
+      deadline_ms = currentMillis + timeout_ms;
+
+      if (rx_offset >= rx_length) {
+        complete();
+      } else if (rx_block_size > 0 && --rx_block_left == 0) {
+        rx_block_left = rx_block_size;
+        send_flow_control();
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  return true;
+}
+
+void IsoTpSession::update(unsigned long currentMillis) {
+  if (state == State::SendingConsecutive) {
+    send_consecutive_frames(currentMillis);
+  } else if (state != State::Idle && reached(currentMillis, deadline_ms)) {
+    state = State::Idle;
+    timed_out++;
+  }
+}
@@ -0,0 +1,102 @@
+#ifndef _ISOTP_H_
+#define _ISOTP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include "../../devboard/utils/types.h"
+
+// ISO 15765-2 (ISO-TP) transport for diagnostic requests to one ECU over classic CAN, normal addressing.
+// Requests longer than a single frame are segmented, following the flow control of the ECU. Multi-frame
+// responses are reassembled into a buffer owned by the caller, with one flow control frame per block
+// rather than per frame: with a block size of 0 the ECU sends the whole response in one burst.
+// Complete responses, e.g. a UDS positive or negative response, are delivered to a callback.
+class IsoTpSession {
+ public:
+  typedef std::function<void(const CAN_frame& frame)> SendFunction;
+  // The complete response, starting with the (UDS) service byte
+  typedef std::function<void(const uint8_t* data, size_t length)> ResponseHandler;
+
+  // How long to wait for the first frame of a response, for flow control, and between consecutive frames
+  static constexpr uint16_t DEFAULT_TIMEOUT_MS = 1000;
+  // Longest message ISO-TP can carry on classic CAN
+  static constexpr size_t MAX_MESSAGE_SIZE = 4095;
+
+  IsoTpSession(uint32_t request_id, uint32_t response_id, uint8_t* buffer, size_t buffer_size, SendFunction send);
+
+  void on_response(ResponseHandler handler) { response_handler = handler; }
+
+  // The flow control sent for multi-frame responses. block_size frames may follow each flow control,
+  // 0 means all of them. st_min is the minimum gap between them, in the ISO-TP encoding.
+  void set_flow_control(uint8_t block_size, uint8_t st_min) {
+    rx_block_size = block_size;
+    rx_st_min = st_min;
+  }
+  void set_timeout(uint16_t timeout_ms) { this->timeout_ms = timeout_ms; }
+  // Filler for the unused bytes of frames, which are always sent with 8 bytes
+  void set_padding(uint8_t padding) { this->padding = padding; }
+
+  // Starts a request. Returns false while the previous one is still running or if it is too long.
+  bool request(const uint8_t* data, size_t length, unsigned long currentMillis);
+
+  // Feeds a received frame. Returns true if it was meant for this session.
+  bool handle_frame(const CAN_frame& frame, unsigned long currentMillis);
+
+  // Sends the consecutive frames of a request as the ECU allows, and detects timeouts. Call every core loop.
+  void update(unsigned long currentMillis);
+
+  // Waiting for a response, or still sending a request
+  bool busy() const { return state != State::Idle; }
+
+  // Gives up on the running request, e.g. because another tester took over the bus
+  void cancel() { state = State::Idle; }
+
+  uint32_t responses() const { return completed; }
+  uint32_t timeouts() const { return timed_out; }
+  // Responses that were out of sequence or did not fit in the buffer
+  uint32_t errors() const { return failed; }
+
+ private:
+  enum class State { Idle, SendingWaitFlowControl, SendingConsecutive, WaitingResponse, Receiving };
+
+  void send(const uint8_t* data, uint8_t length);
+  void send_flow_control();
+  void send_consecutive_frames(unsigned long currentMillis);
+  void complete();
+  void fail();
+
+  uint32_t request_id;
+  uint32_t response_id;
+  uint8_t* buffer;
+  size_t buffer_size;
+  SendFunction send_frame;
+  ResponseHandler response_handler;
+
+  uint8_t rx_block_size = 0;
+  uint8_t rx_st_min = 0;
+  uint16_t timeout_ms = DEFAULT_TIMEOUT_MS;
+  uint8_t padding = 0x00;
+
+  State state = State::Idle;
+  unsigned long deadline_ms = 0;
+
+  // Request being sent. The data is kept in the buffer, which the response then overwrites.
+  size_t tx_length = 0;
+  size_t tx_offset = 0;
+  uint8_t tx_sequence = 0;
+  uint8_t tx_block_left = 0;
+  uint8_t tx_st_min_ms = 0;
+  unsigned long tx_next_ms = 0;
+
+  // Response being received
+  size_t rx_length = 0;
+  size_t rx_offset = 0;
+  uint8_t rx_sequence = 0;
+  uint8_t rx_block_left = 0;
+
+  uint32_t completed = 0;
+  uint32_t timed_out = 0;
+  uint32_t failed = 0;
+};
+
+#endif
@@ -0,0 +1,121 @@
+#include "uds_poll_scheduler.h"
+
+UdsPollScheduler::UdsPollScheduler(Entry* entries, uint16_t capacity, uint16_t requests_per_second)
+    : entries(entries), capacity(capacity) {
+  set_request_budget(requests_per_second);
+}
+
+UdsPollScheduler::Entry* UdsPollScheduler::find(uint16_t pid) {
+  for (uint16_t i = 0; i < used; i++) {
+    if (entries[i].pid == pid) {
+      return &entries[i];
+    }
+  }
+  return nullptr;
+}
+
+bool UdsPollScheduler::add(uint16_t pid, uint32_t period_ms, Priority priority) {
+  Entry* entry = find(pid);
+  if (entry == nullptr) {
+    if (used == capacity) {
+      return false;
+    }
+    entry = &entries[used++];
+    *entry = {};
+    entry->pid = pid;
+    entry->enabled = true;
+  }
+  entry->period_ms = period_ms;
+  entry->priority = priority;
+  return true;
+}
+
+void UdsPollScheduler::set_request_budget(uint16_t requests_per_second) {
+  if (requests_per_second < 1) {
+    requests_per_second = 1;
+  } else if (requests_per_second > 1000) {
+    requests_per_second = 1000;
+  }
+  request_gap_ms = 1000 / requests_per_second;
+}
+
+void UdsPollScheduler::set_enabled(uint16_t pid, bool enabled) {
+  Entry* entry = find(pid);
+  if (entry != nullptr) {
+    entry->enabled = enabled;
+  }
+}
+
+bool UdsPollScheduler::next(unsigned long currentMillis, uint16_t& pid) {
+  if (holding_off(currentMillis)) {
+    return false;
+  }
+  if (outstanding != nullptr) {
+    if (currentMillis - outstanding->last_request_ms < timeout_ms) {
+      return false;
+    }
+    outstanding->timeouts++;
+    outstanding = nullptr;
+  }
+  if (sent_any && currentMillis - last_request_ms < request_gap_ms) {
+    return false;
+  }
+
+  Entry* best = nullptr;
+  unsigned long best_overdue = 0;
+  for (uint16_t i = 0; i < used; i++) {
+    Entry& entry = entries[i];
+    if (!entry.enabled) {
+      continue;
+    }
+    unsigned long overdue;
+    if (!entry.requested) {
+      // Never polled yet, more overdue than anything else of its priority
+      overdue = ~0UL;
+    } else {
+      const unsigned long elapsed = currentMillis - entry.last_request_ms;
+      if (elapsed < entry.period_ms) {
+        continue;
+      }
+      overdue = elapsed - entry.period_ms;
+    }
+    if (best == nullptr || entry.priority < best->priority ||
+        (entry.priority == best->priority && overdue > best_overdue)) {
+      best = &entry;
+      best_overdue = overdue;
+    }
+  }
+  if (best == nullptr) {
+    return false;
+  }
+
+  best->requested = true;
+  best->last_request_ms = currentMillis;
+  outstanding = best;
+  last_request_ms = currentMillis;
+  sent_any = true;
+  pid = best->pid;
+  return true;
+}
+
+void UdsPollScheduler::response(uint16_t pid, unsigned long currentMillis) {
+  Entry* entry = find(pid);
+  if (entry == nullptr) {
+    return;
+  }
+  if (entry == outstanding) {
+    outstanding = nullptr;
+  }
+  if (entry->responses > 0) {
+    const uint32_t period = currentMillis - entry->last_response_ms;
+    entry->achieved_period_ms = entry->responses == 1 ? period : (entry->achieved_period_ms * 3 + period) / 4;
+  }
+  entry->responses++;
+  entry->last_response_ms = currentMillis;
+}
+
+void UdsPollScheduler::hold_off(unsigned long currentMillis, uint32_t duration_ms) {
+  hold_off_start = currentMillis;
+  hold_off_ms = duration_ms;
+  outstanding = nullptr;
+}
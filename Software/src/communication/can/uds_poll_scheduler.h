@@ -0,0 +1,80 @@
+#ifndef _UDS_POLL_SCHEDULER_H_
+#define _UDS_POLL_SCHEDULER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Decides which diagnostic value a battery polls next. Each PID (or data group) is registered with the
+// refresh period it needs and a priority. Of the PIDs that are due, the one with the highest priority
+// goes first, then the most overdue one, so safety-relevant values are not held up behind slow ones
+// like serial numbers. Requests are spaced to stay within a budget of requests per second, only one is
+// outstanding at a time, and polling pauses while another tester is using the diagnostic IDs.
+// The refresh period each PID actually achieves is tracked for the CAN statistics page.
+class UdsPollScheduler {
+ public:
+  enum Priority : uint8_t { PRIORITY_HIGH = 0, PRIORITY_NORMAL = 1, PRIORITY_LOW = 2 };
+
+  struct Entry {
+    uint16_t pid;
+    uint32_t period_ms;
+    Priority priority;
+    bool enabled;
+    bool requested;
+    uint16_t timeouts;
+    uint32_t responses;
+    unsigned long last_request_ms;
+    unsigned long last_response_ms;
+    // Time between responses, averaged over the last few
+    uint32_t achieved_period_ms;
+  };
+
+  // How long to wait for a response before the next request may go out
+  static constexpr uint16_t DEFAULT_TIMEOUT_MS = 500;
+
+  // entries is storage for up to capacity PIDs, owned by the caller
+  UdsPollScheduler(Entry* entries, uint16_t capacity, uint16_t requests_per_second);
+
+  // Registers a PID, or changes the period and priority of one already registered. Returns false when full.
+  bool add(uint16_t pid, uint32_t period_ms, Priority priority = PRIORITY_NORMAL);
+  // Disabled PIDs are not polled, e.g. cells the pack turns out not to have
+  void set_enabled(uint16_t pid, bool enabled);
+
+  // Limited to 1 to 1000 requests per second, as requests are spaced by whole milliseconds
+  void set_request_budget(uint16_t requests_per_second);
+  uint16_t request_budget() const { return 1000 / request_gap_ms; }
+  void set_timeout(uint16_t timeout_ms) { this->timeout_ms = timeout_ms; }
+
+  // Picks the PID to request now and counts it as sent. Returns false if nothing is due, or while the budget,
+  // an outstanding request or a hold-off does not allow another request. Call every core loop.
+  bool next(unsigned long currentMillis, uint16_t& pid);
+
+  // Call when a response to pid arrives
+  void response(uint16_t pid, unsigned long currentMillis);
+
+  // Pauses polling, e.g. because another tester (Leafspy) started using the same diagnostic IDs.
+  // The outstanding request, if any, is given up.
+  void hold_off(unsigned long currentMillis, uint32_t duration_ms);
+  bool holding_off(unsigned long currentMillis) const { return currentMillis - hold_off_start < hold_off_ms; }
+
+  const Entry& entry(uint16_t index) const { return entries[index]; }
+  uint16_t size() const { return used; }
+
+ private:
+  Entry* find(uint16_t pid);
+
+  Entry* entries;
+  uint16_t capacity;
+  uint16_t used = 0;
+
+  uint16_t request_gap_ms;
+  uint16_t timeout_ms = DEFAULT_TIMEOUT_MS;
+  unsigned long last_request_ms = 0;
+  bool sent_any = false;
+
+  Entry* outstanding = nullptr;
+
+  unsigned long hold_off_start = 0;
+  uint32_t hold_off_ms = 0;
+};
+
+#endif
@@ -5,6 +5,7 @@
 #include "../../charger/CanCharger.h"
 #include "../../communication/can/comm_can.h"
 #include "../../devboard/mqtt/mqtt.h"
+#include "../../devboard/mqtt/mqtt_outbox.h"
 #include "../../devboard/wifi/wifi.h"
 #include "../../inverter/INVERTERS.h"
 #include "../contactorcontrol/comm_contactorcontrol.h"
@@ -98,6 +99,15 @@ void init_stored_settings() {
   user_selected_inverter_deye_workaround = settings.getBool("DEYEBYD", false);
   user_selected_can_addon_crystal_frequency_mhz = settings.getUInt("CANFREQ", 8);
   user_selected_canfd_addon_crystal_frequency_mhz = settings.getUInt("CANFDFREQ", 40);
+  // Clamped before narrowing to the uint8_t, so a large stored value does not wrap around
+  const uint32_t can_rx_budget = settings.getUInt("CANRXBUDGET", CAN_RX_BUDGET);
+  if (can_rx_budget == 0) {
+    user_selected_can_rx_budget = 1;  // Always take at least one frame per loop
+  } else if (can_rx_budget > UINT8_MAX) {
+    user_selected_can_rx_budget = UINT8_MAX;
+  } else {
+    user_selected_can_rx_budget = can_rx_budget;
+  }
   user_selected_LEAF_interlock_mandatory = settings.getBool("INTERLOCKREQ", false);
   user_selected_use_estimated_SOC = settings.getBool("SOCESTIMATED", false);
   user_selected_tesla_digital_HVIL = settings.getBool("DIGITALHVIL", false);
@@ -148,6 +158,7 @@ void init_stored_settings() {
   periodic_bms_reset = settings.getBool("PERBMSRESET", false);
   remote_bms_reset = settings.getBool("REMBMSRESET", false);
   use_canfd_as_can = settings.getBool("CANFDASCAN", false);
+  use_can_rx_tasks = settings.getBool("CANRXTASKS", false);
 #ifdef HW_LILYGO2CAN
   user_selected_gpioopt1 = (GPIOOPT1)settings.getUInt("GPIOOPT1", 0);
 #endif
@@ -181,6 +192,11 @@ void init_stored_settings() {
   mqtt_publish_interval_ms = settings.getUInt("MQTTPUBLISHMS", 5000);
   ha_autodiscovery_enabled = settings.getBool("HADISC", false);
   mqtt_transmit_all_cellvoltages = settings.getBool("MQTTCELLV", false);
+  mqtt_transmit_can_stats = settings.getBool("MQTTCANSTATS", false);
+  mqtt_delta_publishing = settings.getBool("MQTTDELTA", false);
+  mqtt_cell_format = (MqttCellFormat)settings.getUInt("MQTTCELLFMT", MQTT_CELLS_JSON);
+  mqtt_publish_rate = settings.getUInt("MQTTRATE", MqttOutbox::DEFAULT_RATE);
+  mqtt_store_offline = settings.getBool("MQTTSTORE", false);
   custom_hostname = settings.getString("HOSTNAME").c_str();
 
   static_IP_enabled = settings.getBool("STATICIP", false);
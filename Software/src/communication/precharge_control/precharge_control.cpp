@@ -1,5 +1,6 @@
 #include "precharge_control.h"
 #include <Arduino.h>
+#include "../../battery/Battery.h"
 #include "../../datalayer/datalayer.h"
 #include "../../datalayer/datalayer_extended.h"
 #include "../../devboard/hal/hal.h"
@@ -62,7 +63,9 @@ void handle_precharge_control(unsigned long currentMillis) {
   }
 
   int32_t target_voltage = datalayer.battery.status.voltage_dV;
-  int32_t external_voltage = datalayer_extended.meb.BMS_voltage_intermediate_dV;
+  // Only MEB batteries report the voltage on the inverter side of their contactors
+  int32_t external_voltage =
+      user_selected_battery_type == BatteryType::Meb ? datalayer_extended.meb.BMS_voltage_intermediate_dV : 0;
 
   switch (datalayer.system.status.precharge_status) {
     case AUTO_PRECHARGE_IDLE:
@@ -259,7 +259,7 @@ struct DATALAYER_SHUNT_TYPE {
 };
 
 struct DATALAYER_SYSTEM_INFO_TYPE {
-  /** array with incoming CAN messages, for displaying on webserver */
+  /** array with log messages, for displaying on webserver */
   char logged_can_messages[15000] = {0};
   /** array with type of battery used, for displaying on webserver */
   char battery_protocol[64] = {0};
@@ -343,6 +343,28 @@ struct DATALAYER_SYSTEM_STATUS_TYPE {
    */
   int64_t time_snap_cantx_us = 0;
 
+  /** uint32_t */
+  /** Number of receive queue overflows seen on each CAN interface, indexed by CAN_Interface.
+   * Every overflow lost at least one incoming frame.
+   */
+  uint32_t can_rx_overflows[NO_CAN_INTERFACE] = {0};
+
+  /** uint16_t */
+  /** Most frames found waiting in each CAN interface receive queue, indexed by CAN_Interface.
+   * Values approaching the queue size mean reception is falling behind the bus.
+   */
+  uint16_t can_rx_backlog_max[NO_CAN_INTERFACE] = {0};
+
+  /** uint32_t */
+  /** Frames dropped because the transmit queue was full, indexed by CAN_Interface and CAN_TX_Priority */
+  uint32_t can_tx_dropped[NO_CAN_INTERFACE][CAN_TX_PRIORITY_COUNT] = {{0}};
+
+  /** uint32_t */
+  /** Longest time in microseconds a frame waited in the transmit queue before the controller took it,
+   * indexed by CAN_Interface and CAN_TX_Priority. Frames sent without queueing are not counted.
+   */
+  uint32_t can_tx_latency_max_us[NO_CAN_INTERFACE][CAN_TX_PRIORITY_COUNT] = {{0}};
+
   /** uint8_t */
   /** A counter set each time a new message comes from inverter.
    * This value then gets decremented every second. Incase we reach 0
@@ -1,3 +1,122 @@
 #include "datalayer_extended.h"
+#include <new>
+#include "../battery/Battery.h"
 
 DataLayerExtended datalayer_extended;
+
+void DataLayerExtended::select(BatteryType type) {
+  switch (type) {
+    case BatteryType::BmwIX:
+      new (&bmwix) DATALAYER_INFO_BMWIX();
+      break;
+    case BatteryType::BmwPhev:
+      new (&bmwphev) DATALAYER_INFO_BMWPHEV();
+      break;
+    case BatteryType::BoltAmpera:
+      new (&boltampera) DATALAYER_INFO_BOLTAMPERA();
+      break;
+    case BatteryType::BydAtto3:
+      new (&bydAtto3) DATALAYER_INFO_BYDATTO3();
+      break;
+    case BatteryType::CellPowerBms:
+      new (&cellpower) DATALAYER_INFO_CELLPOWER();
+      break;
+    case BatteryType::Chademo:
+      new (&chademo) DATALAYER_INFO_CHADEMO();
+      break;
+    case BatteryType::CmfaEv:
+      new (&CMFAEV) DATALAYER_INFO_CMFAEV();
+      break;
+    case BatteryType::CmpSmartCar:
+      new (&stellantisCMPsmart) DATALAYER_INFO_CMPSMART();
+      break;
+    case BatteryType::GeelyGeometryC:
+      new (&geometryC) DATALAYER_INFO_GEELY_GEOMETRY_C();
+      break;
+    case BatteryType::KiaHyundai64:
+      new (&KiaHyundai64[0]) DATALAYER_INFO_KIAHYUNDAI64();
+      new (&KiaHyundai64[1]) DATALAYER_INFO_KIAHYUNDAI64();
+      break;
+    case BatteryType::Meb:
+      new (&meb) DATALAYER_INFO_MEB();
+      break;
+    case BatteryType::NissanLeaf:
+      new (&nissanleaf) DATALAYER_INFO_NISSAN_LEAF();
+      break;
+    case BatteryType::RenaultZoe1:
+      new (&zoe) DATALAYER_INFO_ZOE();
+      break;
+    case BatteryType::RenaultZoe2:
+      new (&zoePH2) DATALAYER_INFO_ZOE_PH2();
+      break;
+    case BatteryType::StellantisEcmp:
+      new (&stellantisECMP) DATALAYER_INFO_ECMP();
+      break;
+    case BatteryType::TeslaModel3Y:
+    case BatteryType::TeslaModelSX:
+      new (&tesla) DATALAYER_INFO_TESLA();
+      break;
+    case BatteryType::VolvoSpa:
+      new (&VolvoPolestar) DATALAYER_INFO_VOLVO_POLESTAR();
+      break;
+    case BatteryType::VolvoSpaHybrid:
+      new (&VolvoHybrid) DATALAYER_INFO_VOLVO_HYBRID();
+      break;
+    default:
+      break;
+  }
+}
+
+size_t DataLayerExtended::size_for(BatteryType type) {
+  switch (type) {
+    case BatteryType::BmwIX:
+      return sizeof(DATALAYER_INFO_BMWIX);
+    case BatteryType::BmwPhev:
+      return sizeof(DATALAYER_INFO_BMWPHEV);
+    case BatteryType::BoltAmpera:
+      return sizeof(DATALAYER_INFO_BOLTAMPERA);
+    case BatteryType::BydAtto3:
+      return sizeof(DATALAYER_INFO_BYDATTO3);
+    case BatteryType::CellPowerBms:
+      return sizeof(DATALAYER_INFO_CELLPOWER);
+    case BatteryType::Chademo:
+      return sizeof(DATALAYER_INFO_CHADEMO);
+    case BatteryType::CmfaEv:
+      return sizeof(DATALAYER_INFO_CMFAEV);
+    case BatteryType::CmpSmartCar:
+      return sizeof(DATALAYER_INFO_CMPSMART);
+    case BatteryType::GeelyGeometryC:
+      return sizeof(DATALAYER_INFO_GEELY_GEOMETRY_C);
+    case BatteryType::KiaHyundai64:
+      return 2 * sizeof(DATALAYER_INFO_KIAHYUNDAI64);
+    case BatteryType::Meb:
+      return sizeof(DATALAYER_INFO_MEB);
+    case BatteryType::NissanLeaf:
+      return sizeof(DATALAYER_INFO_NISSAN_LEAF);
+    case BatteryType::RenaultZoe1:
+      return sizeof(DATALAYER_INFO_ZOE);
+    case BatteryType::RenaultZoe2:
+      return sizeof(DATALAYER_INFO_ZOE_PH2);
+    case BatteryType::StellantisEcmp:
+      return sizeof(DATALAYER_INFO_ECMP);
+    case BatteryType::TeslaModel3Y:
+    case BatteryType::TeslaModelSX:
+      return sizeof(DATALAYER_INFO_TESLA);
+    case BatteryType::VolvoSpa:
+      return sizeof(DATALAYER_INFO_VOLVO_POLESTAR);
+    case BatteryType::VolvoSpaHybrid:
+      return sizeof(DATALAYER_INFO_VOLVO_HYBRID);
+    default:
+      return 0;
+  }
+}
+
+size_t DataLayerExtended::unshared_size() {
+  return sizeof(DATALAYER_INFO_BOLTAMPERA) + sizeof(DATALAYER_INFO_BMWPHEV) + sizeof(DATALAYER_INFO_BMWIX) +
+         sizeof(DATALAYER_INFO_BYDATTO3) + sizeof(DATALAYER_INFO_CELLPOWER) + sizeof(DATALAYER_INFO_CHADEMO) +
+         sizeof(DATALAYER_INFO_CMFAEV) + sizeof(DATALAYER_INFO_CMPSMART) + sizeof(DATALAYER_INFO_ECMP) +
+         sizeof(DATALAYER_INFO_GEELY_GEOMETRY_C) + 2 * sizeof(DATALAYER_INFO_KIAHYUNDAI64) +
+         sizeof(DATALAYER_INFO_TESLA) + sizeof(DATALAYER_INFO_NISSAN_LEAF) + sizeof(DATALAYER_INFO_MEB) +
+         sizeof(DATALAYER_INFO_VOLVO_POLESTAR) + sizeof(DATALAYER_INFO_VOLVO_HYBRID) + sizeof(DATALAYER_INFO_ZOE) +
+         sizeof(DATALAYER_INFO_ZOE_PH2);
+}
@@ -1,6 +1,7 @@
 #ifndef _DATALAYER_EXTENDED_H_
 #define _DATALAYER_EXTENDED_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 struct DATALAYER_INFO_BOLTAMPERA {
@@ -922,27 +923,45 @@ struct DATALAYER_INFO_ZOE_PH2 {
   bool UserRequestNVROLReset = false;
 };
 
+enum class BatteryType;
+
+// Only one battery integration runs at a time, a second or third battery is always of the same type.
+// The battery specific structs therefore share their storage, and only the ones of the selected battery
+// type are constructed, by select(). The others must not be used. test/utils/datalayer_extended_report
+// estimates how much DRAM this saves per battery type, from the host layout of the structs.
 class DataLayerExtended {
  public:
-  DATALAYER_INFO_BOLTAMPERA boltampera;
-  DATALAYER_INFO_BMWPHEV bmwphev;
-  DATALAYER_INFO_BMWIX bmwix;
-  DATALAYER_INFO_BYDATTO3 bydAtto3;
-  DATALAYER_INFO_CELLPOWER cellpower;
-  DATALAYER_INFO_CHADEMO chademo;
-  DATALAYER_INFO_CMFAEV CMFAEV;
-  DATALAYER_INFO_CMPSMART stellantisCMPsmart;
-  DATALAYER_INFO_ECMP stellantisECMP;
-  DATALAYER_INFO_GEELY_GEOMETRY_C geometryC;
-  DATALAYER_INFO_KIAHYUNDAI64 KiaHyundai64;
-  DATALAYER_INFO_KIAHYUNDAI64 KiaHyundai64_2;
-  DATALAYER_INFO_TESLA tesla;
-  DATALAYER_INFO_NISSAN_LEAF nissanleaf;
-  DATALAYER_INFO_MEB meb;
-  DATALAYER_INFO_VOLVO_POLESTAR VolvoPolestar;
-  DATALAYER_INFO_VOLVO_HYBRID VolvoHybrid;
-  DATALAYER_INFO_ZOE zoe;
-  DATALAYER_INFO_ZOE_PH2 zoePH2;
+  DataLayerExtended() {}
+
+  // Constructs the structs the battery type uses, with their default values. Called by create_battery().
+  void select(BatteryType type);
+
+  // Bytes of the structs the battery type uses, 0 for batteries without extended values
+  static size_t size_for(BatteryType type);
+  // Bytes all structs would take if each had storage of its own
+  static size_t unshared_size();
+
+  union {
+    DATALAYER_INFO_BOLTAMPERA boltampera;
+    DATALAYER_INFO_BMWPHEV bmwphev;
+    DATALAYER_INFO_BMWIX bmwix;
+    DATALAYER_INFO_BYDATTO3 bydAtto3;
+    DATALAYER_INFO_CELLPOWER cellpower;
+    DATALAYER_INFO_CHADEMO chademo;
+    DATALAYER_INFO_CMFAEV CMFAEV;
+    DATALAYER_INFO_CMPSMART stellantisCMPsmart;
+    DATALAYER_INFO_ECMP stellantisECMP;
+    DATALAYER_INFO_GEELY_GEOMETRY_C geometryC;
+    // [1] is for the second battery
+    DATALAYER_INFO_KIAHYUNDAI64 KiaHyundai64[2];
+    DATALAYER_INFO_TESLA tesla;
+    DATALAYER_INFO_NISSAN_LEAF nissanleaf;
+    DATALAYER_INFO_MEB meb;
+    DATALAYER_INFO_VOLVO_POLESTAR VolvoPolestar;
+    DATALAYER_INFO_VOLVO_HYBRID VolvoHybrid;
+    DATALAYER_INFO_ZOE zoe;
+    DATALAYER_INFO_ZOE_PH2 zoePH2;
+  };
 };
 
 extern DataLayerExtended datalayer_extended;
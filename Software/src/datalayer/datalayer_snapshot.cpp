@@ -0,0 +1,69 @@
+#include "datalayer_snapshot.h"
+#include <stddef.h>
+#include <string.h>
+
+DataLayerSnapshot datalayer_snapshot;
+
+// Updates the snapshot in place, comparing against the previous copy first to find the groups that changed.
+// The structs are compared bytewise, padding included, so they are copied bytewise too: member-wise
+// assignment need not copy padding, and stale padding would count as a change on every publish.
+static void copy_battery(DATALAYER_BATTERY_SNAPSHOT& snapshot, const DATALAYER_BATTERY_TYPE& battery) {
+  const size_t values_size = offsetof(DATALAYER_BATTERY_STATUS_TYPE, cell_voltages_mV);
+  if (memcmp(&snapshot.info, &battery.info, sizeof(battery.info)) != 0 ||
+      memcmp(&snapshot.status, &battery.status, values_size) != 0) {
+    snapshot.generation[SNAPSHOT_VALUES]++;
+  }
+  if (memcmp(snapshot.status.cell_voltages_mV, battery.status.cell_voltages_mV,
+             sizeof(battery.status.cell_voltages_mV)) != 0) {
+    snapshot.generation[SNAPSHOT_CELL_VOLTAGES]++;
+  }
+  if (memcmp(snapshot.status.cell_balancing_status, battery.status.cell_balancing_status,
+             sizeof(battery.status.cell_balancing_status)) != 0) {
+    snapshot.generation[SNAPSHOT_CELL_BALANCING]++;
+  }
+  memcpy(&snapshot.info, &battery.info, sizeof(battery.info));
+  memcpy(&snapshot.status, &battery.status, sizeof(battery.status));
+}
+
+DataLayerSnapshot::~DataLayerSnapshot() {
+  for (auto& lock : more_batteries) {
+    delete lock.load();
+  }
+}
+
+void DataLayerSnapshot::publish(uint8_t battery_count) {
+  const DATALAYER_BATTERY_TYPE* batteries[] = {&datalayer.battery, &datalayer.battery2, &datalayer.battery3};
+
+  battery.write([](DATALAYER_BATTERY_SNAPSHOT& snapshot) { copy_battery(snapshot, datalayer.battery); });
+
+  for (uint8_t i = 1; i < battery_count && i < 3; i++) {
+    Seqlock<DATALAYER_BATTERY_SNAPSHOT>* lock = more_batteries[i - 1].load(std::memory_order_relaxed);
+    if (lock == nullptr) {
+      lock = new Seqlock<DATALAYER_BATTERY_SNAPSHOT>();
+      more_batteries[i - 1].store(lock, std::memory_order_release);
+    }
+    const DATALAYER_BATTERY_TYPE& source = *batteries[i];
+    lock->write([&source](DATALAYER_BATTERY_SNAPSHOT& snapshot) { copy_battery(snapshot, source); });
+  }
+
+  system.write([](DATALAYER_SYSTEM_STATUS_TYPE& status) { status = datalayer.system.status; });
+  publishes.fetch_add(1, std::memory_order_release);
+}
+
+bool DataLayerSnapshot::read_battery(uint8_t index, DATALAYER_BATTERY_SNAPSHOT& out) const {
+  const Seqlock<DATALAYER_BATTERY_SNAPSHOT>* lock = nullptr;
+  if (index == 0) {
+    lock = &battery;
+  } else if (index < 3) {
+    lock = more_batteries[index - 1].load(std::memory_order_acquire);
+  }
+  return lock != nullptr && lock->read(out);
+}
+
+std::unique_ptr<DATALAYER_BATTERY_SNAPSHOT> DataLayerSnapshot::read_battery(uint8_t index) const {
+  std::unique_ptr<DATALAYER_BATTERY_SNAPSHOT> snapshot(new DATALAYER_BATTERY_SNAPSHOT());
+  if (!read_battery(index, *snapshot)) {
+    return nullptr;
+  }
+  return snapshot;
+}
@@ -0,0 +1,94 @@
+#ifndef _DATALAYER_SNAPSHOT_H_
+#define _DATALAYER_SNAPSHOT_H_
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include "datalayer.h"
+
+// A value written by one task and read by others. The writer never waits: it marks the value as being
+// written by making the sequence number odd, copies, and makes it even again. Readers copy the value and
+// retry if the sequence number was odd or changed meanwhile, so they always get one coherent update.
+template <typename T>
+class Seqlock {
+ public:
+  // fill(T&) updates the value in place, so the writer needs no copy of its own
+  template <typename Fill>
+  void write(Fill fill) {
+    const uint32_t seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    fill(value);
+    sequence.store(seq + 2, std::memory_order_release);
+  }
+
+  // Copies the value to out. Returns false if it was never written.
+  bool read(T& out) const {
+    while (true) {
+      const uint32_t before = sequence.load(std::memory_order_acquire);
+      if (before == 0) {
+        return false;
+      }
+      if (before & 1) {
+        continue;
+      }
+      out = value;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence.load(std::memory_order_relaxed) == before) {
+        return true;
+      }
+    }
+  }
+
+ private:
+  std::atomic<uint32_t> sequence{0};
+  // Value-initialised, so padding starts out zero like that of the static datalayer
+  T value{};
+};
+
+// Parts of a battery snapshot that change independently, each with its own change generation
+enum SnapshotGroup : uint8_t {
+  SNAPSHOT_VALUES = 0,  // Info and everything in the status except the cells
+  SNAPSHOT_CELL_VOLTAGES = 1,
+  SNAPSHOT_CELL_BALANCING = 2,
+  SNAPSHOT_GROUP_COUNT
+};
+
+struct DATALAYER_BATTERY_SNAPSHOT {
+  DATALAYER_BATTERY_INFO_TYPE info;
+  DATALAYER_BATTERY_STATUS_TYPE status;
+  // Counts the publishes that changed a group, so readers can skip what they have already seen
+  uint32_t generation[SNAPSHOT_GROUP_COUNT] = {};
+};
+
+// Coherent copies of the battery and system status, published by the core task once per value update.
+// MQTT, the webserver and the display run on the other core and read these instead of the live datalayer,
+// so what they show never mixes values from before and after an update.
+class DataLayerSnapshot {
+ public:
+  ~DataLayerSnapshot();
+
+  // Copies the status of the first battery_count batteries and the system. Only the core task calls this.
+  void publish(uint8_t battery_count);
+
+  // A copy of battery 0-2, or nullptr if it has not been published yet. Kept on the heap, as the battery
+  // status with its cell voltages is too large for the stack of the reading task.
+  std::unique_ptr<DATALAYER_BATTERY_SNAPSHOT> read_battery(uint8_t index) const;
+  // Copies battery 0-2 to out, for readers that keep their own copy. Returns false if it was not published yet.
+  bool read_battery(uint8_t index, DATALAYER_BATTERY_SNAPSHOT& out) const;
+  // Returns false until the first publish
+  bool read_system(DATALAYER_SYSTEM_STATUS_TYPE& out) const { return system.read(out); }
+  // Counts the publishes, so readers can wait for the next one
+  uint32_t publish_count() const { return publishes.load(std::memory_order_acquire); }
+
+ private:
+  Seqlock<DATALAYER_BATTERY_SNAPSHOT> battery;
+  // Most installations have one battery, the others are allocated when they are first published
+  std::atomic<Seqlock<DATALAYER_BATTERY_SNAPSHOT>*> more_batteries[2] = {};
+  Seqlock<DATALAYER_SYSTEM_STATUS_TYPE> system;
+  std::atomic<uint32_t> publishes{0};
+};
+
+extern DataLayerSnapshot datalayer_snapshot;
+
+#endif
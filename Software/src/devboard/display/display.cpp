@@ -12,6 +12,7 @@ void update_display() {}
 
 #include "../../battery/BATTERIES.h"
 #include "../../datalayer/datalayer.h"
+#include "../../datalayer/datalayer_snapshot.h"
 #include "../hal/hal.h"
 #include "../utils/events.h"
 #include "../utils/logging.h"
@@ -290,7 +291,7 @@ static void cpy(char* dst, const char* src) {
   }
 }
 
-static void print_battery_status(int row, DATALAYER_BATTERY_STATUS_TYPE& status, int num, int page) {
+static void print_battery_status(int row, const DATALAYER_BATTERY_STATUS_TYPE& status, int num, int page) {
   char buf[22];
   memset(buf, ' ', sizeof(buf));
 
@@ -455,12 +456,9 @@ void update_display() {
   int page = (current_phase / num_batteries) % NUM_PAGES;
 
   // Print the battery status for current battery
-  if (battery_index == 0) {
-    print_battery_status(0, datalayer.battery.status, 1, page);
-  } else if (battery_index == 1) {
-    print_battery_status(0, datalayer.battery2.status, 2, page);
-  } else {
-    print_battery_status(0, datalayer.battery3.status, 3, page);
+  auto snapshot = datalayer_snapshot.read_battery(battery_index);
+  if (snapshot) {
+    print_battery_status(0, snapshot->status, battery_index + 1, page);
   }
 
   write_text(0, 2, "---------------------", false);
@@ -5,20 +5,33 @@
 #include <src/communication/nvm/comm_nvm.h>
 #include <list>
 #include "../../battery/BATTERIES.h"
+#include "../../communication/can/can_stats.h"
+#include "../../communication/can/comm_can.h"
 #include "../../communication/contactorcontrol/comm_contactorcontrol.h"
 #include "../../datalayer/datalayer.h"
+#include "../../datalayer/datalayer_snapshot.h"
 #include "../../devboard/hal/hal.h"
 #include "../../devboard/safety/safety.h"
 #include "../../lib/bblanchon-ArduinoJson/ArduinoJson.h"
+#include "../sdcard/sdcard.h"
 #include "../utils/events.h"
 #include "../utils/timer.h"
 #include "../webserver/webserver.h"
 #include "mqtt.h"
 #include "mqtt_client.h"
+#include "mqtt_delta.h"
+#include "mqtt_discovery.h"
+#include "mqtt_outbox.h"
+#include "mqtt_payload.h"
 
 bool mqtt_enabled = false;
 bool ha_autodiscovery_enabled = false;
 bool mqtt_transmit_all_cellvoltages = false;
+bool mqtt_transmit_can_stats = false;
+bool mqtt_delta_publishing = false;
+MqttCellFormat mqtt_cell_format = MQTT_CELLS_JSON;
+uint16_t mqtt_publish_rate = MqttOutbox::DEFAULT_RATE;
+bool mqtt_store_offline = false;
 uint16_t mqtt_timeout_ms = 2000;
 uint16_t mqtt_publish_interval_ms = 5000;
 
@@ -50,6 +63,14 @@ char mqtt_msg[MQTT_MSG_BUFFER_SIZE];
 MyTimer publish_global_timer(0);  // Will be configured with mqtt_publish_interval_ms on first use
 MyTimer check_global_timer(800);  // check timmer - low-priority MQTT checks, where responsiveness is not critical.
 bool client_started = false;
+// Set from the MQTT client task
+static volatile bool mqtt_connected = false;
+
+// Room for a few full sized messages. Producers wait up to OUTBOX_WAIT_MS for room while connected.
+static const size_t OUTBOX_SIZE = 4 * MQTT_MSG_BUFFER_SIZE;
+static const uint16_t OUTBOX_MESSAGES = 32;
+static const unsigned long OUTBOX_WAIT_MS = 2000;
+static MqttOutbox* outbox = nullptr;
 static String lwt_topic = "";
 
 static String topic_name = "";
@@ -57,43 +78,44 @@ static String object_id_prefix = "";
 static String device_name = "";
 static String device_id = "";
 
+// State topics, built once by init_mqtt() so publishing does not allocate
+static String info_topic = "";
+static String cell_voltages_topic[2];
+static String cell_balancing_topic[2];
+static String cell_data_topic[2];
+static String replay_topic = "";
+static String events_topic = "";
+
 static bool publish_common_info(void);
 static bool publish_cell_voltages(void);
 static bool publish_cell_balancing(void);
+static bool publish_cell_data(void);
 static bool publish_events(void);
+static bool publish_can_stats(void);
 
 /** Publish global values and call callbacks for specific modules */
 static void publish_values(void) {
+  // Everything goes through the outbox, so one part that cannot be queued does not hold up the others
 
-  if (mqtt_publish((topic_name + "/status").c_str(), "online", false) == false) {
-    return;
-  }
+  mqtt_publish(lwt_topic.c_str(), "online", false);
 
-  if (publish_events() == false) {
-    return;
-  }
+  publish_events();
 
-  if (publish_common_info() == false) {
-    return;
-  }
+  publish_common_info();
 
-  if (mqtt_transmit_all_cellvoltages) {
-    if (publish_cell_voltages() == false) {
-      return;
-    }
+  const bool binary_cells = mqtt_cell_format == MQTT_CELLS_BASE64 || mqtt_cell_format == MQTT_CELLS_BINARY;
+  if (mqtt_transmit_all_cellvoltages && binary_cells) {
+    publish_cell_data();
+  } else if (mqtt_transmit_all_cellvoltages) {
+    publish_cell_voltages();
+    publish_cell_balancing();
   }
 
-  if (mqtt_transmit_all_cellvoltages) {
-    if (publish_cell_balancing() == false) {
-      return;
-    }
+  if (mqtt_transmit_can_stats) {
+    publish_can_stats();
   }
 }
 
-static bool ha_common_info_published = false;
-static bool ha_cell_voltages_published = false;
-static bool ha_events_published = false;
-static bool ha_buttons_published = false;
 struct SensorConfig {
   const char* object_id;
   const char* name;
@@ -140,29 +162,12 @@ SensorConfig globalSensorConfigTemplate[] = {{"bms_status", "BMS Status", "", ""
                                              {"event_level", "Event Level", "", "", "", always},
                                              {"emulator_status", "Emulator Status", "", "", "", always}};
 
-static std::list<SensorConfig> sensorConfigs;
-
-void create_battery_sensor_configs() {
-  for (auto& config : batterySensorConfigTemplate) {
-    config.value_template = strdup(("{{ value_json." + std::string(config.object_id) + " }}").c_str());
-
-    sensorConfigs.push_back(config);
-
-    if (battery2) {
-      config.value_template = strdup(("{{ value_json." + std::string(config.object_id) + "_2 }}").c_str());
-      config.name = strdup(String(config.name + String(" 2")).c_str());
-      config.object_id = strdup(String(config.object_id + String("_2")).c_str());
-
-      sensorConfigs.push_back(config);
-    }
-  }
-}
-
-void create_global_sensor_configs() {
-  for (auto& config : globalSensorConfigTemplate) {
-    config.value_template = strdup(("{{ value_json." + std::string(config.object_id) + " }}").c_str());
-    sensorConfigs.push_back(config);
+// With delta publishing a message only holds the values that changed, the others keep their state
+static std::string value_template(const std::string& key) {
+  if (mqtt_delta_publishing) {
+    return "{{ value_json." + key + " | default(this.state) }}";
   }
+  return "{{ value_json." + key + " }}";
 }
 
 SensorConfig buttonConfigs[] = {{"BMSRESET", "Reset BMS", nullptr, nullptr, nullptr, nullptr},
@@ -207,364 +212,503 @@ void set_battery_voltage_attributes(JsonDocument& doc, int i, int cellNumber, co
   doc["state_class"] = "measurement";
   doc["state_topic"] = state_topic;
   doc["unit_of_measurement"] = "V";
-  doc["value_template"] = "{{ value_json.cell_voltages[" + String(i) + "] }}";
+  if (mqtt_cell_format == MQTT_CELLS_COMPACT_JSON) {
+    doc["value_template"] = "{{ (value_json.cell_base_mV + value_json.cell_delta_mV[" + String(i) + "]) / 1000 }}";
+  } else {
+    doc["value_template"] = "{{ value_json.cell_voltages[" + String(i) + "] }}";
+  }
 }
 
 static String generateButtonTopic(const char* subtype) {
   return topic_name + "/command/" + String(subtype);
 }
 
-static const char* get_balancing_status_text(balancing_status_enum status) {
-  switch (status) {
-    case BALANCING_STATUS_UNKNOWN:
-      return "Unknown";
-    case BALANCING_STATUS_ERROR:
-      return "Error";
-    case BALANCING_STATUS_READY:
-      return "Ready";
-    case BALANCING_STATUS_ACTIVE:
-      return "Active";
-    default:
-      return "Unknown";
-  }
-}
-
-void set_battery_attributes(JsonDocument& doc, const DATALAYER_BATTERY_TYPE& battery, const String& suffix,
-                            bool supports_charged) {
-  doc["SOC" + suffix] = ((float)battery.status.reported_soc) / 100.0f;
-  doc["SOC_real" + suffix] = ((float)battery.status.real_soc) / 100.0f;
-  doc["state_of_health" + suffix] = ((float)battery.status.soh_pptt) / 100.0f;
-  doc["temperature_min" + suffix] = ((float)((int16_t)battery.status.temperature_min_dC)) / 10.0f;
-  doc["temperature_max" + suffix] = ((float)((int16_t)battery.status.temperature_max_dC)) / 10.0f;
-  doc["cpu_temp" + suffix] = datalayer.system.info.CPU_temperature;
-  doc["stat_batt_power" + suffix] = ((float)((int32_t)battery.status.active_power_W));
-  doc["battery_current" + suffix] = ((float)((int16_t)battery.status.current_dA)) / 10.0f;
-  doc["battery_voltage" + suffix] = ((float)battery.status.voltage_dV) / 10.0f;
-  if (battery.info.number_of_cells != 0u && battery.status.cell_voltages_mV[battery.info.number_of_cells - 1] != 0u) {
-    doc["cell_max_voltage" + suffix] = ((float)battery.status.cell_max_voltage_mV) / 1000.0f;
-    doc["cell_min_voltage" + suffix] = ((float)battery.status.cell_min_voltage_mV) / 1000.0f;
-    doc["cell_voltage_delta" + suffix] =
-        ((float)battery.status.cell_max_voltage_mV) - ((float)battery.status.cell_min_voltage_mV);
-  }
-  doc["total_capacity" + suffix] = ((float)battery.info.total_capacity_Wh);
-  doc["remaining_capacity_real" + suffix] = ((float)battery.status.remaining_capacity_Wh);
-  doc["remaining_capacity" + suffix] = ((float)battery.status.reported_remaining_capacity_Wh);
-  doc["max_discharge_power" + suffix] = ((float)battery.status.max_discharge_power_W);
-  doc["max_charge_power" + suffix] = ((float)battery.status.max_charge_power_W);
-
-  if (supports_charged) {
-    if (datalayer.battery.status.total_charged_battery_Wh != 0 &&
-        datalayer.battery.status.total_discharged_battery_Wh != 0) {
-      doc["charged_energy" + suffix] = ((float)datalayer.battery.status.total_charged_battery_Wh);
-      doc["discharged_energy" + suffix] = ((float)datalayer.battery.status.total_discharged_battery_Wh);
-    }
-  }
-
-  // Add balancing data
-  uint16_t active_cells = 0;
-  if (battery.info.number_of_cells != 0u) {
-    for (size_t i = 0; i < battery.info.number_of_cells; ++i) {
-      if (battery.status.cell_balancing_status[i]) {
-        active_cells++;
-      }
+// Discovery entries, always in this order so that their hashes stay valid across restarts
+static const uint16_t BATTERY_SENSOR_COUNT = sizeof(batterySensorConfigTemplate) / sizeof(SensorConfig);
+static const uint16_t GLOBAL_SENSOR_COUNT = sizeof(globalSensorConfigTemplate) / sizeof(SensorConfig);
+static const uint16_t BUTTON_COUNT = sizeof(buttonConfigs) / sizeof(SensorConfig);
+static const uint16_t DISCOVERY_GLOBAL_SENSORS = 2 * BATTERY_SENSOR_COUNT;
+static const uint16_t DISCOVERY_EVENT = DISCOVERY_GLOBAL_SENSORS + GLOBAL_SENSOR_COUNT;
+static const uint16_t DISCOVERY_BUTTONS = DISCOVERY_EVENT + 1;
+static const uint16_t DISCOVERY_CELLS = DISCOVERY_BUTTONS + BUTTON_COUNT;
+static const uint16_t DISCOVERY_ENTRIES = DISCOVERY_CELLS + 2 * MAX_AMOUNT_CELLS;
+// Entries built per call of publish_discovery(), at most one of them is published
+static const uint8_t DISCOVERY_CHECKS_PER_LOOP = 8;
+
+static DiscoveryCache* discovery = nullptr;  // Allocated when autodiscovery is enabled
+// Hash of everything the entries are built from. A new pass starts when it changes.
+static uint32_t discovery_config = 0;
+static uint32_t saved_discovery_config = 0;
+// Set when a pass had to leave out cells whose number is not known yet
+static bool discovery_incomplete = false;
+// Set from the MQTT client task when Home Assistant comes online
+static volatile bool discovery_requested = false;
+
+enum DiscoveryEntryState { DISCOVERY_IN_USE, DISCOVERY_NOT_USED, DISCOVERY_NOT_KNOWN_YET };
+
+// Builds entry index into mqtt_msg. Entries not used with this configuration have a topic but no payload.
+static DiscoveryEntryState build_discovery_entry(uint16_t index, String& topic) {
+  static JsonDocument doc;
+  doc.clear();
+
+  if (index < DISCOVERY_EVENT) {
+    // Sensors of the info topic, those of the second battery have keys ending in _2
+    const bool global = index >= DISCOVERY_GLOBAL_SENSORS;
+    const bool second = !global && index >= BATTERY_SENSOR_COUNT;
+    const SensorConfig& config = global ? globalSensorConfigTemplate[index - DISCOVERY_GLOBAL_SENSORS]
+                                        : batterySensorConfigTemplate[index % BATTERY_SENSOR_COUNT];
+    Battery* owner = second ? battery2 : battery;
+    const String object_id = String(config.object_id) + (second ? "_2" : "");
+    topic = generateCommonInfoAutoConfigTopic(object_id.c_str());
+    if (!global && (owner == nullptr || !config.condition(owner))) {
+      return DISCOVERY_NOT_USED;
+    }
+
+    doc["name"] = String(config.name) + (second ? " 2" : "");
+    doc["state_topic"] = info_topic;
+    doc["unique_id"] = topic_name + "_" + object_id;
+    doc["object_id"] = object_id_prefix + object_id;
+    doc["value_template"] = value_template(object_id.c_str());
+    if (config.unit != nullptr && strlen(config.unit) > 0) {
+      doc["unit_of_measurement"] = config.unit;
+    }
+    if (config.device_class != nullptr && strlen(config.device_class) > 0) {
+      doc["device_class"] = config.device_class;
+      doc["state_class"] = "measurement";
+    }
+  } else if (index == DISCOVERY_EVENT) {
+    topic = generateEventsAutoConfigTopic("event");
+    doc["name"] = "Event";
+    doc["state_topic"] = events_topic;
+    doc["unique_id"] = topic_name + "_event";
+    doc["object_id"] = object_id_prefix + "event";
+    doc["value_template"] =
+        "{{ value_json.event_type ~ ' (c:' ~ value_json.count ~ ',m:' ~  value_json.millis ~ ') ' ~ value_json.message "
+        "}}";
+    doc["json_attributes_topic"] = events_topic;
+    doc["json_attributes_template"] = "{{ value_json | tojson }}";
+  } else if (index < DISCOVERY_CELLS) {
+    const SensorConfig& config = buttonConfigs[index - DISCOVERY_BUTTONS];
+    topic = generateButtonAutoConfigTopic(config.object_id);
+    doc["name"] = config.name;
+    doc["unique_id"] = object_id_prefix + config.object_id;
+    doc["command_topic"] = generateButtonTopic(config.object_id);
+  } else {
+    const bool second = index >= DISCOVERY_CELLS + MAX_AMOUNT_CELLS;
+    const int i = (index - DISCOVERY_CELLS) % MAX_AMOUNT_CELLS;
+    const uint16_t cells = second ? datalayer.battery2.info.number_of_cells : datalayer.battery.info.number_of_cells;
+    topic = generateCellVoltageAutoConfigTopic(i + 1, second ? "_2_" : "");
+    // Home Assistant cannot decode the binary cell data
+    if (!mqtt_transmit_all_cellvoltages || mqtt_cell_format == MQTT_CELLS_BASE64 ||
+        mqtt_cell_format == MQTT_CELLS_BINARY || (second && battery2 == nullptr)) {
+      return DISCOVERY_NOT_USED;
+    }
+    if (cells == 0) {
+      return DISCOVERY_NOT_KNOWN_YET;
+    }
+    if (i >= cells) {
+      return DISCOVERY_NOT_USED;
     }
+    set_battery_voltage_attributes(doc, i, i + 1, cell_voltages_topic[second ? 1 : 0],
+                                   second ? object_id_prefix + "2_" : object_id_prefix, second ? " 2" : "");
   }
-  doc["balancing_active_cells" + suffix] = active_cells;
-  doc["balancing_status" + suffix] = get_balancing_status_text(battery.status.balancing_status);
+
+  set_common_discovery_attributes(doc);
+  serializeJson(doc, mqtt_msg, sizeof(mqtt_msg));
+  return DISCOVERY_IN_USE;
 }
 
-static std::vector<EventData> order_events;
+static uint32_t discovery_fingerprint(void) {
+  char settings[96];
+  snprintf(settings, sizeof(settings), "%d %d %d %d %d %d %u %u",
+           battery != nullptr && battery->supports_charged_energy(), battery2 != nullptr,
+           battery2 != nullptr && battery2->supports_charged_energy(), mqtt_delta_publishing, mqtt_cell_format,
+           mqtt_transmit_all_cellvoltages, datalayer.battery.info.number_of_cells,
+           datalayer.battery2.info.number_of_cells);
+  uint32_t hash = DiscoveryCache::hash(version_number);
+  hash = DiscoveryCache::hash(topic_name.c_str(), hash);
+  hash = DiscoveryCache::hash(object_id_prefix.c_str(), hash);
+  hash = DiscoveryCache::hash(device_name.c_str(), hash);
+  hash = DiscoveryCache::hash(device_id.c_str(), hash);
+  return DiscoveryCache::hash(settings, hash);
+}
 
-static bool publish_common_info(void) {
-  static JsonDocument doc;
-  static String state_topic = topic_name + "/info";
+static void load_discovery_cache(void) {
+  Preferences preferences;
+  if (!preferences.begin("haDiscovery", true)) {
+    return;
+  }
+  if (preferences.getBytesLength("hashes") == discovery->size()) {
+    preferences.getBytes("hashes", (void*)discovery->data(), discovery->size());
+    saved_discovery_config = preferences.getUInt("config", 0);
+    discovery_config = saved_discovery_config;
+  }
+  preferences.end();
+}
 
-  //  if(ha_autodiscovery_enabled) {
+static void save_discovery_cache(void) {
+  Preferences preferences;
+  if (!preferences.begin("haDiscovery", false)) {
+    return;
+  }
+  preferences.putBytes("hashes", discovery->data(), discovery->size());
+  preferences.putUInt("config", discovery_config);
+  preferences.end();
+  discovery->saved();
+  saved_discovery_config = discovery_config;
+}
 
-  if (ha_autodiscovery_enabled && !ha_common_info_published) {
-    for (auto& config : sensorConfigs) {
-      if (!config.condition(battery)) {
-        continue;
-      }
+// Publishes the discovery entries that changed since they were last published, also across restarts.
+// At most one per call and only while no other message waits, so the state topics are not held up behind
+// hundreds of retained configs. The hashes are saved once a pass is through.
+static void publish_discovery(void) {
+  if (discovery == nullptr) {
+    return;
+  }
+  if (discovery_requested) {
+    discovery_requested = false;
+    discovery->forget();
+    discovery->begin_pass();
+    discovery_incomplete = false;
+  }
+  const uint32_t config = discovery_fingerprint();
+  if (config != discovery_config) {
+    discovery_config = config;
+    discovery->begin_pass();
+    discovery_incomplete = false;
+  }
+  if (!discovery->pass_active() || outbox->size() > 0) {
+    return;
+  }
 
-      doc["name"] = config.name;
-      doc["state_topic"] = state_topic;
-      doc["unique_id"] = topic_name + "_" + String(config.object_id);
-      doc["object_id"] = object_id_prefix + String(config.object_id);
-      doc["value_template"] = config.value_template;
-      if (config.unit != nullptr && strlen(config.unit) > 0) {
-        doc["unit_of_measurement"] = config.unit;
-      }
-      if (config.device_class != nullptr && strlen(config.device_class) > 0) {
-        doc["device_class"] = config.device_class;
-        doc["state_class"] = "measurement";
-      }
-      set_common_discovery_attributes(doc);
-      serializeJson(doc, mqtt_msg);
-      if (mqtt_publish(generateCommonInfoAutoConfigTopic(config.object_id).c_str(), mqtt_msg, true)) {
-        ha_common_info_published = true;
-      } else {
-        return false;
-      }
-      doc.clear();
+  String topic;
+  for (uint8_t checked = 0; checked < DISCOVERY_CHECKS_PER_LOOP && discovery->pass_active(); checked++) {
+    const DiscoveryEntryState state = build_discovery_entry(discovery->position(), topic);
+    if (state == DISCOVERY_NOT_KNOWN_YET) {
+      // Left as it is, until the number of cells is known
+      discovery_incomplete = true;
+      discovery->advance(discovery->data()[discovery->position()]);
+      continue;
     }
-
-  } else {
-    doc["bms_status"] = getBMSStatus(datalayer.battery.status.bms_status);
-    doc["pause_status"] = get_emulator_pause_status();
-
-    //only publish these values if BMS is active and we are comunication  with the battery (can send CAN messages to the battery)
-    if (datalayer.battery.status.CAN_battery_still_alive && allowed_to_send_CAN && esp32hal->system_booted_up()) {
-      set_battery_attributes(doc, datalayer.battery, "", battery->supports_charged_energy());
+    const uint32_t hash = state == DISCOVERY_IN_USE ? DiscoveryCache::hash(topic.c_str(), mqtt_msg) : 0;
+    if (!discovery->changed(hash)) {
+      discovery->advance(hash);
+      continue;
     }
-
-    if (battery2) {
-      //only publish these values if BMS is active and we are comunication  with the battery (can send CAN messages to the battery)
-      if (datalayer.battery2.status.CAN_battery_still_alive && allowed_to_send_CAN && esp32hal->system_booted_up()) {
-        set_battery_attributes(doc, datalayer.battery2, "_2", battery2->supports_charged_energy());
-      }
+    // An empty retained config removes the entity from Home Assistant
+    if (!mqtt_publish(topic.c_str(), state == DISCOVERY_IN_USE ? mqtt_msg : "", true)) {
+      return;
     }
+    discovery->advance(hash);
+    break;
+  }
 
-    doc["event_level"] = get_event_level_string(get_event_level());
-    doc["emulator_status"] = get_emulator_status_string(get_emulator_status());
-
-    serializeJson(doc, mqtt_msg);
-    if (mqtt_publish(state_topic.c_str(), mqtt_msg, false) == false) {
-      logging.println("Common info MQTT msg could not be sent");
-      return false;
-    }
-    doc.clear();
+  if (!discovery->pass_active() &&
+      (discovery->modified() || (!discovery_incomplete && discovery_config != saved_discovery_config))) {
+    save_discovery_cache();
   }
-  return true;
 }
 
-static bool publish_cell_voltages(void) {
-  static JsonDocument doc;
-  static String state_topic = topic_name + "/spec_data";
-  static String state_topic_2 = topic_name + "/spec_data_2";
+static float info_published[INFO_FIELD_COUNT];
+static MqttDeltaTracker info_delta(info_published, INFO_FIELD_COUNT);
 
-  if (ha_autodiscovery_enabled) {
-    bool successfully_published = false;
-    if (ha_cell_voltages_published == false) {
+// The battery being published. Too large for the stack of the MQTT task, and kept here instead of on the heap.
+static DATALAYER_BATTERY_SNAPSHOT battery_snapshot;
 
-      // If the cell voltage number isn't initialized...
-      if (datalayer.battery.info.number_of_cells != 0u) {
+static std::vector<EventData> order_events;
 
-        for (int i = 0; i < datalayer.battery.info.number_of_cells; i++) {
-          int cellNumber = i + 1;
-          set_battery_voltage_attributes(doc, i, cellNumber, state_topic, object_id_prefix, "");
-          set_common_discovery_attributes(doc);
+static bool publish_common_info(void) {
+  if (!datalayer_snapshot.read_battery(0, battery_snapshot)) {
+    return true;  // Nothing published by the core task yet
+  }
 
-          serializeJson(doc, mqtt_msg, sizeof(mqtt_msg));
-          if (mqtt_publish(generateCellVoltageAutoConfigTopic(cellNumber, "").c_str(), mqtt_msg, true) == false) {
-            return false;
-          }
-        }
-        successfully_published = true;
-        doc.clear();  // clear after sending autoconfig
-      }
+  MqttDeltaTracker* delta = nullptr;
+  if (mqtt_delta_publishing) {
+    delta = &info_delta;
+    delta->begin(millis());
+  }
 
-      if (battery2) {
-        successfully_published = false;
-        // TODO: Combine this identical block with the previous one.
-        // If the cell voltage number isn't initialized...
-        if (datalayer.battery2.info.number_of_cells != 0u) {
-
-          for (int i = 0; i < datalayer.battery2.info.number_of_cells; i++) {
-            int cellNumber = i + 1;
-            set_battery_voltage_attributes(doc, i, cellNumber, state_topic_2, object_id_prefix + "2_", " 2");
-            set_common_discovery_attributes(doc);
-
-            serializeJson(doc, mqtt_msg, sizeof(mqtt_msg));
-            if (mqtt_publish(generateCellVoltageAutoConfigTopic(cellNumber, "_2_").c_str(), mqtt_msg, true) == false) {
-              return false;
-            }
-          }
-          successfully_published = true;
-          doc.clear();  // clear after sending autoconfig
-        }
-      }
-    }
-    if (successfully_published) {
-      ha_cell_voltages_published = true;
+  MqttPayloadWriter writer(mqtt_msg, sizeof(mqtt_msg));
+  writer.begin_object();
+  write_info_text(writer, delta, "bms_status", INFO_BMS_STATUS, battery_snapshot.status.bms_status,
+                  getBMSStatus(battery_snapshot.status.bms_status));
+  write_info_text(writer, delta, "pause_status", INFO_PAUSE_STATUS, emulator_pause_status,
+                  get_emulator_pause_status());
+
+  //only publish these values if BMS is active and we are comunication  with the battery (can send CAN messages to the battery)
+  if (battery_snapshot.status.CAN_battery_still_alive && allowed_to_send_CAN && esp32hal->system_booted_up()) {
+    write_battery_info(writer, delta, battery_snapshot, "", 0, battery->supports_charged_energy());
+  }
+
+  if (battery2) {
+    //only publish these values if BMS is active and we are comunication  with the battery (can send CAN messages to the battery)
+    if (datalayer_snapshot.read_battery(1, battery_snapshot) && battery_snapshot.status.CAN_battery_still_alive &&
+        allowed_to_send_CAN && esp32hal->system_booted_up()) {
+      write_battery_info(writer, delta, battery_snapshot, "_2", INFO_BATTERY_FIELD_COUNT,
+                         battery2->supports_charged_energy());
     }
   }
 
-  // If cell voltages have been populated...
-  if (datalayer.battery.info.number_of_cells != 0u &&
-      datalayer.battery.status.cell_voltages_mV[datalayer.battery.info.number_of_cells - 1] != 0u) {
+  write_info_text(writer, delta, "event_level", INFO_EVENT_LEVEL, get_event_level(),
+                  get_event_level_string(get_event_level()));
+  write_info_text(writer, delta, "emulator_status", INFO_EMULATOR_STATUS, get_emulator_status(),
+                  get_emulator_status_string(get_emulator_status()));
 
-    JsonArray cell_voltages = doc["cell_voltages"].to<JsonArray>();
-    for (size_t i = 0; i < datalayer.battery.info.number_of_cells; ++i) {
-      cell_voltages.add(((float)datalayer.battery.status.cell_voltages_mV[i]) / 1000.0f);
-    }
+  if (writer.empty()) {
+    return true;  // Nothing changed since the last delta
+  }
+  writer.end_object();
 
-    serializeJson(doc, mqtt_msg, sizeof(mqtt_msg));
+  if (writer.overflowed()) {
+    logging.println("Common info MQTT msg does not fit the buffer");
+    return true;
+  }
+  // A delta only holds what changed, none of them may be replaced by the next
+  const MqttMessageKind kind = mqtt_delta_publishing ? MQTT_MESSAGE_DELTA : MQTT_MESSAGE_STATE;
+  if (mqtt_publish(info_topic.c_str(), mqtt_msg, false, kind) == false) {
+    logging.println("Common info MQTT msg could not be sent");
+    info_delta.invalidate();
+    return false;
+  }
+  return true;
+}
 
-    if (!mqtt_publish(state_topic.c_str(), mqtt_msg, false)) {
-      logging.println("Cell voltage MQTT msg could not be sent");
-      return false;
-    }
-    doc.clear();
+// What was last published of the cells of a battery, for delta publishing
+struct PublishedCells {
+  uint32_t voltages_generation;
+  uint32_t balancing_generation;
+  uint16_t voltages_mV[MAX_AMOUNT_CELLS];
+};
+static PublishedCells* published_cells[2];  // Allocated when delta publishing first uses them
+
+static PublishedCells& get_published_cells(uint8_t index) {
+  if (published_cells[index] == nullptr) {
+    published_cells[index] = new PublishedCells();
   }
+  return *published_cells[index];
+}
 
-  if (battery2) {
-    // If cell voltages have been populated...
-    if (datalayer.battery2.info.number_of_cells != 0u &&
-        datalayer.battery2.status.cell_voltages_mV[datalayer.battery2.info.number_of_cells - 1] != 0u) {
+// With delta publishing, cell voltages are only sent again once a cell moved by more than the deadband
+static bool cell_voltages_due(uint8_t index, const DATALAYER_BATTERY_SNAPSHOT& snapshot) {
+  if (!mqtt_delta_publishing) {
+    return true;
+  }
+  PublishedCells& published = get_published_cells(index);
+  const uint32_t generation = snapshot.generation[SNAPSHOT_CELL_VOLTAGES];
+  if (info_delta.refreshing()) {
+    published.voltages_generation = generation;
+    memcpy(published.voltages_mV, snapshot.status.cell_voltages_mV, sizeof(published.voltages_mV));
+    return true;
+  }
+  if (generation == published.voltages_generation) {
+    return false;
+  }
+  published.voltages_generation = generation;
+  return cell_voltages_changed(snapshot.status.cell_voltages_mV, published.voltages_mV, snapshot.info.number_of_cells,
+                               CELL_VOLTAGE_DEADBAND_MV);
+}
 
-      JsonArray cell_voltages = doc["cell_voltages"].to<JsonArray>();
-      for (size_t i = 0; i < datalayer.battery2.info.number_of_cells; ++i) {
-        cell_voltages.add(((float)datalayer.battery2.status.cell_voltages_mV[i]) / 1000.0f);
-      }
+// With delta publishing, the balancing state is only sent again when it changed
+static bool cell_balancing_due(uint8_t index, const DATALAYER_BATTERY_SNAPSHOT& snapshot) {
+  if (!mqtt_delta_publishing) {
+    return true;
+  }
+  PublishedCells& published = get_published_cells(index);
+  const uint32_t generation = snapshot.generation[SNAPSHOT_CELL_BALANCING];
+  if (!info_delta.refreshing() && generation == published.balancing_generation) {
+    return false;
+  }
+  published.balancing_generation = generation;
+  return true;
+}
 
-      serializeJson(doc, mqtt_msg, sizeof(mqtt_msg));
+static bool publish_cell_voltages(void) {
+  for (uint8_t i = 0; i < (battery2 ? 2 : 1); i++) {
+    // If cell voltages have been populated...
+    if (!datalayer_snapshot.read_battery(i, battery_snapshot) || battery_snapshot.info.number_of_cells == 0u ||
+        battery_snapshot.status.cell_voltages_mV[battery_snapshot.info.number_of_cells - 1] == 0u ||
+        !cell_voltages_due(i, battery_snapshot)) {
+      continue;
+    }
 
-      if (!mqtt_publish(state_topic_2.c_str(), mqtt_msg, false)) {
-        logging.println("Cell voltage MQTT msg could not be sent");
-        return false;
-      }
-      doc.clear();
+    MqttPayloadWriter writer(mqtt_msg, sizeof(mqtt_msg));
+    if (mqtt_cell_format == MQTT_CELLS_COMPACT_JSON) {
+      write_cell_voltages_compact(writer, battery_snapshot);
+    } else {
+      write_cell_voltages(writer, battery_snapshot);
+    }
+    if (writer.overflowed()) {
+      logging.println("Cell voltage MQTT msg does not fit the buffer");
+      continue;
+    }
+    if (!mqtt_publish(cell_voltages_topic[i].c_str(), mqtt_msg, false, MQTT_MESSAGE_STATE)) {
+      logging.println("Cell voltage MQTT msg could not be sent");
+      info_delta.invalidate();
+      return false;
     }
   }
   return true;
 }
 
 static bool publish_cell_balancing(void) {
-  static JsonDocument doc;
-  static String state_topic = topic_name + "/balancing_data";
-  static String state_topic_2 = topic_name + "/balancing_data_2";
-
-  // If cell balancing data is available...
-  if (datalayer.battery.info.number_of_cells != 0u) {
+  for (uint8_t i = 0; i < (battery2 ? 2 : 1); i++) {
+    // If cell balancing data is available...
+    if (!datalayer_snapshot.read_battery(i, battery_snapshot) || battery_snapshot.info.number_of_cells == 0u ||
+        !cell_balancing_due(i, battery_snapshot)) {
+      continue;
+    }
 
-    JsonArray cell_balancing = doc["cell_balancing"].to<JsonArray>();
-    for (size_t i = 0; i < datalayer.battery.info.number_of_cells; ++i) {
-      cell_balancing.add(datalayer.battery.status.cell_balancing_status[i]);
+    MqttPayloadWriter writer(mqtt_msg, sizeof(mqtt_msg));
+    if (mqtt_cell_format == MQTT_CELLS_COMPACT_JSON) {
+      write_cell_balancing_compact(writer, battery_snapshot);
+    } else {
+      write_cell_balancing(writer, battery_snapshot);
+    }
+    if (writer.overflowed()) {
+      logging.println("Cell balancing MQTT msg does not fit the buffer");
+      continue;
+    }
+    if (!mqtt_publish(cell_balancing_topic[i].c_str(), mqtt_msg, false, MQTT_MESSAGE_STATE)) {
+      logging.println("Cell balancing MQTT msg could not be sent");
+      info_delta.invalidate();
+      return false;
     }
+  }
+  return true;
+}
 
-    serializeJson(doc, mqtt_msg, sizeof(mqtt_msg));
+// Cell voltages and balancing together in one binary message per battery. Home Assistant cannot decode
+// these, so no discovery is published for the cells.
+static bool publish_cell_data(void) {
+  static uint8_t cell_data[CELL_DATA_MAX_SIZE];
 
-    if (!mqtt_publish(state_topic.c_str(), mqtt_msg, false)) {
-      logging.println("Cell balancing MQTT msg could not be sent");
+  for (uint8_t i = 0; i < (battery2 ? 2 : 1); i++) {
+    // If cell voltages have been populated...
+    if (!datalayer_snapshot.read_battery(i, battery_snapshot) || battery_snapshot.info.number_of_cells == 0u ||
+        battery_snapshot.status.cell_voltages_mV[battery_snapshot.info.number_of_cells - 1] == 0u) {
+      continue;
+    }
+    // Both checks run, so each keeps track of what was published
+    const bool voltages_due = cell_voltages_due(i, battery_snapshot);
+    if (!cell_balancing_due(i, battery_snapshot) && !voltages_due) {
+      continue;
+    }
+
+    const size_t length = encode_cell_data(battery_snapshot, cell_data, sizeof(cell_data));
+    bool sent;
+    if (mqtt_cell_format == MQTT_CELLS_BINARY) {
+      sent = mqtt_publish(cell_data_topic[i].c_str(), cell_data, length, false);
+    } else {
+      encode_base64(cell_data, length, mqtt_msg, sizeof(mqtt_msg));
+      sent = mqtt_publish(cell_data_topic[i].c_str(), mqtt_msg, false, MQTT_MESSAGE_STATE);
+    }
+    if (!sent) {
+      logging.println("Cell data MQTT msg could not be sent");
+      info_delta.invalidate();
       return false;
     }
-    doc.clear();
   }
+  return true;
+}
 
-  // Handle second battery if available
-  if (battery2) {
-    if (datalayer.battery2.info.number_of_cells != 0u) {
+// One message per CAN interface in use, split further if its IDs do not fit. IDs are listed as
+// [id, direction (0 = RX, 1 = TX), frames, rate Hz, min ms, mean ms, max ms between frames].
+static bool publish_can_stats(void) {
+  static JsonDocument doc;
+  static String state_topic = topic_name + "/can_stats";
+  std::unique_ptr<CanTrafficStats> copy(new CanTrafficStats());
+  read_can_traffic_stats(*copy);
+  const CanTrafficStats& stats = *copy;
+
+  for (uint8_t i = 0; i < NO_CAN_INTERFACE; i++) {
+    const CAN_Interface interface = (CAN_Interface)i;
+    if (stats.bit_rate(interface) == 0) {
+      continue;
+    }
 
-      JsonArray cell_balancing = doc["cell_balancing"].to<JsonArray>();
-      for (size_t i = 0; i < datalayer.battery2.info.number_of_cells; ++i) {
-        cell_balancing.add(datalayer.battery2.status.cell_balancing_status[i]);
+    uint16_t index = 0;
+    do {
+      doc["interface"] = getCANInterfaceName(interface);
+      doc["bit_rate"] = stats.bit_rate(interface);
+      doc["bus_load"] = stats.bus_load_percent(interface);
+      JsonArray ids = doc["ids"].to<JsonArray>();
+
+      // Leave room for one more ID, about 60 characters
+      for (; index < CanTrafficStats::TABLE_SIZE && measureJson(doc) < sizeof(mqtt_msg) - 64; index++) {
+        const CanTrafficStats::Entry& entry = stats.entry(index);
+        if (!entry.used || entry.interface != interface) {
+          continue;
+        }
+        JsonArray row = ids.add<JsonArray>();
+        row.add(entry.id);
+        row.add(entry.direction);
+        row.add(entry.count);
+        row.add(entry.rate_hz);
+        row.add(entry.min_gap_us / 1000.0f);
+        row.add(entry.mean_gap_us() / 1000.0f);
+        row.add(entry.max_gap_us / 1000.0f);
       }
 
       serializeJson(doc, mqtt_msg, sizeof(mqtt_msg));
-
-      if (!mqtt_publish(state_topic_2.c_str(), mqtt_msg, false)) {
-        logging.println("Cell balancing MQTT msg could not be sent");
+      doc.clear();
+      // Each interface has its own message on the same topic
+      if (!mqtt_publish(state_topic.c_str(), mqtt_msg, false, MQTT_MESSAGE_EVENT)) {
+        logging.println("CAN stats MQTT msg could not be sent");
         return false;
       }
-      doc.clear();
-    }
+    } while (index < CanTrafficStats::TABLE_SIZE);
   }
   return true;
 }
 
 bool publish_events() {
   static JsonDocument doc;
-  static String state_topic = topic_name + "/events";
-  if (ha_autodiscovery_enabled && !ha_events_published) {
+  const EVENTS_STRUCT_TYPE* event_pointer;
+
+  //clear the vector
+  order_events.clear();
+  // Collect all events
+  for (int i = 0; i < EVENT_NOF_EVENTS; i++) {
+    event_pointer = get_event_pointer((EVENTS_ENUM_TYPE)i);
+    if (event_pointer->occurences > 0 && !event_pointer->MQTTpublished) {
+      order_events.push_back({static_cast<EVENTS_ENUM_TYPE>(i), event_pointer});
+    }
+  }
+  // Sort events by timestamp
+  std::sort(order_events.begin(), order_events.end(), compareEventsByTimestampAsc);
+
+  for (const auto& event : order_events) {
+
+    EVENTS_ENUM_TYPE event_handle = event.event_handle;
+    event_pointer = event.event_pointer;
+
+    doc["event_type"] = String(get_event_enum_string(event_handle));
+    doc["severity"] = String(get_event_level_string(event_handle));
+    doc["count"] = String(event_pointer->occurences);
+    doc["data"] = String(event_pointer->data);
+    doc["message"] = get_event_message_string(event_handle);
+    doc["millis"] = String(event_pointer->timestamp);
 
-    doc["name"] = "Event";
-    doc["state_topic"] = state_topic;
-    doc["unique_id"] = topic_name + "_event";
-    doc["object_id"] = object_id_prefix + "event";
-    doc["value_template"] =
-        "{{ value_json.event_type ~ ' (c:' ~ value_json.count ~ ',m:' ~  value_json.millis ~ ') ' ~ value_json.message "
-        "}}";
-    doc["json_attributes_topic"] = state_topic;
-    doc["json_attributes_template"] = "{{ value_json | tojson }}";
-    set_common_discovery_attributes(doc);
     serializeJson(doc, mqtt_msg);
-    if (mqtt_publish(generateEventsAutoConfigTopic("event").c_str(), mqtt_msg, true)) {
-      ha_events_published = true;
-    } else {
+    if (!mqtt_publish(events_topic.c_str(), mqtt_msg, false, MQTT_MESSAGE_EVENT)) {
+      logging.println("Common info MQTT msg could not be sent");
       return false;
+    } else {
+      set_event_MQTTpublished(event_handle);
     }
-
     doc.clear();
-  } else {
-    const EVENTS_STRUCT_TYPE* event_pointer;
-
     //clear the vector
     order_events.clear();
-    // Collect all events
-    for (int i = 0; i < EVENT_NOF_EVENTS; i++) {
-      event_pointer = get_event_pointer((EVENTS_ENUM_TYPE)i);
-      if (event_pointer->occurences > 0 && !event_pointer->MQTTpublished) {
-        order_events.push_back({static_cast<EVENTS_ENUM_TYPE>(i), event_pointer});
-      }
-    }
-    // Sort events by timestamp
-    std::sort(order_events.begin(), order_events.end(), compareEventsByTimestampAsc);
-
-    for (const auto& event : order_events) {
-
-      EVENTS_ENUM_TYPE event_handle = event.event_handle;
-      event_pointer = event.event_pointer;
-
-      doc["event_type"] = String(get_event_enum_string(event_handle));
-      doc["severity"] = String(get_event_level_string(event_handle));
-      doc["count"] = String(event_pointer->occurences);
-      doc["data"] = String(event_pointer->data);
-      doc["message"] = get_event_message_string(event_handle);
-      doc["millis"] = String(event_pointer->timestamp);
-
-      serializeJson(doc, mqtt_msg);
-      if (!mqtt_publish(state_topic.c_str(), mqtt_msg, false)) {
-        logging.println("Common info MQTT msg could not be sent");
-        return false;
-      } else {
-        set_event_MQTTpublished(event_handle);
-      }
-      doc.clear();
-      //clear the vector
-      order_events.clear();
-    }
-  }
-  return true;
-}
-
-static bool publish_buttons_discovery(void) {
-  if (ha_autodiscovery_enabled) {
-    if (ha_buttons_published == false) {
-      logging.println("Publishing buttons discovery");
-
-      static JsonDocument doc;
-      for (int i = 0; i < sizeof(buttonConfigs) / sizeof(buttonConfigs[0]); i++) {
-        SensorConfig& config = buttonConfigs[i];
-        doc["name"] = config.name;
-        doc["unique_id"] = object_id_prefix + config.object_id;
-        doc["command_topic"] = generateButtonTopic(config.object_id);
-        set_common_discovery_attributes(doc);
-        serializeJson(doc, mqtt_msg);
-        if (mqtt_publish(generateButtonAutoConfigTopic(config.object_id).c_str(), mqtt_msg, true)) {
-          ha_buttons_published = true;
-        } else {
-          return false;
-        }
-        doc.clear();
-      }
-    }
   }
   return true;
 }
 
 static void subscribe() {
   esp_mqtt_client_subscribe(client, (topic_name + "/command/+").c_str(), 1);
+  if (ha_autodiscovery_enabled) {
+    // Home Assistant announces itself here when it starts
+    esp_mqtt_client_subscribe(client, "homeassistant/status", 1);
+  }
 }
 
 void mqtt_message_received(char* topic_raw, int topic_len, char* data, int data_len) {
@@ -573,6 +717,15 @@ void mqtt_message_received(char* topic_raw, int topic_len, char* data, int data_
 
   logging.printf("MQTT message arrived: [%.*s]\n", topic_len, topic);
 
+  if (strcmp(topic, "homeassistant/status") == 0) {
+    // Home Assistant restarted, its retained configs may be gone
+    if (data_len == 6 && strncmp(data, "online", data_len) == 0) {
+      discovery_requested = true;
+    }
+    free(topic);
+    return;
+  }
+
   if (remote_bms_reset) {
     if (strcmp(topic, generateButtonTopic("BMSRESET").c_str()) == 0) {
       logging.println("Triggering BMS reset");
@@ -639,12 +792,13 @@ static void mqtt_event_handler(void* handler_args, esp_event_base_t base, int32_
     case MQTT_EVENT_CONNECTED:
       clear_event(EVENT_MQTT_DISCONNECT);
       set_event(EVENT_MQTT_CONNECT, 0);
+      mqtt_connected = true;
 
-      publish_buttons_discovery();
       subscribe();
       logging.println("MQTT connected");
       break;
     case MQTT_EVENT_DISCONNECTED:
+      mqtt_connected = false;
       set_event(EVENT_MQTT_DISCONNECT, 0);
       logging.println("MQTT disconnected!");
       break;
@@ -678,9 +832,14 @@ static void mqtt_event_handler(void* handler_args, esp_event_base_t base, int32_
 }
 
 bool init_mqtt(void) {
+  outbox = new MqttOutbox(OUTBOX_SIZE, OUTBOX_MESSAGES);
+  outbox->set_rate(mqtt_publish_rate);
+  // Their age is counted from boot, messages kept before a restart cannot be replayed
+  delete_stored_mqtt_messages();
+
   if (ha_autodiscovery_enabled) {
-    create_battery_sensor_configs();
-    create_global_sensor_configs();
+    discovery = new DiscoveryCache(new uint32_t[DISCOVERY_ENTRIES], DISCOVERY_ENTRIES);
+    load_discovery_cache();
   }
 
   if (mqtt_manual_topic_object_name) {
@@ -724,6 +883,15 @@ bool init_mqtt(void) {
   mqtt_cfg.credentials.username = mqtt_user.c_str();
   mqtt_cfg.credentials.authentication.password = mqtt_password.c_str();
   lwt_topic = topic_name + "/status";
+  info_topic = topic_name + "/info";
+  cell_voltages_topic[0] = topic_name + "/spec_data";
+  cell_voltages_topic[1] = topic_name + "/spec_data_2";
+  cell_balancing_topic[0] = topic_name + "/balancing_data";
+  cell_balancing_topic[1] = topic_name + "/balancing_data_2";
+  cell_data_topic[0] = topic_name + "/cell_data";
+  cell_data_topic[1] = topic_name + "/cell_data_2";
+  replay_topic = topic_name + "/replay";
+  events_topic = topic_name + "/events";
   mqtt_cfg.session.last_will.topic = lwt_topic.c_str();
   mqtt_cfg.session.last_will.qos = 1;
   mqtt_cfg.session.last_will.retain = true;
@@ -743,8 +911,47 @@ bool init_mqtt(void) {
   return true;
 }
 
+static bool send_message(const char* topic, const uint8_t* data, size_t length, bool retain) {
+  return esp_mqtt_client_publish(client, topic, (const char*)data, length, MQTT_QOS, retain) > -1;
+}
+
+// Messages kept on the SD card while offline go out on <topic>/replay, one at a time while nothing else is
+// waiting. Each says which topic it was for and how long ago: {"topic":"BE/info","age_ms":61000,"payload":{}}
+static void replay_stored_message(void) {
+  static char topic[128];
+  static char replay_msg[MQTT_MSG_BUFFER_SIZE + 256];
+
+  if (outbox->size() > 0 || !has_stored_mqtt_messages()) {
+    return;
+  }
+  size_t length;
+  unsigned long timestamp_ms;
+  if (!read_stored_mqtt_message(topic, sizeof(topic), (uint8_t*)mqtt_msg, sizeof(mqtt_msg) - 1, length,
+                                timestamp_ms)) {
+    return;
+  }
+  mqtt_msg[length] = '\0';
+
+  MqttPayloadWriter writer(replay_msg, sizeof(replay_msg));
+  writer.begin_object();
+  writer.key("topic");
+  writer.text(topic);
+  writer.key("age_ms");
+  writer.number(millis() - timestamp_ms);
+  writer.key("payload");
+  if (mqtt_msg[0] == '{') {
+    writer.raw(mqtt_msg);
+  } else {
+    writer.text(mqtt_msg);
+  }
+  writer.end_object();
+  if (!writer.overflowed()) {
+    mqtt_publish(replay_topic.c_str(), replay_msg, false, MQTT_MESSAGE_EVENT);
+  }
+}
+
 void mqtt_client_loop(void) {
-  // Only attempt to publish/reconnect MQTT if Wi-Fi is connected and checkTimmer is elapsed
+  // Only attempt to start MQTT if Wi-Fi is connected and checkTimmer is elapsed
   if (check_global_timer.elapsed() && WiFi.status() == WL_CONNECTED) {
 
     if (client_started == false) {
@@ -755,15 +962,44 @@ void mqtt_client_loop(void) {
       logging.println("MQTT initialized");
       return;
     }
+  }
 
-    // Skip publishing if OTA update is in progress to avoid interference
-    if (publish_global_timer.elapsed() && !ota_active) {
-      publish_values();
-    }
+  // Skip publishing if OTA update is in progress to avoid interference. Messages are queued even while
+  // offline, so they can be kept on the SD card.
+  if (client_started && publish_global_timer.elapsed() && !ota_active) {
+    publish_values();
+  }
+
+  if (client_started && mqtt_connected && !ota_active) {
+    publish_discovery();
+    replay_stored_message();
+    outbox->flush(millis(), send_message);
   }
 }
 
-bool mqtt_publish(const char* topic, const char* mqtt_msg, bool retain) {
-  int msg_id = esp_mqtt_client_publish(client, topic, mqtt_msg, strlen(mqtt_msg), MQTT_QOS, retain);
-  return msg_id > -1;
+bool mqtt_publish(const char* topic, const char* mqtt_msg, bool retain, MqttMessageKind kind) {
+  return mqtt_publish(topic, (const uint8_t*)mqtt_msg, strlen(mqtt_msg), retain, kind);
+}
+
+bool mqtt_publish(const char* topic, const uint8_t* data, size_t length, bool retain, MqttMessageKind kind) {
+  if (outbox == nullptr) {
+    return false;
+  }
+  const bool state = kind == MQTT_MESSAGE_STATE || kind == MQTT_MESSAGE_DELTA;
+  if (state && mqtt_store_offline && !mqtt_connected) {
+    store_mqtt_message(topic, data, length, millis());
+  }
+
+  const bool coalesce = kind == MQTT_MESSAGE_STATUS || kind == MQTT_MESSAGE_STATE;
+  const unsigned long started = millis();
+  while (!outbox->push(topic, data, length, retain, coalesce)) {
+    // While connected, wait for room as the outbox drains at the publish rate
+    if (!mqtt_connected || millis() - started >= OUTBOX_WAIT_MS) {
+      return false;
+    }
+    if (outbox->flush(millis(), send_message) == 0) {
+      delay(10);
+    }
+  }
+  return true;
 }
@@ -38,12 +38,33 @@
 #include <string>
 #include <vector>
 
-#define MQTT_MSG_BUFFER_SIZE (1024)
+#define MQTT_MSG_BUFFER_SIZE (2048)
+
+// How the cell voltages and balancing state are sent when all cell voltages are published
+enum MqttCellFormat : uint8_t {
+  MQTT_CELLS_JSON = 0,          // spec_data and balancing_data, in volts and booleans
+  MQTT_CELLS_COMPACT_JSON = 1,  // spec_data and balancing_data, as millivolt deltas and a bitmask
+  MQTT_CELLS_BASE64 = 2,        // cell_data, binary encoded in base64
+  MQTT_CELLS_BINARY = 3         // cell_data, raw binary
+};
+
+// How a message is queued until the broker takes it
+enum MqttMessageKind : uint8_t {
+  MQTT_MESSAGE_STATUS,  // Only the newest one per topic is sent
+  MQTT_MESSAGE_STATE,   // Like status, and kept on the SD card while the broker cannot be reached
+  MQTT_MESSAGE_DELTA,   // Part of the state, each one is sent and kept on the SD card while offline
+  MQTT_MESSAGE_EVENT    // Each one is sent
+};
 
 extern const char* version_number;  // The current software version, used for mqtt
 
 extern bool mqtt_enabled;
 extern bool mqtt_transmit_all_cellvoltages;
+extern bool mqtt_transmit_can_stats;
+extern bool mqtt_delta_publishing;
+extern MqttCellFormat mqtt_cell_format;
+extern uint16_t mqtt_publish_rate;
+extern bool mqtt_store_offline;
 extern uint16_t mqtt_timeout_ms;
 extern uint16_t mqtt_publish_interval_ms;
 extern bool ha_autodiscovery_enabled;
@@ -60,6 +81,9 @@ extern char mqtt_msg[MQTT_MSG_BUFFER_SIZE];
 
 bool init_mqtt(void);
 void mqtt_client_loop(void);
-bool mqtt_publish(const char* topic, const char* mqtt_msg, bool retain);
+// Queues a message, returns false if there is no room for it
+bool mqtt_publish(const char* topic, const char* mqtt_msg, bool retain, MqttMessageKind kind = MQTT_MESSAGE_STATUS);
+bool mqtt_publish(const char* topic, const uint8_t* data, size_t length, bool retain,
+                  MqttMessageKind kind = MQTT_MESSAGE_STATUS);
 
 #endif
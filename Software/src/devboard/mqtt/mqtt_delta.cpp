@@ -0,0 +1,40 @@
+#include "mqtt_delta.h"
+#include <math.h>
+#include <string.h>
+
+MqttDeltaTracker::MqttDeltaTracker(float* last, uint16_t count) : last(last), count(count) {
+  for (uint16_t i = 0; i < count; i++) {
+    last[i] = NAN;  // Never published
+  }
+}
+
+bool MqttDeltaTracker::begin(unsigned long currentMillis) {
+  full_refresh = full_refresh_due || currentMillis - last_full_refresh_ms >= FULL_REFRESH_INTERVAL_MS;
+  if (full_refresh) {
+    full_refresh_due = false;
+    last_full_refresh_ms = currentMillis;
+  }
+  return full_refresh;
+}
+
+bool MqttDeltaTracker::changed(uint16_t field, float value, float deadband) {
+  if (field >= count) {
+    return true;
+  }
+  if (!full_refresh && !isnan(last[field]) && fabsf(value - last[field]) <= deadband) {
+    return false;
+  }
+  last[field] = value;
+  return true;
+}
+
+bool cell_voltages_changed(const uint16_t* cells, uint16_t* published, uint16_t count, uint16_t deadband_mV) {
+  for (uint16_t i = 0; i < count; i++) {
+    const uint16_t difference = cells[i] > published[i] ? cells[i] - published[i] : published[i] - cells[i];
+    if (difference > deadband_mV) {
+      memcpy(published, cells, count * sizeof(uint16_t));
+      return true;
+    }
+  }
+  return false;
+}
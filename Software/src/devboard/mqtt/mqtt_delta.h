@@ -0,0 +1,36 @@
+#ifndef _MQTT_DELTA_H_
+#define _MQTT_DELTA_H_
+
+#include <stdint.h>
+
+// Remembers the values last published on a state topic, so that only values that moved by more than their
+// deadband are sent again. A deadband of 0 sends every change. Periodically, and after a publish failed,
+// everything is sent once more, so subscribers that missed a message or started later catch up.
+class MqttDeltaTracker {
+ public:
+  static constexpr uint32_t FULL_REFRESH_INTERVAL_MS = 300000;
+
+  // last is storage for one value per field, owned by the caller
+  MqttDeltaTracker(float* last, uint16_t count);
+
+  // Starts a publish cycle. Returns true if it is a full refresh, in which every value counts as changed.
+  bool begin(unsigned long currentMillis);
+  bool refreshing() const { return full_refresh; }
+  // Returns true if the value is to be published, and then remembers it as the last published one
+  bool changed(uint16_t field, float value, float deadband = 0.0f);
+  // Sends everything again in the next cycle, e.g. because the last publish failed
+  void invalidate() { full_refresh_due = true; }
+
+ private:
+  float* last;
+  uint16_t count;
+  bool full_refresh = true;
+  bool full_refresh_due = true;
+  unsigned long last_full_refresh_ms = 0;
+};
+
+// Returns true if any of count cells moved by more than deadband_mV from the voltages in published,
+// and then copies cells to published. Smaller changes accumulate until they pass the deadband.
+bool cell_voltages_changed(const uint16_t* cells, uint16_t* published, uint16_t count, uint16_t deadband_mV);
+
+#endif
@@ -0,0 +1,29 @@
+#include "mqtt_discovery.h"
+#include <string.h>
+
+DiscoveryCache::DiscoveryCache(uint32_t* hashes, uint16_t count) : hashes(hashes), count(count), cursor(count) {
+  memset(hashes, 0, count * sizeof(uint32_t));
+}
+
+uint32_t DiscoveryCache::hash(const char* text, uint32_t seed) {
+  uint32_t hash = seed;
+  for (; *text != '\0'; text++) {
+    hash = (hash ^ (uint8_t)*text) * FNV_PRIME;
+  }
+  // Separates the texts hashed together, so "ab" + "c" differs from "a" + "bc"
+  hash = (hash ^ 0xFF) * FNV_PRIME;
+  return hash == 0 ? 1 : hash;
+}
+
+void DiscoveryCache::advance(uint32_t hash) {
+  if (hashes[cursor] != hash) {
+    hashes[cursor] = hash;
+    dirty = true;
+  }
+  cursor++;
+}
+
+void DiscoveryCache::forget() {
+  memset(hashes, 0, count * sizeof(uint32_t));
+  dirty = true;
+}
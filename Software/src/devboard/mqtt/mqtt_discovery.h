@@ -0,0 +1,50 @@
+#ifndef _MQTT_DISCOVERY_H_
+#define _MQTT_DISCOVERY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Remembers a hash of each Home Assistant discovery entry as it was last published, so that after a restart
+// or a configuration change only the entries whose content changed are sent again. Entries are numbered by
+// the caller and always in the same order, so the hashes can be saved and loaded. A hash of 0 means the
+// entry is not published. A pass walks through all entries, one at a time, so publishing can be paced.
+class DiscoveryCache {
+ public:
+  // hashes is storage for count entries, owned by the caller
+  DiscoveryCache(uint32_t* hashes, uint16_t count);
+
+  // FNV-1a, never 0. Pass the previous result as seed to hash several texts together.
+  static uint32_t hash(const char* text, uint32_t seed = FNV_OFFSET_BASIS);
+  static uint32_t hash(const char* topic, const char* payload) { return hash(payload, hash(topic)); }
+
+  // Starts walking through all entries again
+  void begin_pass() { cursor = 0; }
+  bool pass_active() const { return cursor < count; }
+  uint16_t position() const { return cursor; }
+
+  // Whether the current entry has to be published to have this hash
+  bool changed(uint32_t hash) const { return hashes[cursor] != hash; }
+  // Moves past the current entry, which now has this hash
+  void advance(uint32_t hash);
+
+  // Everything is published again in the next pass, e.g. once Home Assistant restarted
+  void forget();
+
+  // True when the hashes changed since they were last saved
+  bool modified() const { return dirty; }
+  void saved() { dirty = false; }
+
+  const uint32_t* data() const { return hashes; }
+  size_t size() const { return count * sizeof(uint32_t); }
+
+ private:
+  static constexpr uint32_t FNV_OFFSET_BASIS = 2166136261u;
+  static constexpr uint32_t FNV_PRIME = 16777619u;
+
+  uint32_t* hashes;
+  uint16_t count;
+  uint16_t cursor;
+  bool dirty = false;
+};
+
+#endif
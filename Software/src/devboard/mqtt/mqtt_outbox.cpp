@@ -0,0 +1,99 @@
+#include "mqtt_outbox.h"
+#include <string.h>
+
+MqttOutbox::MqttOutbox(size_t data_size, uint16_t capacity)
+    : data(new uint8_t[data_size]), data_size(data_size), entries(new Entry[capacity]), capacity(capacity) {}
+
+MqttOutbox::~MqttOutbox() {
+  delete[] data;
+  delete[] entries;
+}
+
+int16_t MqttOutbox::find_coalescable(const char* topic) const {
+  for (uint16_t i = 0; i < count; i++) {
+    if (entries[i].coalesce && strcmp(this->topic(entries[i]), topic) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void MqttOutbox::remove(uint16_t index) {
+  const size_t offset = entries[index].offset;
+  const size_t size = stored_size(entries[index]);
+  memmove(data + offset, data + offset + size, used - offset - size);
+  used -= size;
+  for (uint16_t i = index + 1; i < count; i++) {
+    entries[i].offset -= size;
+    entries[i - 1] = entries[i];
+  }
+  count--;
+}
+
+bool MqttOutbox::push(const char* topic, const uint8_t* payload, size_t length, bool retain, bool coalesce) {
+  const size_t topic_length = strlen(topic);
+  if (topic_length > UINT16_MAX || length > UINT16_MAX) {
+    return false;
+  }
+
+  // The message it replaces makes room, but is only dropped once the new one is sure to fit
+  const int16_t previous = coalesce ? find_coalescable(topic) : -1;
+  const size_t freed = previous < 0 ? 0 : stored_size(entries[previous]);
+  const uint16_t slots = previous < 0 ? count : count - 1;
+  if (slots == capacity || used - freed + topic_length + 1 + length > data_size) {
+    return false;
+  }
+  if (previous >= 0) {
+    remove(previous);
+    replaced++;
+  }
+
+  Entry& entry = entries[count++];
+  entry.offset = used;
+  entry.topic_length = topic_length;
+  entry.length = length;
+  entry.retain = retain;
+  entry.coalesce = coalesce;
+  memcpy(data + used, topic, topic_length + 1);
+  memcpy(data + used + topic_length + 1, payload, length);
+  used += stored_size(entry);
+  return true;
+}
+
+void MqttOutbox::set_rate(uint16_t messages_per_second, uint16_t burst) {
+  rate = messages_per_second == 0 ? 1 : messages_per_second;
+  this->burst = burst == 0 ? 1 : burst;
+  if (tokens > this->burst) {
+    tokens = this->burst;
+  }
+}
+
+void MqttOutbox::refill(unsigned long currentMillis) {
+  const uint64_t earned = (uint64_t)(currentMillis - last_refill_ms) * rate / 1000;
+  if (earned == 0) {
+    return;
+  }
+  if (tokens + earned >= burst) {
+    tokens = burst;
+    last_refill_ms = currentMillis;
+  } else {
+    tokens += earned;
+    // Keep the part of a token already earned
+    last_refill_ms += earned * 1000 / rate;
+  }
+}
+
+uint16_t MqttOutbox::flush(unsigned long currentMillis, const Sender& send) {
+  refill(currentMillis);
+  uint16_t sent = 0;
+  while (count > 0 && tokens > 0) {
+    const Entry& entry = entries[0];
+    if (!send(topic(entry), data + entry.offset + entry.topic_length + 1, entry.length, entry.retain)) {
+      break;
+    }
+    remove(0);
+    tokens--;
+    sent++;
+  }
+  return sent;
+}
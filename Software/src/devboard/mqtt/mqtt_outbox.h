@@ -0,0 +1,68 @@
+#ifndef _MQTT_OUTBOX_H_
+#define _MQTT_OUTBOX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+
+// Queue between the code building MQTT messages and the client sending them, so a slow broker holds up
+// neither the producers nor each other. Messages queued with coalesce replace the queued message for the
+// same topic, only the newest state is worth sending once the broker is reachable again. Sending is
+// limited by a token bucket: up to burst messages go out at once, on average no more than the set rate.
+class MqttOutbox {
+ public:
+  // Sends one message, returns false if it could not be sent
+  using Sender = std::function<bool(const char* topic, const uint8_t* data, size_t length, bool retain)>;
+
+  static constexpr uint16_t DEFAULT_RATE = 20;
+  static constexpr uint16_t DEFAULT_BURST = 10;
+
+  // Keeps up to capacity messages, with data_size bytes for their topics and payloads
+  MqttOutbox(size_t data_size, uint16_t capacity);
+  ~MqttOutbox();
+
+  // Queues a message. Returns false if there is no room for it, the queue is left as it was.
+  bool push(const char* topic, const uint8_t* data, size_t length, bool retain, bool coalesce);
+
+  void set_rate(uint16_t messages_per_second, uint16_t burst = DEFAULT_BURST);
+
+  // Sends queued messages, oldest first, as far as the rate allows. Stops at a message that cannot be
+  // sent, it stays queued for the next call. Returns the number of messages sent.
+  uint16_t flush(unsigned long currentMillis, const Sender& send);
+
+  uint16_t size() const { return count; }
+  size_t bytes() const { return used; }
+  // Messages replaced by a newer one before they were sent
+  uint32_t coalesced() const { return replaced; }
+
+ private:
+  struct Entry {
+    size_t offset;
+    uint16_t topic_length;
+    uint16_t length;
+    bool retain;
+    bool coalesce;
+  };
+
+  // Topic, terminating zero and payload
+  static size_t stored_size(const Entry& entry) { return entry.topic_length + 1u + entry.length; }
+  const char* topic(const Entry& entry) const { return (const char*)data + entry.offset; }
+  int16_t find_coalescable(const char* topic) const;
+  void remove(uint16_t index);
+  void refill(unsigned long currentMillis);
+
+  uint8_t* data;
+  size_t data_size;
+  size_t used = 0;
+  Entry* entries;
+  uint16_t capacity;
+  uint16_t count = 0;
+  uint32_t replaced = 0;
+
+  uint16_t rate = DEFAULT_RATE;
+  uint16_t burst = DEFAULT_BURST;
+  uint16_t tokens = DEFAULT_BURST;
+  unsigned long last_refill_ms = 0;
+};
+
+#endif
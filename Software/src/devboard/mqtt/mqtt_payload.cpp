@@ -0,0 +1,341 @@
+#include "mqtt_payload.h"
+#include <math.h>
+#include <string.h>
+
+MqttPayloadWriter::MqttPayloadWriter(char* buffer, size_t size) : buffer(buffer), size(size) {
+  if (size > 0) {
+    buffer[0] = '\0';
+  }
+}
+
+void MqttPayloadWriter::put(char c) {
+  // Always leave room for the terminating zero
+  if (used + 1 >= size) {
+    overflow = true;
+    return;
+  }
+  buffer[used++] = c;
+  buffer[used] = '\0';
+}
+
+void MqttPayloadWriter::put(const char* text) {
+  while (*text != '\0') {
+    put(*text++);
+  }
+}
+
+void MqttPayloadWriter::begin_value() {
+  if (after_key) {
+    after_key = false;
+  } else if (!first) {
+    put(',');
+  }
+  first = false;
+}
+
+void MqttPayloadWriter::begin_object() {
+  begin_value();
+  put('{');
+  first = true;
+}
+
+void MqttPayloadWriter::end_object() {
+  put('}');
+  first = false;
+}
+
+void MqttPayloadWriter::begin_array() {
+  begin_value();
+  put('[');
+  first = true;
+}
+
+void MqttPayloadWriter::end_array() {
+  put(']');
+  first = false;
+}
+
+void MqttPayloadWriter::key(const char* name, const char* suffix) {
+  begin_value();
+  put('"');
+  put(name);
+  put(suffix);
+  put("\":");
+  after_key = true;
+}
+
+void MqttPayloadWriter::number(int64_t value, uint8_t decimals) {
+  begin_value();
+  uint64_t magnitude = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+  while (decimals > 0 && magnitude % 10 == 0) {
+    magnitude /= 10;
+    decimals--;
+  }
+
+  // Digits from the last one backwards, with at least one before the decimal point
+  char digits[24];
+  uint8_t count = 0;
+  do {
+    digits[count++] = '0' + magnitude % 10;
+    magnitude /= 10;
+  } while (magnitude > 0 || count <= decimals);
+
+  if (value < 0) {
+    put('-');
+  }
+  while (count > 0) {
+    if (count == decimals) {
+      put('.');
+    }
+    put(digits[--count]);
+  }
+}
+
+void MqttPayloadWriter::text(const char* value) {
+  begin_value();
+  put('"');
+  for (; *value != '\0'; value++) {
+    if (*value == '"' || *value == '\\') {
+      put('\\');
+      put(*value);
+    } else if ((uint8_t)*value < 0x20) {
+      put(' ');
+    } else {
+      put(*value);
+    }
+  }
+  put('"');
+}
+
+void MqttPayloadWriter::flag(bool value) {
+  begin_value();
+  put(value ? "true" : "false");
+}
+
+void MqttPayloadWriter::hex(const uint8_t* data, size_t length) {
+  static const char digits[] = "0123456789abcdef";
+  begin_value();
+  put('"');
+  for (size_t i = 0; i < length; i++) {
+    put(digits[data[i] >> 4]);
+    put(digits[data[i] & 0x0F]);
+  }
+  put('"');
+}
+
+void MqttPayloadWriter::raw(const char* json) {
+  begin_value();
+  put(json);
+}
+
+static void write_info_number(MqttPayloadWriter& writer, MqttDeltaTracker* delta, const char* name,
+                              const char* suffix, uint16_t field, int64_t value, uint8_t decimals = 0,
+                              float deadband = 0.0f) {
+  if (delta != nullptr && !delta->changed(field, value / powf(10.0f, decimals), deadband)) {
+    return;
+  }
+  writer.key(name, suffix);
+  writer.number(value, decimals);
+}
+
+void write_info_text(MqttPayloadWriter& writer, MqttDeltaTracker* delta, const char* name, uint16_t field,
+                     int state, const char* text) {
+  if (delta != nullptr && !delta->changed(field, (float)state)) {
+    return;
+  }
+  writer.key(name);
+  writer.text(text);
+}
+
+static const char* get_balancing_status_text(balancing_status_enum status) {
+  switch (status) {
+    case BALANCING_STATUS_UNKNOWN:
+      return "Unknown";
+    case BALANCING_STATUS_ERROR:
+      return "Error";
+    case BALANCING_STATUS_READY:
+      return "Ready";
+    case BALANCING_STATUS_ACTIVE:
+      return "Active";
+    default:
+      return "Unknown";
+  }
+}
+
+void write_battery_info(MqttPayloadWriter& writer, MqttDeltaTracker* delta, const DATALAYER_BATTERY_SNAPSHOT& battery,
+                        const char* suffix, uint16_t first_field, bool supports_charged) {
+  const DATALAYER_BATTERY_STATUS_TYPE& status = battery.status;
+  const uint16_t f = first_field;
+
+  write_info_number(writer, delta, "SOC", suffix, f + INFO_SOC, status.reported_soc, 2, 0.1f);
+  write_info_number(writer, delta, "SOC_real", suffix, f + INFO_SOC_REAL, status.real_soc, 2, 0.1f);
+  write_info_number(writer, delta, "state_of_health", suffix, f + INFO_STATE_OF_HEALTH, status.soh_pptt, 2);
+  write_info_number(writer, delta, "temperature_min", suffix, f + INFO_TEMPERATURE_MIN, status.temperature_min_dC, 1,
+                    0.5f);
+  write_info_number(writer, delta, "temperature_max", suffix, f + INFO_TEMPERATURE_MAX, status.temperature_max_dC, 1,
+                    0.5f);
+  write_info_number(writer, delta, "cpu_temp", suffix, f + INFO_CPU_TEMP,
+                    lroundf(datalayer.system.info.CPU_temperature * 10.0f), 1, 1.0f);
+  write_info_number(writer, delta, "stat_batt_power", suffix, f + INFO_POWER, status.active_power_W, 0, 50.0f);
+  write_info_number(writer, delta, "battery_current", suffix, f + INFO_CURRENT, status.current_dA, 1, 0.1f);
+  write_info_number(writer, delta, "battery_voltage", suffix, f + INFO_VOLTAGE, status.voltage_dV, 1, 0.5f);
+  if (battery.info.number_of_cells != 0u && status.cell_voltages_mV[battery.info.number_of_cells - 1] != 0u) {
+    write_info_number(writer, delta, "cell_max_voltage", suffix, f + INFO_CELL_MAX_VOLTAGE, status.cell_max_voltage_mV,
+                      3, CELL_VOLTAGE_DEADBAND_MV / 1000.0f);
+    write_info_number(writer, delta, "cell_min_voltage", suffix, f + INFO_CELL_MIN_VOLTAGE, status.cell_min_voltage_mV,
+                      3, CELL_VOLTAGE_DEADBAND_MV / 1000.0f);
+    write_info_number(writer, delta, "cell_voltage_delta", suffix, f + INFO_CELL_VOLTAGE_DELTA,
+                      (int32_t)status.cell_max_voltage_mV - status.cell_min_voltage_mV, 0, CELL_VOLTAGE_DEADBAND_MV);
+  }
+  write_info_number(writer, delta, "total_capacity", suffix, f + INFO_TOTAL_CAPACITY, battery.info.total_capacity_Wh);
+  write_info_number(writer, delta, "remaining_capacity_real", suffix, f + INFO_REMAINING_CAPACITY_REAL,
+                    status.remaining_capacity_Wh, 0, 50.0f);
+  write_info_number(writer, delta, "remaining_capacity", suffix, f + INFO_REMAINING_CAPACITY,
+                    status.reported_remaining_capacity_Wh, 0, 50.0f);
+  write_info_number(writer, delta, "max_discharge_power", suffix, f + INFO_MAX_DISCHARGE_POWER,
+                    status.max_discharge_power_W, 0, 100.0f);
+  write_info_number(writer, delta, "max_charge_power", suffix, f + INFO_MAX_CHARGE_POWER, status.max_charge_power_W,
+                    0, 100.0f);
+
+  if (supports_charged) {
+    if (status.total_charged_battery_Wh != 0 && status.total_discharged_battery_Wh != 0) {
+      write_info_number(writer, delta, "charged_energy", suffix, f + INFO_CHARGED_ENERGY,
+                        status.total_charged_battery_Wh, 0, 100.0f);
+      write_info_number(writer, delta, "discharged_energy", suffix, f + INFO_DISCHARGED_ENERGY,
+                        status.total_discharged_battery_Wh, 0, 100.0f);
+    }
+  }
+
+  // Add balancing data
+  uint16_t active_cells = 0;
+  for (size_t i = 0; i < battery.info.number_of_cells; ++i) {
+    if (status.cell_balancing_status[i]) {
+      active_cells++;
+    }
+  }
+  write_info_number(writer, delta, "balancing_active_cells", suffix, f + INFO_BALANCING_ACTIVE_CELLS, active_cells);
+  if (delta == nullptr || delta->changed(f + INFO_BALANCING_STATUS, status.balancing_status)) {
+    writer.key("balancing_status", suffix);
+    writer.text(get_balancing_status_text(status.balancing_status));
+  }
+}
+
+void write_cell_voltages(MqttPayloadWriter& writer, const DATALAYER_BATTERY_SNAPSHOT& battery) {
+  writer.begin_object();
+  writer.key("cell_voltages");
+  writer.begin_array();
+  for (size_t i = 0; i < battery.info.number_of_cells; ++i) {
+    writer.number(battery.status.cell_voltages_mV[i], 3);
+  }
+  writer.end_array();
+  writer.end_object();
+}
+
+void write_cell_balancing(MqttPayloadWriter& writer, const DATALAYER_BATTERY_SNAPSHOT& battery) {
+  writer.begin_object();
+  writer.key("cell_balancing");
+  writer.begin_array();
+  for (size_t i = 0; i < battery.info.number_of_cells; ++i) {
+    writer.flag(battery.status.cell_balancing_status[i]);
+  }
+  writer.end_array();
+  writer.end_object();
+}
+
+static uint16_t lowest_cell_voltage(const DATALAYER_BATTERY_SNAPSHOT& battery) {
+  uint16_t lowest = UINT16_MAX;
+  for (size_t i = 0; i < battery.info.number_of_cells; ++i) {
+    if (battery.status.cell_voltages_mV[i] < lowest) {
+      lowest = battery.status.cell_voltages_mV[i];
+    }
+  }
+  return battery.info.number_of_cells == 0u ? 0 : lowest;
+}
+
+// Packs the balancing state into mask, returns the number of bytes used
+static size_t pack_balancing(const DATALAYER_BATTERY_SNAPSHOT& battery, uint8_t* mask) {
+  const size_t bytes = (battery.info.number_of_cells + 7) / 8;
+  memset(mask, 0, bytes);
+  for (size_t i = 0; i < battery.info.number_of_cells; ++i) {
+    if (battery.status.cell_balancing_status[i]) {
+      mask[i / 8] |= 1 << (i % 8);
+    }
+  }
+  return bytes;
+}
+
+void write_cell_voltages_compact(MqttPayloadWriter& writer, const DATALAYER_BATTERY_SNAPSHOT& battery) {
+  const uint16_t base = lowest_cell_voltage(battery);
+  writer.begin_object();
+  writer.key("cell_base_mV");
+  writer.number(base);
+  writer.key("cell_delta_mV");
+  writer.begin_array();
+  for (size_t i = 0; i < battery.info.number_of_cells; ++i) {
+    writer.number(battery.status.cell_voltages_mV[i] - base);
+  }
+  writer.end_array();
+  writer.end_object();
+}
+
+void write_cell_balancing_compact(MqttPayloadWriter& writer, const DATALAYER_BATTERY_SNAPSHOT& battery) {
+  uint8_t mask[(MAX_AMOUNT_CELLS + 7) / 8];
+  const size_t bytes = pack_balancing(battery, mask);
+  writer.begin_object();
+  writer.key("cell_balancing_mask");
+  writer.hex(mask, bytes);
+  writer.end_object();
+}
+
+size_t encode_cell_data(const DATALAYER_BATTERY_SNAPSHOT& battery, uint8_t* out, size_t size) {
+  const uint16_t cells = battery.info.number_of_cells;
+  const uint16_t base = lowest_cell_voltage(battery);
+  bool wide = false;
+  for (size_t i = 0; i < cells; ++i) {
+    if (battery.status.cell_voltages_mV[i] - base > UINT8_MAX) {
+      wide = true;
+    }
+  }
+  const size_t needed = 6 + (wide ? 2 : 1) * cells + (cells + 7) / 8;
+  if (needed > size) {
+    return 0;
+  }
+
+  size_t used = 0;
+  out[used++] = CELL_DATA_VERSION;
+  out[used++] = wide ? CELL_DATA_WIDE_DELTAS : 0;
+  out[used++] = cells & 0xFF;
+  out[used++] = cells >> 8;
+  out[used++] = base & 0xFF;
+  out[used++] = base >> 8;
+  for (size_t i = 0; i < cells; ++i) {
+    const uint16_t delta = battery.status.cell_voltages_mV[i] - base;
+    out[used++] = delta & 0xFF;
+    if (wide) {
+      out[used++] = delta >> 8;
+    }
+  }
+  used += pack_balancing(battery, out + used);
+  return used;
+}
+
+size_t encode_base64(const uint8_t* data, size_t length, char* out, size_t size) {
+  static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  const size_t encoded = (length + 2) / 3 * 4;
+  if (encoded + 1 > size) {
+    return 0;
+  }
+
+  size_t used = 0;
+  for (size_t i = 0; i < length; i += 3) {
+    const size_t remaining = length - i;
+    const uint32_t group = (uint32_t)data[i] << 16 | (remaining > 1 ? data[i + 1] << 8 : 0) |
+                           (remaining > 2 ? data[i + 2] : 0);
+    out[used++] = alphabet[(group >> 18) & 0x3F];
+    out[used++] = alphabet[(group >> 12) & 0x3F];
+    out[used++] = remaining > 1 ? alphabet[(group >> 6) & 0x3F] : '=';
+    out[used++] = remaining > 2 ? alphabet[group & 0x3F] : '=';
+  }
+  out[used] = '\0';
+  return used;
+}
@@ -0,0 +1,121 @@
+#ifndef _MQTT_PAYLOAD_H_
+#define _MQTT_PAYLOAD_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../../datalayer/datalayer_snapshot.h"
+#include "mqtt_delta.h"
+
+// Writes a JSON payload straight into a caller-owned buffer, without a document in between and without
+// allocating. Numbers are fixed point, e.g. number(3712, 3) writes 3.712, so no floats need formatting.
+// Once the buffer is full nothing more is written and overflowed() tells, rather than sending cut-off JSON.
+class MqttPayloadWriter {
+ public:
+  MqttPayloadWriter(char* buffer, size_t size);
+
+  void begin_object();
+  void end_object();
+  void begin_array();
+  void end_array();
+
+  // Names the next value in an object. The suffix is appended, e.g. "_2" for the second battery.
+  void key(const char* name, const char* suffix = "");
+  // Writes value / 10^decimals, leaving out trailing zeros
+  void number(int64_t value, uint8_t decimals = 0);
+  void text(const char* value);
+  void flag(bool value);
+  // Writes the bytes as a string of hex digits, two per byte
+  void hex(const uint8_t* data, size_t length);
+  // Writes JSON that was serialized elsewhere, as it is
+  void raw(const char* json);
+
+  // True while the innermost object or array has no values
+  bool empty() const { return first; }
+  bool overflowed() const { return overflow; }
+  size_t length() const { return used; }
+  const char* c_str() const { return buffer; }
+
+ private:
+  void put(char c);
+  void put(const char* text);
+  void begin_value();
+
+  char* buffer;
+  size_t size;
+  size_t used = 0;
+  bool first = true;
+  bool after_key = false;
+  bool overflow = false;
+};
+
+// Values of the info topic, tracked for delta publishing. Each battery has its own set of fields.
+enum InfoField : uint16_t {
+  INFO_SOC,
+  INFO_SOC_REAL,
+  INFO_STATE_OF_HEALTH,
+  INFO_TEMPERATURE_MIN,
+  INFO_TEMPERATURE_MAX,
+  INFO_CPU_TEMP,
+  INFO_POWER,
+  INFO_CURRENT,
+  INFO_VOLTAGE,
+  INFO_CELL_MAX_VOLTAGE,
+  INFO_CELL_MIN_VOLTAGE,
+  INFO_CELL_VOLTAGE_DELTA,
+  INFO_TOTAL_CAPACITY,
+  INFO_REMAINING_CAPACITY_REAL,
+  INFO_REMAINING_CAPACITY,
+  INFO_MAX_DISCHARGE_POWER,
+  INFO_MAX_CHARGE_POWER,
+  INFO_CHARGED_ENERGY,
+  INFO_DISCHARGED_ENERGY,
+  INFO_BALANCING_ACTIVE_CELLS,
+  INFO_BALANCING_STATUS,
+  INFO_BATTERY_FIELD_COUNT
+};
+enum GlobalInfoField : uint16_t {
+  INFO_BMS_STATUS = 2 * INFO_BATTERY_FIELD_COUNT,
+  INFO_PAUSE_STATUS,
+  INFO_EVENT_LEVEL,
+  INFO_EMULATOR_STATUS,
+  INFO_FIELD_COUNT
+};
+
+// Cell voltages move by a few mV all the time, even when the pack is idle
+static constexpr uint16_t CELL_VOLTAGE_DEADBAND_MV = 5;
+
+// Adds a text to the info payload. With a delta tracker only if the state it describes changed.
+void write_info_text(MqttPayloadWriter& writer, MqttDeltaTracker* delta, const char* name, uint16_t field,
+                     int state, const char* text);
+
+// Adds the values of one battery to the info payload, the keys ending in suffix. first_field is where the
+// fields of this battery start. With a delta tracker only the values that moved by more than their deadband.
+void write_battery_info(MqttPayloadWriter& writer, MqttDeltaTracker* delta, const DATALAYER_BATTERY_SNAPSHOT& battery,
+                        const char* suffix, uint16_t first_field, bool supports_charged);
+
+// The spec_data and balancing_data payloads
+void write_cell_voltages(MqttPayloadWriter& writer, const DATALAYER_BATTERY_SNAPSHOT& battery);
+void write_cell_balancing(MqttPayloadWriter& writer, const DATALAYER_BATTERY_SNAPSHOT& battery);
+
+// The same payloads in millivolts, as the lowest cell voltage plus one delta per cell, e.g.
+// {"cell_base_mV":3650,"cell_delta_mV":[12,0,7]}, and the balancing state as a bitmask in hex,
+// e.g. {"cell_balancing_mask":"0500"}. Home Assistant can still decode the voltages in a template.
+void write_cell_voltages_compact(MqttPayloadWriter& writer, const DATALAYER_BATTERY_SNAPSHOT& battery);
+void write_cell_balancing_compact(MqttPayloadWriter& writer, const DATALAYER_BATTERY_SNAPSHOT& battery);
+
+// Cell voltages and balancing of one battery in binary, all numbers little endian:
+//   version (1 byte), flags (1 byte), number of cells (2 bytes), lowest cell voltage in mV (2 bytes),
+//   per cell the mV above the lowest one (1 byte, or 2 bytes with CELL_DATA_WIDE_DELTAS),
+//   the balancing bitmask (1 bit per cell, cell n in bit n % 8 of byte n / 8).
+// The deltas only take 2 bytes when the cells are 255 mV or more apart.
+static constexpr uint8_t CELL_DATA_VERSION = 1;
+static constexpr uint8_t CELL_DATA_WIDE_DELTAS = 0x01;
+static constexpr size_t CELL_DATA_MAX_SIZE = 6 + 2 * MAX_AMOUNT_CELLS + (MAX_AMOUNT_CELLS + 7) / 8;
+
+// Returns the number of bytes written, or 0 if they do not fit
+size_t encode_cell_data(const DATALAYER_BATTERY_SNAPSHOT& battery, uint8_t* out, size_t size);
+
+// Writes the data in base64 followed by a terminating zero. Returns the length of the text, or 0 if it does not fit.
+size_t encode_base64(const uint8_t* data, size_t length, char* out, size_t size);
+
+#endif
@@ -519,7 +519,7 @@ void update_pause_state() {
   }
 }
 
-std::string get_emulator_pause_status() {
+const char* get_emulator_pause_status() {
   switch (emulator_pause_status) {
     case NORMAL:
       return "RUNNING";
@@ -1,4 +1,5 @@
 #include "sdcard.h"
+#include "../../communication/can/can_log_format.h"
 #include "freertos/ringbuf.h"
 
 File can_log_file;
@@ -16,6 +17,25 @@ bool delete_log_file = false;
 
 bool sd_card_active = false;
 
+// Binary CAN records are collected into blocks and written once a block is full, or once no
+// frames came for CAN_LOG_FLUSH_MS. Blocks end on multiples of CAN_LOG_BLOCK_SIZE in the file,
+// so the SD card mostly sees whole sector writes.
+static uint8_t* can_write_block = nullptr;
+static size_t can_block_fill = 0;
+static size_t can_block_target = CAN_LOG_BLOCK_SIZE;
+static size_t can_log_file_size = 0;
+static unsigned long can_block_started_ms = 0;
+// Set by the writer when records were dropped, so the next frame carries its absolute time
+static volatile bool can_log_resync = true;
+
+// Stored MQTT messages, each as timestamp (4 bytes), topic length (2 bytes), payload length (2 bytes),
+// topic and payload. They are read back from the front, the file is removed once all have been read.
+static size_t mqtt_store_size = 0;
+static size_t mqtt_store_read_offset = 0;
+static const size_t MQTT_STORE_HEADER_SIZE = 8;
+
+static void open_can_log_file();
+
 void delete_can_log() {
   can_logging_paused = true;
   delete_can_file = true;
@@ -23,8 +43,7 @@ void delete_can_log() {
 
 void resume_can_writing() {
   can_logging_paused = false;
-  can_log_file = SD_MMC.open(CAN_LOG_FILE, FILE_APPEND);
-  can_file_open = true;
+  open_can_log_file();
 }
 
 void pause_can_writing() {
@@ -51,34 +70,53 @@ void pause_log_writing() {
   logging_paused = true;
 }
 
-void add_can_frame_to_buffer(CAN_frame frame, frameDirection msgDir) {
+void add_can_frame_to_buffer(const CAN_frame& frame, CAN_Interface interface, frameDirection msgDir,
+                             int64_t timestamp_us) {
 
   if (!sd_card_active)
     return;
 
-  unsigned long currentTime = millis();
-  static char messagestr_buffer[32];
-  size_t size = 0;
-  size = snprintf(messagestr_buffer + size, sizeof(messagestr_buffer) - size, "(%lu.%03lu) %s %lX [%u] ",
-                  currentTime / 1000, currentTime % 1000, (msgDir == MSG_RX ? "RX0" : "TX1"), frame.ID, frame.DLC);
+  static CanLogEncoder encoder;
+  static uint8_t record[CanLogEncoder::MAX_RECORD_SIZE];
 
-  if (xRingbufferSend(can_bufferHandle, &messagestr_buffer, size, pdMS_TO_TICKS(2)) != pdTRUE) {
+  if (can_log_resync) {
+    can_log_resync = false;
+    encoder.resync();
+  }
+
+  // One ring buffer item per frame
+  size_t size = encoder.encode(frame, interface, msgDir, timestamp_us, record);
+  if (xRingbufferSend(can_bufferHandle, record, size, pdMS_TO_TICKS(2)) != pdTRUE) {
+    // The next frame must not be timed relative to the lost one
+    encoder.resync();
     logging.println("Failed to send message to can ring buffer!");
-    return;
   }
+}
 
-  uint8_t i = 0;
-  for (i = 0; i < frame.DLC; i++) {
-    if (i < frame.DLC - 1)
-      size = snprintf(messagestr_buffer, sizeof(messagestr_buffer), "%02X ", frame.data.u8[i]);
-    else
-      size = snprintf(messagestr_buffer, sizeof(messagestr_buffer), "%02X\n", frame.data.u8[i]);
+static void open_can_log_file() {
+  can_log_file = SD_MMC.open(CAN_LOG_FILE, FILE_APPEND);
+  can_file_open = true;
+  can_log_file_size = can_log_file.size();
+  if (can_log_file_size == 0) {
+    can_log_file_size = can_log_file.write((const uint8_t*)CAN_LOG_MAGIC, CAN_LOG_MAGIC_SIZE);
+  }
+  // Fill the first block only up to the next block boundary of the file
+  can_block_target = CAN_LOG_BLOCK_SIZE - (can_log_file_size % CAN_LOG_BLOCK_SIZE);
+}
 
-    if (xRingbufferSend(can_bufferHandle, &messagestr_buffer, size, pdMS_TO_TICKS(2)) != pdTRUE) {
-      logging.println("Failed to send message to can ring buffer!");
-      return;
-    }
+static void write_can_block() {
+  if (can_block_fill == 0) {
+    return;
+  }
+  if (can_file_open == false) {
+    open_can_log_file();
   }
+
+  can_log_file.write(can_write_block, can_block_fill);
+  can_log_file.flush();
+  can_log_file_size += can_block_fill;
+  can_block_fill = 0;
+  can_block_target = CAN_LOG_BLOCK_SIZE - (can_log_file_size % CAN_LOG_BLOCK_SIZE);
 }
 
 void write_can_frame_to_sdcard() {
@@ -89,10 +127,12 @@ void write_can_frame_to_sdcard() {
   size_t receivedMessageSize;
   uint8_t* buffer = (uint8_t*)xRingbufferReceive(can_bufferHandle, &receivedMessageSize, pdMS_TO_TICKS(10));
 
-  if (buffer != NULL) {
+  // Take all frames waiting, so a block fills up with as few calls as possible
+  while (buffer != NULL) {
 
     if (can_logging_paused) {
       if (can_file_open) {
+        write_can_block();
         can_log_file.close();
         can_file_open = false;
       }
@@ -101,19 +141,40 @@ void write_can_frame_to_sdcard() {
         delete_can_file = false;
         can_logging_paused = false;
       }
+      can_block_fill = 0;
+      can_log_resync = true;
       vRingbufferReturnItem(can_bufferHandle, (void*)buffer);
       return;
     }
 
-    if (can_file_open == false) {
-      can_log_file = SD_MMC.open(CAN_LOG_FILE, FILE_APPEND);
-      can_file_open = true;
+    if (can_block_fill == 0) {
+      can_block_started_ms = millis();
     }
 
-    can_log_file.write(buffer, receivedMessageSize);
-    can_log_file.flush();
+    // A frame that crosses the block boundary is split over two blocks
+    size_t copied = 0;
+    while (copied < receivedMessageSize) {
+      if (can_block_fill >= can_block_target) {
+        write_can_block();
+      }
+      size_t chunk = can_block_target - can_block_fill;
+      if (chunk > receivedMessageSize - copied) {
+        chunk = receivedMessageSize - copied;
+      }
+      memcpy(can_write_block + can_block_fill, buffer + copied, chunk);
+      can_block_fill += chunk;
+      copied += chunk;
+    }
+    if (can_block_fill >= can_block_target) {
+      write_can_block();
+    }
 
     vRingbufferReturnItem(can_bufferHandle, (void*)buffer);
+    buffer = (uint8_t*)xRingbufferReceive(can_bufferHandle, &receivedMessageSize, 0);
+  }
+
+  if (can_block_fill > 0 && millis() - can_block_started_ms >= CAN_LOG_FLUSH_MS) {
+    write_can_block();
   }
 }
 
@@ -154,11 +215,86 @@ void write_log_to_sdcard() {
   }
 }
 
+bool store_mqtt_message(const char* topic, const uint8_t* payload, size_t length, unsigned long timestamp_ms) {
+  if (!sd_card_active)
+    return false;
+
+  const size_t topic_length = strlen(topic);
+  const size_t size = MQTT_STORE_HEADER_SIZE + topic_length + length;
+  if (topic_length > UINT16_MAX || length > UINT16_MAX || mqtt_store_size + size > MQTT_STORE_MAX_SIZE) {
+    return false;
+  }
+
+  File file = SD_MMC.open(MQTT_STORE_FILE, FILE_APPEND);
+  if (!file) {
+    return false;
+  }
+  const uint8_t header[MQTT_STORE_HEADER_SIZE] = {
+      (uint8_t)timestamp_ms,         (uint8_t)(timestamp_ms >> 8), (uint8_t)(timestamp_ms >> 16),
+      (uint8_t)(timestamp_ms >> 24), (uint8_t)topic_length,        (uint8_t)(topic_length >> 8),
+      (uint8_t)length,               (uint8_t)(length >> 8)};
+  size_t written = file.write(header, sizeof(header));
+  written += file.write((const uint8_t*)topic, topic_length);
+  written += file.write(payload, length);
+  file.close();
+
+  // A partly written message would make the rest of the file unreadable
+  if (written != size) {
+    delete_stored_mqtt_messages();
+    return false;
+  }
+  mqtt_store_size += size;
+  return true;
+}
+
+bool read_stored_mqtt_message(char* topic, size_t topic_size, uint8_t* payload, size_t payload_size, size_t& length,
+                              unsigned long& timestamp_ms) {
+  if (!sd_card_active || mqtt_store_size == 0)
+    return false;
+
+  File file = SD_MMC.open(MQTT_STORE_FILE, FILE_READ);
+  uint8_t header[MQTT_STORE_HEADER_SIZE];
+  if (!file || !file.seek(mqtt_store_read_offset) || file.read(header, sizeof(header)) != sizeof(header)) {
+    delete_stored_mqtt_messages();
+    return false;
+  }
+  timestamp_ms = header[0] | header[1] << 8 | header[2] << 16 | (uint32_t)header[3] << 24;
+  const size_t topic_length = header[4] | header[5] << 8;
+  length = header[6] | header[7] << 8;
+
+  // Messages that do not fit are skipped
+  bool fits = topic_length < topic_size && length <= payload_size;
+  if (fits) {
+    fits = file.read((uint8_t*)topic, topic_length) == topic_length && file.read(payload, length) == length;
+    topic[topic_length] = '\0';
+  }
+  file.close();
+
+  mqtt_store_read_offset += MQTT_STORE_HEADER_SIZE + topic_length + length;
+  if (mqtt_store_read_offset >= mqtt_store_size) {
+    delete_stored_mqtt_messages();
+  }
+  return fits;
+}
+
+bool has_stored_mqtt_messages() {
+  return mqtt_store_size > 0;
+}
+
+void delete_stored_mqtt_messages() {
+  if (sd_card_active) {
+    SD_MMC.remove(MQTT_STORE_FILE);
+  }
+  mqtt_store_size = 0;
+  mqtt_store_read_offset = 0;
+}
+
 void init_logging_buffers() {
 
   if (datalayer.system.info.CAN_SD_logging_active) {
-    can_bufferHandle = xRingbufferCreate(32 * 1024, RINGBUF_TYPE_BYTEBUF);
-    if (can_bufferHandle == NULL) {
+    can_bufferHandle = xRingbufferCreate(32 * 1024, RINGBUF_TYPE_NOSPLIT);
+    can_write_block = (uint8_t*)malloc(CAN_LOG_BLOCK_SIZE);
+    if (can_bufferHandle == NULL || can_write_block == NULL) {
       logging.println("Failed to create CAN ring buffer!");
       return;
     }
@@ -178,6 +314,8 @@ void deinit_logging_buffers() {
     if (can_bufferHandle != NULL) {
       vRingbufferDelete(can_bufferHandle);
     }
+    free(can_write_block);
+    can_write_block = nullptr;
     if (log_bufferHandle != NULL) {
       vRingbufferDelete(log_bufferHandle);
     }
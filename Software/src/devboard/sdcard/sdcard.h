@@ -6,8 +6,17 @@
 #include "../hal/hal.h"
 #include "../utils/events.h"
 
-#define CAN_LOG_FILE "/canlog.txt"
+// Binary, see communication/can/can_log_format.h
+#define CAN_LOG_FILE "/canlog.bin"
 #define LOG_FILE "/log.txt"
+// CAN log data is written to the card in blocks of this many bytes, a multiple of the 512 byte sector size
+#define CAN_LOG_BLOCK_SIZE 4096
+// Partly filled blocks are written once they are this old
+#define CAN_LOG_FLUSH_MS 1000
+// MQTT messages kept while the broker cannot be reached, replayed once it is back
+#define MQTT_STORE_FILE "/mqtt_store.bin"
+// Once the file has grown this large, further messages are not kept
+#define MQTT_STORE_MAX_SIZE (8 * 1024 * 1024)
 
 void init_logging_buffers();
 void deinit_logging_buffers();
@@ -15,7 +24,8 @@ void deinit_logging_buffers();
 bool init_sdcard();
 void log_sdcard_details();
 
-void add_can_frame_to_buffer(CAN_frame frame, frameDirection msgDir);
+void add_can_frame_to_buffer(const CAN_frame& frame, CAN_Interface interface, frameDirection msgDir,
+                             int64_t timestamp_us);
 void write_can_frame_to_sdcard();
 
 void pause_can_writing();
@@ -28,4 +38,12 @@ void pause_log_writing();
 void add_log_to_buffer(const uint8_t* buffer, size_t size);
 void write_log_to_sdcard();
 
+// Appends a message to MQTT_STORE_FILE, returns false if the card is missing or the file is full
+bool store_mqtt_message(const char* topic, const uint8_t* payload, size_t length, unsigned long timestamp_ms);
+// Takes the oldest stored message. Returns false when there is none, or it does not fit the buffers.
+bool read_stored_mqtt_message(char* topic, size_t topic_size, uint8_t* payload, size_t payload_size, size_t& length,
+                              unsigned long& timestamp_ms);
+bool has_stored_mqtt_messages();
+void delete_stored_mqtt_messages();
+
 #endif  // SDCARD_H
@@ -11,6 +11,7 @@ typedef struct {
 
 /* Local variables */
 static EVENT_TYPE events;
+static uint32_t events_generation = 0;
 static const char* EVENTS_ENUM_TYPE_STRING[] = {EVENTS_ENUM_TYPE(GENERATE_STRING)};
 static const char* EVENTS_LEVEL_TYPE_STRING[] = {EVENTS_LEVEL_TYPE(GENERATE_STRING)};
 static const char* EMULATOR_STATUS_STRING[] = {EMULATOR_STATUS(GENERATE_STRING)};
@@ -28,6 +29,7 @@ void init_events(void) {
     events.entries[i].occurences = 0;
     events.entries[i].MQTTpublished = false;  // Not published by default
   }
+  events_generation++;
 
   events.entries[EVENT_CANMCP2517FD_INIT_FAILURE].level = EVENT_LEVEL_WARNING;
   events.entries[EVENT_CANMCP2515_INIT_FAILURE].level = EVENT_LEVEL_WARNING;
@@ -151,6 +153,7 @@ void set_event_latched(EVENTS_ENUM_TYPE event, uint8_t data) {
 void clear_event(EVENTS_ENUM_TYPE event) {
   if (events.entries[event].state == EVENT_STATE_ACTIVE) {
     events.entries[event].state = EVENT_STATE_INACTIVE;
+    events_generation++;
     update_event_level();
     update_bms_status();
   }
@@ -164,6 +167,7 @@ void reset_all_events() {
     events.entries[i].occurences = 0;
     events.entries[i].MQTTpublished = false;  // Not published by default
   }
+  events_generation++;
   events.level = EVENT_LEVEL_INFO;
   update_bms_status();
 }
@@ -416,8 +420,12 @@ const char* get_event_level_string(EVENTS_ENUM_TYPE event) {
 }
 
 const char* get_event_level_string(EVENTS_LEVEL_TYPE event_level) {
-  // Return the event level but skip "EVENT_LEVEL_TYPE_" that should always be first
-  return EVENTS_LEVEL_TYPE_STRING[event_level] + 17;
+  // Return the event level but skip "EVENT_LEVEL_" that should always be first
+  return EVENTS_LEVEL_TYPE_STRING[event_level] + 12;
+}
+
+uint32_t get_events_generation() {
+  return events_generation;
 }
 
 const EVENTS_STRUCT_TYPE* get_event_pointer(EVENTS_ENUM_TYPE event) {
@@ -466,11 +474,17 @@ static void set_event(EVENTS_ENUM_TYPE event, uint8_t data, bool latched) {
     DEBUG_PRINTF("Event: %s\n", get_event_message_string(event).c_str());
   }
 
+  // A repeated set of an active event only refreshes its timestamp
+  const EVENTS_STATE_TYPE state = latched ? EVENT_STATE_ACTIVE_LATCHED : EVENT_STATE_ACTIVE;
+  if (events.entries[event].state != state || events.entries[event].data != data) {
+    events_generation++;
+  }
+
   // We should set the event, update event info
   events.entries[event].timestamp = millis64();
   events.entries[event].data = data;
   // Check if the event is latching
-  events.entries[event].state = latched ? EVENT_STATE_ACTIVE_LATCHED : EVENT_STATE_ACTIVE;
+  events.entries[event].state = state;
 
   // Update event level, only upwards. Downward changes are done in Software.ino:loop()
   events.level = (EVENTS_LEVEL_TYPE)max(events.level, events.entries[event].level);
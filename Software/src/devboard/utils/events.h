@@ -182,6 +182,8 @@ void reset_all_events();
 void set_event_MQTTpublished(EVENTS_ENUM_TYPE event);
 
 const EVENTS_STRUCT_TYPE* get_event_pointer(EVENTS_ENUM_TYPE event);
+// Changes whenever an event is set, cleared or set with other data, but not when an active event is set again
+uint32_t get_events_generation();
 
 bool compareEventsByTimestampAsc(const EventData& a, const EventData& b);
 bool compareEventsByTimestampDesc(const EventData& a, const EventData& b);
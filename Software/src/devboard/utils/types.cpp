@@ -1,7 +1,7 @@
 #include "types.h"
 
 // Function to get string representation of bms_status_enum
-std::string getBMSStatus(bms_status_enum status) {
+const char* getBMSStatus(bms_status_enum status) {
   switch (status) {
     case STANDBY:
       return "STANDBY";
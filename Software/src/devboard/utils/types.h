@@ -89,6 +89,20 @@ enum CAN_Interface {
 
 extern const char* getCANInterfaceName(CAN_Interface interface);
 
+// When a CAN controller cannot take more frames, queued frames are sent in this order
+enum CAN_TX_Priority {
+  // Frames the battery, shunt or contactors need to stay online
+  CAN_TX_SAFETY = 0,
+
+  // Limits and status towards the inverter or charger
+  CAN_TX_INVERTER = 1,
+
+  // Diagnostic requests and polling (UDS, OBD), CAN replay
+  CAN_TX_DIAGNOSTIC = 2,
+
+  CAN_TX_PRIORITY_COUNT = 3
+};
+
 /* CAN Frame structure */
 typedef struct {
   bool FD;
@@ -109,7 +123,12 @@ typedef struct {
   frameDirection direction;
 } CAN_log_frame;
 
-std::string getBMSStatus(bms_status_enum status);
+typedef struct {
+  CAN_frame frame;
+  int64_t timestamp_us;  // esp_timer_get_time() when the frame was taken from the CAN driver
+} CAN_rx_frame;
+
+const char* getBMSStatus(bms_status_enum status);
 
 #ifdef HW_LILYGO2CAN
 /* Configurable GPIO options (device specific) */
@@ -47,76 +47,97 @@ std::vector<BatteryCommand> battery_commands = {
      [](Battery* b) { b->reset_energy_saving_mode(); }},
 };
 
-String advanced_battery_processor(const String& var) {
-  if (var == "X") {
-    String content = "";
-    //Page format
-    content += "<style>";
-    content += "body { background-color: black; color: white; }";
-    content +=
-        "button { background-color: #505E67; color: white; border: none; padding: 10px 20px; margin: 5px; "
-        "cursor: pointer; border-radius: 10px; }";
-    content += "button:hover { background-color: #3A4A52; }";
-    content += "h4 { margin: 0.6em 0; line-height: 1.2; }";
-    content += "</style>";
-    content += "<button onclick='goToMainPage()'>Back to main page</button>";
-
-    // Start a new block with a specific background color
-    content += "<div style='background-color: #303E47; padding: 10px; margin-bottom: 10px;border-radius: 50px'>";
+// Button and script for one command, if the battery supports it
+static void render_command_button(HtmlStream& out, const BatteryCommand& cmd, Battery* batt, int ix) {
+  if (!cmd.condition(batt)) {
+    return;
+  }
+  // Button for user action
+  out.print("<button onclick='ask");
+  out.print(cmd.identifier);
+  out.printf("(%d)'>", ix);
+  out.print(cmd.title);
+  out.print("</button>");
 
-    // Render buttons dynamically based on what commands the battery supports.
-    auto render_command_buttons = [&content](Battery* batt, int ix) {
-      for (const auto& cmd : battery_commands) {
-        if (cmd.condition(batt)) {
-          // Button for user action
-          content += "<button onclick='ask" + String(cmd.identifier) + "(" + String(ix) + ")'>" + String(cmd.title) +
-                     "</button>";
+  // Script that calls the backend to perform the command
+  out.print("<script>");
+  out.print("function ask");
+  out.print(cmd.identifier);
+  out.print("(batteryNum) { ");
 
-          // Script that calls the backend to perform the command
-          content += "<script>";
-          content += "function ask" + String(cmd.identifier) + "(batteryNum) { ";
+  if (cmd.prompt) {
+    out.print("if (window.confirm('Are you sure you want to ");
+    out.print(cmd.prompt);
+    out.print("'))");
+  }
 
-          if (cmd.prompt) {
-            content += "if (window.confirm('Are you sure you want to " + String(cmd.prompt) + "'))";
-          }
+  out.print("{");
+  out.print(cmd.identifier);
+  out.print("(batteryNum); } }");
+  out.print("function ");
+  out.print(cmd.identifier);
+  out.print("(batteryNum) {");
+  out.print("  var xhr = new XMLHttpRequest();");
+  out.print("  xhr.open('PUT', '/");
+  out.print(cmd.identifier);
+  out.print("', true);");
+  // Send index of the battery as PUT content
+  out.print("  xhr.send(batteryNum);");
+  out.print("}");
+  out.print("</script>");
+}
 
-          content += "{" + String(cmd.identifier) + "(batteryNum); } }";
-          content += "function " + String(cmd.identifier) + "(batteryNum) {";
-          content += "  var xhr = new XMLHttpRequest();";
-          content += "  xhr.open('PUT', '/" + String(cmd.identifier) + "', true);";
-          // Send index of the battery as PUT content
-          content += "  xhr.send(batteryNum);";
-          content += "}";
-          content += "</script>";
-        }
-      }
-    };
+bool advanced_battery_page(HtmlStream& out, uint16_t step) {
+  if (step == 0) {
+    //Page format
+    out.print("<style>");
+    out.print("body { background-color: black; color: white; }");
+    out.print(
+        "button { background-color: #505E67; color: white; border: none; padding: 10px 20px; margin: 5px; "
+        "cursor: pointer; border-radius: 10px; }");
+    out.print("button:hover { background-color: #3A4A52; }");
+    out.print("h4 { margin: 0.6em 0; line-height: 1.2; }");
+    out.print("</style>");
+    out.print("<button onclick='goToMainPage()'>Back to main page</button>");
 
-    if (battery) {
-      content += battery->get_status_renderer().get_status_html();
-      render_command_buttons(battery, 0);
-    }
+    // Start a new block with a specific background color
+    out.print("<div style='background-color: #303E47; padding: 10px; margin-bottom: 10px;border-radius: 50px'>");
+    return true;
+  }
 
-    if (battery2) {
-      content += "<h4>Values from battery 2</h4>";
-      content += battery2->get_status_renderer().get_status_html();
-      render_command_buttons(battery2, 1);
+  // Each battery has a step for its values and then one per command it may support
+  const uint16_t steps_per_battery = 1 + battery_commands.size();
+  const uint16_t battery_step = step - 1;
+  const uint8_t index = battery_step / steps_per_battery;
+  if (index < 3) {
+    Battery* batteries[3] = {battery, battery2, battery3};
+    Battery* batt = batteries[index];
+    if (batt == nullptr) {
+      return true;
     }
-
-    if (battery3) {
-      content += "<h4>Values from battery 3</h4>";
-      content += battery3->get_status_renderer().get_status_html();
-      render_command_buttons(battery3, 1);
+    const uint16_t part = battery_step % steps_per_battery;
+    if (part == 0) {
+      if (index > 0) {
+        out.printf("<h4>Values from battery %d</h4>", index + 1);
+      }
+      // Rendered by the battery into one String, held until this step is sent. The page therefore peaks at
+      // the size of the largest battery block, which is several KB for e.g. Tesla.
+      out.print(batt->get_status_renderer().get_status_html());
+    } else {
+      // The third battery sends its commands to the second one, as it always did
+      render_command_button(out, battery_commands[part - 1], batt, index > 0 ? 1 : 0);
     }
+    return true;
+  }
 
-    content += "</div>";
-
-    content += "<script>";
-    content += "function exportLog() { window.location.href = '/export_log'; }";
-    content += "function goToMainPage() { window.location.href = '/'; }";
-    content += "</script>";
+  if (battery_step == 3 * steps_per_battery) {
+    out.print("</div>");
 
-    return content;
+    out.print("<script>");
+    out.print("function exportLog() { window.location.href = '/export_log'; }");
+    out.print("function goToMainPage() { window.location.href = '/'; }");
+    out.print("</script>");
+    return true;
   }
-  return String();
+  return false;
 }
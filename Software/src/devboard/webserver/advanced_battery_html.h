@@ -3,15 +3,17 @@
 
 #include <Arduino.h>
 #include <string>
+#include "html_stream.h"
 
 /**
- * @brief Replaces placeholder with content section in web page
+ * @brief Renders a step of the advanced battery info web page
  *
- * @param[in] var
+ * @param[in] out
+ * @param[in] step
  *
- * @return String
+ * @return bool false once the page is complete
  */
-String advanced_battery_processor(const String& var);
+bool advanced_battery_page(HtmlStream& out, uint16_t step);
 
 class Battery;
 
@@ -0,0 +1,152 @@
+// Draws the cells of each battery as blocks and as a bar graph. The page calls cellMonitor() once per
+// battery with the values it was rendered with, after that they are redrawn from the live updates of /live.
+const cellMonitors = {};
+
+function home() { window.location.href = '/'; }
+
+// Arduino-style map() function
+function map(value, fromLow, fromHigh, toLow, toHigh) {
+  return (value - fromLow) * (toHigh - toLow) / (fromHigh - fromLow) + toLow;
+}
+
+function drawCells(battery) {
+  const n = battery.name;
+  const data = battery.data;
+  const balancing = battery.balancing;
+  const graphContainer = document.getElementById('graph' + n);
+  const valueDisplay = document.getElementById('valueDisplay' + n);
+  const cellContainer = document.getElementById('cellContainer' + n);
+  graphContainer.innerHTML = '';
+  cellContainer.innerHTML = '';
+
+  // If we have values, do the thing. Otherwise, display friendly message and wait
+  if (data.length == 0) {
+    document.getElementById('voltageValues' + n).textContent = battery.empty;
+    return;
+  }
+  const min_mv = Math.min(...data);
+  const max_mv = Math.max(...data);
+  const min_index = data.indexOf(min_mv);
+  const max_index = data.indexOf(max_mv);
+
+  // For each value, add a cell block with its value
+  data.forEach((mV, index) => {
+    const cell = document.createElement('div');
+    cell.className = 'cell';
+    cell.id = `cellIndex${n}${index}`;
+    let cellContent = `Cell ${index + 1}<br>${mV} mV`;
+    if (mV < 3000) {
+      cellContent = `<span class='low-voltage'>${cellContent}</span>`;
+    }
+    cell.innerHTML = cellContent;
+
+    cell.addEventListener('mouseenter', () => {
+      let bar = document.getElementById(`barIndex${n}${index}`);
+      valueDisplay.textContent = `Value: ${mV}`;
+      bar.style.backgroundColor = balancing[index] ? '#80FFFF' : 'lightblue'; // Lighter cyan if balancing
+      cell.style.backgroundColor = balancing[index] ? '#006666' : 'blue';     // Darker cyan if balancing
+    });
+
+    cell.addEventListener('mouseleave', () => {
+      let bar = document.getElementById(`barIndex${n}${index}`);
+      bar.style.backgroundColor = balancing[index] ? '#00FFFF' : 'blue'; // Restore original color
+      cell.style.removeProperty('background-color');
+    });
+
+    cellContainer.appendChild(cell);
+  });
+
+  // Basically get the mV, scale the height and add a bar div to its container
+  data.forEach((mV, index) => {
+    const bar = document.createElement('div');
+    const mV_limited = map(mV, min_mv - battery.margin, max_mv + battery.margin, battery.margin, 10 * battery.margin);
+    bar.className = 'bar';
+    bar.id = `barIndex${n}${index}`;
+    bar.style.height = `${mV_limited}px`;
+    bar.style.width = `${750/data.length}px`;
+    if (balancing[index]) {
+      bar.style.backgroundColor = '#00FFFF'; // Cyan color for balancing
+      bar.style.borderColor = '#00FFFF';
+    } else {
+      bar.style.backgroundColor = 'blue'; // Normal blue for non-balancing
+      bar.style.borderColor = 'white';
+    }
+
+    const cell = document.getElementById(`cellIndex${n}${index}`);
+
+    // Mark cell and bar with highest/lowest values
+    if ((index == min_index) || (index == max_index)) {
+      cell.style.borderColor = 'red';
+      bar.style.borderColor = 'red';
+    }
+
+    bar.addEventListener('mouseenter', () => {
+      valueDisplay.textContent = `Value: ${mV}` + (balancing[index] ? ' (balancing)' : '');
+      bar.style.backgroundColor = balancing[index] ? '#80FFFF' : 'lightblue';
+      cell.style.backgroundColor = balancing[index] ? '#006666' : 'blue';
+    });
+
+    bar.addEventListener('mouseleave', () => {
+      valueDisplay.textContent = 'Value: ...';
+      bar.style.backgroundColor = balancing[index] ? '#00FFFF' : 'blue'; // Restore cyan if balancing, else blue
+      cell.style.removeProperty('background-color');
+    });
+
+    graphContainer.appendChild(bar);
+  });
+
+  // Update the header of max/min/deviation client-side for consistency
+  document.getElementById('voltageValues' + n).innerHTML = `${battery.title}Max Voltage : ${max_mv} mV<br>` +
+    `Min Voltage: ${min_mv} mV<br>Voltage Deviation: ${max_mv - min_mv} mV${battery.note}`;
+}
+
+// name is '', '2' or '3', as in the ids of the elements of the battery. voltages and balancing leave out
+// the cells reading 0 mV. options: title before the voltages, note after the deviation, empty, the message
+// shown while there are no voltages, and margin, the mV around the lowest and highest cell in the graph.
+function cellMonitor(name, voltages, balancing, options) {
+  const battery = Object.assign({name: name, title: '', note: '', empty: '', margin: 20}, options);
+  battery.data = voltages;
+  battery.balancing = balancing;
+  // The voltages of all cells and the balancing mask, as last received from /live
+  battery.mv = null;
+  battery.mask = null;
+  cellMonitors[name == '' ? '' : '_' + name] = battery;
+  drawCells(battery);
+}
+
+// Redraws a battery once live updates brought both its voltages and balancing flags
+function liveRedraw(suffix) {
+  const battery = cellMonitors[suffix];
+  if (!battery || battery.mv === null || battery.mask === null) return;
+  const mask = battery.mask;
+  const mv = battery.mv;
+  battery.data = mv.filter(v => v != 0);
+  battery.balancing = mv.map((v, i) => ((parseInt(mask.substr((i >> 3) * 2, 2), 16) || 0) >> (i & 7) & 1) == 1)
+    .filter((b, i) => mv[i] != 0);
+  drawCells(battery);
+}
+
+function reloadLater() { setTimeout(function(){ location.reload(true); }, 20000); }
+
+// Starts the live updates, called once all batteries are set up
+function cellMonitorLive() {
+  if (!window.EventSource) {
+    reloadLater();
+    return;
+  }
+  const live = new EventSource('/live');
+  ['', '_2', '_3'].forEach(function(suffix) {
+    live.addEventListener('cells' + suffix, function(e) {
+      const cells = JSON.parse(e.data);
+      if (!cellMonitors[suffix]) return;
+      cellMonitors[suffix].mv = cells.cell_delta_mV.map(delta => delta + cells.cell_base_mV);
+      liveRedraw(suffix);
+    });
+    live.addEventListener('balancing' + suffix, function(e) {
+      if (!cellMonitors[suffix]) return;
+      cellMonitors[suffix].mask = JSON.parse(e.data).cell_balancing_mask;
+      liveRedraw(suffix);
+    });
+  });
+  live.onerror = function() { if (live.readyState == EventSource.CLOSED) reloadLater(); };
+}
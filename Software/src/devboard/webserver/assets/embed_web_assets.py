@@ -0,0 +1,82 @@
+# Compresses the static files of the web pages in this directory with gzip and embeds them in
+# web_assets_data.cpp, from where the webserver sends them as they are.
+#
+# PlatformIO runs this before each build (extra_scripts in platformio.ini), the file is only rewritten when
+# an asset changed. It can also be run by hand: python embed_web_assets.py
+import gzip
+import os
+import zlib
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO
+    PROJECT_DIR = env.subst("$PROJECT_DIR")  # noqa: F821
+    ASSETS_DIR = os.path.join(PROJECT_DIR, "Software", "src", "devboard", "webserver", "assets")
+except NameError:
+    ASSETS_DIR = os.path.dirname(os.path.abspath(__file__))
+
+OUTPUT = os.path.join(os.path.dirname(ASSETS_DIR), "web_assets_data.cpp")
+
+CONTENT_TYPES = {
+    ".css": "text/css",
+    ".js": "text/javascript",
+}
+
+
+def c_name(file_name):
+    return file_name.replace(".", "_").replace("-", "_")
+
+
+def embed(file_name):
+    with open(os.path.join(ASSETS_DIR, file_name), "rb") as f:
+        source = f.read()
+    # No time stamp in the header, so the same asset always compresses to the same bytes
+    data = gzip.compress(source, compresslevel=9, mtime=0)
+    version = "%08x" % zlib.crc32(source)
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in data[i : i + 16]) + ",")
+    array = "static const uint8_t %s[] = {\n%s\n};\n" % (c_name(file_name), "\n".join(lines))
+    entry = '    {"/assets/%s", "/assets/%s?v=%s", "%s", "\\"%s\\"", %s, sizeof(%s)},' % (
+        file_name,
+        file_name,
+        version,
+        CONTENT_TYPES[os.path.splitext(file_name)[1]],
+        version,
+        c_name(file_name),
+        c_name(file_name),
+    )
+    return array, entry
+
+
+def generate():
+    files = sorted(f for f in os.listdir(ASSETS_DIR) if os.path.splitext(f)[1] in CONTENT_TYPES)
+    arrays = []
+    entries = []
+    for file_name in files:
+        array, entry = embed(file_name)
+        arrays.append(array)
+        entries.append(entry)
+
+    text = (
+        "// Generated by assets/embed_web_assets.py from the files in assets/, do not edit\n"
+        '#include "web_assets.h"\n'
+        "\n"
+        "// clang-format off\n"
+        + "\n".join(arrays)
+        + "\n"
+        "const WebAsset web_assets[] = {\n" + "\n".join(entries) + "\n};\n"
+        "const size_t web_asset_count = sizeof(web_assets) / sizeof(web_assets[0]);\n"
+        "// clang-format on\n"
+    )
+
+    old = None
+    if os.path.exists(OUTPUT):
+        with open(OUTPUT, "r", newline="\n") as f:
+            old = f.read()
+    if text != old:
+        with open(OUTPUT, "w", newline="\n") as f:
+            f.write(text)
+        print("Embedded %d web assets in %s" % (len(files), OUTPUT))
+
+
+generate()
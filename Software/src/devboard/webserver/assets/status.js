@@ -0,0 +1,51 @@
+function OTA() { window.location.href = '/update'; }
+function Cellmon() { window.location.href = '/cellmonitor'; }
+function Settings() { window.location.href = '/settings'; }
+function Advanced() { window.location.href = '/advanced'; }
+function CANlog() { window.location.href = '/canlog'; }
+function CANreplay() { window.location.href = '/canreplay'; }
+function CANstats() { window.location.href = '/canstats'; }
+function Log() { window.location.href = '/log'; }
+function Events() { window.location.href = '/events'; }
+function logout() {
+  var xhr = new XMLHttpRequest();
+  xhr.open('GET', '/logout', true);
+  xhr.send();
+  setTimeout(function(){ window.open("/","_self"); }, 1000);
+}
+function PauseBattery(pause){
+  var xhr=new XMLHttpRequest();xhr.onload=function() { window.location.reload();};xhr.open('GET','/pause?value='+pause,true);xhr.send();
+}
+function estop(stop){
+  var xhr=new XMLHttpRequest();xhr.onload=function() { window.location.reload();};xhr.open('GET','/equipmentStop?value='+stop,true);xhr.send();
+}
+
+// Keeps the battery values up to date from /live. The span of a value has the key of the value in the
+// updates as its id. Without live updates the page reloads instead.
+const liveFormat = {SOC: 2, SOC_real: 2, state_of_health: 2, battery_voltage: 1, battery_current: 1,
+  temperature_min: 1, temperature_max: 1, cell_voltage_delta: 0, cell_min_voltage: 'mV',
+  cell_max_voltage: 'mV', stat_batt_power: 'W', max_discharge_power: 'W', max_charge_power: 'W',
+  total_capacity: 'Wh', remaining_capacity: 'Wh', remaining_capacity_real: 'Wh'};
+function liveText(format, value) {
+  if (format == 'mV') return Math.round(value * 1000);
+  if (format == 'W' || format == 'Wh') {
+    const unit = format == 'Wh' ? 'h' : '';
+    return Math.abs(value) >= 1000 ? (value / 1000).toFixed(1) + ' kW' + unit : value.toFixed(0) + ' W' + unit;
+  }
+  return value.toFixed(format);
+}
+function reloadLater() { setTimeout(function(){ location.reload(true); }, 15000); }
+if (window.EventSource) {
+  const live = new EventSource('/live');
+  live.addEventListener('status', function(e) {
+    const values = JSON.parse(e.data);
+    for (const key in values) {
+      const element = document.getElementById(key);
+      const format = liveFormat[key.replace(/_[23]$/, '')];
+      if (element && format !== undefined) element.textContent = liveText(format, values[key]);
+    }
+  });
+  live.onerror = function() { if (live.readyState == EventSource.CLOSED) reloadLater(); };
+} else {
+  reloadLater();
+}
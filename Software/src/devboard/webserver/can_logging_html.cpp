@@ -1,16 +1,15 @@
 #include "can_logging_html.h"
 #include <Arduino.h>
+#include "../../communication/can/can_log_format.h"
 #include "../../communication/can/comm_can.h"
 #include "../../datalayer/datalayer.h"
 #include "index_html.h"
 
+// The page only shows the latest frames, the export has all of them
+#define CAN_LOG_PAGE_FRAMES 300
+
 String can_logger_processor(void) {
-  if (!datalayer.system.info.can_logging_active) {
-    datalayer.system.info.logged_can_messages_offset = 0;
-    datalayer.system.info.logged_can_messages[0] = '\0';
-  }
-  datalayer.system.info.can_logging_active =
-      true;  // Signal to main loop that we should log messages. Disabled by default for performance reasons
+  start_can_web_log();  // Signal to main loop that we should log messages. Disabled by default for performance reasons
   String content = index_html_header;
   // Page format
   content += "<style>";
@@ -42,19 +41,34 @@ String can_logger_processor(void) {
   content += "<div style='background-color: #303E47; padding: 20px; border-radius: 15px'>";
 
   // Check for messages
-  if (datalayer.system.info.logged_can_messages[0] == 0) {
+  std::vector<uint8_t> records;
+  int64_t start_us;
+  const uint32_t frames = copy_can_web_log(records, start_us);
+  if (frames == 0) {
     content += "CAN logger started! Refresh page to display incoming(RX) and outgoing(TX) messages";
   } else {
-    // Split the messages using the newline character
-    String messages = String(datalayer.system.info.logged_can_messages);
-    int startIndex = 0;
-    int endIndex = messages.indexOf('\n');
-    while (endIndex != -1) {
-      // Extract a single message and wrap it in a styled div
-      String singleMessage = messages.substring(startIndex, endIndex);
-      content += "<div class='can-message'>" + singleMessage + "</div>";
-      startIndex = endIndex + 1;  // Move past the newline character
-      endIndex = messages.indexOf('\n', startIndex);
+    const uint32_t skipped = frames > CAN_LOG_PAGE_FRAMES ? frames - CAN_LOG_PAGE_FRAMES : 0;
+    if (skipped > 0) {
+      content += "<div>Showing the latest " + String(CAN_LOG_PAGE_FRAMES) + " of " + String(frames) +
+                 " messages, export to get all of them</div>";
+    }
+
+    CanLogDecoder decoder(start_us);
+    CanLogRecord record;
+    char line[256];
+    size_t offset = 0;
+    size_t used;
+    uint32_t index = 0;
+    while ((used = decoder.next(records.data() + offset, records.size() - offset, record)) > 0) {
+      offset += used;
+      if (index++ < skipped) {
+        continue;
+      }
+      // Wrap each message in a styled div, without its newline
+      const size_t length = format_can_log_line(record, line, sizeof(line));
+      content += "<div class='can-message'>";
+      content.concat(line, length - 1);
+      content += "</div>";
     }
   }
 
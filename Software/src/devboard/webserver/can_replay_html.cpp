@@ -1,15 +1,24 @@
 #include "can_replay_html.h"
 #include <Arduino.h>
+#include "../../communication/can/can_replay.h"
+#include "../../communication/can/comm_can.h"
 #include "../../datalayer/datalayer.h"
 #include "index_html.h"
 
-String can_replay_processor(void) {
-  if (!datalayer.system.info.can_logging_active) {
-    datalayer.system.info.logged_can_messages_offset = 0;
-    datalayer.system.info.logged_can_messages[0] = '\0';
+String can_replay_report_text() {
+  const CanReplayReport& report = get_can_replay_report();
+  String text = can_replay_running() ? "Running. " : "Stopped. ";
+  if (report.frames > 0) {
+    text += String(report.frames) + " frames at " + String(report.speed, 2) + "x speed in " +
+            String(report.achieved_duration_us / 1000) + " ms, intended " +
+            String(report.intended_duration_us / 1000) + " ms. Timing error mean " +
+            String((long)report.mean_error_us()) + " us, max " + String((long)report.max_error_us) + " us.";
   }
-  datalayer.system.info.can_logging_active =
-      true;  // Signal to main loop that we should log messages. Disabled by default for performance reasons
+  return text;
+}
+
+String can_replay_processor(void) {
+  start_can_web_log();  // Signal to main loop that we should log messages. Disabled by default for performance reasons
   String content = index_html_header;
   // Page format
   content += "<style>";
@@ -51,14 +60,20 @@ String can_replay_processor(void) {
   content += "<button onclick='sendCANSelection()'>Apply</button>";
 
   content += "<h3>Step 2: Upload CAN Log File</h3>";
-  content += "<p>Click Browse to select a .txt CANdump log file to upload</p>";
-  content += "<input type='file' id='file-input' accept='.txt'>";
+  content +=
+      "<p>Click Browse to select a .txt CANdump log file, or a .bin log from the SD card, to upload. It is stored "
+      "in flash and replaces the previous one.</p>";
+  content += "<input type='file' id='file-input' accept='.txt,.bin'>";
   content += "<button id='upload-btn'>Upload</button>";
 
   content += "<h3>Step 3: Playback control</h3>";
+  content +=
+      "<p>Frames are sent from the main loop, each within about 1 ms of its offset in the log divided by the "
+      "speed.</p>";
 
   //Checkbox to see if the user wants the log to repeat once it reaches the end
   content += "<input type=\"checkbox\" id=\"loopCheckbox\"> Loop ";
+  content += "Speed <input type='number' id='speed' value='1' min='0.1' max='10' step='0.1' style='width:4em'>x ";
 
   // Add a button to start playing the log
   content += "<button onclick='startReplay()'>Start</button> ";
@@ -68,6 +83,7 @@ String can_replay_processor(void) {
 
   // Status indicator
   content += "<span id='statusIndicator' style='margin-left:10px; font-weight:bold;'>Stopped</span> ";
+  content += "<p id='replayReport'>" + can_replay_report_text() + "</p>";
 
   content += "<h3>Uploaded Log Preview:</h3>";
   content += "<pre id='file-content'></pre>";
@@ -87,9 +103,10 @@ String can_replay_processor(void) {
   content += "const xhr = new XMLHttpRequest();";
   content += "xhr.open('POST', '/import_can_log', true);";
   content +=
-      "xhr.onload = () => { if (xhr.status === 200) { alert('File uploaded successfully!'); const reader = new "
-      "FileReader(); reader.onload = function (e) { fileContent.textContent = e.target.result; }; "
-      "reader.readAsText(selectedFile); } else { alert('Upload failed! Server error.'); }};";
+      "xhr.onload = () => { if (xhr.status === 200) { alert(xhr.responseText); if "
+      "(selectedFile.name.endsWith('.txt')) { const reader = new FileReader(); reader.onload = function (e) { "
+      "fileContent.textContent = e.target.result; }; reader.readAsText(selectedFile); } } else { alert('Upload "
+      "failed! ' + xhr.responseText); }};";
   content += "xhr.send(formData);";
   content += "});";
   content += "</script>";
@@ -100,21 +117,28 @@ String can_replay_processor(void) {
   content += "<script>";
   content += "function startReplay() {";
   content += "  let loop = document.getElementById('loopCheckbox').checked ? 1 : 0;";
-  content += "  fetch('/startReplay?loop=' + loop, { method: 'GET' })";
+  content += "  let speed = document.getElementById('speed').value;";
+  content += "  fetch('/startReplay?loop=' + loop + '&speed=' + speed, { method: 'GET' })";
   content += "    .then(response => response.text())";
   content += "    .then(data => {";
   content += "      console.log(data);";
   content += "      document.getElementById('statusIndicator').innerText = 'Running...';";
   content += "      document.getElementById('statusIndicator').style.color = 'green';";
-  content += "      if (loop === 0) {";  // If loop is not checked
-  content += "        setTimeout(() => {";
-  content += "          document.getElementById('statusIndicator').innerText = 'Completed';";
-  content += "          document.getElementById('statusIndicator').style.color = 'white';";
-  content += "        }, 5000);";  // 5-second timeout before reverting the text
-  content += "      }";
+  content += "      updateReport();";
   content += "    })";
   content += "    .catch(error => console.error('Error:', error));";
   content += "}";
+  content += "function updateReport() {";  // Polled while the replay runs
+  content += "  fetch('/replayReport').then(response => response.text()).then(text => {";
+  content += "    document.getElementById('replayReport').innerText = text;";
+  content += "    if (text.startsWith('Running')) { setTimeout(updateReport, 1000); return; }";
+  content += "    let status = document.getElementById('statusIndicator');";
+  content += "    if (status.innerText !== 'Stopped') {";
+  content += "      status.innerText = 'Completed';";
+  content += "      status.style.color = 'white';";
+  content += "    }";
+  content += "  });";
+  content += "}";
   content += "function stopReplay() {";
   content += "  fetch('/stopReplay', { method: 'GET' })";
   content += "    .then(response => response.text())";
@@ -122,6 +146,7 @@ String can_replay_processor(void) {
   content += "      console.log(data);";
   content += "      document.getElementById('statusIndicator').innerText = 'Stopped';";
   content += "      document.getElementById('statusIndicator').style.color = 'red';";
+  content += "      updateReport();";
   content += "    })";
   content += "    .catch(error => console.error('Error:', error));";
   content += "}";
@@ -13,4 +13,11 @@
  */
 String can_replay_processor(void);
 
+/**
+ * @brief State of the CAN replay and timing of the last one, as text
+ *
+ * @return String
+ */
+String can_replay_report_text();
+
 #endif
@@ -0,0 +1,181 @@
+#include "can_stats_html.h"
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "../../battery/BATTERIES.h"
+#include "../../communication/can/can_stats.h"
+#include "../../communication/can/comm_can.h"
+#include "../../communication/can/uds_poll_scheduler.h"
+
+const char CAN_STATS_HTML_STYLE[] = R"=====(
+<style>body{background-color:#000;color:#fff}button{background-color:#505E67;color:#fff;border:none;padding:10px 20px;margin-bottom:20px;cursor:pointer;border-radius:10px}button:hover{background-color:#3A4A52}.bus{background-color:#303e47;padding:10px;margin-bottom:10px;border-radius:25px}table{border-collapse:collapse;width:100%}th,td{padding:4px 8px;text-align:right}th{background-color:#1e2c33}tr:nth-child(even){background-color:#455a64}tr:nth-child(odd){background-color:#394b52}</style>
+)=====";
+
+static const char* const POLL_PRIORITY_NAMES[] = {"High", "Normal", "Low"};
+
+// The CAN statistics page, one table row per step. The traffic statistics are copied once when the page
+// is requested, so the tables show a single update of the core task.
+class CanStatsPage {
+ public:
+  bool render(HtmlStream& out, uint16_t step);
+
+ private:
+  void start(HtmlStream& out);
+  bool traffic_step(HtmlStream& out, CAN_Interface interface);
+  bool poll_step(HtmlStream& out, uint8_t index);
+  void end(HtmlStream& out);
+
+  std::unique_ptr<CanTrafficStats> stats;
+  // Indices of the used entries, sorted so the tables list IDs in order
+  std::vector<uint16_t> order;
+  int64_t now_us = 0;
+  unsigned long now_ms = 0;
+
+  // Traffic table per interface, then poll table per battery
+  uint8_t table = 0;
+  bool table_open = false;
+  // Next entry of the current table
+  uint16_t position = 0;
+};
+
+void CanStatsPage::start(HtmlStream& out) {
+  stats.reset(new CanTrafficStats());
+  read_can_traffic_stats(*stats);
+  now_us = esp_timer_get_time();
+  now_ms = millis();
+
+  order.reserve(stats->size());
+  for (uint16_t i = 0; i < CanTrafficStats::TABLE_SIZE; i++) {
+    if (stats->entry(i).used) {
+      order.push_back(i);
+    }
+  }
+  const CanTrafficStats& table = *stats;
+  std::sort(order.begin(), order.end(), [&table](uint16_t a, uint16_t b) {
+    const CanTrafficStats::Entry& ea = table.entry(a);
+    const CanTrafficStats::Entry& eb = table.entry(b);
+    if (ea.id != eb.id) {
+      return ea.id < eb.id;
+    }
+    return ea.direction < eb.direction;
+  });
+
+  out.print(CAN_STATS_HTML_STYLE);
+  out.print("<button onclick='home()'>Back to main page</button>");
+}
+
+// Writes the heading, the next row or the end of the interface's table. Returns false once the table is
+// complete, or if the interface is not in use.
+bool CanStatsPage::traffic_step(HtmlStream& out, CAN_Interface interface) {
+  if (stats->bit_rate(interface) == 0) {
+    return false;
+  }
+  if (!table_open) {
+    table_open = true;
+    out.printf("<div class='bus'><h4>%s: %lu kbit/s, bus load %u%%</h4>", getCANInterfaceName(interface),
+               (unsigned long)(stats->bit_rate(interface) / 1000), stats->bus_load_percent(interface));
+    out.print(
+        "<table><tr><th>ID</th><th>Dir</th><th>Frames</th><th>Rate Hz</th><th>Min ms</th><th>Mean ms</th>"
+        "<th>Max ms</th><th>Last seen ms ago</th></tr>");
+    return true;
+  }
+  while (position < order.size()) {
+    const CanTrafficStats::Entry& entry = stats->entry(order[position++]);
+    if (entry.interface != interface) {
+      continue;
+    }
+    out.printf(
+        "<tr><td>%lX</td><td>%s</td><td>%lu</td><td>%u</td><td>%.1f</td><td>%.1f</td><td>%.1f</td><td>%lu</td></tr>",
+        (unsigned long)entry.id, entry.direction == MSG_RX ? "RX" : "TX", (unsigned long)entry.count, entry.rate_hz,
+        entry.min_gap_us / 1000.0f, entry.mean_gap_us() / 1000.0f, entry.max_gap_us / 1000.0f,
+        (unsigned long)((now_us - entry.last_us) / 1000));
+    return true;
+  }
+  if (position == order.size()) {
+    out.print("</table></div>");
+    position++;
+    return true;
+  }
+  return false;
+}
+
+// Target and achieved refresh period of every value a battery polls, as traffic_step
+bool CanStatsPage::poll_step(HtmlStream& out, uint8_t index) {
+  static const char* const titles[] = {"Battery", "Battery 2", "Battery 3"};
+  Battery* batteries[] = {battery, battery2, battery3};
+  const UdsPollScheduler* poller = batteries[index] ? batteries[index]->get_poll_scheduler() : nullptr;
+  if (poller == nullptr) {
+    return false;
+  }
+  if (!table_open) {
+    table_open = true;
+    out.printf("<div class='bus'><h4>%s: polling up to %u requests/s%s</h4>", titles[index],
+               poller->request_budget(), poller->holding_off(now_ms) ? ", paused for another tester" : "");
+    out.print(
+        "<table><tr><th>PID</th><th>Priority</th><th>Target ms</th><th>Achieved ms</th><th>Responses</th>"
+        "<th>Timeouts</th><th>Last response ms ago</th></tr>");
+    return true;
+  }
+  while (position < poller->size()) {
+    const UdsPollScheduler::Entry& entry = poller->entry(position++);
+    if (!entry.enabled) {
+      continue;
+    }
+    out.printf("<tr><td>%04X</td><td>%s</td><td>%lu</td><td>%lu</td><td>%lu</td><td>%u</td><td>", entry.pid,
+               POLL_PRIORITY_NAMES[entry.priority], (unsigned long)entry.period_ms,
+               (unsigned long)entry.achieved_period_ms, (unsigned long)entry.responses, entry.timeouts);
+    if (entry.responses > 0) {
+      out.print(now_ms - entry.last_response_ms);
+    } else {
+      out.print("-");
+    }
+    out.print("</td></tr>");
+    return true;
+  }
+  if (position == poller->size()) {
+    out.print("</table></div>");
+    position++;
+    return true;
+  }
+  return false;
+}
+
+void CanStatsPage::end(HtmlStream& out) {
+  if (stats->untracked_frames() > 0) {
+    out.printf("<h4>Frames of IDs not tracked (table full): %lu</h4>", (unsigned long)stats->untracked_frames());
+  }
+  out.print("<button onclick='home()'>Back to main page</button>");
+  out.print("<script>");
+  out.print("function home() { window.location.href = '/'; }");
+  out.print("setTimeout(function(){ location.reload(true); }, 5000);");
+  out.print("</script>");
+}
+
+static const uint8_t POLL_TABLES = 3;
+
+bool CanStatsPage::render(HtmlStream& out, uint16_t step) {
+  if (step == 0) {
+    start(out);
+    return true;
+  }
+  for (; table < NO_CAN_INTERFACE + POLL_TABLES; table++, table_open = false, position = 0) {
+    const bool more = table < NO_CAN_INTERFACE ? traffic_step(out, (CAN_Interface)table)
+                                               : poll_step(out, table - NO_CAN_INTERFACE);
+    if (more) {
+      return true;
+    }
+  }
+  if (table == NO_CAN_INTERFACE + POLL_TABLES) {
+    end(out);
+    table++;
+    return true;
+  }
+  return false;
+}
+
+HtmlStream::Renderer can_stats_page() {
+  auto page = std::make_shared<CanStatsPage>();
+  return [page](HtmlStream& out, uint16_t step) { return page->render(out, step); };
+}
@@ -0,0 +1,13 @@
+#ifndef CAN_STATS_H
+#define CAN_STATS_H
+
+#include "html_stream.h"
+
+/**
+ * @brief Renders the CAN traffic statistics web page step by step
+ *
+ * @return HtmlStream::Renderer
+ */
+HtmlStream::Renderer can_stats_page();
+
+#endif
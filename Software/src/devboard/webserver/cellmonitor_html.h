@@ -2,14 +2,16 @@
 #define CELLMONITOR_H
 
 #include <WString.h>
+#include "html_stream.h"
 
 /**
- * @brief Replaces placeholder with content section in web page
+ * @brief Renders a step of the cellmonitor web page
  *
- * @param[in] var
+ * @param[in] out
+ * @param[in] step
  *
- * @return String
+ * @return bool false once the page is complete
  */
-String cellmonitor_processor(const String& var);
+bool cellmonitor_page(HtmlStream& out, uint16_t step);
 
 #endif
@@ -0,0 +1,124 @@
+#include "html_stream.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <utility>
+
+void HtmlStream::add(const char* text, size_t length) {
+  if (length == 0) {
+    return;
+  }
+  // Values written one after another stay one fragment
+  if (fragment_count > 0) {
+    Fragment& last = fragments[fragment_count - 1];
+    if (last.text + last.length == text && text >= values && text < values + VALUE_BUFFER_SIZE) {
+      last.length += length;
+      return;
+    }
+  }
+  if (fragment_count == MAX_FRAGMENTS || length > UINT16_MAX) {
+    overflow = true;
+    return;
+  }
+  fragments[fragment_count++] = {text, (uint16_t)length};
+}
+
+char* HtmlStream::reserve(size_t& room) {
+  room = VALUE_BUFFER_SIZE - values_used;
+  return values + values_used;
+}
+
+void HtmlStream::print(const char* text) {
+  add(text, strlen(text));
+}
+
+void HtmlStream::print(const String& text) {
+  size_t room;
+  char* target = reserve(room);
+  size_t length = text.length();
+  if (length > room) {
+    overflow = true;
+    length = room;
+  }
+  memcpy(target, text.c_str(), length);
+  values_used += length;
+  add(target, length);
+}
+
+void HtmlStream::print(String&& text) {
+  size_t room;
+  reserve(room);
+  if ((size_t)text.length() <= room || held.length() > 0) {
+    print(text);
+    return;
+  }
+  held = std::move(text);
+  add(held.c_str(), held.length());
+}
+
+void HtmlStream::print(long long value) {
+  printf("%lld", value);
+}
+
+void HtmlStream::print(unsigned long long value) {
+  printf("%llu", value);
+}
+
+void HtmlStream::print(float value, uint8_t decimals) {
+  printf("%.*f", decimals, value);
+}
+
+void HtmlStream::printf(const char* format, ...) {
+  size_t room;
+  char* target = reserve(room);
+  va_list args;
+  va_start(args, format);
+  const int length = vsnprintf(target, room, format, args);
+  va_end(args);
+  if (length < 0) {
+    return;
+  }
+  size_t written = length;
+  // vsnprintf needs room for its terminating zero, which is not part of the value
+  if (written >= room) {
+    overflow = true;
+    written = room == 0 ? 0 : room - 1;
+  }
+  values_used += written;
+  add(target, written);
+}
+
+size_t HtmlStream::read(char* buffer, size_t maxLen) {
+  size_t written = 0;
+  while (written < maxLen) {
+    if (current == fragment_count) {
+      if (done) {
+        break;
+      }
+      // All of the previous step is sent, its fragments and values can be reused
+      fragment_count = 0;
+      current = 0;
+      offset = 0;
+      values_used = 0;
+      held = String();
+      if (!renderer(*this, next_step++)) {
+        done = true;
+      }
+      continue;
+    }
+
+    const Fragment& fragment = fragments[current];
+    size_t length = fragment.length - offset;
+    if (length > maxLen - written) {
+      length = maxLen - written;
+    }
+    memcpy(buffer + written, fragment.text + offset, length);
+    written += length;
+    offset += length;
+    if (offset == fragment.length) {
+      current++;
+      offset = 0;
+    }
+  }
+  return written;
+}
@@ -0,0 +1,74 @@
+#ifndef HTML_STREAM_H
+#define HTML_STREAM_H
+
+#include <WString.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+
+// Renders a web page piece by piece while it is sent as a chunked response, instead of building the whole
+// page in one String first. The page is split into steps, each one writes a few lines. Static text is
+// referenced where it is, in flash, and only the values are formatted, into a small buffer that is reused
+// for the next step once the previous one is sent. So a page written this way needs the same few hundred
+// bytes no matter how large it is. A block rendered elsewhere and handed over with print(String&&), such
+// as the battery specific values of the advanced battery page, still takes its full size while its step
+// is sent. Those battery pages are several KB for some batteries.
+class HtmlStream {
+ public:
+  // Writes step number step of the page to out. Returns false when there is no such step, the page is done.
+  // A step may write nothing, e.g. for a block that is not shown.
+  using Renderer = std::function<bool(HtmlStream& out, uint16_t step)>;
+
+  // Pieces of text and bytes of values one step can hold
+  static constexpr uint8_t MAX_FRAGMENTS = 64;
+  static constexpr size_t VALUE_BUFFER_SIZE = 256;
+
+  explicit HtmlStream(Renderer renderer) : renderer(renderer) {}
+
+  // Text that stays where it is until the step is sent, such as string literals. It is not copied.
+  void print(const char* text);
+  // Values are copied into the value buffer
+  void print(const String& text);
+  // Takes over a value too large for the buffer, such as a whole block rendered elsewhere. One per step.
+  void print(String&& text);
+  void print(int value) { print((long long)value); }
+  void print(unsigned int value) { print((unsigned long long)value); }
+  void print(long value) { print((long long)value); }
+  void print(unsigned long value) { print((unsigned long long)value); }
+  void print(long long value);
+  void print(unsigned long long value);
+  void print(float value, uint8_t decimals);
+  void printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+  // Fills buffer with the next part of the page, rendering steps as needed. Returns the number of bytes
+  // written, 0 once the page is complete.
+  size_t read(char* buffer, size_t maxLen);
+
+  // True if a step wrote more than fits, what did not fit is left out
+  bool overflowed() const { return overflow; }
+
+ private:
+  struct Fragment {
+    const char* text;
+    uint16_t length;
+  };
+
+  void add(const char* text, size_t length);
+  char* reserve(size_t& room);
+
+  Renderer renderer;
+  uint16_t next_step = 0;
+  bool done = false;
+  bool overflow = false;
+
+  Fragment fragments[MAX_FRAGMENTS];
+  uint8_t fragment_count = 0;
+  uint8_t current = 0;  // Fragment being sent
+  uint16_t offset = 0;  // Bytes of the current fragment already sent
+
+  char values[VALUE_BUFFER_SIZE];
+  size_t values_used = 0;
+  String held;
+};
+
+#endif
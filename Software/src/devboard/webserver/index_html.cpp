@@ -3,6 +3,7 @@
 const char index_html[] = INDEX_HTML_HEADER COMMON_JAVASCRIPT "%X%" INDEX_HTML_FOOTER;
 const char index_html_header[] = INDEX_HTML_HEADER;
 const char index_html_footer[] = INDEX_HTML_FOOTER;
+const char common_javascript[] = COMMON_JAVASCRIPT;
 
 /* The above code is minified (https://kangax.github.io/html-minifier/) to increase performance. Here is the full HTML function:
 <!DOCTYPE HTML><html>
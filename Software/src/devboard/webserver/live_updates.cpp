@@ -0,0 +1,128 @@
+#include "live_updates.h"
+#include <stdio.h>
+#include <string.h>
+
+std::atomic<uint8_t> LiveUpdateStream::open_streams{0};
+std::atomic<uint32_t> LiveUpdateStream::dropped{0};
+
+static const char* const SUFFIXES[3] = {"", "_2", "_3"};
+
+LiveUpdateStream::LiveUpdateStream()
+    : trackers{{last_values[0], INFO_BATTERY_FIELD_COUNT},
+               {last_values[1], INFO_BATTERY_FIELD_COUNT},
+               {last_values[2], INFO_BATTERY_FIELD_COUNT}} {
+  open_streams++;
+}
+
+LiveUpdateStream::~LiveUpdateStream() {
+  open_streams--;
+}
+
+size_t LiveUpdateStream::begin_message(const char* event, const char* suffix) {
+  const int length = snprintf(message, sizeof(message), "event: %s%s\ndata: ", event, suffix);
+  return length < 0 ? 0 : (size_t)length;
+}
+
+bool LiveUpdateStream::end_message(size_t header_length, const MqttPayloadWriter& writer) {
+  // The writer leaves room for the blank line that ends the message
+  if (writer.overflowed()) {
+    dropped++;
+    return false;
+  }
+  message_length = header_length + writer.length();
+  message[message_length++] = '\n';
+  message[message_length++] = '\n';
+  message_sent = 0;
+  return true;
+}
+
+bool LiveUpdateStream::write_part(uint8_t index, Part part, unsigned long currentMillis) {
+  if (part == PART_STATUS) {
+    snapshot_valid = datalayer_snapshot.read_battery(index, snapshot);
+  }
+  if (!snapshot_valid) {
+    return false;
+  }
+
+  const size_t header_length =
+      begin_message(part == PART_STATUS ? "status" : (part == PART_CELLS ? "cells" : "balancing"),
+                    part == PART_STATUS ? "" : SUFFIXES[index]);
+  MqttPayloadWriter writer(message + header_length, sizeof(message) - header_length - 2);
+
+  if (part == PART_STATUS) {
+    trackers[index].begin(currentMillis);
+    writer.begin_object();
+    // The charged and discharged energy are not on the pages
+    write_battery_info(writer, &trackers[index], snapshot, SUFFIXES[index], 0, false);
+    if (writer.empty()) {
+      return false;
+    }
+    writer.end_object();
+    if (!end_message(header_length, writer)) {
+      trackers[index].invalidate();
+      return false;
+    }
+    return true;
+  }
+
+  const SnapshotGroup group = part == PART_CELLS ? SNAPSHOT_CELL_VOLTAGES : SNAPSHOT_CELL_BALANCING;
+  if (sent[index][group] && snapshot.generation[group] == sent_generation[index][group]) {
+    return false;
+  }
+  if (part == PART_CELLS) {
+    write_cell_voltages_compact(writer, snapshot);
+  } else {
+    write_cell_balancing_compact(writer, snapshot);
+  }
+  if (!end_message(header_length, writer)) {
+    return false;
+  }
+  sent_generation[index][group] = snapshot.generation[group];
+  sent[index][group] = true;
+  return true;
+}
+
+bool LiveUpdateStream::next_message(unsigned long currentMillis) {
+  if (position == 3 * PART_COUNT) {
+    const uint32_t publish = datalayer_snapshot.publish_count();
+    if (publish == seen_publish) {
+      return false;
+    }
+    // A client that falls behind skips to the newest values
+    seen_publish = publish;
+    position = 0;
+  }
+  while (position < 3 * PART_COUNT) {
+    const uint8_t index = position / PART_COUNT;
+    const Part part = (Part)(position % PART_COUNT);
+    position++;
+    if (write_part(index, part, currentMillis)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t LiveUpdateStream::read(char* buffer, size_t maxLen, unsigned long currentMillis) {
+  if (message_sent == message_length) {
+    if (next_message(currentMillis)) {
+      last_send_ms = currentMillis;
+    } else if (currentMillis - last_send_ms >= KEEPALIVE_INTERVAL_MS) {
+      static const char KEEPALIVE[] = ": keepalive\n\n";
+      memcpy(message, KEEPALIVE, sizeof(KEEPALIVE) - 1);
+      message_length = sizeof(KEEPALIVE) - 1;
+      message_sent = 0;
+      last_send_ms = currentMillis;
+    } else {
+      return 0;
+    }
+  }
+
+  size_t length = message_length - message_sent;
+  if (length > maxLen) {
+    length = maxLen;
+  }
+  memcpy(buffer, message + message_sent, length);
+  message_sent += length;
+  return length;
+}
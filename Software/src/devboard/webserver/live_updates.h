@@ -0,0 +1,73 @@
+#ifndef LIVE_UPDATES_H
+#define LIVE_UPDATES_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include "../../datalayer/datalayer_snapshot.h"
+#include "../mqtt/mqtt_delta.h"
+#include "../mqtt/mqtt_payload.h"
+
+// Server-Sent Events stream of /live, which keeps the status page and the cell monitor up to date without
+// reloading them. After each publish of the datalayer snapshot, once per value update, a client gets:
+//   event: status     the values of each battery that changed, with the keys of the MQTT info topic,
+//                     e.g. {"SOC":55.3,"battery_voltage_2":372.1}
+//   event: cells      the cell voltages as {"cell_base_mV":3650,"cell_delta_mV":[12,0,7]}, if they changed
+//   event: balancing  the balancing bitmask as {"cell_balancing_mask":"0500"}, if it changed
+// The cells and balancing events of the second and third battery are named cells_2, balancing_3 and so on.
+// The first messages carry everything, after that only what changed. A comment is sent when there was
+// nothing to send for a while, so proxies and the browser keep the connection open.
+class LiveUpdateStream {
+ public:
+  static constexpr uint8_t MAX_CLIENTS = 4;
+  static constexpr unsigned long KEEPALIVE_INTERVAL_MS = 15000;
+  // Room for one message, the cell voltages of the largest battery being the longest. Each cell takes up to
+  // 6 characters: a delta of up to 5 digits, as while some cells still read 0 mV, and a comma.
+  static constexpr size_t MESSAGE_SIZE = 128 + MAX_AMOUNT_CELLS * 6;
+
+  LiveUpdateStream();
+  ~LiveUpdateStream();
+  LiveUpdateStream(const LiveUpdateStream&) = delete;
+  LiveUpdateStream& operator=(const LiveUpdateStream&) = delete;
+
+  // Streams open at the moment
+  static uint8_t clients() { return open_streams.load(); }
+  // Messages left out as they did not fit MESSAGE_SIZE, over all streams
+  static uint32_t dropped_messages() { return dropped.load(); }
+
+  // Fills buffer with the next part of the stream. Returns the number of bytes written, 0 if there is
+  // nothing to send yet.
+  size_t read(char* buffer, size_t maxLen, unsigned long currentMillis);
+
+ private:
+  // What is sent for each battery after a publish, one message each
+  enum Part : uint8_t { PART_STATUS, PART_CELLS, PART_BALANCING, PART_COUNT };
+
+  bool next_message(unsigned long currentMillis);
+  bool write_part(uint8_t index, Part part, unsigned long currentMillis);
+  // Starts a message with its event line, returns the length of what is written
+  size_t begin_message(const char* event, const char* suffix);
+  // Ends the message once its data is written. Returns false if it did not fit, nothing is sent then.
+  bool end_message(size_t header_length, const MqttPayloadWriter& writer);
+
+  static std::atomic<uint8_t> open_streams;
+  static std::atomic<uint32_t> dropped;
+
+  uint32_t seen_publish = 0;
+  // Parts of the current publish still to send, as battery index * PART_COUNT + part
+  uint8_t position = 3 * PART_COUNT;
+  DATALAYER_BATTERY_SNAPSHOT snapshot;
+  bool snapshot_valid = false;
+
+  float last_values[3][INFO_BATTERY_FIELD_COUNT];
+  MqttDeltaTracker trackers[3];
+  uint32_t sent_generation[3][SNAPSHOT_GROUP_COUNT] = {};
+  bool sent[3][SNAPSHOT_GROUP_COUNT] = {};
+
+  char message[MESSAGE_SIZE];
+  size_t message_length = 0;
+  size_t message_sent = 0;
+  unsigned long last_send_ms = 0;
+};
+
+#endif
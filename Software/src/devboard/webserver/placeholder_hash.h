@@ -0,0 +1,30 @@
+#ifndef PLACEHOLDER_HASH_H
+#define PLACEHOLDER_HASH_H
+
+#include <WString.h>
+#include <stdint.h>
+
+// Template processors are called once for every %PLACEHOLDER% in a page. Instead of comparing the name
+// against each known placeholder in turn, they switch on its hash. The hashes of the known names are
+// computed at compile time for the case labels, and two names with the same hash do not compile, as their
+// case labels would be duplicates.
+//
+//   switch (placeholder_hash(var)) {
+//     case placeholder_hash("HOSTNAME"):
+//       return ...;
+//   }
+
+// 32 bit FNV-1a
+constexpr uint32_t placeholder_hash(const char* name) {
+  uint32_t hash = 2166136261u;
+  for (; *name != '\0'; name++) {
+    hash = (hash ^ (uint8_t)*name) * 16777619u;
+  }
+  return hash;
+}
+
+inline uint32_t placeholder_hash(const String& name) {
+  return placeholder_hash(name.c_str());
+}
+
+#endif
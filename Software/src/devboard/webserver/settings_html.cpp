@@ -6,11 +6,15 @@
 #include "../../communication/can/comm_can.h"
 #include "../../communication/nvm/comm_nvm.h"
 #include "../../datalayer/datalayer.h"
+#include "../mqtt/mqtt.h"
+#include "../mqtt/mqtt_outbox.h"
 #include "html_escape.h"
 #include "index_html.h"
+#include "placeholder_hash.h"
 #include "src/battery/BATTERIES.h"
 #include "src/battery/Shunt.h"
 #include "src/inverter/INVERTERS.h"
+#include "web_assets.h"
 
 extern bool settingsUpdated;
 
@@ -100,6 +104,11 @@ String options_from_map(int selected, const TMap& value_name_map) {
 
 static const std::map<int, String> led_modes = {{0, "Classic"}, {1, "Energy Flow"}, {2, "Heartbeat"}};
 
+static const std::map<int, String> mqtt_cell_formats = {{MQTT_CELLS_JSON, "JSON (volts)"},
+                                                        {MQTT_CELLS_COMPACT_JSON, "Compact JSON (millivolt deltas)"},
+                                                        {MQTT_CELLS_BASE64, "Binary, base64 (no HA discovery)"},
+                                                        {MQTT_CELLS_BINARY, "Binary, raw (no HA discovery)"}};
+
 static const std::map<int, String> tesla_countries = {
     {21843, "US (USA)"},     {17217, "CA (Canada)"},  {18242, "GB (UK & N Ireland)"},
     {17483, "DK (Denmark)"}, {17477, "DE (Germany)"}, {16725, "AU (Australia)"}};
@@ -174,101 +183,89 @@ String settings_processor(const String& var, BatteryEmulatorSettingsStore& setti
   // HTML-ready values (such as select options) are returned here. These don't
   // get any additional escaping.
 
-  if (var == "BATTTYPE") {
-    return options_for_enum_with_none((BatteryType)settings.getUInt("BATTTYPE", (int)BatteryType::None),
-                                      name_for_battery_type, BatteryType::None);
-  }
-  if (var == "BATTCOMM") {
-    return options_for_enum((comm_interface)settings.getUInt("BATTCOMM", (int)comm_interface::CanNative),
-                            name_for_comm_interface);
-  }
-  if (var == "BATTCHEM") {
-    return options_for_enum(
-        (battery_chemistry_enum)settings.getUInt("BATTCHEM", (int)battery_chemistry_enum::Autodetect),
-        name_for_chemistry);
-  }
-  if (var == "INVTYPE") {
-    return options_for_enum_with_none(
-        (InverterProtocolType)settings.getUInt("INVTYPE", (int)InverterProtocolType::None), name_for_inverter_type,
-        InverterProtocolType::None);
-  }
-  if (var == "INVCOMM") {
-    return options_for_enum((comm_interface)settings.getUInt("INVCOMM", (int)comm_interface::CanNative),
-                            name_for_comm_interface);
-  }
-  if (var == "CHGTYPE") {
-    return options_for_enum_with_none((ChargerType)settings.getUInt("CHGTYPE", (int)ChargerType::None),
-                                      name_for_charger_type, ChargerType::None);
-  }
-  if (var == "CHGCOMM") {
-    return options_for_enum((comm_interface)settings.getUInt("CHGCOMM", (int)comm_interface::CanNative),
-                            name_for_comm_interface);
-  }
-
-  if (var == "SHUNTTYPE") {
-    return options_for_enum_with_none((ShuntType)settings.getUInt("SHUNTTYPE", (int)ShuntType::None),
-                                      name_for_shunt_type, ShuntType::None);
-  }
-
-  if (var == "SHUNTCOMM") {
-    return options_for_enum((comm_interface)settings.getUInt("SHUNTCOMM", (int)comm_interface::CanNative),
-                            name_for_comm_interface);
-  }
-
-  if (var == "EQSTOP") {
-    return options_for_enum_with_none(
-        (STOP_BUTTON_BEHAVIOR)settings.getUInt("EQSTOP", (int)STOP_BUTTON_BEHAVIOR::NOT_CONNECTED),
-        name_for_button_type, STOP_BUTTON_BEHAVIOR::NOT_CONNECTED);
-  }
-
-  if (var == "BATT2COMM") {
-    return options_for_enum((comm_interface)settings.getUInt("BATT2COMM", (int)comm_interface::CanNative),
-                            name_for_comm_interface);
-  }
-
-  if (var == "BATT3COMM") {
-    return options_for_enum((comm_interface)settings.getUInt("BATT3COMM", (int)comm_interface::CanNative),
-                            name_for_comm_interface);
-  }
-
-  if (var == "GTWCOUNTRY") {
-    return options_from_map(settings.getUInt("GTWCOUNTRY", 0), tesla_countries);
-  }
-
-  if (var == "GTWMAPREG") {
-    return options_from_map(settings.getUInt("GTWMAPREG", 0), tesla_mapregion);
-  }
-
-  if (var == "GTWCHASSIS") {
-    return options_from_map(settings.getUInt("GTWCHASSIS", 0), tesla_chassis);
-  }
-
-  if (var == "GTWPACK") {
-    return options_from_map(settings.getUInt("GTWPACK", 0), tesla_pack);
-  }
-
-  if (var == "LEDMODE") {
-    return options_from_map(settings.getUInt("LEDMODE", 0), led_modes);
-  }
-
-  if (var == "SUNGROW_MODEL") {
-    return options_from_map(settings.getUInt("INVBTYPE", 1), sungrow_models);  // Default: SBR096
-  }
+  switch (placeholder_hash(var)) {
+    case placeholder_hash("SETTINGS_CSS_URL"):
+      return web_asset_url("/assets/settings.css");
+    case placeholder_hash("SETTINGS_JS_URL"):
+      return web_asset_url("/assets/settings.js");
+    case placeholder_hash("BATTTYPE"):
+      return options_for_enum_with_none((BatteryType)settings.getUInt("BATTTYPE", (int)BatteryType::None),
+                                        name_for_battery_type, BatteryType::None);
+    case placeholder_hash("BATTCOMM"):
+      return options_for_enum((comm_interface)settings.getUInt("BATTCOMM", (int)comm_interface::CanNative),
+                              name_for_comm_interface);
+    case placeholder_hash("BATTCHEM"):
+      return options_for_enum(
+          (battery_chemistry_enum)settings.getUInt("BATTCHEM", (int)battery_chemistry_enum::Autodetect),
+          name_for_chemistry);
+    case placeholder_hash("INVTYPE"):
+      return options_for_enum_with_none(
+          (InverterProtocolType)settings.getUInt("INVTYPE", (int)InverterProtocolType::None), name_for_inverter_type,
+          InverterProtocolType::None);
+    case placeholder_hash("INVCOMM"):
+      return options_for_enum((comm_interface)settings.getUInt("INVCOMM", (int)comm_interface::CanNative),
+                              name_for_comm_interface);
+    case placeholder_hash("CHGTYPE"):
+      return options_for_enum_with_none((ChargerType)settings.getUInt("CHGTYPE", (int)ChargerType::None),
+                                        name_for_charger_type, ChargerType::None);
+    case placeholder_hash("CHGCOMM"):
+      return options_for_enum((comm_interface)settings.getUInt("CHGCOMM", (int)comm_interface::CanNative),
+                              name_for_comm_interface);
+
+    case placeholder_hash("SHUNTTYPE"):
+      return options_for_enum_with_none((ShuntType)settings.getUInt("SHUNTTYPE", (int)ShuntType::None),
+                                        name_for_shunt_type, ShuntType::None);
+
+    case placeholder_hash("SHUNTCOMM"):
+      return options_for_enum((comm_interface)settings.getUInt("SHUNTCOMM", (int)comm_interface::CanNative),
+                              name_for_comm_interface);
+
+    case placeholder_hash("EQSTOP"):
+      return options_for_enum_with_none(
+          (STOP_BUTTON_BEHAVIOR)settings.getUInt("EQSTOP", (int)STOP_BUTTON_BEHAVIOR::NOT_CONNECTED),
+          name_for_button_type, STOP_BUTTON_BEHAVIOR::NOT_CONNECTED);
+
+    case placeholder_hash("BATT2COMM"):
+      return options_for_enum((comm_interface)settings.getUInt("BATT2COMM", (int)comm_interface::CanNative),
+                              name_for_comm_interface);
+
+    case placeholder_hash("BATT3COMM"):
+      return options_for_enum((comm_interface)settings.getUInt("BATT3COMM", (int)comm_interface::CanNative),
+                              name_for_comm_interface);
+
+    case placeholder_hash("GTWCOUNTRY"):
+      return options_from_map(settings.getUInt("GTWCOUNTRY", 0), tesla_countries);
+
+    case placeholder_hash("GTWMAPREG"):
+      return options_from_map(settings.getUInt("GTWMAPREG", 0), tesla_mapregion);
+
+    case placeholder_hash("GTWCHASSIS"):
+      return options_from_map(settings.getUInt("GTWCHASSIS", 0), tesla_chassis);
+
+    case placeholder_hash("GTWPACK"):
+      return options_from_map(settings.getUInt("GTWPACK", 0), tesla_pack);
+
+    case placeholder_hash("LEDMODE"):
+      return options_from_map(settings.getUInt("LEDMODE", 0), led_modes);
+
+    case placeholder_hash("MQTTCELLFMT"):
+      return options_from_map(settings.getUInt("MQTTCELLFMT", MQTT_CELLS_JSON), mqtt_cell_formats);
+
+    case placeholder_hash("SUNGROW_MODEL"):
+      return options_from_map(settings.getUInt("INVBTYPE", 1), sungrow_models);  // Default: SBR096
 
 #ifdef HW_LILYGO2CAN
-  if (var == "GPIOOPT1") {
-    return options_for_enum_with_none((GPIOOPT1)settings.getUInt("GPIOOPT1", (int)GPIOOPT1::DEFAULT_OPT),
-                                      name_for_gpioopt1, GPIOOPT1::DEFAULT_OPT);
-  }
+    case placeholder_hash("GPIOOPT1"):
+      return options_for_enum_with_none((GPIOOPT1)settings.getUInt("GPIOOPT1", (int)GPIOOPT1::DEFAULT_OPT),
+                                        name_for_gpioopt1, GPIOOPT1::DEFAULT_OPT);
 #endif
-  if (var == "GPIOOPT2") {
-    return options_for_enum_with_none((GPIOOPT2)settings.getUInt("GPIOOPT2", (int)GPIOOPT2::DEFAULT_OPT_BMS_POWER_18),
-                                      name_for_gpioopt2, GPIOOPT2::DEFAULT_OPT_BMS_POWER_18);
-  }
+    case placeholder_hash("GPIOOPT2"):
+      return options_for_enum_with_none((GPIOOPT2)settings.getUInt("GPIOOPT2", (int)GPIOOPT2::DEFAULT_OPT_BMS_POWER_18),
+                                        name_for_gpioopt2, GPIOOPT2::DEFAULT_OPT_BMS_POWER_18);
 
-  if (var == "GPIOOPT3") {
-    return options_for_enum_with_none((GPIOOPT3)settings.getUInt("GPIOOPT3", (int)GPIOOPT3::DEFAULT_SMA_ENABLE_05),
-                                      name_for_gpioopt3, GPIOOPT3::DEFAULT_SMA_ENABLE_05);
+    case placeholder_hash("GPIOOPT3"):
+      return options_for_enum_with_none((GPIOOPT3)settings.getUInt("GPIOOPT3", (int)GPIOOPT3::DEFAULT_SMA_ENABLE_05),
+                                        name_for_gpioopt3, GPIOOPT3::DEFAULT_SMA_ENABLE_05);
   }
 
   // All other values are wrapped by html_escape to avoid HTML injection.
@@ -279,551 +276,467 @@ String settings_processor(const String& var, BatteryEmulatorSettingsStore& setti
 String raw_settings_processor(const String& var, BatteryEmulatorSettingsStore& settings) {
   // All of these returned values are raw un-escaped UTF-8 strings.
 
-  if (var == "HOSTNAME") {
-    return settings.getString("HOSTNAME");
-  }
+  switch (placeholder_hash(var)) {
+    case placeholder_hash("HOSTNAME"):
+      return settings.getString("HOSTNAME");
 
-  if (var == "BATTERYINTF") {
-    if (battery) {
-      return battery->interface_name();
-    }
-  }
+    case placeholder_hash("BATTERYINTF"):
+      if (battery) {
+        return battery->interface_name();
+      }
+      break;
 
-  if (var == "SSID") {
-    return settings.getString("SSID");
-  }
+    case placeholder_hash("SSID"):
+      return settings.getString("SSID");
 
-  if (var == "PASSWORD") {
-    return settings.getString("PASSWORD");
-  }
+    case placeholder_hash("PASSWORD"):
+      return settings.getString("PASSWORD");
 
-  if (var == "SAVEDCLASS") {
-    if (!settingsUpdated) {
-      return "hidden";
-    }
-  }
+    case placeholder_hash("SAVEDCLASS"):
+      if (!settingsUpdated) {
+        return "hidden";
+      }
+      break;
 
-  if (var == "BATTERY2CLASS") {
-    if (!battery2) {
-      return "hidden";
-    }
-  }
+    case placeholder_hash("BATTERY2CLASS"):
+      if (!battery2) {
+        return "hidden";
+      }
+      break;
 
-  if (var == "BATTERY2INTF") {
-    if (battery2) {
-      return battery2->interface_name();
-    }
-  }
+    case placeholder_hash("BATTERY2INTF"):
+      if (battery2) {
+        return battery2->interface_name();
+      }
+      break;
 
-  if (var == "INVCLASS") {
-    if (!inverter) {
-      return "hidden";
-    }
-  }
+    case placeholder_hash("INVCLASS"):
+      if (!inverter) {
+        return "hidden";
+      }
+      break;
 
-  if (var == "INVBIDCLASS") {
-    if (!inverter || !inverter->supports_battery_id()) {
-      return "hidden";
-    }
-  }
+    case placeholder_hash("INVBIDCLASS"):
+      if (!inverter || !inverter->supports_battery_id()) {
+        return "hidden";
+      }
+      break;
 
-  if (var == "INVBID") {
-    if (inverter && inverter->supports_battery_id()) {
-      return String(datalayer.battery.settings.sofar_user_specified_battery_id);
-    }
-  }
+    case placeholder_hash("INVBID"):
+      if (inverter && inverter->supports_battery_id()) {
+        return String(datalayer.battery.settings.sofar_user_specified_battery_id);
+      }
+      break;
 
-  if (var == "INVINTF") {
-    if (inverter) {
-      return inverter->interface_name();
-    }
-  }
+    case placeholder_hash("INVINTF"):
+      if (inverter) {
+        return inverter->interface_name();
+      }
+      break;
 
-  if (var == "SHUNTINTF") {
-    if (shunt) {
-      return shunt->interface_name();
-    }
-  }
+    case placeholder_hash("SHUNTINTF"):
+      if (shunt) {
+        return shunt->interface_name();
+      }
+      break;
 
-  if (var == "SHUNTCLASS") {
-    if (!shunt) {
-      return "hidden";
-    }
-  }
+    case placeholder_hash("SHUNTCLASS"):
+      if (!shunt) {
+        return "hidden";
+      }
+      break;
 
-  if (var == "CHARGERCLASS") {
-    if (!charger) {
-      return "hidden";
-    }
-  }
+    case placeholder_hash("CHARGERCLASS"):
+      if (!charger) {
+        return "hidden";
+      }
+      break;
 
-  if (var == "DBLBTR") {
-    return settings.getBool("DBLBTR") ? "checked" : "";
-  }
+    case placeholder_hash("DBLBTR"):
+      return settings.getBool("DBLBTR") ? "checked" : "";
 
-  if (var == "TRIBTR") {
-    return settings.getBool("TRIBTR") ? "checked" : "";
-  }
+    case placeholder_hash("TRIBTR"):
+      return settings.getBool("TRIBTR") ? "checked" : "";
 
-  if (var == "SOCESTIMATED") {
-    return settings.getBool("SOCESTIMATED") ? "checked" : "";
-  }
+    case placeholder_hash("SOCESTIMATED"):
+      return settings.getBool("SOCESTIMATED") ? "checked" : "";
 
-  if (var == "CNTCTRL") {
-    return settings.getBool("CNTCTRL") ? "checked" : "";
-  }
+    case placeholder_hash("CNTCTRL"):
+      return settings.getBool("CNTCTRL") ? "checked" : "";
 
-  if (var == "NCCONTACTOR") {
-    return settings.getBool("NCCONTACTOR") ? "checked" : "";
-  }
+    case placeholder_hash("NCCONTACTOR"):
+      return settings.getBool("NCCONTACTOR") ? "checked" : "";
 
-  if (var == "CNTCTRLDBL") {
-    return settings.getBool("CNTCTRLDBL") ? "checked" : "";
-  }
+    case placeholder_hash("CNTCTRLDBL"):
+      return settings.getBool("CNTCTRLDBL") ? "checked" : "";
 
-  if (var == "CNTCTRLTRI") {
-    return settings.getBool("CNTCTRLTRI") ? "checked" : "";
-  }
+    case placeholder_hash("CNTCTRLTRI"):
+      return settings.getBool("CNTCTRLTRI") ? "checked" : "";
 
-  if (var == "PWMCNTCTRL") {
-    return settings.getBool("PWMCNTCTRL") ? "checked" : "";
-  }
+    case placeholder_hash("PWMCNTCTRL"):
+      return settings.getBool("PWMCNTCTRL") ? "checked" : "";
 
-  if (var == "PERBMSRESET") {
-    return settings.getBool("PERBMSRESET") ? "checked" : "";
-  }
+    case placeholder_hash("PERBMSRESET"):
+      return settings.getBool("PERBMSRESET") ? "checked" : "";
 
-  if (var == "REMBMSRESET") {
-    return settings.getBool("REMBMSRESET") ? "checked" : "";
-  }
+    case placeholder_hash("REMBMSRESET"):
+      return settings.getBool("REMBMSRESET") ? "checked" : "";
 
-  if (var == "EXTPRECHARGE") {
-    return settings.getBool("EXTPRECHARGE") ? "checked" : "";
-  }
+    case placeholder_hash("EXTPRECHARGE"):
+      return settings.getBool("EXTPRECHARGE") ? "checked" : "";
 
-  if (var == "MAXPRETIME") {
-    return String(settings.getUInt("MAXPRETIME", 15000));
-  }
+    case placeholder_hash("MAXPRETIME"):
+      return String(settings.getUInt("MAXPRETIME", 15000));
 
-  if (var == "MAXPREFREQ") {
-    return String(settings.getUInt("MAXPREFREQ", 34000));
-  }
+    case placeholder_hash("MAXPREFREQ"):
+      return String(settings.getUInt("MAXPREFREQ", 34000));
 
-  if (var == "NOINVDISC") {
-    return settings.getBool("NOINVDISC") ? "checked" : "";
-  }
+    case placeholder_hash("NOINVDISC"):
+      return settings.getBool("NOINVDISC") ? "checked" : "";
 
-  if (var == "CANFDASCAN") {
-    return settings.getBool("CANFDASCAN") ? "checked" : "";
-  }
+    case placeholder_hash("CANFDASCAN"):
+      return settings.getBool("CANFDASCAN") ? "checked" : "";
 
-  if (var == "WIFIAPENABLED") {
-    return settings.getBool("WIFIAPENABLED", wifiap_enabled) ? "checked" : "";
-  }
+    case placeholder_hash("CANRXTASKS"):
+      return settings.getBool("CANRXTASKS") ? "checked" : "";
 
-  if (var == "APPASSWORD") {
-    return settings.getString("APPASSWORD", "123456789");
-  }
+    case placeholder_hash("WIFIAPENABLED"):
+      return settings.getBool("WIFIAPENABLED", wifiap_enabled) ? "checked" : "";
 
-  if (var == "APNAME") {
-    return settings.getString("APNAME", "BatteryEmulator");
-  }
+    case placeholder_hash("APPASSWORD"):
+      return settings.getString("APPASSWORD", "123456789");
 
-  if (var == "STATICIP") {
-    return settings.getBool("STATICIP") ? "checked" : "";
-  }
+    case placeholder_hash("APNAME"):
+      return settings.getString("APNAME", "BatteryEmulator");
 
-  if (var == "WIFICHANNEL") {
-    return String(settings.getUInt("WIFICHANNEL", 0));
-  }
+    case placeholder_hash("STATICIP"):
+      return settings.getBool("STATICIP") ? "checked" : "";
 
-  if (var == "CHGPOWER") {
-    return String(settings.getUInt("CHGPOWER", 0));
-  }
+    case placeholder_hash("WIFICHANNEL"):
+      return String(settings.getUInt("WIFICHANNEL", 0));
 
-  if (var == "DCHGPOWER") {
-    return String(settings.getUInt("DCHGPOWER", 0));
-  }
+    case placeholder_hash("CHGPOWER"):
+      return String(settings.getUInt("CHGPOWER", 0));
 
-  if (var == "LOCALIP1") {
-    return String(settings.getUInt("LOCALIP1", 0));
-  }
+    case placeholder_hash("DCHGPOWER"):
+      return String(settings.getUInt("DCHGPOWER", 0));
 
-  if (var == "LOCALIP2") {
-    return String(settings.getUInt("LOCALIP2", 0));
-  }
+    case placeholder_hash("LOCALIP1"):
+      return String(settings.getUInt("LOCALIP1", 0));
 
-  if (var == "LOCALIP3") {
-    return String(settings.getUInt("LOCALIP3", 0));
-  }
+    case placeholder_hash("LOCALIP2"):
+      return String(settings.getUInt("LOCALIP2", 0));
 
-  if (var == "LOCALIP4") {
-    return String(settings.getUInt("LOCALIP4", 0));
-  }
+    case placeholder_hash("LOCALIP3"):
+      return String(settings.getUInt("LOCALIP3", 0));
 
-  if (var == "GATEWAY1") {
-    return String(settings.getUInt("GATEWAY1", 0));
-  }
+    case placeholder_hash("LOCALIP4"):
+      return String(settings.getUInt("LOCALIP4", 0));
 
-  if (var == "GATEWAY2") {
-    return String(settings.getUInt("GATEWAY2", 0));
-  }
+    case placeholder_hash("GATEWAY1"):
+      return String(settings.getUInt("GATEWAY1", 0));
 
-  if (var == "GATEWAY3") {
-    return String(settings.getUInt("GATEWAY3", 0));
-  }
+    case placeholder_hash("GATEWAY2"):
+      return String(settings.getUInt("GATEWAY2", 0));
 
-  if (var == "GATEWAY4") {
-    return String(settings.getUInt("GATEWAY4", 0));
-  }
+    case placeholder_hash("GATEWAY3"):
+      return String(settings.getUInt("GATEWAY3", 0));
 
-  if (var == "SUBNET1") {
-    return String(settings.getUInt("SUBNET1", 0));
-  }
+    case placeholder_hash("GATEWAY4"):
+      return String(settings.getUInt("GATEWAY4", 0));
 
-  if (var == "SUBNET2") {
-    return String(settings.getUInt("SUBNET2", 0));
-  }
+    case placeholder_hash("SUBNET1"):
+      return String(settings.getUInt("SUBNET1", 0));
 
-  if (var == "SUBNET3") {
-    return String(settings.getUInt("SUBNET3", 0));
-  }
+    case placeholder_hash("SUBNET2"):
+      return String(settings.getUInt("SUBNET2", 0));
 
-  if (var == "SUBNET4") {
-    return String(settings.getUInt("SUBNET4", 0));
-  }
+    case placeholder_hash("SUBNET3"):
+      return String(settings.getUInt("SUBNET3", 0));
 
-  if (var == "PERFPROFILE") {
-    return settings.getBool("PERFPROFILE") ? "checked" : "";
-  }
+    case placeholder_hash("SUBNET4"):
+      return String(settings.getUInt("SUBNET4", 0));
 
-  if (var == "CANLOGUSB") {
-    return settings.getBool("CANLOGUSB") ? "checked" : "";
-  }
+    case placeholder_hash("PERFPROFILE"):
+      return settings.getBool("PERFPROFILE") ? "checked" : "";
 
-  if (var == "USBENABLED") {
-    return settings.getBool("USBENABLED") ? "checked" : "";
-  }
+    case placeholder_hash("CANLOGUSB"):
+      return settings.getBool("CANLOGUSB") ? "checked" : "";
 
-  if (var == "WEBENABLED") {
-    return settings.getBool("WEBENABLED") ? "checked" : "";
-  }
+    case placeholder_hash("USBENABLED"):
+      return settings.getBool("USBENABLED") ? "checked" : "";
 
-  if (var == "CANLOGSD") {
-    return settings.getBool("CANLOGSD") ? "checked" : "";
-  }
+    case placeholder_hash("WEBENABLED"):
+      return settings.getBool("WEBENABLED") ? "checked" : "";
 
-  if (var == "SDLOGENABLED") {
-    return settings.getBool("SDLOGENABLED") ? "checked" : "";
-  }
+    case placeholder_hash("CANLOGSD"):
+      return settings.getBool("CANLOGSD") ? "checked" : "";
 
-  if (var == "MQTTENABLED") {
-    return settings.getBool("MQTTENABLED") ? "checked" : "";
-  }
+    case placeholder_hash("SDLOGENABLED"):
+      return settings.getBool("SDLOGENABLED") ? "checked" : "";
 
-  if (var == "MQTTSERVER") {
-    return settings.getString("MQTTSERVER");
-  }
+    case placeholder_hash("MQTTENABLED"):
+      return settings.getBool("MQTTENABLED") ? "checked" : "";
 
-  if (var == "MQTTPORT") {
-    return String(settings.getUInt("MQTTPORT", 1883));
-  }
+    case placeholder_hash("MQTTSERVER"):
+      return settings.getString("MQTTSERVER");
 
-  if (var == "MQTTUSER") {
-    return settings.getString("MQTTUSER");
-  }
+    case placeholder_hash("MQTTPORT"):
+      return String(settings.getUInt("MQTTPORT", 1883));
 
-  if (var == "MQTTPASSWORD") {
-    return settings.getString("MQTTPASSWORD");
-  }
+    case placeholder_hash("MQTTUSER"):
+      return settings.getString("MQTTUSER");
 
-  if (var == "MQTTTOPICS") {
-    return settings.getBool("MQTTTOPICS") ? "checked" : "";
-  }
+    case placeholder_hash("MQTTPASSWORD"):
+      return settings.getString("MQTTPASSWORD");
 
-  if (var == "MQTTTOPIC") {
-    return settings.getString("MQTTTOPIC");
-  }
+    case placeholder_hash("MQTTTOPICS"):
+      return settings.getBool("MQTTTOPICS") ? "checked" : "";
 
-  if (var == "MQTTTIMEOUT") {
-    return String(settings.getUInt("MQTTTIMEOUT", 2000));
-  }
+    case placeholder_hash("MQTTTOPIC"):
+      return settings.getString("MQTTTOPIC");
 
-  if (var == "MQTTPUBLISHMS") {
-    return String(settings.getUInt("MQTTPUBLISHMS", 5000) / 1000);
-  }
+    case placeholder_hash("MQTTTIMEOUT"):
+      return String(settings.getUInt("MQTTTIMEOUT", 2000));
 
-  if (var == "MQTTOBJIDPREFIX") {
-    return settings.getString("MQTTOBJIDPREFIX");
-  }
+    case placeholder_hash("MQTTPUBLISHMS"):
+      return String(settings.getUInt("MQTTPUBLISHMS", 5000) / 1000);
 
-  if (var == "MQTTDEVICENAME") {
-    return settings.getString("MQTTDEVICENAME");
-  }
+    case placeholder_hash("MQTTOBJIDPREFIX"):
+      return settings.getString("MQTTOBJIDPREFIX");
 
-  if (var == "MQTTCELLV") {
-    return settings.getBool("MQTTCELLV") ? "checked" : "";
-  }
+    case placeholder_hash("MQTTDEVICENAME"):
+      return settings.getString("MQTTDEVICENAME");
 
-  if (var == "HADEVICEID") {
-    return settings.getString("HADEVICEID");
-  }
+    case placeholder_hash("MQTTCELLV"):
+      return settings.getBool("MQTTCELLV") ? "checked" : "";
 
-  if (var == "HADISC") {
-    return settings.getBool("HADISC") ? "checked" : "";
-  }
+    case placeholder_hash("MQTTCANSTATS"):
+      return settings.getBool("MQTTCANSTATS") ? "checked" : "";
 
-  if (var == "MANUAL_BAL_CLASS") {
-    if (battery && battery->supports_manual_balancing()) {
-      return "";
-    } else {
-      return "hidden";
-    }
-  }
+    case placeholder_hash("MQTTDELTA"):
+      return settings.getBool("MQTTDELTA") ? "checked" : "";
 
-  if (var == "BATTPVMAX") {
-    return String(static_cast<float>(settings.getUInt("BATTPVMAX", 0)) / 10.0f, 1);
-  }
+    case placeholder_hash("MQTTRATE"):
+      return String(settings.getUInt("MQTTRATE", MqttOutbox::DEFAULT_RATE));
 
-  if (var == "BATTPVMIN") {
-    return String(static_cast<float>(settings.getUInt("BATTPVMIN", 0)) / 10.0f, 1);
-  }
+    case placeholder_hash("MQTTSTORE"):
+      return settings.getBool("MQTTSTORE") ? "checked" : "";
 
-  if (var == "BATTCVMAX") {
-    return String(settings.getUInt("BATTCVMAX", 0));
-  }
+    case placeholder_hash("HADEVICEID"):
+      return settings.getString("HADEVICEID");
 
-  if (var == "BATTCVMIN") {
-    return String(settings.getUInt("BATTCVMIN", 0));
-  }
+    case placeholder_hash("HADISC"):
+      return settings.getBool("HADISC") ? "checked" : "";
 
-  if (var == "BATTERY_WH_MAX") {
-    return String(datalayer.battery.info.total_capacity_Wh);
-  }
+    case placeholder_hash("MANUAL_BAL_CLASS"):
+      if (battery && battery->supports_manual_balancing()) {
+        return "";
+      } else {
+        return "hidden";
+      }
+      break;
 
-  if (var == "MAX_CHARGE_SPEED") {
-    return String(datalayer.battery.settings.max_user_set_charge_dA / 10.0f, 1);
-  }
+    case placeholder_hash("BATTPVMAX"):
+      return String(static_cast<float>(settings.getUInt("BATTPVMAX", 0)) / 10.0f, 1);
 
-  if (var == "MAX_DISCHARGE_SPEED") {
-    return String(datalayer.battery.settings.max_user_set_discharge_dA / 10.0f, 1);
-  }
+    case placeholder_hash("BATTPVMIN"):
+      return String(static_cast<float>(settings.getUInt("BATTPVMIN", 0)) / 10.0f, 1);
 
-  if (var == "SOC_MAX_PERCENTAGE") {
-    return String(datalayer.battery.settings.max_percentage / 100.0f, 1);
-  }
+    case placeholder_hash("BATTCVMAX"):
+      return String(settings.getUInt("BATTCVMAX", 0));
 
-  if (var == "SOC_MIN_PERCENTAGE") {
-    return String(datalayer.battery.settings.min_percentage / 100.0f, 1);
-  }
+    case placeholder_hash("BATTCVMIN"):
+      return String(settings.getUInt("BATTCVMIN", 0));
 
-  if (var == "CHARGE_VOLTAGE") {
-    return String(datalayer.battery.settings.max_user_set_charge_voltage_dV / 10.0f, 1);
-  }
+    case placeholder_hash("BATTERY_WH_MAX"):
+      return String(datalayer.battery.info.total_capacity_Wh);
 
-  if (var == "DISCHARGE_VOLTAGE") {
-    return String(datalayer.battery.settings.max_user_set_discharge_voltage_dV / 10.0f, 1);
-  }
+    case placeholder_hash("MAX_CHARGE_SPEED"):
+      return String(datalayer.battery.settings.max_user_set_charge_dA / 10.0f, 1);
 
-  if (var == "SOC_SCALING_ACTIVE_CLASS") {
-    return datalayer.battery.settings.soc_scaling_active ? "active" : "inactive";
-  }
+    case placeholder_hash("MAX_DISCHARGE_SPEED"):
+      return String(datalayer.battery.settings.max_user_set_discharge_dA / 10.0f, 1);
 
-  if (var == "VOLTAGE_LIMITS_ACTIVE_CLASS") {
-    return datalayer.battery.settings.user_set_voltage_limits_active ? "active" : "inactive";
-  }
+    case placeholder_hash("SOC_MAX_PERCENTAGE"):
+      return String(datalayer.battery.settings.max_percentage / 100.0f, 1);
 
-  if (var == "SOC_SCALING_CLASS") {
-    return datalayer.battery.settings.soc_scaling_active ? "active" : "inactiveSoc";
-  }
+    case placeholder_hash("SOC_MIN_PERCENTAGE"):
+      return String(datalayer.battery.settings.min_percentage / 100.0f, 1);
 
-  if (var == "SOC_SCALING") {
-    return datalayer.battery.settings.soc_scaling_active ? TRUE_CHAR_CODE : FALSE_CHAR_CODE;
-  }
+    case placeholder_hash("CHARGE_VOLTAGE"):
+      return String(datalayer.battery.settings.max_user_set_charge_voltage_dV / 10.0f, 1);
 
-  if (var == "FAKE_VOLTAGE_CLASS") {
-    return battery && battery->supports_set_fake_voltage() ? "" : "hidden";
-  }
+    case placeholder_hash("DISCHARGE_VOLTAGE"):
+      return String(datalayer.battery.settings.max_user_set_discharge_voltage_dV / 10.0f, 1);
 
-  if (var == "MANUAL_BALANCING_CLASS") {
-    return datalayer.battery.settings.user_requests_balancing ? "" : "inactiveSoc";
-  }
+    case placeholder_hash("SOC_SCALING_ACTIVE_CLASS"):
+      return datalayer.battery.settings.soc_scaling_active ? "active" : "inactive";
 
-  if (var == "MANUAL_BALANCING") {
-    if (datalayer.battery.settings.user_requests_balancing) {
-      return TRUE_CHAR_CODE;
-    } else {
-      return FALSE_CHAR_CODE;
-    }
-  }
+    case placeholder_hash("VOLTAGE_LIMITS_ACTIVE_CLASS"):
+      return datalayer.battery.settings.user_set_voltage_limits_active ? "active" : "inactive";
 
-  if (var == "BATTERY_VOLTAGE") {
-    if (battery) {
-      return String(battery->get_voltage(), 1);
-    }
-  }
+    case placeholder_hash("SOC_SCALING_CLASS"):
+      return datalayer.battery.settings.soc_scaling_active ? "active" : "inactiveSoc";
 
-  if (var == "VOLTAGE_LIMITS") {
-    if (datalayer.battery.settings.user_set_voltage_limits_active) {
-      return TRUE_CHAR_CODE;
-    } else {
-      return FALSE_CHAR_CODE;
-    }
-  }
+    case placeholder_hash("SOC_SCALING"):
+      return datalayer.battery.settings.soc_scaling_active ? TRUE_CHAR_CODE : FALSE_CHAR_CODE;
 
-  if (var == "BALANCING_CLASS") {
-    return datalayer.battery.settings.user_requests_balancing ? "active" : "inactive";
-  }
+    case placeholder_hash("FAKE_VOLTAGE_CLASS"):
+      return battery && battery->supports_set_fake_voltage() ? "" : "hidden";
 
-  if (var == "BALANCING_MAX_TIME") {
-    return String(datalayer.battery.settings.balancing_max_time_ms / 60000.0f, 1);
-  }
+    case placeholder_hash("MANUAL_BALANCING_CLASS"):
+      return datalayer.battery.settings.user_requests_balancing ? "" : "inactiveSoc";
 
-  if (var == "BAL_POWER") {
-    return String(datalayer.battery.settings.balancing_float_power_W / 1.0f, 0);
-  }
+    case placeholder_hash("MANUAL_BALANCING"):
+      if (datalayer.battery.settings.user_requests_balancing) {
+        return TRUE_CHAR_CODE;
+      } else {
+        return FALSE_CHAR_CODE;
+      }
+      break;
 
-  if (var == "BAL_MAX_PACK_VOLTAGE") {
-    return String(datalayer.battery.settings.balancing_max_pack_voltage_dV / 10.0f, 0);
-  }
-  if (var == "BAL_MAX_CELL_VOLTAGE") {
-    return String(datalayer.battery.settings.balancing_max_cell_voltage_mV / 1.0f, 0);
-  }
-  if (var == "BAL_MAX_DEV_CELL_VOLTAGE") {
-    return String(datalayer.battery.settings.balancing_max_deviation_cell_voltage_mV / 1.0f, 0);
-  }
+    case placeholder_hash("BATTERY_VOLTAGE"):
+      if (battery) {
+        return String(battery->get_voltage(), 1);
+      }
+      break;
 
-  if (var == "BMS_RESET_DURATION") {
-    return String(datalayer.battery.settings.user_set_bms_reset_duration_ms / 1000.0f, 0);
-  }
+    case placeholder_hash("VOLTAGE_LIMITS"):
+      if (datalayer.battery.settings.user_set_voltage_limits_active) {
+        return TRUE_CHAR_CODE;
+      } else {
+        return FALSE_CHAR_CODE;
+      }
+      break;
 
-  if (var == "CHARGER_CLASS") {
-    if (!charger) {
-      return "hidden";
-    }
-  }
+    case placeholder_hash("BALANCING_CLASS"):
+      return datalayer.battery.settings.user_requests_balancing ? "active" : "inactive";
 
-  if (var == "CHG_HV_CLASS") {
-    if (datalayer.charger.charger_HV_enabled) {
-      return "active";
-    } else {
-      return "inactiveSoc";
-    }
-  }
+    case placeholder_hash("BALANCING_MAX_TIME"):
+      return String(datalayer.battery.settings.balancing_max_time_ms / 60000.0f, 1);
 
-  if (var == "CHG_HV") {
-    if (datalayer.charger.charger_HV_enabled) {
-      return TRUE_CHAR_CODE;
-    } else {
-      return FALSE_CHAR_CODE;
-    }
-  }
+    case placeholder_hash("BAL_POWER"):
+      return String(datalayer.battery.settings.balancing_float_power_W / 1.0f, 0);
 
-  if (var == "CHG_AUX12V_CLASS") {
-    if (datalayer.charger.charger_aux12V_enabled) {
-      return "active";
-    } else {
-      return "inactiveSoc";
-    }
-  }
+    case placeholder_hash("BAL_MAX_PACK_VOLTAGE"):
+      return String(datalayer.battery.settings.balancing_max_pack_voltage_dV / 10.0f, 0);
+    case placeholder_hash("BAL_MAX_CELL_VOLTAGE"):
+      return String(datalayer.battery.settings.balancing_max_cell_voltage_mV / 1.0f, 0);
+    case placeholder_hash("BAL_MAX_DEV_CELL_VOLTAGE"):
+      return String(datalayer.battery.settings.balancing_max_deviation_cell_voltage_mV / 1.0f, 0);
 
-  if (var == "CHG_AUX12V") {
-    if (datalayer.charger.charger_aux12V_enabled) {
-      return TRUE_CHAR_CODE;
-    } else {
-      return FALSE_CHAR_CODE;
-    }
-  }
+    case placeholder_hash("BMS_RESET_DURATION"):
+      return String(datalayer.battery.settings.user_set_bms_reset_duration_ms / 1000.0f, 0);
 
-  if (var == "CHG_VOLTAGE_SETPOINT") {
-    return String(datalayer.charger.charger_setpoint_HV_VDC, 1);
-  }
+    case placeholder_hash("CHARGER_CLASS"):
+      if (!charger) {
+        return "hidden";
+      }
+      break;
 
-  if (var == "CHG_CURRENT_SETPOINT") {
-    return String(datalayer.charger.charger_setpoint_HV_IDC, 1);
-  }
+    case placeholder_hash("CHG_HV_CLASS"):
+      if (datalayer.charger.charger_HV_enabled) {
+        return "active";
+      } else {
+        return "inactiveSoc";
+      }
+      break;
 
-  if (var == "SOFAR_ID") {
-    return String(settings.getUInt("SOFAR_ID", 0));
-  }
+    case placeholder_hash("CHG_HV"):
+      if (datalayer.charger.charger_HV_enabled) {
+        return TRUE_CHAR_CODE;
+      } else {
+        return FALSE_CHAR_CODE;
+      }
+      break;
 
-  if (var == "PYLONSEND") {
-    return String(settings.getUInt("PYLONSEND", 0));
-  }
+    case placeholder_hash("CHG_AUX12V_CLASS"):
+      if (datalayer.charger.charger_aux12V_enabled) {
+        return "active";
+      } else {
+        return "inactiveSoc";
+      }
+      break;
 
-  if (var == "PYLONOFFSET") {
-    return settings.getBool("PYLONOFFSET") ? "checked" : "";
-  }
+    case placeholder_hash("CHG_AUX12V"):
+      if (datalayer.charger.charger_aux12V_enabled) {
+        return TRUE_CHAR_CODE;
+      } else {
+        return FALSE_CHAR_CODE;
+      }
+      break;
 
-  if (var == "PYLONORDER") {
-    return settings.getBool("PYLONORDER") ? "checked" : "";
-  }
-  if (var == "PYLONBAUD") {
-    return String(settings.getUInt("PYLONBAUD", 500));
-  }
+    case placeholder_hash("CHG_VOLTAGE_SETPOINT"):
+      return String(datalayer.charger.charger_setpoint_HV_VDC, 1);
 
-  if (var == "INVCELLS") {
-    return String(settings.getUInt("INVCELLS", 0));
-  }
+    case placeholder_hash("CHG_CURRENT_SETPOINT"):
+      return String(datalayer.charger.charger_setpoint_HV_IDC, 1);
 
-  if (var == "INVMODULES") {
-    return String(settings.getUInt("INVMODULES", 0));
-  }
+    case placeholder_hash("SOFAR_ID"):
+      return String(settings.getUInt("SOFAR_ID", 0));
 
-  if (var == "INVCELLSPER") {
-    return String(settings.getUInt("INVCELLSPER", 0));
-  }
+    case placeholder_hash("PYLONSEND"):
+      return String(settings.getUInt("PYLONSEND", 0));
 
-  if (var == "INVVLEVEL") {
-    return String(settings.getUInt("INVVLEVEL", 0));
-  }
+    case placeholder_hash("PYLONOFFSET"):
+      return settings.getBool("PYLONOFFSET") ? "checked" : "";
 
-  if (var == "INVCAPACITY") {
-    return String(settings.getUInt("INVCAPACITY", 0));
-  }
+    case placeholder_hash("PYLONORDER"):
+      return settings.getBool("PYLONORDER") ? "checked" : "";
+    case placeholder_hash("PYLONBAUD"):
+      return String(settings.getUInt("PYLONBAUD", 500));
 
-  if (var == "INVBTYPE") {
-    return String(settings.getUInt("INVBTYPE", 0));
-  }
+    case placeholder_hash("INVCELLS"):
+      return String(settings.getUInt("INVCELLS", 0));
 
-  if (var == "INVICNT") {
-    return settings.getBool("INVICNT") ? "checked" : "";
-  }
+    case placeholder_hash("INVMODULES"):
+      return String(settings.getUInt("INVMODULES", 0));
 
-  if (var == "DEYEBYD") {
-    return settings.getBool("DEYEBYD") ? "checked" : "";
-  }
+    case placeholder_hash("INVCELLSPER"):
+      return String(settings.getUInt("INVCELLSPER", 0));
 
-  if (var == "CANFREQ") {
-    return String(settings.getUInt("CANFREQ", 8));
-  }
+    case placeholder_hash("INVVLEVEL"):
+      return String(settings.getUInt("INVVLEVEL", 0));
 
-  if (var == "CANFDFREQ") {
-    return String(settings.getUInt("CANFDFREQ", 40));
-  }
+    case placeholder_hash("INVCAPACITY"):
+      return String(settings.getUInt("INVCAPACITY", 0));
 
-  if (var == "PRECHGMS") {
-    return String(settings.getUInt("PRECHGMS", 100));
-  }
+    case placeholder_hash("INVBTYPE"):
+      return String(settings.getUInt("INVBTYPE", 0));
 
-  if (var == "PWMFREQ") {
-    return String(settings.getUInt("PWMFREQ", 20000));
-  }
+    case placeholder_hash("INVICNT"):
+      return settings.getBool("INVICNT") ? "checked" : "";
 
-  if (var == "PWMHOLD") {
-    return String(settings.getUInt("PWMHOLD", 250));
-  }
+    case placeholder_hash("DEYEBYD"):
+      return settings.getBool("DEYEBYD") ? "checked" : "";
 
-  if (var == "INTERLOCKREQ") {
-    return settings.getBool("INTERLOCKREQ") ? "checked" : "";
-  }
+    case placeholder_hash("CANFREQ"):
+      return String(settings.getUInt("CANFREQ", 8));
 
-  if (var == "DIGITALHVIL") {
-    return settings.getBool("DIGITALHVIL") ? "checked" : "";
-  }
+    case placeholder_hash("CANFDFREQ"):
+      return String(settings.getUInt("CANFDFREQ", 40));
+
+    case placeholder_hash("CANRXBUDGET"):
+      return String(settings.getUInt("CANRXBUDGET", CAN_RX_BUDGET));
+
+    case placeholder_hash("PRECHGMS"):
+      return String(settings.getUInt("PRECHGMS", 100));
+
+    case placeholder_hash("PWMFREQ"):
+      return String(settings.getUInt("PWMFREQ", 20000));
 
-  if (var == "GTWRHD") {
-    return settings.getBool("GTWRHD") ? "checked" : "";
+    case placeholder_hash("PWMHOLD"):
+      return String(settings.getUInt("PWMHOLD", 250));
+
+    case placeholder_hash("INTERLOCKREQ"):
+      return settings.getBool("INTERLOCKREQ") ? "checked" : "";
+
+    case placeholder_hash("DIGITALHVIL"):
+      return settings.getBool("DIGITALHVIL") ? "checked" : "";
+
+    case placeholder_hash("GTWRHD"):
+      return settings.getBool("GTWRHD") ? "checked" : "";
   }
 
   return String();
@@ -888,300 +801,6 @@ const char* getCANInterfaceName(CAN_Interface interface) {
 #define GPIOOPT3_SETTING ""
 #endif
 
-#define SETTINGS_HTML_SCRIPTS \
-  R"rawliteral(
-    <script>
-
-    function askFactoryReset() {
-      if (confirm('Are you sure you want to reset the device to factory settings? This will erase all settings and data.')) {
-        var xhr = new XMLHttpRequest();
-        xhr.onload = function() {
-          if (this.status == 200) {
-            alert('Factory reset successful. The device will now restart.');
-            reboot();
-          } else {
-            alert('Factory reset failed. Please try again.');
-          }
-        };
-        xhr.onerror = function() {
-          alert('An error occurred while trying to reset the device.');
-        };
-        xhr.open('POST', '/factoryReset', true);
-        xhr.send();
-      }
-    }
-
-    function editComplete(){if(this.status==200){window.location.reload();}}
-
-    function editError(){alert('Invalid input');}
-        function editRecoveryMode(){var value=prompt('Extremely dangerous option. Emergency charge allows recovery for a severely undercharged battery. Limit charge power to avoid cell rupture and possible fire. Start 30min recovery process? (0 = No, 1 = Yes):');
-          if(value!==null){if(value==0||value==1){var xhr=new 
-        XMLHttpRequest();xhr.onload=editComplete;xhr.onerror=editError;xhr.open('GET','/enableRecoveryMode?value='+value,true);xhr.send();}else{alert('Invalid value. Please enter a value between 0 and 1.');}}}
-
-        function editWh(){var value=prompt('How much energy the battery can store. Enter new Wh value (1-400000):');
-          if(value!==null){if(value>=1&&value<=400000){var xhr=new 
-        XMLHttpRequest();xhr.onload=editComplete;xhr.onerror=editError;xhr.open('GET','/updateBatterySize?value='+value,true);xhr.send();}else{
-          alert('Invalid value. Please enter a value between 1 and 400000.');}}}
-
-        function editUseScaledSOC(){var value=prompt('Extends battery life by rescaling the SOC within the configured minimum and maximum percentage. Should SOC scaling be applied? (0 = No, 1 = Yes):');
-          if(value!==null){if(value==0||value==1){var xhr=new 
-        XMLHttpRequest();xhr.onload=editComplete;xhr.onerror=editError;xhr.open('GET','/updateUseScaledSOC?value='+value,true);xhr.send();}else{alert('Invalid value. Please enter a value between 0 and 1.');}}}
-    
-        function editSocMax(){var value=prompt('Inverter will see fully charged (100pct)SOC when this value is reached. Enter new maximum SOC value that battery will charge to (50.0-100.0):');if(value!==null){if(value>=50&&value<=100){var xhr=new 
-        XMLHttpRequest();xhr.onload=editComplete;xhr.onerror=editError;xhr.open('GET','/updateSocMax?value='+value,true);xhr.send();}else{alert('Invalid value. Please enter a value between 50.0 and 100.0');}}}
-    
-        function editSocMin(){
-          var value=prompt('Inverter will see completely discharged (0pct)SOC when this value is reached. Advanced users can set to negative values. Enter new minimum SOC value that battery will discharge to (-10.0to50.0):');
-          if(value!==null){if(value>=-10&&value<=50){var xhr=new 
-        XMLHttpRequest();xhr.onload=editComplete;xhr.onerror=editError;xhr.open('GET','/updateSocMin?value='+value,true);xhr.send();}else{alert('Invalid value. Please enter a value between -10 and 50.0');}}}
-    
-        function editMaxChargeA(){var value=prompt('Some inverters needs to be artificially limited. Enter new maximum charge current in A (0-1000.0):');if(value!==null){if(value>=0&&value<=1000){var xhr=new 
-        XMLHttpRequest();xhr.onload=editComplete;xhr.onerror=editError;xhr.open('GET','/updateMaxChargeA?value='+value,true);xhr.send();}else{alert('Invalid value. Please enter a value between 0 and 1000.0');}}}
-    
-        function editMaxDischargeA(){var value=prompt('Some inverters needs to be artificially limited. Enter new maximum discharge current in A (0-1000.0):');if(value!==null){if(value>=0&&value<=1000){var xhr=new 
-        XMLHttpRequest();xhr.onload=editComplete;xhr.onerror=editError;xhr.open('GET','/updateMaxDischargeA?value='+value,true);xhr.send();}else{alert('Invalid value. Please enter a value between 0 and 1000.0');}}}
-    
-        function editUseVoltageLimit(){var value=prompt('Enable this option to manually restrict charge/discharge to a specific voltage set below. If disabled the emulator automatically determines this based on battery limits. Restrict manually? (0 = No, 1 = Yes):');if(value!==null){if(value==0||value==1){var xhr=new 
-        XMLHttpRequest();xhr.onload=editComplete;xhr.onerror=editError;xhr.open('GET','/updateUseVoltageLimit?value='+value,true);xhr.send();}else{alert('Invalid value. Please enter a value between 0 and 1.');}}}
-    
-        function editMaxChargeVoltage(){var value=prompt('Some inverters needs to be artificially limited. Enter new voltage setpoint batttery should charge to (0-1000.0):');if(value!==null){if(value>=0&&value<=1000){var 
-        xhr=new XMLHttpRequest();xhr.onload=editComplete;xhr.onerror=editError;xhr.open('GET','/updateMaxChargeVoltage?value='+value,true);xhr.send();}else{alert('Invalid value. Please enter a value between 0 and 1000.0');}}}
-    
-        function editMaxDischargeVoltage(){var value=prompt('Some inverters needs to be artificially limited. Enter new voltage setpoint batttery should discharge to (0-1000.0):');if(value!==null){if(value>=0&&value<=1000){var 
-        xhr=new 
-        XMLHttpRequest();xhr.onload=editComplete;xhr.onerror=editError;xhr.open('GET','/updateMaxDischargeVoltage?value='+value,true);xhr.send();}else{alert('Invalid value. Please enter a value between 0 and 1000.0');}}}
-
-        function editBMSresetDuration(){var value=prompt('Amount of seconds BMS power should be off during periodic daily resets. Requires "Periodic BMS reset" to be enabled. Enter value in seconds (1-59):');if(value!==null){if(value>=1&&value<=59){var 
-        xhr=new XMLHttpRequest();xhr.onload=editComplete;xhr.onerror=editError;xhr.open('GET','/updateBMSresetDuration?value='+value,true);xhr.send();}else{alert('Invalid value. Please enter a value between 1 and 59');}}}
-
-        function editTeslaBalAct(){var value=prompt('Enable or disable forced LFP balancing. Makes the battery charge to 101percent. This should be performed once every month, to keep LFP batteries balanced. Ensure battery is fully charged before enabling, and also that you have enough sun or grid power to feed power into the battery while balancing is active. Enter 1 for enabled, 0 for disabled');if(value!==null){if(value==0||value==1){var xhr=new 
-        XMLHttpRequest();xhr.onload=editComplete;xhr.onerror=editError;xhr.open('GET','/TeslaBalAct?value='+value,true);xhr.send();}}else{alert('Invalid value. Please enter 1 or 0');}}
-    
-        function editBalTime(){var value=prompt('Enter new max balancing time in minutes');if(value!==null){if(value>=1&&value<=300){var xhr=new 
-        XMLHttpRequest();xhr.onload=editComplete;xhr.onerror=editError;xhr.open('GET','/BalTime?value='+value,true);xhr.send();}else{alert('Invalid value. Please enter a value between 1 and 300');}}}
-    
-        function editBalFloatPower(){var value=prompt('Power level in Watt to float charge during forced balancing');if(value!==null){if(value>=100&&value<=2000){var xhr=new 
-        XMLHttpRequest();xhr.onload=editComplete;xhr.onerror=editError;xhr.open('GET','/BalFloatPower?value='+value,true);xhr.send();}else{alert('Invalid value. Please enter a value between 100 and 2000');}}}
-    
-        function editBalMaxPackV(){var value=prompt('Battery pack max voltage temporarily raised to this value during forced balancing. Value in V');if(value!==null){if(value>=380&&value<=410){var xhr=new 
-        XMLHttpRequest();xhr.onload=editComplete;xhr.onerror=editError;xhr.open('GET','/BalMaxPackV?value='+value,true);xhr.send();}else{alert('Invalid value. Please enter a value between 380 and 410');}}}
-
-        function editBalMaxCellV(){var value=prompt('Cellvoltage max temporarily raised to this value during forced balancing. Value in mV');if(value!==null){if(value>=3400&&value<=3750){var xhr=new 
-        XMLHttpRequest();xhr.onload=editComplete;xhr.onerror=editError;xhr.open('GET','/BalMaxCellV?value='+value,true);xhr.send();}else{alert('Invalid value. Please enter a value between 3400 and 3750');}}}
-    
-        function editBalMaxDevCellV(){var value=prompt('Cellvoltage max deviation temporarily raised to this value during forced balancing. Value in mV');if(value!==null){if(value>=300&&value<=600){var xhr=new 
-        XMLHttpRequest();xhr.onload=editComplete;xhr.onerror=editError;xhr.open('GET','/BalMaxDevCellV?value='+value,true);xhr.send();}else{alert('Invalid value. Please enter a value between 300 and 600');}}}
-
-          function editFakeBatteryVoltage(){var value=prompt('Enter new fake battery voltage');if(value!==null){if(value>=0&&value<=5000){var xhr=new 
-          XMLHttpRequest();xhr.onload=editComplete;xhr.onerror=editError;xhr.open('GET','/updateFakeBatteryVoltage?value='+value,true);xhr.send();}else{alert('Invalid value. Please enter a value between 0 and 1000');}}}
-
-          function editChargerHVDCEnabled(){var value=prompt('Enable or disable HV DC output. Enter 1 for enabled, 0 for disabled');if(value!==null){if(value==0||value==1){var xhr=new 
-          XMLHttpRequest();xhr.onload=editComplete;xhr.onerror=editError;xhr.open('GET','/updateChargerHvEnabled?value='+value,true);xhr.send();}}else{alert('Invalid value. Please enter 1 or 0');}}
-
-          function editChargerAux12vEnabled(){var value=prompt('Enable or disable low voltage 12v auxiliary DC output. Enter 1 for enabled, 0 for disabled');if(value!==null){if(value==0||value==1){var xhr=new 
-          XMLHttpRequest();xhr.onload=editComplete;xhr.onerror=editError;xhr.open('GET','/updateChargerAux12vEnabled?value='+value,true);xhr.send();}else{alert('Invalid value. Please enter 1 or 0');}}}
-
-          function editChargerSetpointVDC(){var value=prompt('Set charging voltage. Input will be validated against inverter and/or charger configuration parameters, but use sensible values like 200 to 420.');
-            if(value!==null){if(value>=0&&value<=1000){var xhr=new XMLHttpRequest();xhr.onload=editComplete;xhr.onerror=editError;xhr.open('GET','/updateChargeSetpointV?value='+value,true);xhr.send();}else{
-            alert('Invalid value. Please enter a value between 0 and 1000');}}}
-
-          function editChargerSetpointIDC(){var value=prompt('Set charging amperage. Input will be validated against inverter and/or charger configuration parameters, but use sensible values like 6 to 48.');
-            if(value!==null){if(value>=0&&value<=1000){var xhr=new           XMLHttpRequest();xhr.onload=editComplete;xhr.onerror=editError;xhr.open('GET','/updateChargeSetpointA?value='+value,true);xhr.send();}else{
-              alert('Invalid value. Please enter a value between 0 and 100');}}}
-
-          function editChargerSetpointEndI(){
-            var value=prompt('Set amperage that terminates charge as being sufficiently complete. Input will be validated against inverter and/or charger configuration parameters, but use sensible values like 1-5.');
-            if(value!==null){if(value>=0&&value<=1000){var xhr=new 
-          XMLHttpRequest();xhr.onload=editComplete;xhr.onerror=editError;xhr.open('GET','/updateChargeEndA?value='+value,true);xhr.send();}else{alert('Invalid value. Please enter a value between 0 and 100');}}}
-
-          function goToMainPage() { window.location.href = '/'; }
-
-          document.querySelectorAll('select,input').forEach(function(sel) {
-            function ch() {
-              sel.closest('form').setAttribute('data-' + sel.name?.toLowerCase(), sel.type=='checkbox'?sel.checked:sel.value);
-            }
-            sel.addEventListener('change', ch);
-            ch();
-          });
-    </script>
-)rawliteral"
-
-#define SETTINGS_STYLE \
-  R"rawliteral(
-    <style>
-    body { background-color: black; color: white; }
-        button { background-color: #505E67; color: white; border: none; padding: 10px 20px; margin-bottom: 20px;
-        cursor: pointer; border-radius: 10px; }
-    button:hover { background-color: #3A4A52; }
-    h4 { margin: 0.6em 0; line-height: 1.2; }
-    select, input { max-width: 250px; box-sizing: border-box; }
-    .hidden {
-      display: none;
-    }
-    .active {
-      color: white;
-    }
-    .inactive {
-      color: darkgrey;
-    }
-
-    .inactiveSoc {
-      color: red;
-    }
-
-    .mqtt-settings, .mqtt-topics {
-      display: none;
-      grid-column: span 2;
-    }
-
-    .settings-card {
-    background-color: #3a4b54; /* Slightly lighter than main background */
-    padding: 15px 20px;
-    margin-bottom: 20px;
-    border-radius: 20px; /* Less rounded than 50px for a more card-like feel */
-    box-shadow: 0 2px 5px rgba(0, 0, 0, 0.2);
-  }
-  .settings-card h3 {
-    color: #fff;
-    margin-top: 0;
-    margin-bottom: 15px;
-    padding-bottom: 8px;
-    border-bottom: 1px solid #4d5f69;
-  }
-
-    form .if-battery, form .if-inverter, form .if-charger, form .if-shunt { display: contents; }
-    form[data-battery="0"] .if-battery { display: none; }
-    form[data-inverter="0"] .if-inverter { display: none; }    
-    form[data-charger="0"] .if-charger { display: none; }
-    form[data-SHUNTTYPE="0"] .if-shunt { display: none; }
-
-    form .if-cbms { display: none; }
-    form[data-battery="6"] .if-cbms, form[data-battery="11"] .if-cbms, form[data-battery="22"] .if-cbms, form[data-battery="23"] .if-cbms, form[data-battery="24"] .if-cbms, form[data-battery="31"] .if-cbms, form[data-battery="41"] .if-cbms, form[data-battery="48"] .if-cbms, form[data-battery="49"] .if-cbms {
-      display: contents;
-    }
-
-    form .if-nissan { display: none; }
-    form[data-battery="21"] .if-nissan {
-      display: contents;
-    }
-
-    form .if-tesla { display: none; }
-    form[data-battery="32"] .if-tesla, form[data-battery="33"] .if-tesla {
-      display: contents;
-    }
-
-    form .if-estimated { display: none; } /* Integrations with manually set charge/discharge power */
-    form[data-battery="3"] .if-estimated, 
-    form[data-battery="4"] .if-estimated, 
-    form[data-battery="6"] .if-estimated, 
-    form[data-battery="14"] .if-estimated, 
-    form[data-battery="16"] .if-estimated, 
-    form[data-battery="24"] .if-estimated,
-    form[data-battery="32"] .if-estimated, 
-    form[data-battery="33"] .if-estimated,
-    form[data-battery="40"] .if-estimated,
-    form[data-battery="41"] .if-estimated,
-    form[data-battery="44"] .if-estimated {
-      display: contents;
-    }
-
-    form .if-socestimated { display: none; } /* Integrations where you can turn on SOC estimation */
-    form[data-battery="16"] .if-socestimated,
-    form[data-battery="41"] .if-socestimated {
-      display: contents;
-    }
-
-    form .if-dblbtr { display: none; }
-    form[data-dblbtr="true"] .if-dblbtr {
-      display: contents;
-    }
-
-    form .if-tribtr { display: none; }
-    form[data-tribtr="true"] .if-tribtr {
-      display: contents;
-    }
-
-    form .if-pwmcntctrl { display: none; }
-    form[data-pwmcntctrl="true"] .if-pwmcntctrl {
-      display: contents;
-    }
-
-    form .if-cntctrl { display: none; }
-    form[data-cntctrl="true"] .if-cntctrl {
-      display: contents;
-    }
-
-    form .if-extprecharge { display: none; }
-    form[data-extprecharge="true"] .if-extprecharge {
-      display: contents;
-    }
-
-    form .if-sofar { display: none; }
-    form[data-inverter="17"] .if-sofar {
-      display: contents;
-    }
-
-    form .if-byd { display: none; }
-    form[data-inverter="2"] .if-byd {
-      display: contents;
-    }
-
-    form .if-pylon { display: none; }
-    form[data-battery="22"] .if-pylon,
-    form[data-inverter="10"] .if-pylon {
-      display: contents;
-    }
-
-    form .if-pylon-inverter { display: none; }
-    form[data-inverter="10"] .if-pylon-inverter {
-      display: contents;
-    }
-
-    form .if-pylon-battery { display: none; }
-    form[data-battery="22"] .if-pylon-battery {
-      display: contents;
-    }
-
-    form .if-pylonish { display: none; }
-    form[data-inverter="4"] .if-pylonish, 
-    form[data-inverter="10"] .if-pylonish, 
-    form[data-inverter="19"] .if-pylonish {
-      display: contents;
-    }
-
-    form .if-solax { display: none; }
-    form[data-inverter="18"] .if-solax {
-      display: contents;
-    }
-      
-    form .if-sungrow { display: none; }
-    form[data-inverter="21"] .if-sungrow {
-      display: contents;
-    }
-      
-    form .if-kostal { display: none; }
-    form[data-inverter="9"] .if-kostal {
-      display: contents;
-    }
-
-    form .if-staticip { display: none; }
-    form[data-staticip="true"] .if-staticip {
-      display: contents;
-    }
-
-    form .if-mqtt { display: none; }
-    form[data-mqttenabled="true"] .if-mqtt {
-      display: contents;
-    }
-
-    form .if-topics { display: none; }
-    form[data-mqtttopics="true"] .if-topics {
-      display: contents;
-    }
-
-    </style>
-)rawliteral"
-
 #define SETTINGS_HTML_BODY \
   R"rawliteral(
   <button onclick='goToMainPage()'>Back to main page</button>
@@ -1443,6 +1062,15 @@ const char* getCANInterfaceName(CAN_Interface interface) {
         <input type='number' name='CANFDFREQ' value="%CANFDFREQ%" 
         min="0" max="1000" step="1"
         title="Configure this if you are using a custom add-on CAN board. Integers only" />
+
+        <label>CAN RX frames per loop: </label>
+        <input type='number' name='CANRXBUDGET' value="%CANRXBUDGET%" 
+        min="1" max="255" step="1"
+        title="Maximum frames read from each CAN interface every millisecond. Raise if RX overflows are reported on busy buses" />
+
+        <label>Receive CAN in separate tasks: </label>
+        <input type='checkbox' name='CANRXTASKS' value='on' %CANRXTASKS% 
+        title="When enabled, each CAN interface is read by its own task every millisecond, so frames are not lost while the main loop is busy. Requires reboot" />
         
         <label>Equipment stop button: </label><select name='EQSTOP'>
         %EQSTOP%  
@@ -1599,6 +1227,19 @@ const char* getCANInterfaceName(CAN_Interface interface) {
         min="1" max="300" step="1"
         title="How often to publish MQTT messages in seconds (1-300, step 1). Default: 5" />
         <label>Send all cellvoltages via MQTT: </label><input type='checkbox' name='MQTTCELLV' value='on' %MQTTCELLV% />
+        <label for='MQTTCELLFMT'>MQTT cellvoltage format: </label><select name='MQTTCELLFMT' id='MQTTCELLFMT'>
+        %MQTTCELLFMT%
+        </select>
+        <label>Send CAN traffic statistics via MQTT: </label>
+        <input type='checkbox' name='MQTTCANSTATS' value='on' %MQTTCANSTATS% />
+        <label>Only send MQTT values that changed: </label>
+        <input type='checkbox' name='MQTTDELTA' value='on' %MQTTDELTA% />
+        <label>MQTT messages per second, at most: </label>
+        <input name='MQTTRATE' type='number' value="%MQTTRATE%" 
+        min="1" max="1000" step="1"
+        title="Messages are queued and sent at no more than this rate (1-1000). Default: 20" />
+        <label>Keep MQTT data on SD card while offline: </label>
+        <input type='checkbox' name='MQTTSTORE' value='on' %MQTTSTORE% />
         <label>Remote BMS reset via MQTT allowed: </label>
         <input type='checkbox' name='REMBMSRESET' value='on' %REMBMSRESET% />
         <label>Customized MQTT topics: </label>
@@ -1661,7 +1302,7 @@ const char* getCANInterfaceName(CAN_Interface interface) {
 
         <label>Enable CAN message logging via SD card: </label>
         <input type='checkbox' name='CANLOGSD' value='on' %CANLOGSD% 
-        title="Enable this if you want incoming/outgoing CAN messages to be stored to an SD card. Only works on select hardware with SD-card slot" />
+        title="Enable this if you want incoming/outgoing CAN messages to be stored to an SD card, in a compact binary format. Convert the exported canlog.bin to text with test/utils/canlog_convert. Only works on select hardware with SD-card slot" />
 
         <label>Enable general logging via SD card: </label>
         <input type='checkbox' name='SDLOGENABLED' value='on' %SDLOGENABLED% 
@@ -1764,5 +1405,8 @@ const char* getCANInterfaceName(CAN_Interface interface) {
 
 )rawliteral"
 
+#define SETTINGS_STYLE R"rawliteral(<link rel="stylesheet" href="%SETTINGS_CSS_URL%">)rawliteral"
+#define SETTINGS_HTML_SCRIPTS R"rawliteral(<script src="%SETTINGS_JS_URL%"></script>)rawliteral"
+
 const char settings_html[] =
     INDEX_HTML_HEADER COMMON_JAVASCRIPT SETTINGS_STYLE SETTINGS_HTML_BODY SETTINGS_HTML_SCRIPTS INDEX_HTML_FOOTER;
@@ -0,0 +1,262 @@
+#include "status_api.h"
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "../../battery/BATTERIES.h"
+#include "../../datalayer/datalayer_snapshot.h"
+#include "../mqtt/mqtt_payload.h"
+#include "../utils/events.h"
+#include "../utils/types.h"
+
+// Room for the values of one battery or one event
+static const size_t JSON_BUFFER_SIZE = 1024;
+
+// Cell values written per step, at most 6 characters each so they fit the value buffer of HtmlStream
+static const uint16_t CELLS_PER_STEP = 32;
+static const uint16_t CELL_STEPS = (MAX_AMOUNT_CELLS + CELLS_PER_STEP - 1) / CELLS_PER_STEP;
+
+struct BatterySnapshots {
+  std::unique_ptr<DATALAYER_BATTERY_SNAPSHOT> snapshots[3];
+  bool supports_charged[3] = {};
+  uint8_t count = 0;
+};
+
+// Reads the snapshots of the batteries in use, skipping those not published yet
+static void read_batteries(BatterySnapshots& batteries) {
+  Battery* in_use[3] = {battery, battery2, battery3};
+  for (uint8_t i = 0; i < 3; i++) {
+    if (in_use[i] == nullptr) {
+      continue;
+    }
+    std::unique_ptr<DATALAYER_BATTERY_SNAPSHOT> snapshot = datalayer_snapshot.read_battery(i);
+    if (snapshot == nullptr) {
+      continue;
+    }
+    batteries.supports_charged[batteries.count] = in_use[i]->supports_charged_energy();
+    batteries.snapshots[batteries.count++] = std::move(snapshot);
+  }
+}
+
+struct StatusResponse {
+  BatterySnapshots batteries;
+  EVENTS_LEVEL_TYPE event_level;
+  EMULATOR_STATUS emulator_status;
+  char buffer[JSON_BUFFER_SIZE];
+};
+
+ApiResponse api_status(uint32_t boot_id) {
+  auto response = std::make_shared<StatusResponse>();
+  read_batteries(response->batteries);
+  response->event_level = get_event_level();
+  response->emulator_status = get_emulator_status();
+
+  uint32_t generations[4];
+  size_t count = 0;
+  for (uint8_t i = 0; i < response->batteries.count; i++) {
+    generations[count++] = response->batteries.snapshots[i]->generation[SNAPSHOT_VALUES];
+  }
+  // The event level and emulator status change with the events
+  generations[count++] = get_events_generation();
+
+  return {api_etag(boot_id, generations, count), [response](HtmlStream& out, uint16_t step) {
+            const BatterySnapshots& batteries = response->batteries;
+            if (step == 0) {
+              MqttPayloadWriter writer(response->buffer, sizeof(response->buffer));
+              writer.begin_object();
+              if (batteries.count > 0) {
+                writer.key("bms_status");
+                writer.text(getBMSStatus(batteries.snapshots[0]->status.bms_status));
+              }
+              writer.key("event_level");
+              writer.text(get_event_level_string(response->event_level));
+              writer.key("emulator_status");
+              writer.text(get_emulator_status_string(response->emulator_status));
+              out.print(response->buffer);
+              out.print(",\"batteries\":[");
+              return true;
+            }
+            if (step <= batteries.count) {
+              const uint8_t index = step - 1;
+              const DATALAYER_BATTERY_SNAPSHOT& snapshot = *batteries.snapshots[index];
+              MqttPayloadWriter writer(response->buffer, sizeof(response->buffer));
+              writer.begin_object();
+              writer.key("alive");
+              writer.flag(snapshot.status.CAN_battery_still_alive);
+              write_battery_info(writer, nullptr, snapshot, "", 0, batteries.supports_charged[index]);
+              writer.end_object();
+              if (index > 0) {
+                out.print(",");
+              }
+              out.print(response->buffer);
+              return true;
+            }
+            if (step == batteries.count + 1) {
+              out.print("]}");
+              return true;
+            }
+            return false;
+          }};
+}
+
+// The voltages or balancing of one step of cells
+static void cell_values(HtmlStream& out, const DATALAYER_BATTERY_SNAPSHOT& snapshot, uint16_t chunk,
+                        bool balancing) {
+  const uint16_t cells = std::min<uint16_t>(snapshot.info.number_of_cells, MAX_AMOUNT_CELLS);
+  const uint16_t end = std::min<uint16_t>(cells, (chunk + 1) * CELLS_PER_STEP);
+  for (uint16_t i = chunk * CELLS_PER_STEP; i < end; i++) {
+    // One fragment per cell, the separator is part of it
+    if (balancing) {
+      const bool active = snapshot.status.cell_balancing_status[i];
+      out.print(i > 0 ? (active ? ",true" : ",false") : (active ? "true" : "false"));
+    } else {
+      out.printf(i > 0 ? ",%u" : "%u", snapshot.status.cell_voltages_mV[i]);
+    }
+  }
+}
+
+ApiResponse api_cells(uint32_t boot_id) {
+  auto batteries = std::make_shared<BatterySnapshots>();
+  read_batteries(*batteries);
+
+  uint32_t generations[6];
+  size_t count = 0;
+  for (uint8_t i = 0; i < batteries->count; i++) {
+    generations[count++] = batteries->snapshots[i]->generation[SNAPSHOT_CELL_VOLTAGES];
+    generations[count++] = batteries->snapshots[i]->generation[SNAPSHOT_CELL_BALANCING];
+  }
+
+  // Each battery has a step per chunk of voltages, then per chunk of balancing states
+  return {api_etag(boot_id, generations, count), [batteries](HtmlStream& out, uint16_t step) {
+            const uint16_t steps_per_battery = 2 * CELL_STEPS;
+            if (step == 0) {
+              out.print("{\"batteries\":[");
+              return true;
+            }
+            const uint16_t battery_step = step - 1;
+            const uint8_t index = battery_step / steps_per_battery;
+            if (index < batteries->count) {
+              const DATALAYER_BATTERY_SNAPSHOT& snapshot = *batteries->snapshots[index];
+              const uint16_t part = battery_step % steps_per_battery;
+              if (part == 0) {
+                out.print(index > 0 ? ",{" : "{");
+                out.printf("\"number_of_cells\":%u,\"cell_voltages_mV\":[", snapshot.info.number_of_cells);
+              } else if (part == CELL_STEPS) {
+                out.print("],\"cell_balancing\":[");
+              }
+              cell_values(out, snapshot, part % CELL_STEPS, part >= CELL_STEPS);
+              if (part == steps_per_battery - 1) {
+                out.print("]}");
+              }
+              return true;
+            }
+            if (battery_step == batteries->count * steps_per_battery) {
+              out.print("]}");
+              return true;
+            }
+            return false;
+          }};
+}
+
+struct EventsResponse {
+  std::vector<EventData> events;
+  char buffer[JSON_BUFFER_SIZE];
+};
+
+ApiResponse api_events(uint32_t boot_id) {
+  auto response = std::make_shared<EventsResponse>();
+  for (int i = 0; i < EVENT_NOF_EVENTS; i++) {
+    const EVENTS_STRUCT_TYPE* event_pointer = get_event_pointer((EVENTS_ENUM_TYPE)i);
+    if (event_pointer->occurences > 0) {
+      response->events.push_back({static_cast<EVENTS_ENUM_TYPE>(i), event_pointer});
+    }
+  }
+  std::sort(response->events.begin(), response->events.end(), compareEventsByTimestampDesc);
+
+  const uint32_t generation = get_events_generation();
+  return {api_etag(boot_id, &generation, 1), [response](HtmlStream& out, uint16_t step) {
+            if (step == 0) {
+              out.print("{\"events\":[");
+              return true;
+            }
+            if (step <= response->events.size()) {
+              const EventData& event = response->events[step - 1];
+              MqttPayloadWriter writer(response->buffer, sizeof(response->buffer));
+              writer.begin_object();
+              writer.key("type");
+              writer.text(get_event_enum_string(event.event_handle));
+              writer.key("severity");
+              writer.text(get_event_level_string(event.event_handle));
+              writer.key("active");
+              writer.flag(event.event_pointer->state == EVENT_STATE_ACTIVE ||
+                          event.event_pointer->state == EVENT_STATE_ACTIVE_LATCHED);
+              writer.key("count");
+              writer.number(event.event_pointer->occurences);
+              writer.key("data");
+              writer.number(event.event_pointer->data);
+              writer.key("millis");
+              writer.number((int64_t)event.event_pointer->timestamp);
+              writer.key("message");
+              writer.text(get_event_message_string(event.event_handle).c_str());
+              writer.end_object();
+              if (step > 1) {
+                out.print(",");
+              }
+              out.print(response->buffer);
+              return true;
+            }
+            if (step == response->events.size() + 1) {
+              out.print("]}");
+              return true;
+            }
+            return false;
+          }};
+}
+
+String api_etag(uint32_t boot_id, const uint32_t* generations, size_t count) {
+  char etag[80];
+  int length = snprintf(etag, sizeof(etag), "W/\"%08x", (unsigned)boot_id);
+  for (size_t i = 0; i < count && length < (int)sizeof(etag); i++) {
+    length += snprintf(etag + length, sizeof(etag) - length, "-%u", (unsigned)generations[i]);
+  }
+  if (length < (int)sizeof(etag) - 1) {
+    etag[length++] = '"';
+    etag[length] = '\0';
+  }
+  return String(etag);
+}
+
+// If-None-Match compares tags without their weak marker
+static const char* opaque_tag(const char* tag, const char* end) {
+  return end - tag >= 2 && strncmp(tag, "W/", 2) == 0 ? tag + 2 : tag;
+}
+
+bool etag_matches(const char* if_none_match, const char* etag) {
+  const char* wanted = opaque_tag(etag, etag + strlen(etag));
+  const size_t wanted_length = strlen(wanted);
+
+  const char* next = if_none_match;
+  while (*next != '\0') {
+    while (*next == ' ' || *next == ',') {
+      next++;
+    }
+    const char* end = next;
+    while (*end != '\0' && *end != ',') {
+      end++;
+    }
+    const char* last = end;
+    while (last > next && last[-1] == ' ') {
+      last--;
+    }
+    if (last - next == 1 && *next == '*') {
+      return true;
+    }
+    const char* tag = opaque_tag(next, last);
+    if ((size_t)(last - tag) == wanted_length && strncmp(tag, wanted, wanted_length) == 0) {
+      return true;
+    }
+    next = end;
+  }
+  return false;
+}
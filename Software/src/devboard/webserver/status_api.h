@@ -0,0 +1,41 @@
+#ifndef STATUS_API_H
+#define STATUS_API_H
+
+#include <WString.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "html_stream.h"
+
+// The JSON API under /api/v1/ for dashboards and scripts. The battery values come from the datalayer
+// snapshot, read once when the request arrives, and are written step by step while the response is sent.
+//
+// Each response has an ETag made of the change generations of what it contains. A client that sends it
+// back in If-None-Match gets 304 Not Modified without a body until the next value update changes
+// something. The ETags are weak: values outside the snapshot, such as the CPU temperature or the time an
+// active event was last seen, are only refreshed along with it.
+
+struct ApiResponse {
+  String etag;
+  HtmlStream::Renderer body;
+};
+
+// The values of each battery, and the BMS and emulator status:
+//   {"bms_status":"ACTIVE","event_level":"INFO","emulator_status":"OK","batteries":[{"alive":true,...}]}
+ApiResponse api_status(uint32_t boot_id);
+// The cell voltages in mV and balancing of each battery:
+//   {"batteries":[{"number_of_cells":96,"cell_voltages_mV":[3712,...],"cell_balancing":[false,...]}]}
+ApiResponse api_cells(uint32_t boot_id);
+// The events that occurred since startup, newest first:
+//   {"events":[{"type":"CAN_BATTERY_MISSING","severity":"ERROR","active":true,"count":1,"data":0,
+//     "millis":12000,"message":"..."}]}
+ApiResponse api_events(uint32_t boot_id);
+
+// ETag of a response containing the given generations, e.g. W/"5f3a9c01-12-7". The boot id tells apart
+// the generations of different startups, which all count from zero.
+String api_etag(uint32_t boot_id, const uint32_t* generations, size_t count);
+
+// True if the value of an If-None-Match header lists etag, or is *. Weak and strong tags are compared
+// the same way, as If-None-Match does.
+bool etag_matches(const char* if_none_match, const char* etag);
+
+#endif
@@ -0,0 +1,16 @@
+#include "web_assets.h"
+#include <string.h>
+
+const WebAsset* find_web_asset(const char* path) {
+  for (size_t i = 0; i < web_asset_count; i++) {
+    if (strcmp(web_assets[i].path, path) == 0) {
+      return &web_assets[i];
+    }
+  }
+  return nullptr;
+}
+
+const char* web_asset_url(const char* path) {
+  const WebAsset* asset = find_web_asset(path);
+  return asset == nullptr ? path : asset->url;
+}
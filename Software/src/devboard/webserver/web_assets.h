@@ -0,0 +1,29 @@
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// The style sheets and scripts of the web pages. They are kept in assets/ and compressed into
+// web_assets_data.cpp at build time, by assets/embed_web_assets.py, so they are sent from flash as they
+// are, with Content-Encoding: gzip. Browsers cache them for a long time: the pages refer to them by a URL
+// containing their version, which changes along with their content.
+struct WebAsset {
+  const char* path;  // e.g. /assets/status.css
+  const char* url;   // The path with the version, for the pages to refer to, e.g. /assets/status.css?v=5f3a9c01
+  const char* content_type;
+  const char* etag;
+  const uint8_t* data;  // gzip
+  size_t length;
+};
+
+extern const WebAsset web_assets[];
+extern const size_t web_asset_count;
+
+// Returns the asset served at path, nullptr if there is none
+const WebAsset* find_web_asset(const char* path);
+
+// The URL of the asset at path, for the pages to refer to. path itself if there is no such asset.
+const char* web_asset_url(const char* path);
+
+#endif
@@ -0,0 +1,489 @@
+// Generated by assets/embed_web_assets.py from the files in assets/, do not edit
+#include "web_assets.h"
+
+// clang-format off
+static const uint8_t cellmonitor_css[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x75, 0x92, 0x4b, 0x6e, 0xe3, 0x30,
+    0x0c, 0x86, 0xf7, 0x39, 0x05, 0x81, 0xec, 0x8a, 0x2a, 0x4d, 0xd3, 0x66, 0x06, 0x70, 0x56, 0x05,
+    0x66, 0x4e, 0x30, 0x27, 0xd0, 0x83, 0xb1, 0x35, 0xc3, 0x88, 0x86, 0x24, 0x27, 0x0d, 0x8a, 0xde,
+    0xbd, 0x94, 0x1f, 0x49, 0x9b, 0x71, 0x37, 0xb2, 0x29, 0x90, 0x9f, 0xc8, 0x9f, 0xbf, 0x61, 0x77,
+    0x86, 0x37, 0x30, 0xda, 0xfe, 0xab, 0x23, 0x77, 0xc1, 0x29, 0xcb, 0xc4, 0xb1, 0x02, 0x43, 0x72,
+    0xb5, 0x83, 0x31, 0x3a, 0x35, 0x3e, 0xe3, 0x0e, 0xde, 0x17, 0xa6, 0xcb, 0x99, 0xc3, 0x6c, 0xc5,
+    0x72, 0xbb, 0xde, 0xfe, 0xfe, 0xf1, 0xf3, 0xb6, 0xc6, 0x70, 0x74, 0x28, 0x61, 0xe0, 0x20, 0x51,
+    0xab, 0x9d, 0xf3, 0xa1, 0xae, 0xe0, 0x71, 0xdd, 0xbe, 0xc2, 0x46, 0x8e, 0x1d, 0x1c, 0x74, 0xac,
+    0x7d, 0x50, 0x86, 0x05, 0x7d, 0xa8, 0xc6, 0x4b, 0xdb, 0xc5, 0x54, 0x28, 0x2d, 0xfb, 0x90, 0x31,
+    0x4e, 0x1c, 0x15, 0xb5, 0xf3, 0x5d, 0x1a, 0xea, 0xaf, 0x0d, 0x55, 0x0d, 0x1f, 0x31, 0xce, 0xb7,
+    0xf5, 0xf4, 0xf2, 0xfc, 0xb2, 0xdd, 0x94, 0xdc, 0x95, 0xe5, 0x90, 0xb5, 0x0f, 0x7d, 0xa6, 0xf3,
+    0xa9, 0x25, 0x7d, 0xae, 0x60, 0x4f, 0x28, 0xa4, 0x72, 0xaa, 0x53, 0xd4, 0xad, 0x34, 0x2e, 0xe7,
+    0x0e, 0xfe, 0x76, 0x29, 0xfb, 0xfd, 0x59, 0x95, 0x1a, 0x0c, 0xb9, 0x82, 0xd4, 0x6a, 0x8b, 0x4a,
+    0xf7, 0xf0, 0x81, 0x86, 0x44, 0x02, 0xfa, 0x32, 0xd2, 0x75, 0xde, 0x47, 0x99, 0x2f, 0x31, 0x79,
+    0x37, 0x09, 0x91, 0xf1, 0x35, 0x2b, 0x4d, 0xbe, 0x0e, 0x15, 0x58, 0x1c, 0x86, 0x12, 0x0a, 0xf1,
+    0x49, 0x1d, 0x99, 0xb2, 0xae, 0x51, 0x60, 0x63, 0xd3, 0x11, 0xcb, 0x13, 0xf0, 0x70, 0x07, 0x7f,
+    0xf2, 0x99, 0x10, 0xf6, 0x1c, 0x41, 0x12, 0x61, 0x4a, 0x2c, 0x2c, 0xb8, 0x7b, 0x58, 0xac, 0xc6,
+    0x0b, 0x75, 0xd4, 0xd4, 0x61, 0x12, 0xc0, 0x8d, 0x98, 0xa3, 0x4c, 0x5f, 0x49, 0x13, 0x65, 0x2c,
+    0x4a, 0x68, 0xb3, 0x97, 0xa5, 0x0a, 0x6f, 0x59, 0xcb, 0xec, 0xcd, 0x3d, 0x0c, 0xdf, 0xcd, 0xf4,
+    0xf3, 0xf4, 0xbf, 0x5e, 0xfd, 0x20, 0x4a, 0x06, 0x3b, 0xa4, 0xe1, 0x4a, 0x61, 0x91, 0xa5, 0x41,
+    0x5f, 0x37, 0xb9, 0x2c, 0xf1, 0x1b, 0x31, 0x96, 0xd6, 0x5a, 0xb1, 0x01, 0x27, 0x5f, 0xde, 0x2c,
+    0x93, 0x92, 0xce, 0xfe, 0xd8, 0x9b, 0x6b, 0x65, 0x74, 0xbc, 0x8c, 0x50, 0xc1, 0x1a, 0x06, 0xc6,
+    0x8c, 0x37, 0x3b, 0xc9, 0xbf, 0x34, 0xe4, 0x03, 0xc9, 0x4e, 0x95, 0x21, 0x2e, 0x8e, 0x9d, 0x43,
+    0x7f, 0x63, 0xa6, 0x99, 0x25, 0xbd, 0x2f, 0x96, 0xbd, 0x2a, 0xbf, 0x06, 0xb8, 0x08, 0xf0, 0x39,
+    0xdc, 0xdc, 0xc4, 0x45, 0x97, 0xcf, 0x6b, 0x25, 0xdc, 0x67, 0xb1, 0x92, 0x38, 0x46, 0x9d, 0x46,
+    0x21, 0x0c, 0x93, 0xbb, 0x58, 0x3c, 0x73, 0x7b, 0x75, 0xee, 0x07, 0xdd, 0x51, 0xce, 0xfc, 0x7b,
+    0x03, 0x00, 0x00,
+};
+
+static const uint8_t cellmonitor_js[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x58, 0x6d, 0x6f, 0x1b, 0x37,
+    0x12, 0xfe, 0xae, 0x5f, 0x31, 0x41, 0x83, 0xdb, 0xdd, 0x8b, 0xbc, 0x52, 0x1c, 0xb4, 0x3d, 0xd8,
+    0x91, 0x0f, 0xad, 0x9d, 0xa2, 0x29, 0xec, 0xb8, 0x68, 0x72, 0xfe, 0x12, 0x18, 0x36, 0xa5, 0xa5,
+    0x24, 0x36, 0xbb, 0x4b, 0x61, 0x49, 0x49, 0x16, 0x5c, 0xfd, 0xf7, 0xce, 0x0c, 0x97, 0xbb, 0xd4,
+    0x8b, 0x1d, 0x1b, 0xcd, 0xf9, 0x83, 0xa1, 0x25, 0x87, 0x33, 0xc3, 0x99, 0x67, 0x5e, 0x38, 0xbd,
+    0x1e, 0x9c, 0x55, 0x62, 0x69, 0xc0, 0x4e, 0x25, 0x8c, 0x64, 0x9e, 0x1b, 0xd0, 0x63, 0x90, 0x62,
+    0x34, 0x85, 0xa1, 0xb0, 0x56, 0x56, 0x2b, 0x10, 0x06, 0x86, 0xb9, 0x1e, 0x7d, 0x31, 0x20, 0xca,
+    0x8c, 0xbe, 0x04, 0x6e, 0x55, 0x30, 0xa9, 0xc4, 0x6c, 0x9a, 0xc2, 0x27, 0x3c, 0x37, 0x13, 0x13,
+    0x3c, 0x2c, 0xe8, 0x30, 0xb1, 0xb8, 0xd0, 0xa5, 0xb2, 0xba, 0x8a, 0x13, 0xd0, 0xe5, 0x08, 0x77,
+    0x65, 0xd5, 0xe9, 0xf5, 0x1a, 0x76, 0x4b, 0x65, 0xa7, 0x2c, 0x6d, 0x21, 0xf2, 0xb9, 0x34, 0xa0,
+    0x2c, 0x2c, 0x91, 0x69, 0x25, 0xcb, 0x4c, 0x56, 0x32, 0xe3, 0xfd, 0x2e, 0x88, 0x31, 0x12, 0x23,
+    0x99, 0xb0, 0x44, 0x8b, 0x4a, 0x54, 0x12, 0x49, 0x32, 0x54, 0xb5, 0x84, 0x71, 0xa5, 0x0b, 0xe6,
+    0x90, 0xab, 0x85, 0x84, 0xf9, 0x2c, 0x13, 0x56, 0xb2, 0xda, 0x3d, 0x5a, 0x48, 0x3b, 0x23, 0x5d,
+    0x1a, 0x1b, 0x6a, 0x62, 0x60, 0x00, 0xf7, 0xeb, 0xe3, 0x4e, 0x67, 0x3c, 0x2f, 0x47, 0x56, 0xe9,
+    0x12, 0xa6, 0xba, 0x90, 0xa8, 0xdf, 0x3d, 0x4a, 0x2b, 0x33, 0xbd, 0x4c, 0xf1, 0x7e, 0x82, 0x36,
+    0xd2, 0x69, 0x25, 0xc7, 0x48, 0x1d, 0xf5, 0xa2, 0x63, 0x58, 0x77, 0x48, 0xef, 0x9f, 0xaa, 0x6c,
+    0xae, 0x4a, 0x7d, 0x60, 0xec, 0x2a, 0x97, 0x50, 0x88, 0x19, 0x9e, 0xf3, 0x7c, 0x5a, 0x86, 0xb4,
+    0xce, 0x17, 0xea, 0xb2, 0x7a, 0xe7, 0x7a, 0xe9, 0x7e, 0xfc, 0xaa, 0x26, 0x78, 0x1b, 0xab, 0x79,
+    0xc1, 0x6a, 0xfa, 0x44, 0xb1, 0x1d, 0xc0, 0xcb, 0xd8, 0x79, 0x55, 0x82, 0x3b, 0x04, 0x07, 0xfe,
+    0x54, 0x02, 0xff, 0x86, 0xd8, 0xd1, 0xe1, 0x22, 0x9f, 0x4b, 0xa0, 0x07, 0xb1, 0xe7, 0x15, 0x52,
+    0xbe, 0x72, 0xfb, 0xc7, 0x9d, 0x75, 0x70, 0x33, 0x32, 0xd1, 0x29, 0xf9, 0x31, 0xae, 0x0d, 0xee,
+    0xc4, 0x39, 0x9b, 0x94, 0x78, 0xb5, 0x7a, 0x39, 0x2d, 0x45, 0x21, 0x8f, 0x9b, 0x1d, 0xb4, 0xa1,
+    0x08, 0x36, 0xe9, 0xb3, 0xdd, 0x1c, 0x8a, 0x5c, 0x94, 0x23, 0x55, 0x4e, 0x02, 0x8a, 0x66, 0xad,
+    0x25, 0x63, 0x44, 0x9c, 0xea, 0xd2, 0x0a, 0x55, 0xa2, 0xf3, 0x06, 0x90, 0xe9, 0xd1, 0xbc, 0x90,
+    0xa5, 0x4d, 0x27, 0xd2, 0xbe, 0xcb, 0x25, 0xfd, 0xfc, 0x79, 0xf5, 0x3e, 0x8b, 0x23, 0xa6, 0x8c,
+    0xf0, 0x02, 0x65, 0xd2, 0x1e, 0x67, 0x4b, 0x9c, 0x29, 0x33, 0xcb, 0xc5, 0xea, 0xb1, 0xc3, 0x21,
+    0xdd, 0x36, 0x0f, 0x72, 0xfa, 0x93, 0x34, 0xd8, 0x20, 0x6c, 0xb9, 0x6c, 0x5e, 0x21, 0x55, 0x25,
+    0xfe, 0xff, 0xf5, 0xd3, 0xc5, 0x39, 0x41, 0x22, 0x62, 0x31, 0xe1, 0xb9, 0x9d, 0x7d, 0x24, 0x40,
+    0xc4, 0xbc, 0x1f, 0xc3, 0x52, 0xc2, 0x54, 0x2c, 0x3c, 0xc6, 0xbb, 0xa8, 0x07, 0x03, 0xd6, 0x4e,
+    0xd1, 0x60, 0x29, 0x5c, 0xe2, 0xef, 0x6a, 0xa9, 0x0c, 0x82, 0x25, 0xab, 0xef, 0x3b, 0xae, 0x14,
+    0x06, 0x40, 0xbe, 0x82, 0x42, 0x1a, 0x43, 0xe1, 0x44, 0xb1, 0xb6, 0x14, 0xca, 0x22, 0x4b, 0x35,
+    0x86, 0x98, 0x1c, 0x92, 0xe6, 0xb2, 0x9c, 0x60, 0xf0, 0x0c, 0x06, 0xd0, 0x77, 0x5e, 0x85, 0x47,
+    0xac, 0xa4, 0x73, 0x8b, 0x7c, 0xae, 0x58, 0x01, 0x77, 0xc1, 0xd4, 0xca, 0x3b, 0x4b, 0xca, 0x23,
+    0x51, 0xe0, 0x49, 0x59, 0xcc, 0xec, 0xea, 0x98, 0xb9, 0x39, 0x50, 0xd2, 0xef, 0x75, 0x63, 0xd2,
+    0x42, 0x95, 0x37, 0xc5, 0x02, 0xe9, 0x2f, 0x84, 0x9d, 0xa6, 0xf8, 0x15, 0xa7, 0x29, 0xe3, 0x23,
+    0x30, 0x7b, 0x21, 0xee, 0x42, 0x1a, 0x71, 0xb7, 0x8f, 0x06, 0xf9, 0x60, 0xb0, 0xc9, 0x3b, 0x72,
+    0x0b, 0xdd, 0x86, 0x3f, 0x2e, 0xc7, 0xb1, 0x13, 0xb0, 0xc5, 0x6d, 0x3f, 0x25, 0x8b, 0x49, 0xbc,
+    0x9d, 0x7f, 0xd1, 0x95, 0xcb, 0x54, 0x75, 0xe0, 0x89, 0x0c, 0xd3, 0x13, 0x7b, 0xc8, 0x25, 0x2c,
+    0x97, 0x6a, 0x94, 0x35, 0x8e, 0x00, 0x0f, 0x31, 0xb7, 0xb1, 0xae, 0xde, 0xe1, 0xa9, 0x38, 0x2e,
+    0xae, 0xba, 0xc0, 0xac, 0x13, 0x18, 0x9c, 0xd4, 0xf6, 0x6c, 0x61, 0x14, 0xa2, 0x67, 0x54, 0x49,
+    0xcc, 0x31, 0xb5, 0x7d, 0xe3, 0x28, 0x53, 0x8b, 0x28, 0x71, 0x16, 0x23, 0xca, 0x74, 0x94, 0x0b,
+    0x63, 0x3e, 0x60, 0x3c, 0x11, 0x0c, 0x68, 0x25, 0x0a, 0x36, 0x55, 0x86, 0xab, 0xb7, 0xf4, 0xf3,
+    0x3d, 0xc9, 0x7a, 0x79, 0x5f, 0xae, 0x5f, 0xde, 0xb3, 0xd8, 0xf5, 0xad, 0x23, 0xcb, 0x65, 0x0b,
+    0x5c, 0xe7, 0x9a, 0x5b, 0x8a, 0x60, 0xa8, 0xc9, 0xd0, 0x77, 0xaf, 0xd7, 0x6f, 0x87, 0xd5, 0xc9,
+    0xcb, 0xfb, 0xe2, 0x6a, 0x0d, 0xc5, 0x55, 0x7d, 0x8c, 0x60, 0x51, 0x5c, 0xc1, 0x5b, 0x78, 0xd3,
+    0xef, 0x37, 0x78, 0x80, 0x6d, 0x4e, 0x6f, 0xcd, 0x4c, 0x94, 0xc0, 0x1a, 0x0e, 0xa2, 0x5c, 0x2f,
+    0x0f, 0x6a, 0x60, 0x44, 0xc8, 0x2e, 0x20, 0x5d, 0xbf, 0xed, 0x11, 0xe1, 0x49, 0xcd, 0x7b, 0x1d,
+    0xe8, 0x1f, 0x60, 0x3c, 0x38, 0xc0, 0x4e, 0xa8, 0x49, 0xd0, 0xf0, 0xef, 0x16, 0xb8, 0x76, 0xae,
+    0x0c, 0x6e, 0xc9, 0x2a, 0x8e, 0x0a, 0x3d, 0x37, 0x12, 0x57, 0x30, 0xb6, 0xba, 0x10, 0x07, 0xf6,
+    0x75, 0xb7, 0xa5, 0xfa, 0xf1, 0x70, 0x70, 0xde, 0xe2, 0xf6, 0xae, 0xad, 0x6a, 0x83, 0xc3, 0x46,
+    0x9e, 0xd8, 0x82, 0xf4, 0x2d, 0xc3, 0xfd, 0x08, 0xd8, 0x52, 0xb7, 0xfe, 0x00, 0xb2, 0x4b, 0x39,
+    0x7b, 0x63, 0xd2, 0x1a, 0x7d, 0x99, 0x54, 0x7a, 0x5e, 0x66, 0xa7, 0x3a, 0xd7, 0x15, 0x07, 0x41,
+    0x9d, 0xc6, 0x3e, 0xb3, 0x98, 0x6b, 0xf8, 0x2f, 0x44, 0xdf, 0xfd, 0xa7, 0xff, 0x0b, 0xfe, 0x45,
+    0x70, 0x04, 0x51, 0x8e, 0x39, 0xd7, 0x0e, 0x91, 0x29, 0xd6, 0x03, 0x84, 0xdc, 0x39, 0x7d, 0x62,
+    0x66, 0x19, 0xad, 0xd0, 0xa8, 0xe8, 0x80, 0xe6, 0x78, 0x60, 0xfc, 0xe7, 0xc9, 0xea, 0xf7, 0x7f,
+    0xc0, 0x3f, 0x96, 0x55, 0x8b, 0xa1, 0x3f, 0x14, 0x75, 0x26, 0xaa, 0x2f, 0x0f, 0x4a, 0x5a, 0x27,
+    0x4f, 0xb0, 0x7f, 0x2e, 0x31, 0x05, 0x7d, 0x7b, 0xfb, 0x3f, 0xdb, 0x9c, 0xfd, 0xd6, 0x9c, 0xad,
+    0x25, 0xff, 0x90, 0x06, 0x2b, 0xb3, 0x04, 0x5d, 0xa9, 0x89, 0x2a, 0x45, 0x8e, 0x91, 0x87, 0x2c,
+    0x76, 0xcd, 0x58, 0xc9, 0x42, 0x2f, 0xe4, 0xef, 0x95, 0xc6, 0x36, 0xc2, 0xae, 0xe2, 0xa8, 0x95,
+    0x79, 0xc0, 0x27, 0x7c, 0x20, 0x6e, 0x58, 0xa4, 0xcd, 0xd0, 0x62, 0x36, 0xc3, 0xbc, 0x7a, 0x3a,
+    0x55, 0x79, 0x16, 0xd3, 0x0e, 0x53, 0xaf, 0x9b, 0x14, 0xf2, 0xb3, 0x30, 0x8a, 0x1a, 0x97, 0x15,
+    0xa0, 0x0d, 0x38, 0x45, 0x53, 0x52, 0x30, 0xb8, 0x24, 0xf9, 0x6b, 0x2a, 0xc9, 0xe1, 0xae, 0xf1,
+    0xe1, 0xec, 0x42, 0x96, 0xc3, 0xf0, 0xc7, 0xca, 0xcb, 0x89, 0x65, 0xe4, 0x05, 0x3d, 0x23, 0xb9,
+    0x6c, 0x19, 0xff, 0x91, 0xdc, 0xe2, 0xb2, 0xe1, 0xd5, 0x4d, 0xae, 0x0a, 0x65, 0x25, 0xe5, 0x11,
+    0x6a, 0x33, 0x88, 0x73, 0x9d, 0x94, 0x0f, 0x9a, 0x24, 0x5e, 0x88, 0x0a, 0xcd, 0xd8, 0xf5, 0x99,
+    0xf8, 0xd5, 0xce, 0xc6, 0xf6, 0xf7, 0xeb, 0x3e, 0x76, 0x1a, 0x9b, 0x8b, 0xb5, 0x58, 0xf2, 0xef,
+    0x46, 0x46, 0xc3, 0x85, 0xa8, 0xdd, 0x72, 0xf9, 0x6c, 0x2f, 0x44, 0x5a, 0x22, 0xe7, 0xbb, 0xda,
+    0x7a, 0x48, 0x4e, 0x01, 0xe9, 0xaf, 0xb1, 0x9e, 0xdd, 0xed, 0x50, 0x2e, 0x55, 0x46, 0x85, 0x8d,
+    0x08, 0x7f, 0xfc, 0xbe, 0xdf, 0x0b, 0xaa, 0x5d, 0x4b, 0x4d, 0xf9, 0x6e, 0x1b, 0x5f, 0x6d, 0xda,
+    0x7b, 0x0c, 0x95, 0x0d, 0x04, 0x19, 0x79, 0xa7, 0x14, 0x51, 0x8c, 0x1d, 0x40, 0x6f, 0xed, 0x84,
+    0x70, 0xc0, 0x48, 0x57, 0xd8, 0x92, 0xee, 0x32, 0x71, 0x78, 0x03, 0x99, 0x1b, 0xf9, 0x34, 0xf1,
+    0x2d, 0xea, 0x3f, 0xe8, 0xaa, 0x10, 0x54, 0x9e, 0xb0, 0xe7, 0x23, 0xe1, 0xa5, 0x2e, 0x0f, 0x9e,
+    0xac, 0xc0, 0x72, 0x8a, 0xe6, 0xf3, 0xe2, 0x3b, 0x8f, 0x94, 0xab, 0xed, 0x78, 0xde, 0x5f, 0x7c,
+    0x7c, 0xc0, 0xa0, 0x5a, 0x17, 0x98, 0x6b, 0x1c, 0x17, 0x42, 0x3a, 0x01, 0x94, 0x4b, 0xe7, 0x14,
+    0xdd, 0x87, 0x61, 0xda, 0xc3, 0xb2, 0x21, 0x7d, 0x83, 0x66, 0x1a, 0x5f, 0xc4, 0x75, 0x8d, 0x1e,
+    0xb4, 0xa5, 0x3d, 0x81, 0xbf, 0xfe, 0x82, 0x60, 0xdd, 0x17, 0xf2, 0x64, 0xb3, 0x3c, 0xed, 0xbf,
+    0x1e, 0xb6, 0xf7, 0xd1, 0xf1, 0xd7, 0x6c, 0xd0, 0x12, 0xd5, 0x16, 0x20, 0xca, 0x67, 0xd5, 0x9f,
+    0x27, 0x97, 0x0f, 0x0c, 0xa2, 0x78, 0x5f, 0x3e, 0x0b, 0x56, 0x13, 0x4e, 0x6a, 0x51, 0xf2, 0x8d,
+    0x2b, 0xcd, 0xb7, 0x2b, 0x26, 0x9b, 0xa9, 0xf1, 0x11, 0x5b, 0xed, 0xaf, 0x15, 0x8f, 0xd8, 0x2a,
+    0xaa, 0x6d, 0x85, 0x8d, 0x5e, 0xf4, 0xff, 0xa9, 0x0c, 0x3b, 0x95, 0xaf, 0xeb, 0x42, 0x6e, 0xe8,
+    0x7a, 0xb9, 0x7f, 0x5a, 0x27, 0xb6, 0x5a, 0xfd, 0xb0, 0x50, 0xe0, 0x3d, 0xb6, 0xea, 0xc4, 0xff,
+    0xf8, 0x91, 0x59, 0x97, 0x04, 0x81, 0x80, 0xa4, 0xe7, 0x26, 0xc2, 0xbb, 0x87, 0xd0, 0xef, 0x65,
+    0x72, 0xa1, 0xf8, 0xf5, 0x88, 0x6d, 0x16, 0x76, 0xf1, 0xf6, 0xc0, 0xa8, 0xcc, 0x85, 0x37, 0x85,
+    0x27, 0xdb, 0x79, 0xb4, 0xea, 0x3c, 0xb3, 0x57, 0x0f, 0xdb, 0x2e, 0xcc, 0x8a, 0x3e, 0x53, 0x5b,
+    0x65, 0x73, 0xb9, 0xbe, 0x10, 0x77, 0x70, 0xe5, 0x0e, 0x01, 0xc3, 0x95, 0xb3, 0x3e, 0xf5, 0x86,
+    0xd4, 0x27, 0x22, 0x72, 0xf9, 0x86, 0xb7, 0x17, 0xaa, 0xf4, 0x64, 0x4c, 0xc5, 0x45, 0xc3, 0x53,
+    0xf9, 0xf3, 0x67, 0x5e, 0xfb, 0x96, 0x11, 0xd6, 0x95, 0x96, 0xb6, 0x95, 0x5d, 0x6a, 0x2b, 0x29,
+    0xc9, 0xbb, 0x77, 0x31, 0xbd, 0x1f, 0x41, 0x19, 0x84, 0x7f, 0x17, 0xa2, 0xc3, 0x08, 0x0b, 0x39,
+    0x44, 0x6f, 0xf0, 0x37, 0xbe, 0xe5, 0x51, 0x2c, 0x59, 0x4a, 0x65, 0xfc, 0x2a, 0xa7, 0x9f, 0xd2,
+    0x5d, 0xb7, 0xf9, 0xf6, 0x2c, 0xa1, 0xbe, 0xba, 0xa9, 0x13, 0x8f, 0x7f, 0x67, 0x32, 0x1c, 0x41,
+    0xcf, 0x2d, 0x49, 0x6a, 0x47, 0x13, 0x58, 0x2a, 0x33, 0xda, 0xee, 0xa3, 0x5e, 0x29, 0xe8, 0x19,
+    0xa9, 0x6d, 0x8e, 0x80, 0x8d, 0x02, 0x43, 0x39, 0x26, 0xd8, 0xf0, 0x68, 0xa1, 0xe6, 0xda, 0x05,
+    0xd2, 0xb9, 0x19, 0x26, 0x48, 0x68, 0x5c, 0x85, 0x58, 0xa2, 0x67, 0x4f, 0xd7, 0xd5, 0x7c, 0xf7,
+    0xe6, 0x22, 0x59, 0x66, 0xaa, 0x97, 0x25, 0x60, 0xa6, 0x75, 0x0d, 0x00, 0xf2, 0xa3, 0xc9, 0x43,
+    0xa9, 0x03, 0x96, 0xa4, 0xa9, 0xaf, 0xa2, 0xae, 0x63, 0x40, 0x1a, 0x02, 0x9a, 0x9b, 0x49, 0xb8,
+    0x5c, 0x49, 0x44, 0x75, 0xfa, 0x74, 0x89, 0xb5, 0xb6, 0x89, 0x9b, 0x9a, 0xb4, 0xcf, 0xf5, 0x70,
+    0x5e, 0x42, 0x16, 0xed, 0x06, 0x82, 0x02, 0xe0, 0xd7, 0x57, 0x0d, 0xdf, 0xf2, 0x7e, 0x9e, 0x32,
+    0x80, 0xcb, 0xe1, 0x9f, 0x72, 0x64, 0x53, 0xac, 0xd8, 0x6a, 0x52, 0xc6, 0xf7, 0xc4, 0xe6, 0x08,
+    0x1c, 0x33, 0xb6, 0xcc, 0x11, 0xfb, 0x88, 0x2c, 0xe1, 0x7e, 0xf1, 0xcd, 0xdd, 0x4f, 0x77, 0x8f,
+    0x23, 0x38, 0xec, 0xaf, 0x5b, 0x21, 0x04, 0xfd, 0x70, 0x10, 0x80, 0x22, 0xbc, 0x52, 0xe1, 0xd6,
+    0xe6, 0x54, 0x20, 0x98, 0x06, 0xa0, 0x19, 0x3f, 0x05, 0x4e, 0x20, 0x9f, 0x63, 0x8b, 0x55, 0xbb,
+    0x50, 0xd4, 0x76, 0x6a, 0x4f, 0x17, 0xc2, 0x7c, 0x61, 0xd8, 0x60, 0xcf, 0x61, 0xd1, 0xc5, 0x23,
+    0xa9, 0x16, 0xd8, 0xec, 0xf0, 0x94, 0x87, 0x27, 0x3a, 0x81, 0x4c, 0x7e, 0x64, 0x96, 0xf3, 0x3c,
+    0x0f, 0x15, 0x21, 0x06, 0xc1, 0x72, 0x38, 0xf8, 0xf9, 0xcc, 0x28, 0x1d, 0xd0, 0xeb, 0x9c, 0x12,
+    0x0e, 0x67, 0x9a, 0x1b, 0x8e, 0x30, 0x5c, 0xbf, 0x6e, 0x1f, 0xc1, 0x74, 0x6e, 0x77, 0x72, 0xe2,
+    0xa1, 0xfe, 0x07, 0x0f, 0x9e, 0xdc, 0xe0, 0xcb, 0x19, 0x9d, 0x07, 0x5b, 0x1b, 0xe3, 0xa7, 0x21,
+    0x42, 0x80, 0x9a, 0x9d, 0xa1, 0xf6, 0x6f, 0xce, 0xfd, 0xc8, 0x1e, 0xe7, 0x62, 0x62, 0x5a, 0xff,
+    0x13, 0x0f, 0xc7, 0x3e, 0x36, 0xf3, 0xf1, 0x58, 0xdd, 0xed, 0x77, 0xf1, 0xc6, 0x9d, 0x1c, 0xe1,
+    0xf5, 0x71, 0x3d, 0x1a, 0x78, 0xe1, 0xc9, 0xb0, 0xf6, 0x86, 0x76, 0x1a, 0x38, 0x93, 0x6c, 0x2c,
+    0xb3, 0xa5, 0xea, 0x8d, 0x24, 0x78, 0xee, 0xfb, 0x87, 0x37, 0x1b, 0x32, 0xa4, 0x0e, 0x36, 0x17,
+    0xe1, 0xd6, 0x62, 0x0f, 0x48, 0x8a, 0x45, 0x3a, 0x56, 0x39, 0xae, 0xc4, 0x0b, 0x2a, 0x22, 0x0b,
+    0x78, 0x41, 0x83, 0x8a, 0x87, 0x20, 0x83, 0xd4, 0xd4, 0xcd, 0xc6, 0x0b, 0xec, 0x93, 0xb9, 0xe8,
+    0xc4, 0xf1, 0x4c, 0x54, 0x46, 0xbe, 0xc7, 0x2e, 0x98, 0x24, 0xa7, 0x66, 0x3e, 0x34, 0xb6, 0xc2,
+    0x36, 0x03, 0x4e, 0x4e, 0xe0, 0x0d, 0x0d, 0xc6, 0x0e, 0xbb, 0x70, 0x98, 0x60, 0xeb, 0xfa, 0x03,
+    0xf7, 0x19, 0xf8, 0xe6, 0xc5, 0x0d, 0xdc, 0xfe, 0x17, 0xfc, 0x98, 0xe0, 0xbf, 0xd7, 0x09, 0x39,
+    0xfa, 0x75, 0xc2, 0xb9, 0xcf, 0x6b, 0x12, 0x0f, 0x3d, 0xfb, 0x62, 0xf1, 0x59, 0x5d, 0xb7, 0x2a,
+    0x3d, 0xe0, 0xed, 0xc6, 0x31, 0x95, 0xcc, 0xb5, 0xc8, 0xce, 0x05, 0x31, 0xa1, 0x41, 0xa1, 0x91,
+    0xf6, 0x93, 0x2a, 0x24, 0xa6, 0xa4, 0xd8, 0xd3, 0xc4, 0xc9, 0x3d, 0x34, 0x83, 0x43, 0x47, 0x1f,
+    0xdb, 0x6a, 0x2e, 0x93, 0x63, 0xc0, 0x68, 0x3a, 0xec, 0xd3, 0xb3, 0xdc, 0x4f, 0x11, 0x3f, 0x5a,
+    0x51, 0x59, 0xb3, 0x33, 0xb5, 0xec, 0xf2, 0xd8, 0x14, 0xd1, 0xce, 0x80, 0xa2, 0x28, 0x71, 0xda,
+    0x28, 0xc2, 0x0d, 0x26, 0x1e, 0x94, 0x8a, 0xa4, 0x7b, 0xd3, 0xc5, 0x39, 0xb2, 0x89, 0x1d, 0x5a,
+    0x18, 0x05, 0xf5, 0x24, 0x93, 0x8b, 0xfb, 0x47, 0x3d, 0xaf, 0x46, 0xd2, 0x37, 0x5d, 0x1b, 0x57,
+    0x79, 0x78, 0xd0, 0xc3, 0x7a, 0x21, 0x34, 0xe4, 0x12, 0x02, 0x26, 0x71, 0xc4, 0x31, 0xe8, 0xca,
+    0xe7, 0x67, 0x4e, 0xf6, 0x37, 0x87, 0xfc, 0xff, 0x4d, 0x74, 0xdd, 0x3c, 0x77, 0x1a, 0x93, 0x84,
+    0x20, 0x06, 0x66, 0xb9, 0xa7, 0xe3, 0xe0, 0x4c, 0x40, 0x51, 0xe8, 0xa8, 0xbb, 0xcd, 0x3c, 0x35,
+    0x96, 0x41, 0xa3, 0xd8, 0xb4, 0xb6, 0x34, 0xbe, 0xfd, 0xed, 0xe3, 0xe5, 0x87, 0x94, 0xf1, 0x11,
+    0xcb, 0x76, 0xb2, 0xe4, 0x5b, 0xd1, 0x17, 0xfb, 0xe2, 0x23, 0xc4, 0xb7, 0x6f, 0x16, 0xb6, 0x69,
+    0x5c, 0x42, 0x61, 0x21, 0x29, 0xfd, 0xbf, 0xc9, 0x24, 0x46, 0xed, 0x0d, 0x56, 0x17, 0xc2, 0x26,
+    0x7f, 0x10, 0x76, 0xdc, 0x8f, 0x57, 0x21, 0xe1, 0x50, 0x18, 0x89, 0x74, 0x8d, 0x1a, 0xbb, 0x81,
+    0xdc, 0xf6, 0x1b, 0x8f, 0x98, 0xa2, 0x89, 0x88, 0xaf, 0x99, 0xe3, 0x1f, 0x5e, 0xd3, 0x45, 0xf6,
+    0xae, 0x15, 0xfd, 0x65, 0x6a, 0x2d, 0x6e, 0x7c, 0xcc, 0x7f, 0xfd, 0x4a, 0xee, 0x3f, 0x5f, 0x4b,
+    0xe3, 0x55, 0x2a, 0xee, 0xf2, 0xda, 0xd0, 0xc0, 0x90, 0x21, 0x95, 0x79, 0x9f, 0xca, 0xf6, 0x0a,
+    0x23, 0xc0, 0x72, 0x2a, 0x0e, 0xc0, 0x95, 0x9e, 0x9e, 0x5f, 0x7e, 0x7c, 0x77, 0x96, 0x6c, 0x41,
+    0x14, 0xd6, 0x14, 0x8b, 0x7f, 0x03, 0x53, 0xe0, 0x84, 0xea, 0x9b, 0x18, 0x00, 0x00,
+};
+
+static const uint8_t settings_css[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x58, 0x4b, 0x6f, 0xdb, 0x38,
+    0x10, 0xbe, 0xe7, 0x57, 0x10, 0xe9, 0x65, 0xb7, 0xb0, 0x12, 0x3f, 0x64, 0x37, 0xb1, 0xd1, 0x43,
+    0xb1, 0x28, 0xd0, 0x02, 0x45, 0x77, 0x81, 0x74, 0x0f, 0x8b, 0xa2, 0x07, 0x4a, 0xa4, 0x2d, 0x22,
+    0x14, 0xa9, 0x25, 0xa9, 0xda, 0xee, 0xa2, 0xff, 0x7d, 0x47, 0xa2, 0xa8, 0x87, 0x23, 0x97, 0x54,
+    0x10, 0x24, 0x11, 0xf1, 0x3d, 0x66, 0x86, 0xc3, 0xa1, 0x9c, 0x44, 0x92, 0x33, 0xfa, 0x0f, 0x25,
+    0x38, 0x7d, 0x3e, 0x28, 0x59, 0x0a, 0x12, 0xa5, 0x92, 0x4b, 0xb5, 0x45, 0x09, 0x87, 0xa5, 0x1d,
+    0x6a, 0x9e, 0x8e, 0x19, 0x33, 0x74, 0x87, 0x7e, 0xde, 0xa0, 0xfa, 0x2b, 0x29, 0x8d, 0x91, 0x62,
+    0x94, 0xf7, 0x6a, 0x3d, 0x5f, 0xbf, 0xdf, 0xbc, 0xb9, 0x64, 0x26, 0x52, 0x11, 0x0a, 0x8f, 0x42,
+    0x0a, 0x78, 0x2a, 0x30, 0x21, 0x4c, 0x1c, 0xb6, 0x68, 0x31, 0x2f, 0x4e, 0x68, 0x09, 0x3f, 0x76,
+    0x28, 0xc7, 0xea, 0xc0, 0x44, 0x94, 0x48, 0x90, 0xce, 0xb7, 0x76, 0xb1, 0xb1, 0x4b, 0x4b, 0xa5,
+    0x2b, 0xad, 0x42, 0x32, 0x61, 0xa8, 0x72, 0x6a, 0x91, 0xc2, 0x84, 0x95, 0xda, 0xaa, 0xd8, 0xe0,
+    0x6c, 0x60, 0xdb, 0x4c, 0x7e, 0xa7, 0x6a, 0x3c, 0xbc, 0xd5, 0xbb, 0xf8, 0xdd, 0x7a, 0x69, 0xd1,
+    0x59, 0x0c, 0x18, 0xeb, 0xbb, 0x45, 0xf3, 0xbb, 0x0d, 0xcd, 0xd1, 0x7c, 0x87, 0x38, 0x13, 0x34,
+    0xca, 0x28, 0x3b, 0x64, 0x06, 0xa4, 0xef, 0x1a, 0xac, 0xa6, 0x9c, 0xa6, 0x66, 0x86, 0x98, 0x28,
+    0x4a, 0x53, 0xd3, 0x4e, 0xd1, 0x91, 0x11, 0x93, 0x41, 0xa8, 0xeb, 0xda, 0x3f, 0x91, 0xa7, 0x48,
+    0xb3, 0x1f, 0x75, 0x5e, 0x4d, 0x80, 0xb0, 0x64, 0xd9, 0x77, 0x19, 0x23, 0x84, 0x42, 0xc5, 0xea,
+    0x8c, 0x08, 0xd3, 0x05, 0xc7, 0xe7, 0xa6, 0x1a, 0xb0, 0x54, 0x43, 0x70, 0x6a, 0xd8, 0x77, 0xda,
+    0x40, 0x06, 0xd5, 0x73, 0x08, 0x26, 0xc6, 0x30, 0x04, 0x2b, 0x48, 0x92, 0x9e, 0x2d, 0xac, 0x8f,
+    0x7b, 0x92, 0xe9, 0x10, 0xaa, 0x28, 0xe9, 0x50, 0xf9, 0xbf, 0xc6, 0x44, 0x9a, 0x1a, 0x03, 0x11,
+    0xeb, 0x59, 0xf3, 0x6c, 0x64, 0xc1, 0x52, 0x7d, 0x2d, 0x4e, 0x84, 0x0e, 0x8a, 0xd5, 0xb5, 0x2c,
+    0x73, 0x28, 0x99, 0x2e, 0xb0, 0x40, 0xcb, 0x4e, 0xd1, 0x89, 0x45, 0x29, 0x56, 0xa4, 0xd6, 0x18,
+    0xdb, 0x00, 0x1c, 0x27, 0xeb, 0x78, 0x87, 0xee, 0x5f, 0xa3, 0x27, 0x5e, 0x15, 0x99, 0x9f, 0x51,
+    0xfd, 0x1b, 0x76, 0xcc, 0x64, 0x20, 0x98, 0x63, 0x26, 0x7a, 0x44, 0xf4, 0xfa, 0x1e, 0x84, 0xba,
+    0x8e, 0x59, 0xbb, 0x8e, 0x81, 0xd5, 0x2b, 0x3d, 0x73, 0xd1, 0x1e, 0xb6, 0xbf, 0xc0, 0xef, 0x13,
+    0xd5, 0x1a, 0xd5, 0xa2, 0x94, 0x58, 0xaf, 0x6a, 0xe7, 0xd0, 0x5e, 0x2a, 0x84, 0x51, 0x2e, 0x15,
+    0x45, 0x55, 0xe0, 0x11, 0x67, 0xcf, 0x14, 0xed, 0x29, 0xe5, 0xd6, 0xba, 0xde, 0xd7, 0x0c, 0x13,
+    0x79, 0x84, 0x26, 0x41, 0x4b, 0x20, 0x54, 0x21, 0xa8, 0x43, 0x82, 0x7f, 0x9b, 0xcf, 0x50, 0xf3,
+    0x7d, 0xb7, 0xfc, 0x7d, 0x77, 0xf3, 0xf3, 0xe6, 0xa2, 0x04, 0xd9, 0xaa, 0xae, 0x82, 0x4b, 0x7d,
+    0xbf, 0xdf, 0xf7, 0xa2, 0x86, 0x52, 0x83, 0xe0, 0x48, 0x1a, 0x55, 0x8a, 0xbb, 0x2e, 0xe7, 0x76,
+    0xfd, 0x61, 0x90, 0x5d, 0x8b, 0x86, 0x60, 0xb4, 0xe4, 0x8c, 0xa0, 0x57, 0x31, 0x59, 0xef, 0x37,
+    0x8f, 0x55, 0x1c, 0x00, 0x83, 0xac, 0x72, 0x68, 0x85, 0x7d, 0x94, 0x60, 0x03, 0xb5, 0x3d, 0xcf,
+    0xba, 0x15, 0x26, 0xe0, 0x78, 0xc0, 0x5a, 0x6f, 0x29, 0xcd, 0x20, 0x86, 0xc1, 0x8a, 0xce, 0x4a,
+    0x51, 0x35, 0x7a, 0xdb, 0x04, 0xa9, 0x84, 0xc3, 0x27, 0x8c, 0xb6, 0x1d, 0x5d, 0xe1, 0xbe, 0x12,
+    0x6c, 0xb0, 0xd3, 0x7f, 0x7b, 0x3b, 0xbf, 0xfd, 0xd6, 0x37, 0xec, 0x73, 0xed, 0xb1, 0x1f, 0xf2,
+    0x5c, 0x14, 0x1d, 0xd1, 0xad, 0x8c, 0x30, 0xab, 0xde, 0x1b, 0xb0, 0x9b, 0x80, 0x3b, 0x72, 0xb3,
+    0xe0, 0x73, 0x7d, 0xfa, 0xf0, 0xf7, 0xe7, 0x2f, 0x5f, 0xfe, 0xf9, 0xeb, 0x7d, 0xc7, 0x7c, 0x91,
+    0xa9, 0xe3, 0xf5, 0xab, 0x98, 0x26, 0xb9, 0xf6, 0x69, 0xb7, 0x95, 0xd8, 0xb8, 0x98, 0x80, 0x34,
+    0x1b, 0x03, 0x2c, 0x16, 0x3e, 0xc4, 0x72, 0xe9, 0x45, 0xac, 0xbc, 0x88, 0xd8, 0x87, 0x58, 0x79,
+    0xe3, 0x88, 0xfd, 0x88, 0x07, 0x2f, 0xe2, 0xb1, 0x87, 0xb8, 0x9c, 0x2d, 0x6d, 0x5b, 0xb9, 0x31,
+    0xd2, 0x96, 0x5c, 0x30, 0xad, 0xb1, 0x08, 0x2e, 0xfa, 0xd2, 0x45, 0xea, 0x78, 0xa1, 0x3e, 0x86,
+    0x6a, 0x8e, 0x83, 0x6d, 0x56, 0x6e, 0x63, 0x6a, 0xda, 0x78, 0x55, 0x57, 0x7d, 0x48, 0x78, 0x20,
+    0x54, 0x1b, 0x96, 0x63, 0x03, 0xc3, 0x69, 0xe4, 0x00, 0xc0, 0xfc, 0xfa, 0x08, 0xc4, 0x83, 0xc2,
+    0x86, 0x49, 0xa1, 0xd1, 0x91, 0x99, 0x0c, 0x26, 0x87, 0x28, 0x31, 0x87, 0x09, 0x0a, 0x73, 0x07,
+    0xd9, 0x13, 0x70, 0x0f, 0x4c, 0xfb, 0x17, 0xdc, 0x97, 0x47, 0x38, 0x10, 0xf5, 0x10, 0x1b, 0x8b,
+    0xb2, 0x09, 0xb2, 0x75, 0x9d, 0xa1, 0x71, 0x60, 0x1c, 0x0a, 0xdc, 0x84, 0x02, 0x17, 0xc1, 0x92,
+    0x8b, 0x60, 0xcd, 0xe5, 0x4b, 0x4d, 0xcf, 0x06, 0x7a, 0x25, 0x57, 0xab, 0x40, 0xc9, 0x78, 0x1e,
+    0x0a, 0x5c, 0x84, 0x02, 0x5f, 0x64, 0x13, 0xde, 0x46, 0x5a, 0xa6, 0xd3, 0x3a, 0x29, 0xa3, 0x70,
+    0xf5, 0x9d, 0x65, 0x09, 0xd7, 0x9f, 0x40, 0xa6, 0x54, 0x02, 0xc1, 0xcb, 0xdd, 0xd3, 0x9f, 0x7f,
+    0xa0, 0x46, 0x06, 0x50, 0x57, 0xbb, 0xa8, 0xdd, 0xa0, 0xbe, 0xab, 0x2f, 0xfb, 0x61, 0x84, 0xa1,
+    0x79, 0x91, 0x84, 0x27, 0xc6, 0x3b, 0xe0, 0x2d, 0xea, 0xed, 0xad, 0x51, 0x25, 0x6d, 0xec, 0x1c,
+    0x31, 0x78, 0x20, 0x28, 0x16, 0x60, 0x64, 0x51, 0x03, 0x23, 0x47, 0x0c, 0x35, 0x2a, 0x8e, 0x79,
+    0x2a, 0x4c, 0x6a, 0x14, 0xf7, 0x99, 0x75, 0xc8, 0x81, 0x61, 0x5f, 0x20, 0xd4, 0x34, 0xd0, 0x71,
+    0xcc, 0x6e, 0xb2, 0x17, 0x3d, 0x99, 0x42, 0xd1, 0x66, 0x1c, 0x79, 0x0c, 0xfb, 0xd8, 0x81, 0xeb,
+    0x50, 0x24, 0xfc, 0x14, 0xec, 0xb1, 0x0a, 0x7f, 0x07, 0x59, 0xbc, 0x69, 0x7b, 0xb3, 0xe6, 0x85,
+    0xda, 0x24, 0x67, 0x12, 0x6e, 0xe2, 0x26, 0x4f, 0x4d, 0x0a, 0x6e, 0x92, 0x33, 0x97, 0x13, 0x6e,
+    0x41, 0xe7, 0x51, 0xd3, 0x66, 0xd7, 0xb2, 0x9d, 0xf7, 0x51, 0x13, 0x63, 0xf9, 0xd5, 0x7b, 0x5a,
+    0x90, 0x5f, 0x4f, 0x60, 0x9a, 0x71, 0xe0, 0x9b, 0xe5, 0x95, 0x62, 0x74, 0xf4, 0x49, 0xae, 0x4c,
+    0x67, 0xe1, 0x89, 0xc6, 0x7d, 0x43, 0x60, 0x5e, 0x5c, 0x2d, 0xd7, 0x2a, 0xf2, 0x4b, 0xe4, 0xe3,
+    0x05, 0x72, 0xca, 0x19, 0xe0, 0xf8, 0x34, 0x61, 0x97, 0x1e, 0xda, 0x33, 0x50, 0xf3, 0x82, 0x6d,
+    0x4a, 0x01, 0x9f, 0xd5, 0x8e, 0x13, 0xce, 0x41, 0x7b, 0x11, 0x38, 0x66, 0xa8, 0xd5, 0xb3, 0xd4,
+    0x06, 0xf3, 0x70, 0x27, 0x57, 0x3b, 0xc7, 0x0b, 0x4e, 0xc9, 0xc0, 0xb5, 0x97, 0xb2, 0xc2, 0xe7,
+    0xe4, 0x70, 0x83, 0x81, 0xd5, 0x91, 0x43, 0xed, 0xaa, 0xcf, 0xde, 0x3e, 0xab, 0x0a, 0x43, 0x05,
+    0x4e, 0x38, 0x25, 0x03, 0x37, 0xcb, 0x0d, 0xbe, 0xdb, 0x9a, 0x0f, 0xf8, 0x7e, 0x2f, 0x8b, 0x1c,
+    0xde, 0x6f, 0xa3, 0xff, 0x1d, 0x18, 0x9a, 0xfd, 0x0f, 0x34, 0x5f, 0xc2, 0x45, 0x52, 0x12, 0x00,
+    0x00,
+};
+
+static const uint8_t settings_js[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xdd, 0x5a, 0xdf, 0x53, 0x23, 0xb9,
+    0x11, 0x7e, 0xe7, 0xaf, 0x50, 0xee, 0xe1, 0x6c, 0xea, 0xcc, 0x30, 0xde, 0xc5, 0x9b, 0xbb, 0x23,
+    0x0e, 0xe5, 0x05, 0x36, 0x4b, 0x15, 0xe4, 0xa8, 0x35, 0x61, 0x93, 0x47, 0x79, 0x46, 0x63, 0xab,
+    0xd0, 0x8c, 0xe6, 0x24, 0x8d, 0x0d, 0xd9, 0xf3, 0xff, 0x9e, 0x6e, 0x49, 0xf3, 0xc3, 0xac, 0xb1,
+    0xcd, 0x1d, 0x36, 0x7b, 0xe1, 0x05, 0xdb, 0x23, 0xb5, 0xba, 0xbf, 0xaf, 0xbb, 0xd5, 0xea, 0x51,
+    0x52, 0x64, 0x91, 0xe1, 0x32, 0x23, 0x54, 0xdf, 0x7d, 0xa0, 0x91, 0x91, 0xea, 0xe1, 0x13, 0xd3,
+    0xcc, 0xb4, 0xf7, 0xc9, 0x97, 0x3d, 0x42, 0x78, 0x42, 0xda, 0x91, 0xcc, 0x12, 0xae, 0xd2, 0x76,
+    0x6b, 0xa0, 0x18, 0x79, 0x90, 0x05, 0xd1, 0x85, 0xff, 0x30, 0xa3, 0x99, 0x21, 0x46, 0x12, 0x85,
+    0x33, 0x88, 0x99, 0x30, 0x12, 0xb3, 0x29, 0x8f, 0x18, 0xfe, 0x96, 0x38, 0x61, 0x04, 0x9e, 0x18,
+    0x9e, 0x8d, 0xf5, 0x09, 0xb9, 0x99, 0x70, 0x4d, 0x66, 0x5c, 0x08, 0xc2, 0x14, 0xd5, 0x8c, 0x50,
+    0xf8, 0x54, 0x3e, 0x25, 0x34, 0x8b, 0x49, 0x4c, 0x0d, 0x0d, 0x5a, 0xfb, 0x6e, 0x65, 0x42, 0xa6,
+    0x54, 0x91, 0xfb, 0x89, 0x22, 0x7d, 0x92, 0xb1, 0x19, 0xf9, 0xf7, 0xd5, 0xe5, 0x47, 0x63, 0xf2,
+    0x4f, 0xec, 0xd7, 0x82, 0x69, 0x50, 0xef, 0xd8, 0x8e, 0x81, 0xe7, 0x81, 0xcc, 0x84, 0xa4, 0x31,
+    0x0c, 0x4b, 0xbc, 0x2d, 0xed, 0x52, 0x82, 0xd3, 0xdf, 0xc0, 0xba, 0x81, 0x36, 0xd4, 0x14, 0x9a,
+    0xf4, 0xfb, 0xe4, 0x4d, 0x18, 0xd6, 0xcf, 0x09, 0x68, 0xc1, 0x94, 0x69, 0xb7, 0xbc, 0xed, 0xde,
+    0x14, 0x5d, 0x44, 0x11, 0xd3, 0x3a, 0x29, 0x44, 0x00, 0x6a, 0x57, 0x66, 0x59, 0xe5, 0x33, 0x39,
+    0xc3, 0x51, 0x86, 0x2a, 0x03, 0xca, 0x1e, 0x57, 0x82, 0x14, 0x1b, 0x49, 0x59, 0x29, 0x46, 0xc8,
+    0x9c, 0x30, 0x01, 0x56, 0xae, 0x59, 0x29, 0xa1, 0x5c, 0xb0, 0x38, 0x20, 0xd7, 0x82, 0x21, 0x26,
+    0x06, 0x1e, 0xd0, 0x31, 0xe5, 0x59, 0x43, 0xf4, 0xdc, 0xfe, 0x9f, 0x37, 0x0d, 0x66, 0x4a, 0x49,
+    0xb5, 0xdc, 0x62, 0xbf, 0xca, 0x20, 0x23, 0x6e, 0x90, 0x8c, 0xa2, 0x42, 0x29, 0x16, 0x93, 0xd9,
+    0x04, 0x56, 0xc2, 0x05, 0x00, 0xef, 0x65, 0xa4, 0x55, 0x2b, 0x36, 0x57, 0xca, 0x59, 0xd6, 0x6e,
+    0x5d, 0xff, 0x32, 0xbc, 0x69, 0x75, 0x48, 0xeb, 0x30, 0x69, 0x38, 0x08, 0xfc, 0x60, 0x54, 0xc1,
+    0x1a, 0x3c, 0x68, 0x96, 0xc5, 0xce, 0xfc, 0xf9, 0xde, 0x7c, 0x6f, 0xaf, 0xd4, 0x8d, 0xb0, 0x98,
+    0x9b, 0x53, 0x99, 0xe6, 0x82, 0x19, 0xd6, 0xde, 0xff, 0xc2, 0x93, 0x26, 0x23, 0xfd, 0x3e, 0xf2,
+    0xf1, 0x65, 0xc6, 0xb3, 0x58, 0xce, 0x02, 0x21, 0x23, 0x8a, 0x73, 0x02, 0xc5, 0x90, 0x53, 0x90,
+    0x36, 0x7f, 0x2c, 0xe9, 0x1c, 0xad, 0x02, 0x31, 0xde, 0xce, 0x8b, 0x6c, 0x4a, 0x05, 0x8f, 0x09,
+    0xcf, 0xf2, 0xc2, 0x80, 0x05, 0x0e, 0xac, 0x85, 0x19, 0x9f, 0x58, 0x24, 0xa7, 0x4c, 0x3d, 0x5c,
+    0xc9, 0x18, 0xd7, 0x47, 0xb7, 0x82, 0x39, 0x05, 0xeb, 0xe7, 0x0a, 0xb4, 0x02, 0x19, 0xe7, 0xf7,
+    0x46, 0xb1, 0x94, 0x89, 0x07, 0xf0, 0xc0, 0x6c, 0xcc, 0x94, 0x04, 0x47, 0x91, 0xb9, 0xd5, 0x83,
+    0x9c, 0xa7, 0x4c, 0x8d, 0x59, 0x16, 0x3d, 0x90, 0x68, 0x42, 0xe1, 0x13, 0x7a, 0xad, 0x9c, 0x69,
+    0x40, 0xcf, 0x09, 0x25, 0x09, 0x60, 0x4c, 0xc1, 0x8f, 0xe1, 0x0b, 0x4a, 0x28, 0xb2, 0x98, 0x29,
+    0x37, 0x34, 0x26, 0x23, 0x6a, 0x0c, 0x8c, 0x09, 0xc8, 0x25, 0x4f, 0xb9, 0x29, 0x25, 0xe4, 0x72,
+    0xc6, 0x14, 0x32, 0x40, 0xa7, 0x12, 0x34, 0x8f, 0x18, 0x38, 0x95, 0x2a, 0x72, 0x83, 0x51, 0x85,
+    0x61, 0x90, 0x4b, 0xad, 0xf9, 0x08, 0xb8, 0x82, 0xa8, 0x63, 0x01, 0x19, 0xa2, 0xa7, 0x91, 0xb7,
+    0x61, 0xca, 0xb3, 0x7a, 0x55, 0x50, 0x1d, 0x1d, 0xf4, 0x84, 0xb4, 0x43, 0x70, 0x83, 0x7f, 0xca,
+    0x0e, 0xe9, 0xc2, 0xff, 0xff, 0x30, 0xbd, 0xff, 0x73, 0xed, 0x38, 0x80, 0xb4, 0x35, 0xf4, 0x2f,
+    0xfd, 0x7e, 0x56, 0x08, 0x61, 0xa1, 0x77, 0x96, 0xf7, 0xc3, 0xdf, 0x7e, 0xf3, 0x9f, 0xba, 0x0e,
+    0x11, 0x20, 0xb0, 0x8f, 0x61, 0x66, 0xa7, 0x7e, 0x15, 0x6b, 0x75, 0x98, 0xf5, 0x9b, 0x6c, 0x1e,
+    0x37, 0xbc, 0xb1, 0x5f, 0x91, 0x73, 0x5c, 0x7b, 0xce, 0x3f, 0xce, 0xc1, 0x71, 0x5a, 0x87, 0x2c,
+    0xa3, 0x60, 0x4f, 0x93, 0x87, 0x13, 0xb7, 0x7a, 0xeb, 0x07, 0xfb, 0xbf, 0xe3, 0x3c, 0xa9, 0xe1,
+    0x44, 0x73, 0x8c, 0x9d, 0xc7, 0x1c, 0xdb, 0xb1, 0x55, 0xa8, 0xb0, 0x0c, 0xb0, 0x05, 0xe8, 0xed,
+    0xaf, 0x64, 0xc4, 0xcc, 0x8c, 0xb1, 0x8c, 0x84, 0x16, 0xc2, 0x2e, 0x3a, 0xf3, 0x1c, 0x7d, 0xe7,
+    0x2b, 0x6f, 0xf8, 0x3c, 0x59, 0xea, 0x03, 0x1f, 0x21, 0xaa, 0xd3, 0x22, 0x9a, 0x80, 0x58, 0x20,
+    0xfc, 0xc1, 0xc6, 0x85, 0xa7, 0x8f, 0x44, 0x34, 0x23, 0x1a, 0x1c, 0x1f, 0xd6, 0x3e, 0xb7, 0x8b,
+    0x22, 0x50, 0x9f, 0x27, 0x7e, 0xe5, 0x76, 0xf7, 0xe0, 0x28, 0xc4, 0xbf, 0x8d, 0xa0, 0xff, 0x7b,
+    0xbf, 0xfb, 0xfd, 0xf7, 0xf6, 0xd3, 0xdf, 0xfa, 0x7e, 0xda, 0xf6, 0xf1, 0x2f, 0x72, 0x48, 0xad,
+    0xec, 0xbd, 0x33, 0x67, 0xc8, 0xff, 0xbb, 0x21, 0xfc, 0x8b, 0x19, 0xe5, 0x39, 0x2c, 0x74, 0x2d,
+    0x0b, 0xce, 0xbe, 0xa7, 0xa9, 0xf8, 0x97, 0x66, 0xc3, 0x08, 0xa4, 0xc7, 0xc3, 0x5f, 0x4e, 0x9f,
+    0x0a, 0x4c, 0xd0, 0x47, 0x57, 0x44, 0x08, 0x9e, 0xc0, 0x1a, 0x36, 0x75, 0xc2, 0x3c, 0x9b, 0xc7,
+    0x80, 0x26, 0x98, 0x0d, 0x99, 0x19, 0x72, 0x4a, 0x66, 0xbf, 0xda, 0xed, 0x6a, 0x5c, 0x60, 0xca,
+    0x83, 0x90, 0xe1, 0x69, 0x91, 0x5a, 0x65, 0x52, 0x7a, 0x6f, 0x3f, 0xe7, 0x10, 0x9e, 0xa0, 0x34,
+    0x1d, 0x63, 0x68, 0x4d, 0x64, 0x21, 0x62, 0x2b, 0xa0, 0x14, 0x38, 0x82, 0x18, 0xcc, 0x73, 0xc1,
+    0x59, 0xfc, 0x27, 0x89, 0x2d, 0xc7, 0x6d, 0x13, 0xca, 0xd7, 0x8b, 0xad, 0xa1, 0x8c, 0xae, 0xe8,
+    0xfd, 0x52, 0x2a, 0x61, 0x1d, 0x58, 0x0f, 0x84, 0xda, 0x3d, 0x54, 0x33, 0xc8, 0x6e, 0x00, 0x5b,
+    0x99, 0x55, 0x63, 0x88, 0xa2, 0x30, 0xcc, 0x23, 0xb3, 0x6f, 0xc9, 0x9c, 0x30, 0xa4, 0x12, 0xaa,
+    0x05, 0xb7, 0x3e, 0xc7, 0x74, 0x4b, 0xa3, 0x09, 0xee, 0x93, 0x75, 0x00, 0x96, 0x84, 0xe2, 0x0c,
+    0x37, 0xce, 0x4c, 0xa8, 0xa9, 0x7c, 0xc5, 0xae, 0xe3, 0x33, 0x2e, 0xe4, 0xda, 0x76, 0x2f, 0x0c,
+    0xc2, 0x03, 0x58, 0x24, 0x70, 0x71, 0xba, 0x22, 0x40, 0x7b, 0x61, 0x15, 0xa1, 0xdd, 0x1d, 0x86,
+    0xa7, 0x03, 0x6f, 0x6b, 0xe4, 0xa1, 0xfd, 0x8e, 0x3f, 0xc4, 0x60, 0x25, 0x85, 0x1c, 0xea, 0x89,
+    0x32, 0xf8, 0x37, 0x61, 0x32, 0xf2, 0xf6, 0xe2, 0x06, 0xca, 0x75, 0xc5, 0xe8, 0x46, 0x7c, 0x0e,
+    0xe2, 0x29, 0xcd, 0x22, 0x18, 0x5e, 0x68, 0xa6, 0xb4, 0x4b, 0xb5, 0xcc, 0x16, 0x95, 0x19, 0x1b,
+    0x43, 0x2d, 0x30, 0x65, 0x6e, 0x92, 0x5e, 0xa0, 0xde, 0xc7, 0xf5, 0x2a, 0xea, 0x2b, 0x4d, 0x2c,
+    0xfb, 0xc0, 0x7c, 0x10, 0x1a, 0xd9, 0x2b, 0xe9, 0x5f, 0x9f, 0xa6, 0x61, 0x46, 0xe5, 0x06, 0xbd,
+    0xdd, 0x7a, 0x01, 0xcf, 0xb6, 0xe6, 0x05, 0x60, 0x95, 0x75, 0x82, 0xde, 0x2a, 0x1f, 0x00, 0x37,
+    0x3c, 0xb5, 0xd0, 0x0d, 0x96, 0x86, 0xf2, 0x50, 0xa6, 0xc0, 0xa1, 0xf7, 0x02, 0x0d, 0x84, 0x30,
+    0x48, 0xd1, 0x00, 0x32, 0xa6, 0x4e, 0x65, 0x78, 0xc2, 0x23, 0x4e, 0x31, 0xb4, 0x05, 0x16, 0x3d,
+    0xcb, 0x63, 0xd6, 0x33, 0x63, 0x2b, 0x53, 0x38, 0x42, 0x40, 0xe6, 0x1e, 0x80, 0xbf, 0x60, 0x78,
+    0x6e, 0x10, 0x9f, 0x0b, 0xe1, 0xb9, 0x3b, 0x66, 0x6a, 0x54, 0xb6, 0x9d, 0x60, 0xc3, 0x70, 0x0d,
+    0x3b, 0x67, 0xa5, 0x6f, 0x6f, 0x8d, 0xa0, 0x3a, 0x7a, 0xfe, 0x6c, 0x1c, 0xd5, 0xd8, 0xbc, 0x2e,
+    0x4d, 0xb0, 0x23, 0xdf, 0x4a, 0x81, 0x75, 0x86, 0x2d, 0xfe, 0x97, 0xd7, 0x37, 0xb6, 0x2e, 0x76,
+    0xa9, 0xd1, 0x1d, 0x38, 0x90, 0xa6, 0x94, 0x66, 0x85, 0xe5, 0x07, 0x4f, 0x99, 0x8a, 0x47, 0xe5,
+    0xc1, 0xe1, 0x70, 0x21, 0xa5, 0xc1, 0x99, 0x23, 0x67, 0x11, 0x92, 0x49, 0xa6, 0x6e, 0x1d, 0x9b,
+    0x38, 0x47, 0x70, 0x70, 0x9a, 0x05, 0xe4, 0x22, 0x41, 0x0a, 0x51, 0x7a, 0x6c, 0x8b, 0x22, 0x96,
+    0x16, 0x82, 0x1a, 0x3c, 0xaa, 0x14, 0x46, 0xa6, 0x90, 0x57, 0x23, 0xbb, 0x42, 0x0c, 0x08, 0x2b,
+    0xc8, 0xa6, 0x4c, 0x3b, 0x25, 0x46, 0x60, 0x74, 0x4c, 0x40, 0x8d, 0xba, 0xe2, 0x02, 0xdd, 0x21,
+    0xf7, 0x7e, 0x2a, 0x55, 0x29, 0x95, 0x7b, 0xa2, 0x3a, 0xfa, 0xf6, 0xca, 0xa2, 0x26, 0x09, 0xaf,
+    0x57, 0x19, 0x55, 0xc9, 0xc3, 0xab, 0xf3, 0xd2, 0x71, 0xdb, 0x70, 0x81, 0x5c, 0xf2, 0xcc, 0xed,
+    0x85, 0x96, 0x41, 0xed, 0x6a, 0xdc, 0xc6, 0x5e, 0xf8, 0x47, 0x62, 0xb8, 0x3c, 0xec, 0xf7, 0x97,
+    0xb6, 0x64, 0x5e, 0x36, 0xcf, 0x7a, 0xa8, 0xbe, 0x9d, 0x6c, 0xfb, 0x5a, 0xdc, 0x2d, 0x96, 0x32,
+    0x2f, 0x46, 0xdf, 0x8e, 0xf2, 0xf0, 0x37, 0x41, 0xe3, 0xfb, 0xab, 0xa1, 0xed, 0x77, 0x9d, 0x15,
+    0x8a, 0xba, 0x86, 0xd9, 0x12, 0x0e, 0x07, 0xa9, 0x2c, 0x00, 0x7e, 0x99, 0x00, 0x15, 0x70, 0x8a,
+    0x04, 0x02, 0x61, 0x9a, 0x6f, 0xd7, 0x78, 0x2a, 0x80, 0x4e, 0x99, 0x40, 0x6e, 0x2d, 0x14, 0x1e,
+    0x16, 0xe1, 0x2c, 0xc9, 0x65, 0x0c, 0x19, 0x38, 0xa6, 0x5c, 0xf8, 0x8e, 0x9e, 0x4d, 0x96, 0xbf,
+    0x16, 0x1c, 0xbe, 0x90, 0xef, 0xae, 0xcb, 0x01, 0x28, 0xc8, 0x3e, 0xfe, 0xce, 0x3b, 0x85, 0x6b,
+    0x89, 0x54, 0x7e, 0xe0, 0x0b, 0xe3, 0xac, 0x5a, 0xb9, 0xdd, 0x3d, 0xe8, 0xfd, 0xb4, 0x8e, 0xe2,
+    0xba, 0x95, 0x00, 0x63, 0x77, 0x15, 0x9f, 0x8f, 0xa1, 0xdc, 0x1a, 0xb1, 0xae, 0x89, 0xd0, 0xfb,
+    0xe9, 0x49, 0x52, 0x6f, 0x98, 0x16, 0xf4, 0x3d, 0x15, 0x83, 0x68, 0xe5, 0xf6, 0x0a, 0xbb, 0x9e,
+    0xdf, 0x0b, 0xb1, 0x59, 0x87, 0x67, 0x8d, 0xcb, 0x0f, 0xd7, 0x10, 0x64, 0x02, 0x0e, 0x1e, 0xc0,
+    0x62, 0x40, 0xae, 0xe8, 0x9d, 0xdd, 0x00, 0x1b, 0x1d, 0x9f, 0x2a, 0xdc, 0xba, 0x61, 0xd7, 0x77,
+    0x0c, 0x02, 0xd7, 0xc0, 0xae, 0x1d, 0x01, 0x7e, 0x07, 0x79, 0xa9, 0xdd, 0x30, 0x23, 0x30, 0xc2,
+    0x36, 0xe6, 0x52, 0x99, 0x99, 0x49, 0x07, 0x67, 0xde, 0x31, 0x96, 0xfb, 0x95, 0x50, 0x28, 0x67,
+    0xda, 0xaf, 0xe9, 0x58, 0xb7, 0x4d, 0xf4, 0x72, 0x3d, 0x90, 0xbb, 0x78, 0x1c, 0x1e, 0x31, 0x10,
+    0xed, 0xbd, 0x04, 0x74, 0xec, 0x58, 0x28, 0xa8, 0xd0, 0xd2, 0x9d, 0x74, 0xb0, 0xf9, 0x3e, 0xa1,
+    0x53, 0x1c, 0x20, 0x8b, 0xf1, 0x84, 0xe8, 0x22, 0x43, 0x33, 0xc7, 0x8a, 0xc7, 0x75, 0x7b, 0x31,
+    0x81, 0x1c, 0xe4, 0xbf, 0x41, 0x56, 0x91, 0x0b, 0x06, 0xba, 0x66, 0x70, 0x85, 0x01, 0x2a, 0x40,
+    0x23, 0x3c, 0x6d, 0x95, 0x0e, 0xd9, 0xb5, 0x8d, 0x4d, 0xef, 0xa5, 0x1d, 0x08, 0xb2, 0xa4, 0x86,
+    0x31, 0xfe, 0x96, 0x36, 0xfa, 0x86, 0x13, 0xac, 0xf5, 0xc4, 0x8d, 0x5d, 0xb1, 0x8b, 0x68, 0xba,
+    0x6c, 0xb2, 0x2c, 0x99, 0x50, 0x71, 0xc3, 0xd3, 0x27, 0x7a, 0xc9, 0xcd, 0x52, 0xba, 0x01, 0xb0,
+    0xe1, 0x76, 0x7f, 0xc0, 0xa3, 0x6b, 0x61, 0x98, 0xde, 0x34, 0xae, 0xdf, 0xee, 0xa4, 0x78, 0xf6,
+    0x06, 0x6d, 0x39, 0x92, 0xc1, 0x96, 0xa7, 0xf3, 0x33, 0x15, 0x1f, 0x40, 0x7d, 0x73, 0x8d, 0xee,
+    0xba, 0x14, 0x58, 0xfb, 0x84, 0x08, 0x88, 0x32, 0x81, 0x38, 0x7e, 0x06, 0x47, 0xb6, 0x4e, 0x8e,
+    0xb3, 0xca, 0x78, 0xf5, 0x69, 0xd9, 0x47, 0x79, 0x05, 0xfe, 0x1a, 0xb0, 0xc3, 0x7a, 0xa7, 0x7c,
+    0x13, 0xee, 0x0a, 0xef, 0xda, 0xda, 0xed, 0xa1, 0x1e, 0xba, 0xad, 0x11, 0x8d, 0x5a, 0x05, 0x3c,
+    0x6c, 0xd6, 0xd7, 0x34, 0xba, 0xbb, 0x5d, 0x0a, 0xbb, 0x6f, 0x1a, 0x93, 0x1c, 0x46, 0x58, 0x97,
+    0x2e, 0xab, 0x15, 0xc3, 0xd2, 0x5c, 0x2a, 0xaa, 0xec, 0xc6, 0x47, 0x39, 0x9e, 0x1b, 0x6c, 0x8e,
+    0xa9, 0xba, 0x3c, 0x4f, 0x90, 0x11, 0x90, 0xdb, 0x72, 0xaf, 0xbb, 0x5d, 0x4d, 0xcc, 0xdb, 0x1f,
+    0x6b, 0x62, 0x8e, 0xba, 0x3b, 0xe2, 0xa5, 0x04, 0x63, 0x6b, 0xac, 0x80, 0x55, 0xae, 0x39, 0xde,
+    0x5d, 0x47, 0xca, 0x29, 0x13, 0x62, 0x39, 0x29, 0xf8, 0xa4, 0xe4, 0x01, 0x39, 0x79, 0x01, 0x2e,
+    0xd2, 0x75, 0x64, 0x1c, 0x35, 0xc2, 0xe4, 0xed, 0x5f, 0x7b, 0xbb, 0xa3, 0xc3, 0xc2, 0xb0, 0x3d,
+    0x3a, 0x8e, 0x7c, 0x94, 0xa0, 0x4d, 0x6b, 0x08, 0x39, 0x63, 0xd3, 0xcd, 0x39, 0xc1, 0x97, 0xaa,
+    0xd4, 0x1d, 0xe9, 0x77, 0xc0, 0x4e, 0x83, 0x9c, 0x77, 0xe1, 0xee, 0xb8, 0x29, 0x11, 0xd9, 0x1e,
+    0x3d, 0x9e, 0x9d, 0x77, 0x8b, 0x29, 0xec, 0x11, 0x3d, 0x1f, 0xa0, 0x80, 0xf3, 0x89, 0x6a, 0xd5,
+    0x19, 0xad, 0xde, 0x9b, 0x13, 0x98, 0x50, 0xd5, 0x42, 0x9e, 0xb5, 0x4d, 0x4f, 0x53, 0xbd, 0xe5,
+    0x7b, 0xc4, 0xb6, 0x8e, 0x52, 0x5f, 0xdb, 0xb6, 0x83, 0x93, 0xd4, 0x0a, 0xac, 0xdd, 0xd9, 0x5c,
+    0x7d, 0xbc, 0x3d, 0x3b, 0x75, 0xf5, 0x75, 0xbc, 0x61, 0xed, 0xfd, 0xf1, 0x96, 0x9c, 0x9d, 0x12,
+    0x59, 0x98, 0xbc, 0x30, 0x5b, 0xaf, 0x32, 0xb7, 0xc5, 0x46, 0x69, 0xfd, 0xd4, 0xdb, 0xbe, 0xc5,
+    0x92, 0x73, 0x39, 0xee, 0x83, 0xe2, 0xbe, 0xfb, 0x66, 0xfa, 0x3c, 0xe4, 0x85, 0xac, 0x9b, 0x0c,
+    0x30, 0x99, 0xd0, 0xe2, 0x9e, 0x0b, 0x4e, 0xc1, 0xf5, 0xff, 0x6f, 0x08, 0x59, 0x80, 0xe5, 0xc5,
+    0x02, 0xa4, 0xc1, 0xc9, 0x4a, 0x52, 0x86, 0xbe, 0x73, 0x03, 0x31, 0xb1, 0xbc, 0x39, 0xc4, 0x7c,
+    0x89, 0x8a, 0x69, 0xde, 0x33, 0x11, 0x90, 0x0b, 0xbc, 0xb2, 0xe2, 0x5e, 0x56, 0x8d, 0xec, 0x5b,
+    0x2e, 0x8e, 0x06, 0xc5, 0xee, 0xfe, 0x8f, 0x36, 0x55, 0x37, 0x09, 0xa3, 0xf2, 0x10, 0x14, 0x71,
+    0x45, 0xae, 0xaa, 0x5e, 0x70, 0xbb, 0xdd, 0x25, 0xa7, 0x8a, 0xa6, 0xd8, 0xc6, 0xd5, 0x1d, 0x32,
+    0x02, 0x79, 0x85, 0xc6, 0x4e, 0x52, 0xe6, 0x6e, 0x90, 0xb8, 0x57, 0x67, 0x44, 0x70, 0x48, 0x77,
+    0x50, 0x06, 0xe2, 0xbe, 0x73, 0xf4, 0x26, 0x5c, 0xb8, 0xb6, 0xf4, 0x3b, 0x9b, 0xf8, 0xdb, 0x64,
+    0xb3, 0x82, 0xf3, 0x59, 0xd7, 0x14, 0x7e, 0xd7, 0x45, 0x85, 0xe7, 0xa4, 0xbc, 0x52, 0xad, 0x8b,
+    0x4d, 0x58, 0xa6, 0x69, 0xce, 0xd4, 0x6b, 0xd0, 0xfc, 0xce, 0x92, 0xfc, 0xe3, 0x4b, 0x70, 0x5c,
+    0xff, 0xed, 0x82, 0xed, 0xc1, 0x33, 0xd9, 0xfe, 0x63, 0x7c, 0x6f, 0x4e, 0xf7, 0x79, 0x16, 0x5f,
+    0xd4, 0xef, 0xc3, 0x97, 0xbd, 0x11, 0x47, 0xe2, 0x4b, 0xbe, 0x5d, 0x7f, 0xc6, 0xbd, 0x55, 0x01,
+    0x13, 0x75, 0x75, 0x6d, 0x4c, 0x83, 0x0e, 0xe8, 0x18, 0xba, 0x48, 0xb0, 0x19, 0x0c, 0xea, 0x61,
+    0xbb, 0xc7, 0xe3, 0xb6, 0x73, 0x2f, 0xe9, 0x1e, 0xf4, 0x5e, 0xc2, 0x43, 0x76, 0x90, 0xda, 0x01,
+    0xfe, 0x1d, 0xbc, 0xc9, 0x7b, 0xc2, 0x1d, 0xc6, 0xf2, 0x46, 0x5e, 0x01, 0x01, 0xd7, 0xb6, 0xa4,
+    0x24, 0x5f, 0xc8, 0xe3, 0x7b, 0x8a, 0x13, 0xc5, 0x12, 0xd2, 0x27, 0xad, 0xc3, 0xd6, 0x31, 0xa9,
+    0xa6, 0xc7, 0x32, 0x2a, 0x52, 0xec, 0x18, 0x02, 0x1c, 0xea, 0x61, 0xc8, 0x04, 0xc3, 0x6b, 0x93,
+    0x03, 0x21, 0xda, 0x2d, 0x6d, 0xbf, 0x74, 0xfc, 0x6d, 0xc5, 0x00, 0x76, 0xd7, 0x73, 0x1a, 0x4d,
+    0xda, 0xd5, 0x3d, 0x4e, 0x78, 0xde, 0xbc, 0x9c, 0x5a, 0x29, 0x02, 0x63, 0x9a, 0xbf, 0x13, 0x60,
+    0x55, 0x04, 0x91, 0x90, 0x1a, 0xf1, 0x6e, 0x61, 0x1b, 0x12, 0xa4, 0x69, 0x66, 0x06, 0xc6, 0x28,
+    0x0e, 0xcc, 0xb3, 0x76, 0x0b, 0x6f, 0xd3, 0x1e, 0xb4, 0xc8, 0x0f, 0x76, 0x68, 0x06, 0x6e, 0x71,
+    0x12, 0x18, 0x79, 0x89, 0x1d, 0x87, 0x53, 0x00, 0xa4, 0xbd, 0xdf, 0xb1, 0x0f, 0xcc, 0x43, 0x0e,
+    0x3b, 0x76, 0x2b, 0x9a, 0xb0, 0xe8, 0x6e, 0x24, 0xef, 0x5b, 0x27, 0x56, 0x30, 0x7e, 0x63, 0xf1,
+    0xcf, 0xf8, 0xd9, 0x02, 0xd6, 0xf0, 0x94, 0xf9, 0x5e, 0x53, 0x05, 0x1a, 0xc7, 0xe7, 0x53, 0x30,
+    0xf5, 0x92, 0x6b, 0x83, 0x37, 0xe7, 0xda, 0x20, 0x09, 0xef, 0x50, 0xb6, 0x3a, 0xa0, 0x72, 0x63,
+    0x16, 0xea, 0x5f, 0xdd, 0x67, 0x85, 0x4f, 0xff, 0x03, 0xc1, 0x4a, 0x9a, 0x85, 0x77, 0x2c, 0x00,
+    0x00,
+};
+
+static const uint8_t status_css[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x7d, 0x52, 0xcb, 0x52, 0xc3, 0x30,
+    0x0c, 0xbc, 0xf7, 0x2b, 0x34, 0xc3, 0xad, 0x33, 0x6e, 0xd3, 0x27, 0x90, 0x9c, 0x38, 0x70, 0xe4,
+    0x23, 0x9c, 0xd8, 0xc4, 0x1a, 0x1c, 0x2b, 0xe3, 0x38, 0xb4, 0x85, 0xe1, 0xdf, 0x91, 0x13, 0xa7,
+    0xa5, 0xbc, 0x2e, 0x71, 0x56, 0x96, 0xd6, 0xd2, 0xae, 0x4a, 0x52, 0x27, 0x78, 0x87, 0x52, 0x56,
+    0x2f, 0xb5, 0xa7, 0xde, 0x29, 0x51, 0x91, 0x25, 0x9f, 0x43, 0x69, 0x39, 0x54, 0x40, 0x42, 0x07,
+    0x83, 0x41, 0x17, 0xf0, 0x31, 0x2b, 0xfb, 0x10, 0xc8, 0xfd, 0x5a, 0x71, 0xb3, 0xcb, 0x76, 0x8f,
+    0xfb, 0xdb, 0xef, 0x35, 0x25, 0x79, 0xa5, 0x19, 0x3a, 0x72, 0x8c, 0x5a, 0xa9, 0x14, 0xba, 0x3a,
+    0x87, 0x55, 0xd6, 0x1e, 0x61, 0xcd, 0x9f, 0x02, 0x1a, 0xe9, 0x6b, 0x74, 0xa2, 0x24, 0xa6, 0x6e,
+    0xf2, 0x14, 0xac, 0x7a, 0xdf, 0x45, 0x96, 0x96, 0xd0, 0x05, 0xed, 0x27, 0x1e, 0xe1, 0xa5, 0xc2,
+    0xbe, 0x1b, 0xeb, 0x2f, 0x0d, 0xe5, 0x86, 0x5e, 0xb5, 0xff, 0xbd, 0xad, 0xcd, 0xc3, 0xf6, 0x61,
+    0xb7, 0x8e, 0xb9, 0x66, 0xcd, 0x19, 0xcf, 0xe4, 0x82, 0xe8, 0xf0, 0x4d, 0x33, 0xc7, 0x62, 0xad,
+    0x9b, 0xe9, 0xfd, 0x1c, 0xb2, 0xc5, 0x46, 0x37, 0x90, 0xf1, 0xb9, 0x8b, 0xe7, 0x50, 0xb1, 0xe5,
+    0x8a, 0xcb, 0xfd, 0x7e, 0x8c, 0x5b, 0x74, 0x5a, 0x18, 0x8d, 0xb5, 0x09, 0x03, 0x49, 0xcc, 0x5c,
+    0x04, 0x22, 0x1b, 0xb0, 0x85, 0xe9, 0x27, 0xe8, 0x63, 0x80, 0xf7, 0x19, 0xc0, 0x2b, 0x76, 0x58,
+    0xa2, 0xc5, 0x70, 0xca, 0xc1, 0xa0, 0x52, 0xda, 0x15, 0x1c, 0x3d, 0xa0, 0x0a, 0x26, 0x0e, 0x1b,
+    0xe7, 0x60, 0xfc, 0x4f, 0xe3, 0xcb, 0x39, 0x3c, 0xc9, 0x50, 0x19, 0xd6, 0x0d, 0x82, 0xd1, 0x90,
+    0x3c, 0x18, 0x47, 0x1e, 0x92, 0x61, 0xbe, 0x64, 0x8a, 0x2b, 0xdd, 0x19, 0xc7, 0x0e, 0x84, 0xb4,
+    0x58, 0x73, 0xef, 0x95, 0x1e, 0x54, 0x8c, 0x0f, 0x5d, 0xeb, 0xb8, 0x1f, 0x9f, 0x3f, 0xfb, 0x72,
+    0x97, 0x30, 0x75, 0x18, 0x90, 0x85, 0x05, 0x59, 0x76, 0x64, 0xfb, 0x91, 0xf1, 0x4d, 0xa0, 0x53,
+    0xfa, 0xc8, 0x43, 0x47, 0x94, 0x7c, 0xb3, 0xfa, 0x99, 0x65, 0x10, 0xab, 0x69, 0x12, 0x6a, 0x65,
+    0x35, 0x0c, 0x9b, 0x0d, 0x4d, 0x78, 0xe9, 0x26, 0xaa, 0x74, 0x13, 0x85, 0xee, 0xe2, 0xdd, 0x17,
+    0x2b, 0xb2, 0xc5, 0x3d, 0x5b, 0x31, 0xc5, 0x0e, 0x49, 0x5b, 0x47, 0xbe, 0x91, 0x36, 0x86, 0xbf,
+    0x49, 0xbe, 0x2d, 0x66, 0x17, 0xc9, 0x93, 0xf9, 0xd7, 0xc2, 0x5f, 0xc9, 0x3e, 0xfc, 0x5b, 0x5e,
+    0xbf, 0x73, 0x6f, 0xab, 0xaf, 0x9e, 0x09, 0xac, 0x86, 0x9d, 0xfe, 0xb1, 0xc8, 0x69, 0x07, 0x8d,
+    0xb6, 0x2d, 0xe7, 0xff, 0x65, 0xc4, 0xd9, 0x82, 0x4f, 0x83, 0xec, 0x0a, 0xdf, 0x4d, 0x03, 0x00,
+    0x00,
+};
+
+static const uint8_t status_js[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xbd, 0x55, 0x5d, 0x6f, 0xdb, 0x36,
+    0x14, 0x7d, 0xf7, 0xaf, 0xb8, 0x0b, 0x86, 0x4a, 0x5a, 0x0c, 0xd9, 0x69, 0xb1, 0x97, 0x18, 0x5e,
+    0x91, 0x66, 0xe9, 0xbe, 0xdc, 0x66, 0x98, 0x8d, 0x65, 0x40, 0x11, 0x08, 0xac, 0x74, 0x15, 0x11,
+    0x95, 0x49, 0x95, 0xa4, 0x1c, 0x1b, 0xad, 0xff, 0x7b, 0x2f, 0x49, 0xc9, 0x96, 0xec, 0x2c, 0xde,
+    0xd3, 0x1e, 0xe2, 0x48, 0x97, 0xe7, 0xdc, 0x7b, 0x78, 0xbf, 0x94, 0xd7, 0x22, 0x35, 0x5c, 0x0a,
+    0xb8, 0x5d, 0x5c, 0x85, 0x11, 0x7c, 0x81, 0x47, 0x2e, 0x32, 0xf9, 0x18, 0x97, 0x32, 0x65, 0xd6,
+    0x1e, 0x17, 0x0a, 0x73, 0x98, 0x42, 0x30, 0xaa, 0xab, 0x8c, 0x19, 0x0c, 0x26, 0xb0, 0x1d, 0xe4,
+    0x2d, 0xe9, 0x1a, 0xcb, 0x72, 0x29, 0xc5, 0xf3, 0xc4, 0xd4, 0x83, 0xb8, 0x91, 0xaa, 0xcf, 0x9e,
+    0xa3, 0x31, 0x5c, 0x3c, 0xe8, 0xe7, 0xe9, 0xba, 0x41, 0xf5, 0xb9, 0x57, 0xd9, 0x8a, 0x89, 0x14,
+    0xb3, 0xe7, 0xb9, 0xac, 0x41, 0x1d, 0xa8, 0xbe, 0x7a, 0x5f, 0xca, 0x87, 0x13, 0xa2, 0x99, 0x20,
+    0xcc, 0x11, 0x4f, 0x61, 0x55, 0xb2, 0xcd, 0x49, 0xaa, 0x87, 0x1d, 0xb1, 0xb5, 0x61, 0x46, 0x9f,
+    0x24, 0x3b, 0x54, 0x9f, 0x3b, 0x3b, 0x25, 0xf7, 0x48, 0xeb, 0xcd, 0x0a, 0xc5, 0xa9, 0x58, 0xe8,
+    0x30, 0x7d, 0x1e, 0x39, 0x92, 0xb5, 0xb1, 0xbc, 0x01, 0xc0, 0x8a, 0x29, 0x58, 0x17, 0x8a, 0xc0,
+    0x02, 0x1f, 0xe1, 0x9f, 0x77, 0xb3, 0x5f, 0x8d, 0xa9, 0xfe, 0xc2, 0xcf, 0x35, 0x6a, 0x82, 0x4c,
+    0x08, 0x41, 0xa7, 0xb1, 0xac, 0x50, 0x84, 0xc1, 0x2f, 0x37, 0x8b, 0x60, 0xe8, 0x95, 0x90, 0x03,
+    0x7a, 0x34, 0xaa, 0xc6, 0x1d, 0x46, 0xa3, 0xc8, 0x3c, 0x83, 0xca, 0xb9, 0xe0, 0x4b, 0xb4, 0x41,
+    0xda, 0xa0, 0x61, 0xb4, 0x13, 0xe9, 0x7c, 0x9d, 0x8d, 0xce, 0x86, 0x67, 0x89, 0xc6, 0x32, 0x3f,
+    0x8b, 0x48, 0xdc, 0x10, 0x2e, 0xc6, 0xe3, 0x31, 0x91, 0x3b, 0x32, 0xff, 0x64, 0xb5, 0xc6, 0x37,
+    0xcc, 0x18, 0x54, 0x9b, 0xb0, 0xb2, 0x2f, 0x51, 0x47, 0xf0, 0xf4, 0x49, 0xb9, 0x4e, 0x2b, 0x55,
+    0x95, 0x65, 0xd3, 0x7d, 0xe4, 0x27, 0xf2, 0xa3, 0xd0, 0x62, 0x88, 0xb0, 0x9d, 0x1c, 0x5c, 0x2f,
+    0x18, 0xb9, 0x50, 0xaf, 0x57, 0xac, 0xac, 0x71, 0x1a, 0x9c, 0xbb, 0xb7, 0xa1, 0xbf, 0x68, 0xf7,
+    0x96, 0x1d, 0xa1, 0x14, 0x5a, 0x56, 0xa1, 0xfd, 0xf9, 0x7f, 0x04, 0x92, 0x33, 0x5e, 0x2d, 0xa9,
+    0xae, 0x73, 0x0a, 0xb9, 0x13, 0x6a, 0xe3, 0x3f, 0xa9, 0x73, 0x30, 0x1a, 0xc1, 0x1f, 0x88, 0x95,
+    0x06, 0x53, 0x20, 0x7c, 0xf4, 0x09, 0x05, 0x47, 0xd3, 0x50, 0x57, 0x60, 0x24, 0xd8, 0xa9, 0x87,
+    0x5c, 0xc9, 0x25, 0x8c, 0x4a, 0xbe, 0xc2, 0x18, 0x16, 0x84, 0xd4, 0x15, 0x13, 0x20, 0x73, 0x60,
+    0x1e, 0x0b, 0x05, 0xf3, 0x1e, 0x3e, 0xe1, 0xc6, 0x9a, 0xed, 0xa3, 0x3f, 0xe0, 0xc2, 0xbe, 0xd8,
+    0x30, 0x7e, 0x7f, 0x68, 0x20, 0x24, 0x37, 0xf4, 0x97, 0xc5, 0x70, 0xc7, 0x4d, 0x41, 0x8d, 0x00,
+    0xd6, 0xef, 0xee, 0xdc, 0x72, 0x2b, 0xf6, 0x80, 0xe0, 0xaf, 0x49, 0x48, 0x9a, 0x08, 0x64, 0x59,
+    0x3c, 0x48, 0x25, 0x3d, 0x39, 0xf0, 0x5b, 0xa9, 0x96, 0xcc, 0x50, 0x5f, 0x7e, 0x99, 0xdf, 0x5e,
+    0x5f, 0xc2, 0xcb, 0x21, 0xd0, 0xff, 0x44, 0x21, 0x2b, 0xdd, 0x8b, 0x9d, 0x20, 0x4c, 0x64, 0x9e,
+    0x14, 0x64, 0x31, 0x85, 0xb3, 0x35, 0x77, 0x4b, 0x56, 0xb2, 0x34, 0xe4, 0xfd, 0x12, 0x2e, 0xf6,
+    0xb6, 0xb4, 0x56, 0x8a, 0x52, 0x66, 0x6d, 0x54, 0x23, 0x83, 0xcb, 0x0a, 0x15, 0x33, 0xb5, 0xc2,
+    0x64, 0xc9, 0x85, 0x43, 0xf6, 0x6c, 0x6c, 0xed, 0x6c, 0x76, 0xaf, 0xb5, 0xee, 0x92, 0x0c, 0xe9,
+    0xff, 0x25, 0x8c, 0x1b, 0x33, 0xf1, 0xf6, 0x91, 0x82, 0xe5, 0xdf, 0x81, 0x75, 0xec, 0x4f, 0xd8,
+    0xfa, 0xe0, 0xc4, 0xc9, 0x4d, 0xac, 0x96, 0xa4, 0x92, 0x8f, 0xa8, 0xc8, 0x7c, 0x47, 0x56, 0x0b,
+    0xcc, 0xb8, 0x4e, 0x0b, 0xa6, 0xc8, 0xff, 0xe1, 0xc9, 0xb1, 0xd9, 0x2a, 0x97, 0x86, 0x95, 0x49,
+    0xca, 0x2a, 0x96, 0x72, 0xb3, 0xb1, 0xe6, 0x82, 0xe0, 0x0a, 0x97, 0x8c, 0x0b, 0x5a, 0xa1, 0xff,
+    0xe1, 0xa4, 0xc9, 0xa1, 0x3d, 0xde, 0x4e, 0x3a, 0x5b, 0x81, 0x72, 0xbe, 0xc0, 0x35, 0x8d, 0xac,
+    0x4b, 0xfc, 0xd0, 0x17, 0xd7, 0x2f, 0x09, 0x9e, 0x43, 0x63, 0x86, 0xe9, 0xd4, 0xdd, 0x28, 0x22,
+    0xc7, 0x94, 0x29, 0x01, 0xef, 0x98, 0x29, 0x62, 0x25, 0x6b, 0xea, 0x36, 0xdf, 0x0d, 0x3f, 0xb4,
+    0xa3, 0x7c, 0x44, 0xbb, 0x0b, 0xe0, 0xeb, 0x57, 0xe8, 0x1a, 0x8a, 0xc0, 0xfb, 0xa7, 0xbc, 0xb9,
+    0xba, 0xd7, 0xf4, 0x05, 0xa1, 0x8a, 0xf7, 0x21, 0xf0, 0x1a, 0x02, 0xfa, 0x25, 0xc5, 0xc1, 0xc4,
+    0x61, 0xbb, 0x91, 0xd9, 0x47, 0x1d, 0x36, 0x42, 0x7f, 0x9a, 0xba, 0xc8, 0x04, 0x6f, 0x94, 0x8c,
+    0xbc, 0x92, 0xd8, 0xc8, 0xb7, 0x7c, 0x4d, 0x9f, 0x91, 0x8b, 0x08, 0xce, 0x21, 0x80, 0x4f, 0xa4,
+    0xe3, 0xdc, 0x87, 0xba, 0xf4, 0x97, 0xdc, 0x21, 0xc6, 0x1e, 0xb1, 0x03, 0xd8, 0x78, 0xdb, 0xc1,
+    0x2e, 0x62, 0x1f, 0xec, 0x55, 0xf6, 0x57, 0x81, 0xef, 0xe7, 0x19, 0xb5, 0xa6, 0x72, 0x63, 0xfd,
+    0x2f, 0x9b, 0xf0, 0x70, 0xcc, 0xfd, 0xd8, 0xba, 0x35, 0xf8, 0xa3, 0x4b, 0x1e, 0x45, 0xb5, 0xc9,
+    0x6b, 0xb6, 0x82, 0x5b, 0xf4, 0x73, 0x59, 0xab, 0xb4, 0xa9, 0xc7, 0x7e, 0x4a, 0x9a, 0xbd, 0xdd,
+    0x41, 0x84, 0x81, 0x9b, 0xe1, 0xc0, 0x55, 0xc0, 0x4d, 0x33, 0xcb, 0x32, 0x77, 0x3e, 0xe3, 0x34,
+    0x64, 0x82, 0x94, 0x05, 0xb6, 0x1b, 0x6b, 0x4d, 0xdd, 0xb1, 0x13, 0x85, 0xfd, 0x42, 0x34, 0xdb,
+    0x61, 0x0a, 0xbf, 0xcf, 0x6f, 0xdf, 0xc7, 0x15, 0x53, 0x1a, 0x43, 0x8c, 0x69, 0x78, 0x59, 0xe4,
+    0x6b, 0x40, 0x97, 0x87, 0xd0, 0x63, 0xed, 0x3e, 0xe0, 0x4d, 0x72, 0x74, 0xeb, 0xa6, 0x75, 0x84,
+    0x25, 0xda, 0x4d, 0x45, 0x9e, 0x32, 0x99, 0xd6, 0xf6, 0x31, 0x7e, 0x40, 0x73, 0xe3, 0xad, 0x6f,
+    0x36, 0xbf, 0x65, 0x21, 0xd1, 0x1b, 0x9f, 0x2d, 0xa7, 0x2d, 0x7f, 0x67, 0x0d, 0x7c, 0x20, 0x54,
+    0xec, 0xbe, 0xb8, 0x74, 0xc1, 0x51, 0xf2, 0xe1, 0xe5, 0xab, 0xfb, 0xef, 0x47, 0xf4, 0x29, 0x0a,
+    0xa2, 0xfb, 0x96, 0x6b, 0xf3, 0xd5, 0x46, 0x7b, 0xf1, 0xa2, 0x75, 0xf2, 0x1d, 0x35, 0x11, 0xf5,
+    0x26, 0xe6, 0x5c, 0x60, 0x16, 0xb5, 0x72, 0x62, 0x43, 0x8d, 0x7e, 0x2d, 0x85, 0xf1, 0xd2, 0x9e,
+    0x6e, 0x7d, 0x6d, 0x83, 0xde, 0x37, 0xda, 0x6c, 0x17, 0x6c, 0xf7, 0x29, 0x95, 0x94, 0x46, 0x25,
+    0xed, 0x57, 0xb3, 0xb7, 0xc5, 0xad, 0x06, 0x77, 0x4e, 0x23, 0x96, 0x6d, 0xe6, 0x76, 0x45, 0xd9,
+    0x2e, 0xee, 0x54, 0x27, 0xbe, 0x9e, 0xdd, 0xce, 0x6f, 0x7e, 0x8e, 0xfa, 0x9d, 0x42, 0xf5, 0xa6,
+    0x36, 0x22, 0x75, 0x1a, 0x5d, 0xfe, 0xfa, 0x87, 0xd4, 0x60, 0xdf, 0x00, 0x40, 0x41, 0x0a, 0x4f,
+    0xc3, 0x09, 0x00, 0x00,
+};
+
+const WebAsset web_assets[] = {
+    {"/assets/cellmonitor.css", "/assets/cellmonitor.css?v=fcce51dd", "text/css", "\"fcce51dd\"", cellmonitor_css, sizeof(cellmonitor_css)},
+    {"/assets/cellmonitor.js", "/assets/cellmonitor.js?v=ea84e053", "text/javascript", "\"ea84e053\"", cellmonitor_js, sizeof(cellmonitor_js)},
+    {"/assets/settings.css", "/assets/settings.css?v=45c25f34", "text/css", "\"45c25f34\"", settings_css, sizeof(settings_css)},
+    {"/assets/settings.js", "/assets/settings.js?v=859a4ac1", "text/javascript", "\"859a4ac1\"", settings_js, sizeof(settings_js)},
+    {"/assets/status.css", "/assets/status.css?v=df0aec83", "text/css", "\"df0aec83\"", status_css, sizeof(status_css)},
+    {"/assets/status.js", "/assets/status.js?v=4f0a4140", "text/javascript", "\"4f0a4140\"", status_js, sizeof(status_js)},
+};
+const size_t web_asset_count = sizeof(web_assets) / sizeof(web_assets[0]);
+// clang-format on
@@ -1,17 +1,21 @@
 #include "webserver.h"
 #include <Preferences.h>
 #include <ctime>
+#include <memory>
 #include <vector>
 #include "../../battery/BATTERIES.h"
 #include "../../battery/Battery.h"
 #include "../../battery/Shunt.h"
 #include "../../charger/CHARGERS.h"
+#include "../../communication/can/can_log_format.h"
+#include "../../communication/can/can_replay.h"
 #include "../../communication/can/comm_can.h"
 #include "../../communication/contactorcontrol/comm_contactorcontrol.h"
 #include "../../communication/equipmentstopbutton/comm_equipmentstopbutton.h"
 #include "../../communication/nvm/comm_nvm.h"
 #include "../../datalayer/datalayer.h"
 #include "../../datalayer/datalayer_extended.h"
+#include "../../datalayer/datalayer_snapshot.h"
 #include "../../devboard/safety/safety.h"
 #include "../../inverter/INVERTERS.h"
 #include "../../lib/bblanchon-ArduinoJson/ArduinoJson.h"
@@ -21,6 +25,10 @@
 #include "../utils/timer.h"
 #include "esp_task_wdt.h"
 #include "html_escape.h"
+#include "html_stream.h"
+#include "live_updates.h"
+#include "status_api.h"
+#include "web_assets.h"
 
 #include <string>
 extern std::string http_username;
@@ -37,6 +45,7 @@ unsigned long ota_progress_millis = 0;
 #include "advanced_battery_html.h"
 #include "can_logging_html.h"
 #include "can_replay_html.h"
+#include "can_stats_html.h"
 #include "cellmonitor_html.h"
 #include "debug_logging_html.h"
 #include "events_html.h"
@@ -48,125 +57,43 @@ bool ota_active = false;
 
 const char get_firmware_info_html[] = R"rawliteral(%X%)rawliteral";
 
-String importedLogs = "";      // Store the uploaded logfile contents in RAM
-bool isReplayRunning = false;  // Global flag to track replay state
-
 // True when user has updated settings that need a reboot to be effective.
 bool settingsUpdated = false;
 
-CAN_frame currentFrame = {.FD = true, .ext_ID = false, .DLC = 64, .ID = 0x12F, .data = {0}};
-
 void handleFileUpload(AsyncWebServerRequest* request, String filename, size_t index, uint8_t* data, size_t len,
                       bool final) {
+  // The log is parsed as it arrives and stored in binary, see can_replay.h
   if (!index) {
-    importedLogs = "";  // Clear previous logs
     logging.printf("Receiving file: %s\n", filename.c_str());
+    if (!can_replay_import_begin()) {
+      if (can_replay_running()) {
+        request->send(400, "text/plain", "Cannot store file, stop the replay first");
+      } else {
+        request->send(500, "text/plain", "Cannot store file in flash");
+      }
+      return;
+    }
   }
 
-  // Append received data to the string (RAM storage)
-  importedLogs += String((char*)data).substring(0, len);
-
-  if (final) {
-    logging.println("Upload Complete!");
-    request->send(200, "text/plain", "File uploaded successfully");
+  if (!can_replay_import(data, len)) {
+    // Only answered once, the rest of a failed upload finds no open import
+    if (can_replay_import_abort()) {
+      request->send(500, "text/plain", "Upload failed, the log does not fit in flash");
+    }
+    return;
   }
-}
-
-void canReplayTask(void* param) {
-  std::vector<String> messages;
-  messages.reserve(1000);  // Pre-allocate memory to reduce fragmentation
-
-  if (!importedLogs.isEmpty()) {
-    int lastIndex = 0;
 
-    while (true) {
-      int nextIndex = importedLogs.indexOf("\n", lastIndex);
-      if (nextIndex == -1) {
-        messages.push_back(importedLogs.substring(lastIndex));
-        break;
-      }
-      messages.push_back(importedLogs.substring(lastIndex, nextIndex));
-      lastIndex = nextIndex + 1;
+  if (final) {
+    uint32_t frames;
+    if (!can_replay_import_end(frames)) {
+      request->send(500, "text/plain", "Upload failed, the log does not fit in flash or is damaged");
+      return;
     }
-
-    do {
-      float firstTimestamp = -1.0f;
-      float lastTimestamp = 0.0f;
-      bool firstMessageSent = false;  // Track first message
-
-      for (size_t i = 0; i < messages.size(); i++) {
-        String line = messages[i];
-        line.trim();
-        if (line.length() == 0)
-          continue;
-
-        int timeStart = line.indexOf("(") + 1;
-        int timeEnd = line.indexOf(")");
-        if (timeStart == 0 || timeEnd == -1)
-          continue;
-
-        float currentTimestamp = line.substring(timeStart, timeEnd).toFloat();
-
-        if (firstTimestamp < 0) {
-          firstTimestamp = currentTimestamp;
-        }
-
-        // Send first message immediately
-        if (!firstMessageSent) {
-          firstMessageSent = true;
-          firstTimestamp = currentTimestamp;  // Adjust reference time
-        } else {
-          // Delay only if this isn't the first message
-          float deltaT = (currentTimestamp - lastTimestamp) * 1000;
-          vTaskDelay((int)deltaT / portTICK_PERIOD_MS);
-        }
-
-        lastTimestamp = currentTimestamp;
-
-        int interfaceStart = timeEnd + 2;
-        int interfaceEnd = line.indexOf(" ", interfaceStart);
-        if (interfaceEnd == -1)
-          continue;
-
-        int idStart = interfaceEnd + 1;
-        int idEnd = line.indexOf(" [", idStart);
-        if (idStart == -1 || idEnd == -1)
-          continue;
-
-        String messageID = line.substring(idStart, idEnd);
-        int dlcStart = idEnd + 2;
-        int dlcEnd = line.indexOf("]", dlcStart);
-        if (dlcEnd == -1)
-          continue;
-
-        String dlc = line.substring(dlcStart, dlcEnd);
-        int dataStart = dlcEnd + 2;
-        String dataBytes = line.substring(dataStart);
-
-        currentFrame.ID = strtol(messageID.c_str(), NULL, 16);
-        currentFrame.DLC = dlc.toInt();
-
-        int byteIndex = 0;
-        char* token = strtok((char*)dataBytes.c_str(), " ");
-        while (token != NULL && byteIndex < currentFrame.DLC) {
-          currentFrame.data.u8[byteIndex++] = strtol(token, NULL, 16);
-          token = strtok(NULL, " ");
-        }
-
-        currentFrame.FD = (datalayer.system.info.can_replay_interface == CANFD_NATIVE) ||
-                          (datalayer.system.info.can_replay_interface == CANFD_ADDON_MCP2518);
-        currentFrame.ext_ID = (currentFrame.ID > 0x7F0);
-
-        transmit_can_frame_to_interface(&currentFrame, (CAN_Interface)datalayer.system.info.can_replay_interface);
-      }
-    } while (datalayer.system.info.loop_playback);
-
-    messages.clear();          // Free vector memory
-    messages.shrink_to_fit();  // Release excess memory
+    logging.println("Upload Complete!");
+    request->send(200, "text/plain",
+                  "File uploaded successfully, " + String(frames) + " frames (" + String(can_replay_skipped_lines()) +
+                      " lines skipped)");
   }
-
-  isReplayRunning = false;  // Mark replay as stopped
-  vTaskDelete(NULL);
 }
 
 void def_route_with_auth(const char* uri, AsyncWebServer& serv, WebRequestMethodComposite method,
@@ -179,6 +106,67 @@ void def_route_with_auth(const char* uri, AsyncWebServer& serv, WebRequestMethod
   });
 }
 
+// Sends a page framed by the common header and footer, rendered step by step while it is sent
+static void send_page(AsyncWebServerRequest* request, HtmlStream::Renderer page) {
+  bool footer_sent = false;
+  auto stream = std::make_shared<HtmlStream>([page, footer_sent](HtmlStream& out, uint16_t step) mutable {
+    if (step == 0) {
+      out.print(index_html_header);
+      out.print(common_javascript);
+      return true;
+    }
+    if (page(out, step - 1)) {
+      return true;
+    }
+    if (footer_sent) {
+      return false;
+    }
+    out.print(index_html_footer);
+    footer_sent = true;
+    return true;
+  });
+  request->send(request->beginChunkedResponse(
+      "text/html",
+      [stream](uint8_t* buffer, size_t maxLen, size_t index) { return stream->read((char*)buffer, maxLen); }));
+}
+
+// Tells the ETags of the JSON API apart from those given out before a restart
+static uint32_t api_boot_id = 0;
+
+// Sends a JSON API response, or 304 Not Modified if the client already has this version of it
+static void send_api(AsyncWebServerRequest* request, ApiResponse api) {
+  if (request->hasHeader("If-None-Match") && etag_matches(request->header("If-None-Match").c_str(), api.etag.c_str())) {
+    AsyncWebServerResponse* response = request->beginResponse(304);
+    response->addHeader("ETag", api.etag);
+    request->send(response);
+    return;
+  }
+  auto stream = std::make_shared<HtmlStream>(std::move(api.body));
+  AsyncWebServerResponse* response = request->beginChunkedResponse(
+      "application/json",
+      [stream](uint8_t* buffer, size_t maxLen, size_t index) { return stream->read((char*)buffer, maxLen); });
+  response->addHeader("ETag", api.etag);
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
+}
+
+// Sends a style sheet or script of the pages as it is stored, compressed. The pages refer to it by a URL
+// with its version, so browsers can keep it for a year without asking again.
+static void send_asset(AsyncWebServerRequest* request, const WebAsset* asset) {
+  if (request->hasHeader("If-None-Match") && etag_matches(request->header("If-None-Match").c_str(), asset->etag)) {
+    AsyncWebServerResponse* response = request->beginResponse(304);
+    response->addHeader("ETag", asset->etag);
+    response->addHeader("Cache-Control", "public, max-age=31536000");
+    request->send(response);
+    return;
+  }
+  AsyncWebServerResponse* response = request->beginResponse(200, asset->content_type, asset->data, asset->length);
+  response->addHeader("Content-Encoding", "gzip");
+  response->addHeader("ETag", asset->etag);
+  response->addHeader("Cache-Control", "public, max-age=31536000");
+  request->send(response);
+}
+
 void init_webserver() {
 
   server.on("/logout", HTTP_GET, [](AsyncWebServerRequest* request) { request->send(401); });
@@ -192,7 +180,7 @@ void init_webserver() {
   def_route_with_auth("/", server, HTTP_GET, [](AsyncWebServerRequest* request) {
     // Clear OTA active flag as a safeguard in case onOTAEnd() wasn't called
     ota_active = false;
-    request->send(200, "text/html", index_html, processor);
+    send_page(request, status_page());
   });
 
   // Route for going to settings web page
@@ -206,7 +194,7 @@ void init_webserver() {
 
   // Route for going to advanced battery info web page
   def_route_with_auth("/advanced", server, HTTP_GET, [](AsyncWebServerRequest* request) {
-    request->send(200, "text/html", index_html, advanced_battery_processor);
+    send_page(request, advanced_battery_page);
   });
 
   // Route for going to CAN logging web page
@@ -221,26 +209,33 @@ void init_webserver() {
 
   def_route_with_auth("/startReplay", server, HTTP_GET, [](AsyncWebServerRequest* request) {
     // Prevent multiple replay tasks from being created
-    if (isReplayRunning) {
+    if (can_replay_running()) {
       request->send(400, "text/plain", "Replay already running!");
       return;
     }
 
     datalayer.system.info.loop_playback = request->hasParam("loop") && request->getParam("loop")->value().toInt() == 1;
-    isReplayRunning = true;  // Set flag before starting task
-
-    xTaskCreatePinnedToCore(canReplayTask, "CAN_Replay", 8192, NULL, 1, NULL, 1);
+    const float speed = request->hasParam("speed") ? request->getParam("speed")->value().toFloat() : 1.0f;
 
+    if (!start_can_replay((CAN_Interface)datalayer.system.info.can_replay_interface, speed)) {
+      request->send(400, "text/plain", "No log uploaded!");
+      return;
+    }
     request->send(200, "text/plain", "CAN replay started!");
   });
 
   // Route for stopping the CAN replay
   def_route_with_auth("/stopReplay", server, HTTP_GET, [](AsyncWebServerRequest* request) {
-    datalayer.system.info.loop_playback = false;
+    stop_can_replay();
 
     request->send(200, "text/plain", "CAN replay stopped!");
   });
 
+  // Route for the state and timing of the last CAN replay
+  def_route_with_auth("/replayReport", server, HTTP_GET, [](AsyncWebServerRequest* request) {
+    request->send(200, "text/plain", can_replay_report_text());
+  });
+
   // Route to handle setting the CAN interface for CAN replay
   def_route_with_auth("/setCANInterface", server, HTTP_GET, [](AsyncWebServerRequest* request) {
     if (request->hasParam("interface")) {
@@ -297,9 +292,11 @@ void init_webserver() {
   } else {
     // Define the handler to export can log
     server.on("/export_can_log", HTTP_GET, [](AsyncWebServerRequest* request) {
-      String logs = String(datalayer.system.info.logged_can_messages);
-      if (logs.length() == 0) {
-        logs = "No logs available.";
+      std::vector<uint8_t> records;
+      int64_t start_us;
+      if (copy_can_web_log(records, start_us) == 0) {
+        request->send(200, "text/plain", "No logs available.");
+        return;
       }
 
       // Get the current time
@@ -316,8 +313,11 @@ void init_webserver() {
         strcpy(filename, "battery_emulator_can_log.txt");
       }
 
-      // Use request->send with dynamic headers
-      AsyncWebServerResponse* response = request->beginResponse(200, "text/plain", logs);
+      // The text is rendered chunk by chunk as the response is sent, from a copy of the binary log
+      auto reader = std::make_shared<CanLogTextReader>(std::move(records), start_us);
+      AsyncWebServerResponse* response = request->beginChunkedResponse(
+          "text/plain",
+          [reader](uint8_t* buffer, size_t maxLen, size_t index) { return reader->read((char*)buffer, maxLen); });
       response->addHeader("Content-Disposition", String("attachment; filename=\"") + String(filename) + "\"");
       request->send(response);
     });
@@ -367,7 +367,45 @@ void init_webserver() {
 
   // Route for going to cellmonitor web page
   def_route_with_auth("/cellmonitor", server, HTTP_GET, [](AsyncWebServerRequest* request) {
-    request->send(200, "text/html", index_html, cellmonitor_processor);
+    send_page(request, cellmonitor_page);
+  });
+
+  // Live updates for the status page and cell monitor. The response stays open, while there is nothing
+  // to send the server asks again later.
+  def_route_with_auth("/live", server, HTTP_GET, [](AsyncWebServerRequest* request) {
+    if (LiveUpdateStream::clients() >= LiveUpdateStream::MAX_CLIENTS) {
+      request->send(503, "text/plain", "Too many live update connections");
+      return;
+    }
+    auto stream = std::make_shared<LiveUpdateStream>();
+    AsyncWebServerResponse* response = request->beginChunkedResponse(
+        "text/event-stream", [stream](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+          const size_t length = stream->read((char*)buffer, maxLen, millis());
+          return length == 0 ? RESPONSE_TRY_AGAIN : length;
+        });
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
+  });
+
+  // JSON API for dashboards and scripts
+  api_boot_id = esp_random();
+  def_route_with_auth("/api/v1/status", server, HTTP_GET,
+                      [](AsyncWebServerRequest* request) { send_api(request, api_status(api_boot_id)); });
+  def_route_with_auth("/api/v1/cells", server, HTTP_GET,
+                      [](AsyncWebServerRequest* request) { send_api(request, api_cells(api_boot_id)); });
+  def_route_with_auth("/api/v1/events", server, HTTP_GET,
+                      [](AsyncWebServerRequest* request) { send_api(request, api_events(api_boot_id)); });
+
+  // Style sheets and scripts of the pages
+  for (size_t i = 0; i < web_asset_count; i++) {
+    const WebAsset* asset = &web_assets[i];
+    def_route_with_auth(asset->path, server, HTTP_GET,
+                        [asset](AsyncWebServerRequest* request) { send_asset(request, asset); });
+  }
+
+  // Route for going to CAN traffic statistics web page
+  def_route_with_auth("/canstats", server, HTTP_GET, [](AsyncWebServerRequest* request) {
+    send_page(request, can_stats_page());
   });
 
   // Route for going to event log web page
@@ -398,16 +436,18 @@ void init_webserver() {
       "REMBMSRESET",   "EXTPRECHARGE", "USBENABLED",  "CANLOGUSB",    "WEBENABLED",   "CANFDASCAN",   "CANLOGSD",
       "WIFIAPENABLED", "MQTTENABLED",  "NOINVDISC",   "HADISC",       "MQTTTOPICS",   "MQTTCELLV",    "INVICNT",
       "GTWRHD",        "DIGITALHVIL",  "PERFPROFILE", "INTERLOCKREQ", "SOCESTIMATED", "PYLONOFFSET",  "PYLONORDER",
-      "DEYEBYD",       "NCCONTACTOR",  "TRIBTR",      "CNTCTRLTRI",
+      "DEYEBYD",       "NCCONTACTOR",  "TRIBTR",      "CNTCTRLTRI",   "CANRXTASKS",   "MQTTCANSTATS", "MQTTDELTA",
+      "MQTTSTORE",
   };
 
   const char* uintSettingNames[] = {
-      "BATTCVMAX", "BATTCVMIN",  "MAXPRETIME", "MAXPREFREQ", "WIFICHANNEL", "DCHGPOWER", "CHGPOWER",
-      "LOCALIP1",  "LOCALIP2",   "LOCALIP3",   "LOCALIP4",   "GATEWAY1",    "GATEWAY2",  "GATEWAY3",
-      "GATEWAY4",  "SUBNET1",    "SUBNET2",    "SUBNET3",    "SUBNET4",     "MQTTPORT",  "MQTTTIMEOUT",
-      "SOFAR_ID",  "PYLONSEND",  "INVCELLS",   "INVMODULES", "INVCELLSPER", "INVVLEVEL", "INVCAPACITY",
-      "INVBTYPE",  "CANFREQ",    "CANFDFREQ",  "PRECHGMS",   "PWMFREQ",     "PWMHOLD",   "GTWCOUNTRY",
-      "GTWMAPREG", "GTWCHASSIS", "GTWPACK",    "LEDMODE",    "GPIOOPT1",    "GPIOOPT2",  "GPIOOPT3",
+      "BATTCVMAX",   "BATTCVMIN",   "MAXPRETIME", "MAXPREFREQ", "WIFICHANNEL", "DCHGPOWER", "CHGPOWER",
+      "LOCALIP1",    "LOCALIP2",    "LOCALIP3",   "LOCALIP4",   "GATEWAY1",    "GATEWAY2",  "GATEWAY3",
+      "GATEWAY4",    "SUBNET1",     "SUBNET2",    "SUBNET3",    "SUBNET4",     "MQTTPORT",  "MQTTTIMEOUT",
+      "SOFAR_ID",    "PYLONSEND",   "INVCELLS",   "INVMODULES", "INVCELLSPER", "INVVLEVEL", "INVCAPACITY",
+      "INVBTYPE",    "CANFREQ",     "CANFDFREQ",  "PRECHGMS",   "PWMFREQ",     "PWMHOLD",   "GTWCOUNTRY",
+      "GTWMAPREG",   "GTWCHASSIS",  "GTWPACK",    "LEDMODE",    "GPIOOPT1",    "GPIOOPT2",  "GPIOOPT3",
+      "CANRXBUDGET", "MQTTCELLFMT", "MQTTRATE",
   };
 
   const char* stringSettingNames[] = {"APNAME",       "APPASSWORD", "HOSTNAME",        "MQTTSERVER",     "MQTTUSER",
@@ -791,732 +831,809 @@ String get_uptime() {
          " minutes, " + (String)remaining_seconds + " seconds";
 }
 
-String processor(const String& var) {
-  if (var == "X") {
-    String content = "";
-    content += "<style>";
-    content += "body { background-color: black; color: white; }";
-    content +=
-        "button { background-color: #505E67; color: white; border: none; padding: 10px 20px; margin-bottom: 20px; "
-        "cursor: pointer; border-radius: 10px; }";
-    content += "button:hover { background-color: #3A4A52; }";
-    content += "h2 { font-size: 1.2em; margin: 0.3em 0 0.5em 0; }";
-    content += "h4 { margin: 0.6em 0; line-height: 1.2; }";
-    //content += ".tooltip { position: relative; display: inline-block; }";
-    content += ".tooltip .tooltiptext {";
-    content += "  visibility: hidden;";
-    content += "  width: 200px;";
-    content += "  background-color: #3A4A52;";  // Matching your button hover color
-    content += "  color: white;";
-    content += "  text-align: center;";
-    content += "  border-radius: 6px;";
-    content += "  padding: 8px;";
-    content += "  position: absolute;";
-    content += "  z-index: 1;";
-    content += "  margin-left: -100px;";
-    content += "  opacity: 0;";
-    content += "  transition: opacity 0.3s;";
-    content += "  font-size: 0.9em;";
-    content += "  font-weight: normal;";
-    content += "  line-height: 1.4;";
-    content += "}";
-    content += ".tooltip:hover .tooltiptext { visibility: visible; opacity: 1; }";
-    content += ".tooltip-icon { color: #505E67; cursor: help; }";  // Matching your button color
-    content += "</style>";
-
-    // Compact header
-    content += "<h2>Battery Emulator</h2>";
-
-    // Start content block
-    content += "<div style='background-color: #303E47; padding: 10px; margin-bottom: 10px; border-radius: 50px'>";
-    content += "<h4>Software: " + String(version_number);
+// A copy of the battery status for the status page, all zero until the core task publishes the first one
+static std::unique_ptr<DATALAYER_BATTERY_SNAPSHOT> battery_snapshot(uint8_t index) {
+  auto snapshot = datalayer_snapshot.read_battery(index);
+  if (!snapshot) {
+    snapshot.reset(new DATALAYER_BATTERY_SNAPSHOT());
+  }
+  return snapshot;
+}
+
+// As formatPowerValue(), written to the stream
+static void print_power(HtmlStream& out, float value, const char* unit, int precision) {
+  if (value >= 1000.0f || value <= -1000.0f) {
+    out.printf("%.*f kW%s", precision, value / 1000.0f, unit);
+  } else {
+    out.printf("%.0f W%s", value, unit);
+  }
+}
+
+// Opens a span around a value that the live updates replace, see assets/status.js. key is the key
+// of the value in the live status updates, suffix the one of its battery.
+static void live_value(HtmlStream& out, const char* key, const char* suffix) {
+  out.print("<span id='");
+  out.print(key);
+  out.print(suffix);
+  out.print("'>");
+}
+
+static void print_live_power(HtmlStream& out, const char* key, const char* suffix, float value, const char* unit) {
+  live_value(out, key, suffix);
+  print_power(out, value, unit, 1);
+  out.print("</span>");
+}
+
+static void print_power(HtmlStream& out, const char* label, float value, const char* unit, int precision,
+                        bool red = false) {
+  out.print(red ? "<h4 style='color: red;'>" : "<h4 style='color: white;'>");
+  out.print(label);
+  out.print(": ");
+  print_power(out, value, unit, precision);
+  out.print("</h4>");
+}
+
+static void print_live_power(HtmlStream& out, const char* label, const char* key, const char* suffix, float value,
+                             const char* unit, bool red = false) {
+  out.print(red ? "<h4 style='color: red;'>" : "<h4 style='color: white;'>");
+  out.print(label);
+  out.print(": ");
+  print_live_power(out, key, suffix, value, unit);
+  out.print("</h4>");
+}
+
+static void print_check(HtmlStream& out, bool ok) {
+  out.print(ok ? "<span>&#10003;</span>" : "<span style='color: red;'>&#10005;</span>");
+}
+
+static const char* bms_status_text(uint8_t bms_status) {
+  switch (bms_status) {
+    case ACTIVE:
+      return "OK";
+    case UPDATING:
+      return "UPDATING";
+    case FAULT:
+      return "FAULT";
+    case INACTIVE:
+      return "INACTIVE";
+    case STANDBY:
+      return "STANDBY";
+    default:
+      return "??";
+  }
+}
+
+static const char* real_bms_status_text(uint8_t real_bms_status) {
+  switch (real_bms_status) {
+    case BMS_ACTIVE:
+      return "OK";
+    case BMS_FAULT:
+      return "FAULT";
+    case BMS_DISCONNECTED:
+      return "DISCONNECTED";
+    case BMS_STANDBY:
+      return "STANDBY";
+    default:
+      return "??";
+  }
+}
+
+// Steps of the status page, each one a block or part of a block of it
+enum StatusPageStep : uint16_t {
+  STATUS_SYSTEM,
+  STATUS_PERFORMANCE,
+  STATUS_CAN_QUEUES,  // One step per CAN interface
+  STATUS_WIFI = STATUS_CAN_QUEUES + NO_CAN_INTERFACE,
+  STATUS_COMPONENTS,
+  STATUS_BATTERY_FIGURES,
+  STATUS_BATTERY_CAPACITY,
+  STATUS_BATTERY_LIMITS,
+  STATUS_BATTERY_STATE,
+  STATUS_BATTERY2,
+  STATUS_BATTERY2_CAPACITY,
+  STATUS_BATTERY2_STATE,
+  STATUS_BATTERY3,
+  STATUS_BATTERY3_CAPACITY,
+  STATUS_BATTERY3_STATE,
+  STATUS_CONTACTORS,
+  STATUS_CHARGER,
+  STATUS_BUTTONS,
+  STATUS_SCRIPTS,
+};
+
+// The status page, rendered step by step while it is sent. The first battery comes from one copy of its
+// status, taken at the start, as the other blocks refer to it too. The second one is copied for its block.
+class StatusPage {
+ public:
+  bool render(HtmlStream& out, uint16_t step);
+
+ private:
+  void system(HtmlStream& out);
+  void performance(HtmlStream& out);
+  void can_queues(HtmlStream& out, int interface);
+  void wifi(HtmlStream& out);
+  void components(HtmlStream& out);
+  void battery_figures(HtmlStream& out);
+  void battery_capacity(HtmlStream& out, const DATALAYER_BATTERY_INFO_TYPE& info,
+                        const DATALAYER_BATTERY_STATUS_TYPE& status, const char* suffix);
+  void battery_limits(HtmlStream& out);
+  void battery_state(HtmlStream& out);
+  void other_battery(HtmlStream& out, const DATALAYER_BATTERY_STATUS_TYPE& status, const char* suffix);
+  void other_battery_state(HtmlStream& out, const DATALAYER_BATTERY_INFO_TYPE& info,
+                           const DATALAYER_BATTERY_STATUS_TYPE& status, const char* suffix);
+  void contactors(HtmlStream& out);
+  void charger_block(HtmlStream& out);
+  void buttons(HtmlStream& out);
+  void scripts(HtmlStream& out);
+
+  std::unique_ptr<DATALAYER_BATTERY_SNAPSHOT> snapshot;
+  std::unique_ptr<DATALAYER_BATTERY_SNAPSHOT> snapshot2;
+  std::unique_ptr<DATALAYER_BATTERY_SNAPSHOT> snapshot3;
+};
+
+bool StatusPage::render(HtmlStream& out, uint16_t step) {
+  if (!snapshot) {
+    snapshot = battery_snapshot(0);
+  }
+  if (step >= STATUS_CAN_QUEUES && step < STATUS_WIFI) {
+    if (datalayer.system.info.performance_measurement_active) {
+      can_queues(out, step - STATUS_CAN_QUEUES);
+    }
+    return true;
+  }
+
+  switch (step) {
+    case STATUS_SYSTEM:
+      system(out);
+      break;
+    case STATUS_PERFORMANCE:
+      if (datalayer.system.info.performance_measurement_active) {
+        performance(out);
+      }
+      break;
+    case STATUS_WIFI:
+      wifi(out);
+      break;
+    case STATUS_COMPONENTS:
+      if (inverter || battery || charger || user_selected_shunt_type != ShuntType::None) {
+        components(out);
+      }
+      break;
+    case STATUS_BATTERY_FIGURES:
+      if (battery) {
+        battery_figures(out);
+      }
+      break;
+    case STATUS_BATTERY_CAPACITY:
+      if (battery) {
+        battery_capacity(out, snapshot->info, snapshot->status, "");
+      }
+      break;
+    case STATUS_BATTERY_LIMITS:
+      if (battery) {
+        battery_limits(out);
+      }
+      break;
+    case STATUS_BATTERY_STATE:
+      if (battery) {
+        battery_state(out);
+      }
+      break;
+    case STATUS_BATTERY2:
+      if (battery && battery2) {
+        snapshot2 = battery_snapshot(1);
+        other_battery(out, snapshot2->status, "_2");
+      }
+      break;
+    case STATUS_BATTERY2_CAPACITY:
+      if (battery && battery2) {
+        battery_capacity(out, snapshot2->info, snapshot2->status, "_2");
+      }
+      break;
+    case STATUS_BATTERY2_STATE:
+      if (battery && battery2) {
+        other_battery_state(out, snapshot2->info, snapshot2->status, "_2");
+        snapshot2.reset();
+        if (!battery3) {
+          out.print("</div>");
+        }
+      }
+      break;
+    case STATUS_BATTERY3:
+      if (battery && battery2 && battery3) {
+        snapshot3 = battery_snapshot(2);
+        other_battery(out, snapshot3->status, "_3");
+      }
+      break;
+    case STATUS_BATTERY3_CAPACITY:
+      if (battery && battery2 && battery3) {
+        battery_capacity(out, snapshot3->info, snapshot3->status, "_3");
+      }
+      break;
+    case STATUS_BATTERY3_STATE:
+      if (battery && battery2 && battery3) {
+        other_battery_state(out, snapshot3->info, snapshot3->status, "_3");
+        snapshot3.reset();
+        out.print("</div></div>");
+      }
+      break;
+    case STATUS_CONTACTORS:
+      contactors(out);
+      break;
+    case STATUS_CHARGER:
+      if (charger) {
+        charger_block(out);
+      }
+      break;
+    case STATUS_BUTTONS:
+      buttons(out);
+      break;
+    case STATUS_SCRIPTS:
+      scripts(out);
+      break;
+    default:
+      return false;
+  }
+  return true;
+}
+
+void StatusPage::system(HtmlStream& out) {
+  out.print("<link rel='stylesheet' href='");
+  out.print(web_asset_url("/assets/status.css"));
+  out.print("'>");
+
+  // Compact header
+  out.print("<h2>Battery Emulator</h2>");
+
+  // Start content block
+  out.print("<div style='background-color: #303E47; padding: 10px; margin-bottom: 10px; border-radius: 50px'>");
+  out.print("<h4>Software: ");
+  out.print(version_number);
 
 // Show hardware used:
 #ifdef HW_LILYGO
-    content += " Hardware: LilyGo T-CAN485";
+  out.print(" Hardware: LilyGo T-CAN485");
 #endif  // HW_LILYGO
 #ifdef HW_LILYGO2CAN
-    content += " Hardware: LilyGo T_2CAN";
+  out.print(" Hardware: LilyGo T_2CAN");
 #endif  // HW_LILYGO2CAN
 #ifdef HW_BECOM
-    content += " Hardware: BECom";
+  out.print(" Hardware: BECom");
 #endif  // HW_BECOM
 #ifdef HW_STARK
-    content += " Hardware: Stark CMR Module";
+  out.print(" Hardware: Stark CMR Module");
 #endif  // HW_STARK
-    content += " @ " + String(datalayer.system.info.CPU_temperature, 1) + " &deg;C</h4>";
-    content += "<h4>Uptime: " + get_uptime() + "</h4>";
-    if (datalayer.system.info.performance_measurement_active) {
-      content +=
-          "<h4>Free heap: " + String(ESP.getFreeHeap()) + ", max alloc: " + String(ESP.getMaxAllocHeap()) + "</h4>";
-      FlashMode_t mode = ESP.getFlashChipMode();
-      content += "<h4>Flash mode: " +
-                 String(mode == FM_QIO    ? "QIO"
-                        : mode == FM_QOUT ? "QOUT"
-                        : mode == FM_DIO  ? "DIO"
-                        : mode == FM_DOUT ? "DOUT"
-                                          : /*mode == FM_UNKNOWN*/ "Unknown") +
-                 ", size: " + String(ESP.getFlashChipSize() / (1024 * 1024)) + " MB</h4>";
-      // Load information
-      content += "<h4>Core task max load: " + String(datalayer.system.status.core_task_max_us) + " us</h4>";
-      content +=
-          "<h4>Core task max load last 10 s: " + String(datalayer.system.status.core_task_10s_max_us) + " us</h4>";
-      content +=
-          "<h4>MQTT function (MQTT task) max load last 10 s: " + String(datalayer.system.status.mqtt_task_10s_max_us) +
-          " us</h4>";
-      content +=
-          "<h4>WIFI function (MQTT task) max load last 10 s: " + String(datalayer.system.status.wifi_task_10s_max_us) +
-          " us</h4>";
-      content += "<h4>Max load @ worst case execution of core task:</h4>";
-      content += "<h4>10ms function timing: " + String(datalayer.system.status.time_snap_10ms_us) + " us</h4>";
-      content += "<h4>Values function timing: " + String(datalayer.system.status.time_snap_values_us) + " us</h4>";
-      content += "<h4>CAN/serial RX function timing: " + String(datalayer.system.status.time_snap_comm_us) + " us</h4>";
-      content += "<h4>CAN TX function timing: " + String(datalayer.system.status.time_snap_cantx_us) + " us</h4>";
-      content += "<h4>OTA function timing: " + String(datalayer.system.status.time_snap_ota_us) + " us</h4>";
+  out.printf(" @ %.1f &deg;C</h4>", datalayer.system.info.CPU_temperature);
+  out.print("<h4>Uptime: ");
+  out.print(get_uptime());
+  out.print("</h4>");
+}
+
+void StatusPage::performance(HtmlStream& out) {
+  std::unique_ptr<DATALAYER_SYSTEM_STATUS_TYPE> system_status(new DATALAYER_SYSTEM_STATUS_TYPE());
+  datalayer_snapshot.read_system(*system_status);
+
+  out.printf("<h4>Free heap: %lu, max alloc: %lu</h4>", (unsigned long)ESP.getFreeHeap(),
+             (unsigned long)ESP.getMaxAllocHeap());
+  FlashMode_t mode = ESP.getFlashChipMode();
+  out.print("<h4>Flash mode: ");
+  out.print(mode == FM_QIO    ? "QIO"
+            : mode == FM_QOUT ? "QOUT"
+            : mode == FM_DIO  ? "DIO"
+            : mode == FM_DOUT ? "DOUT"
+                              : /*mode == FM_UNKNOWN*/ "Unknown");
+  out.printf(", size: %lu MB</h4>", (unsigned long)(ESP.getFlashChipSize() / (1024 * 1024)));
+  // Load information
+  out.print("<h4>Core task max load: ");
+  out.print(system_status->core_task_max_us);
+  out.print(" us</h4><h4>Core task max load last 10 s: ");
+  out.print(system_status->core_task_10s_max_us);
+  out.print(" us</h4><h4>MQTT function (MQTT task) max load last 10 s: ");
+  out.print(system_status->mqtt_task_10s_max_us);
+  out.print(" us</h4><h4>WIFI function (MQTT task) max load last 10 s: ");
+  out.print(system_status->wifi_task_10s_max_us);
+  out.print(" us</h4><h4>Max load @ worst case execution of core task:</h4>");
+  out.print("<h4>10ms function timing: ");
+  out.print(system_status->time_snap_10ms_us);
+  out.print(" us</h4><h4>Values function timing: ");
+  out.print(system_status->time_snap_values_us);
+  out.print(" us</h4><h4>CAN/serial RX function timing: ");
+  out.print(system_status->time_snap_comm_us);
+  out.print(" us</h4><h4>CAN TX function timing: ");
+  out.print(system_status->time_snap_cantx_us);
+  out.print(" us</h4><h4>OTA function timing: ");
+  out.print(system_status->time_snap_ota_us);
+  out.print(" us</h4>");
+}
+
+void StatusPage::can_queues(HtmlStream& out, int interface) {
+  std::unique_ptr<DATALAYER_SYSTEM_STATUS_TYPE> system_status(new DATALAYER_SYSTEM_STATUS_TYPE());
+  datalayer_snapshot.read_system(*system_status);
+  const char* name = getCANInterfaceName((CAN_Interface)interface);
+
+  if (system_status->can_rx_backlog_max[interface] > 0 || system_status->can_rx_overflows[interface] > 0) {
+    out.print("<h4>");
+    out.print(name);
+    out.print(" RX backlog max: ");
+    out.print(system_status->can_rx_backlog_max[interface]);
+    out.print(" frames, overflows: ");
+    out.print(system_status->can_rx_overflows[interface]);
+    out.print("</h4>");
+  }
+  static const char* const tx_priority_names[CAN_TX_PRIORITY_COUNT] = {"safety", "inverter", "diagnostic"};
+  for (int p = 0; p < CAN_TX_PRIORITY_COUNT; p++) {
+    if (system_status->can_tx_latency_max_us[interface][p] > 0 || system_status->can_tx_dropped[interface][p] > 0) {
+      out.print("<h4>");
+      out.print(name);
+      out.print(" TX ");
+      out.print(tx_priority_names[p]);
+      out.print(" queue wait max: ");
+      out.print(system_status->can_tx_latency_max_us[interface][p]);
+      out.print(" us, dropped: ");
+      out.print(system_status->can_tx_dropped[interface][p]);
+      out.print("</h4>");
     }
+  }
+}
+
+void StatusPage::wifi(HtmlStream& out) {
+  wl_status_t status = WiFi.status();
+  // Display ssid of network connected to and, if connected to the WiFi, its own IP
+  out.print("<h4>SSID: ");
+  out.print(html_escape(ssid.c_str()));
+  if (status == WL_CONNECTED) {
+    // Get and display the signal strength (RSSI) and channel
+    out.printf(" RSSI:%d dBm Ch: %d", (int)WiFi.RSSI(), (int)WiFi.channel());
+  }
+  out.print("</h4>");
+  if (status == WL_CONNECTED) {
+    out.print("<h4>Hostname: ");
+    out.print(html_escape(WiFi.getHostname()));
+    out.print("</h4><h4>IP: ");
+    out.print(WiFi.localIP().toString());
+    out.print("</h4>");
+  } else {
+    out.print("<h4>Wifi state: ");
+    out.print(getConnectResultString(status));
+    out.print("</h4>");
+  }
+  // Close the block
+  out.print("</div>");
+}
 
-    wl_status_t status = WiFi.status();
-    // Display ssid of network connected to and, if connected to the WiFi, its own IP
-    content += "<h4>SSID: " + html_escape(ssid.c_str());
-    if (status == WL_CONNECTED) {
-      // Get and display the signal strength (RSSI) and channel
-      content += " RSSI:" + String(WiFi.RSSI()) + " dBm Ch: " + String(WiFi.channel());
+void StatusPage::components(HtmlStream& out) {
+  // Start a new block with a specific background color
+  out.print("<div style='background-color: #333; padding: 10px; margin-bottom: 10px; border-radius: 50px'>");
+
+  // Display which components are used
+  if (inverter) {
+    out.print("<h4 style='color: white;'>Inverter protocol: ");
+    out.print(inverter->name());
+    out.print(" ");
+    out.print(datalayer.system.info.inverter_brand);
+    out.print("</h4>");
+  }
+
+  if (battery) {
+    out.print("<h4 style='color: white;'>Battery protocol: ");
+    out.print(datalayer.system.info.battery_protocol);
+    if (battery3) {
+      out.print(" (Triple battery)");
+    } else if (battery2) {
+      out.print(" (Double battery)");
     }
-    content += "</h4>";
-    if (status == WL_CONNECTED) {
-      content += "<h4>Hostname: " + html_escape(WiFi.getHostname()) + "</h4>";
-      content += "<h4>IP: " + WiFi.localIP().toString() + "</h4>";
-    } else {
-      content += "<h4>Wifi state: " + getConnectResultString(status) + "</h4>";
+    if (snapshot->info.chemistry == battery_chemistry_enum::LFP) {
+      out.print(" (LFP)");
     }
-    // Close the block
-    content += "</div>";
-
-    if (inverter || battery || charger || user_selected_shunt_type != ShuntType::None) {
-      // Start a new block with a specific background color
-      content += "<div style='background-color: #333; padding: 10px; margin-bottom: 10px; border-radius: 50px'>";
-
-      // Display which components are used
-      if (inverter) {
-        content += "<h4 style='color: white;'>Inverter protocol: ";
-        content += inverter->name();
-        content += " ";
-        content += datalayer.system.info.inverter_brand;
-        content += "</h4>";
-      }
+    out.print("</h4>");
+  }
 
-      if (battery) {
-        content += "<h4 style='color: white;'>Battery protocol: ";
-        content += datalayer.system.info.battery_protocol;
-        if (battery3) {
-          content += " (Triple battery)";
-        } else if (battery2) {
-          content += " (Double battery)";
-        }
-        if (datalayer.battery.info.chemistry == battery_chemistry_enum::LFP) {
-          content += " (LFP)";
-        }
-        content += "</h4>";
-      }
+  if (user_selected_shunt_type != ShuntType::None) {
+    out.print("<h4 style='color: white;'>Shunt protocol: ");
+    out.print(datalayer.system.info.shunt_protocol);
+    out.print("</h4>");
+  }
 
-      if (user_selected_shunt_type != ShuntType::None) {
-        content += "<h4 style='color: white;'>Shunt protocol: ";
-        content += datalayer.system.info.shunt_protocol;
-        content += "</h4>";
-      }
+  if (charger) {
+    out.print("<h4 style='color: white;'>Charger protocol: ");
+    out.print(charger->name());
+    out.print("</h4>");
+  }
 
-      if (charger) {
-        content += "<h4 style='color: white;'>Charger protocol: ";
-        content += charger->name();
-        content += "</h4>";
-      }
+  // Close the block
+  out.print("</div>");
+}
 
-      // Close the block
-      content += "</div>";
-    }
+// SOH, voltage, current and power, the same for each battery
+static void battery_figures_common(HtmlStream& out, const DATALAYER_BATTERY_STATUS_TYPE& status, const char* suffix) {
+  out.print("<h4 style='color: white;'>SOH: ");
+  live_value(out, "state_of_health", suffix);
+  out.printf("%.2f", status.soh_pptt / 100.0f);
+  out.print("</span>&percnt;</h4><h4 style='color: white;'>Voltage: ");
+  live_value(out, "battery_voltage", suffix);
+  out.printf("%.1f", status.voltage_dV / 10.0f);
+  out.print("</span> V &nbsp; Current: ");
+  live_value(out, "battery_current", suffix);
+  out.printf("%.1f", status.current_dA / 10.0f);
+  out.print("</span> A</h4>");
+  print_live_power(out, "Power", "stat_batt_power", suffix, status.active_power_W, "");
+}
 
-    if (battery) {
-      if (battery2) {
-        // Start a new block with a specific background color. Color changes depending on BMS status
-        content += "<div style='display: flex; width: 100%;'>";
-        content += "<div style='flex: 1; background-color: ";
-      } else {
-        // Start a new block with a specific background color. Color changes depending on system status
-        content += "<div style='background-color: ";
-      }
+void StatusPage::battery_figures(HtmlStream& out) {
+  const DATALAYER_BATTERY_STATUS_TYPE& status = snapshot->status;
 
-      switch (get_emulator_status()) {
-        case EMULATOR_STATUS::STATUS_OK:
-          content += "#2D3F2F;";
-          break;
-        case EMULATOR_STATUS::STATUS_WARNING:
-          content += "#F5CC00;";
-          break;
-        case EMULATOR_STATUS::STATUS_ERROR:
-          content += "#A70107;";
-          break;
-        case EMULATOR_STATUS::STATUS_UPDATING:
-          content += "#2B35AF;";  // Blue in test mode
-          break;
-      }
+  if (battery2) {
+    // Start a new block with a specific background color. Color changes depending on BMS status
+    out.print("<div style='display: flex; width: 100%;'>");
+    out.print("<div style='flex: 1; background-color: ");
+  } else {
+    // Start a new block with a specific background color. Color changes depending on system status
+    out.print("<div style='background-color: ");
+  }
 
-      // Add the common style properties
-      content += "padding: 10px; margin-bottom: 10px; border-radius: 50px;'>";
-
-      // Display battery statistics within this block
-      float socRealFloat =
-          static_cast<float>(datalayer.battery.status.real_soc) / 100.0f;  // Convert to float and divide by 100
-      float socScaledFloat =
-          static_cast<float>(datalayer.battery.status.reported_soc) / 100.0f;  // Convert to float and divide by 100
-      float sohFloat =
-          static_cast<float>(datalayer.battery.status.soh_pptt) / 100.0f;  // Convert to float and divide by 100
-      float voltageFloat =
-          static_cast<float>(datalayer.battery.status.voltage_dV) / 10.0f;  // Convert to float and divide by 10
-      float currentFloat =
-          static_cast<float>(datalayer.battery.status.current_dA) / 10.0f;  // Convert to float and divide by 10
-      float powerFloat = static_cast<float>(datalayer.battery.status.active_power_W);                // Convert to float
-      float tempMaxFloat = static_cast<float>(datalayer.battery.status.temperature_max_dC) / 10.0f;  // Convert to float
-      float tempMinFloat = static_cast<float>(datalayer.battery.status.temperature_min_dC) / 10.0f;  // Convert to float
-      float maxCurrentChargeFloat =
-          static_cast<float>(datalayer.battery.status.max_charge_current_dA) / 10.0f;  // Convert to float
-      float maxCurrentDischargeFloat =
-          static_cast<float>(datalayer.battery.status.max_discharge_current_dA) / 10.0f;  // Convert to float
-      uint16_t cell_delta_mv =
-          datalayer.battery.status.cell_max_voltage_mV - datalayer.battery.status.cell_min_voltage_mV;
-
-      if (datalayer.battery.settings.soc_scaling_active)
-        content += "<h4 style='color: white;'>Scaled SOC: " + String(socScaledFloat, 2) +
-                   "&percnt; (real: " + String(socRealFloat, 2) + "&percnt;)</h4>";
-      else
-        content += "<h4 style='color: white;'>SOC: " + String(socRealFloat, 2) + "&percnt;</h4>";
-
-      content += "<h4 style='color: white;'>SOH: " + String(sohFloat, 2) + "&percnt;</h4>";
-      content += "<h4 style='color: white;'>Voltage: " + String(voltageFloat, 1) +
-                 " V &nbsp; Current: " + String(currentFloat, 1) + " A</h4>";
-      content += formatPowerValue("Power", powerFloat, "", 1);
-
-      if (datalayer.battery.settings.soc_scaling_active)
-        content += "<h4 style='color: white;'>Scaled total capacity: " +
-                   formatPowerValue(datalayer.battery.info.reported_total_capacity_Wh, "h", 1) +
-                   " (real: " + formatPowerValue(datalayer.battery.info.total_capacity_Wh, "h", 1) + ")</h4>";
-      else
-        content += formatPowerValue("Total capacity", datalayer.battery.info.total_capacity_Wh, "h", 1);
-
-      if (datalayer.battery.settings.soc_scaling_active)
-        content += "<h4 style='color: white;'>Scaled remaining capacity: " +
-                   formatPowerValue(datalayer.battery.status.reported_remaining_capacity_Wh, "h", 1) +
-                   " (real: " + formatPowerValue(datalayer.battery.status.remaining_capacity_Wh, "h", 1) + ")</h4>";
-      else
-        content += formatPowerValue("Remaining capacity", datalayer.battery.status.remaining_capacity_Wh, "h", 1);
-
-      if (datalayer.system.info.equipment_stop_active) {
-        content +=
-            formatPowerValue("Max discharge power", datalayer.battery.status.max_discharge_power_W, "", 1, "red");
-        content += formatPowerValue("Max charge power", datalayer.battery.status.max_charge_power_W, "", 1, "red");
-        content += "<h4 style='color: red;'>Max discharge current: " + String(maxCurrentDischargeFloat, 1) + " A</h4>";
-        content += "<h4 style='color: red;'>Max charge current: " + String(maxCurrentChargeFloat, 1) + " A</h4>";
-      } else {
-        content += formatPowerValue("Max discharge power", datalayer.battery.status.max_discharge_power_W, "", 1);
-        content += formatPowerValue("Max charge power", datalayer.battery.status.max_charge_power_W, "", 1);
-        content += "<h4 style='color: white;'>Max discharge current: " + String(maxCurrentDischargeFloat, 1) + " A";
-        if (datalayer.battery.settings.remote_settings_limit_discharge) {
-          content += " (Remote)</h4>";
-        } else if (datalayer.battery.settings.user_settings_limit_discharge) {
-          content += " (Manual)</h4>";
-        } else {
-          content += " (BMS)</h4>";
-        }
-        content += "<h4 style='color: white;'>Max charge current: " + String(maxCurrentChargeFloat, 1) + " A";
-        if (datalayer.battery.settings.remote_settings_limit_charge) {
-          content += " (Remote)</h4>";
-        } else if (datalayer.battery.settings.user_settings_limit_charge) {
-          content += " (Manual)</h4>";
-        } else {
-          content += " (BMS)</h4>";
-        }
-      }
+  switch (get_emulator_status()) {
+    case EMULATOR_STATUS::STATUS_OK:
+      out.print("#2D3F2F;");
+      break;
+    case EMULATOR_STATUS::STATUS_WARNING:
+      out.print("#F5CC00;");
+      break;
+    case EMULATOR_STATUS::STATUS_ERROR:
+      out.print("#A70107;");
+      break;
+    case EMULATOR_STATUS::STATUS_UPDATING:
+      out.print("#2B35AF;");  // Blue in test mode
+      break;
+  }
 
-      content += "<h4>Cell min/max: " + String(datalayer.battery.status.cell_min_voltage_mV) + " mV / " +
-                 String(datalayer.battery.status.cell_max_voltage_mV) + " mV</h4>";
-      if (cell_delta_mv > datalayer.battery.info.max_cell_voltage_deviation_mV) {
-        content += "<h4 style='color: red;'>Cell delta: " + String(cell_delta_mv) + " mV</h4>";
-      } else {
-        content += "<h4>Cell delta: " + String(cell_delta_mv) + " mV</h4>";
-      }
-      content += "<h4>Temperature min/max: " + String(tempMinFloat, 1) + " &deg;C / " + String(tempMaxFloat, 1) +
-                 " &deg;C</h4>";
-
-      content += "<h4>System status: ";
-      switch (datalayer.battery.status.bms_status) {
-        case ACTIVE:
-          content += String("OK");
-          break;
-        case UPDATING:
-          content += String("UPDATING");
-          break;
-        case FAULT:
-          content += String("FAULT");
-          break;
-        case INACTIVE:
-          content += String("INACTIVE");
-          break;
-        case STANDBY:
-          content += String("STANDBY");
-          break;
-        default:
-          content += String("??");
-          break;
-      }
-      content += "</h4>";
-
-      if (battery && battery->supports_real_BMS_status()) {
-        content += "<h4>Battery BMS status: ";
-        switch (datalayer.battery.status.real_bms_status) {
-          case BMS_ACTIVE:
-            content += String("OK");
-            break;
-          case BMS_FAULT:
-            content += String("FAULT");
-            break;
-          case BMS_DISCONNECTED:
-            content += String("DISCONNECTED");
-            break;
-          case BMS_STANDBY:
-            content += String("STANDBY");
-            break;
-          default:
-            content += String("??");
-            break;
-        }
-        content += "</h4>";
-      }
+  // Add the common style properties
+  out.print("padding: 10px; margin-bottom: 10px; border-radius: 50px;'>");
 
-      if (datalayer.battery.status.current_dA == 0) {
-        content += "<h4>Battery idle</h4>";
-      } else if (datalayer.battery.status.current_dA < 0) {
-        content += "<h4>Battery discharging!";
-        if (datalayer.battery.settings.inverter_limits_discharge) {
-          content += " (Inverter limiting)</h4>";
-        } else {
-          if (datalayer.battery.settings.user_settings_limit_discharge) {
-            content += " (Settings limiting)</h4>";
-          } else {
-            content += " (Battery limiting)</h4>";
-          }
-        }
-        content += "</h4>";
-      } else {  // > 0 , positive current
-        content += "<h4>Battery charging!";
-        if (datalayer.battery.settings.inverter_limits_charge) {
-          content += " (Inverter limiting)</h4>";
-        } else {
-          if (datalayer.battery.settings.user_settings_limit_charge) {
-            content += " (Settings limiting)</h4>";
-          } else {
-            content += " (Battery limiting)</h4>";
-          }
-        }
-      }
+  // Display battery statistics within this block
+  if (datalayer.battery.settings.soc_scaling_active) {
+    out.print("<h4 style='color: white;'>Scaled SOC: ");
+    live_value(out, "SOC", "");
+    out.printf("%.2f", status.reported_soc / 100.0f);
+    out.print("</span>&percnt; (real: ");
+  } else {
+    out.print("<h4 style='color: white;'>SOC: ");
+  }
+  live_value(out, "SOC_real", "");
+  out.printf("%.2f", status.real_soc / 100.0f);
+  out.print(datalayer.battery.settings.soc_scaling_active ? "</span>&percnt;)</h4>" : "</span>&percnt;</h4>");
+  battery_figures_common(out, status, "");
+}
 
-      // Close the block
-      content += "</div>";
-
-      if (battery2) {
-        content += "<div style='flex: 1; background-color: ";
-        switch (datalayer.battery.status.bms_status) {
-          case ACTIVE:
-            content += "#2D3F2F;";
-            break;
-          case FAULT:
-            content += "#A70107;";
-            break;
-          default:
-            content += "#2D3F2F;";
-            break;
-        }
-        // Add the common style properties
-        content += "padding: 10px; margin-bottom: 10px; border-radius: 50px;'>";
-
-        // Display battery statistics within this block
-        socRealFloat =
-            static_cast<float>(datalayer.battery2.status.real_soc) / 100.0f;  // Convert to float and divide by 100
-        //socScaledFloat; // Same value used for bat2
-        sohFloat =
-            static_cast<float>(datalayer.battery2.status.soh_pptt) / 100.0f;  // Convert to float and divide by 100
-        voltageFloat =
-            static_cast<float>(datalayer.battery2.status.voltage_dV) / 10.0f;  // Convert to float and divide by 10
-        currentFloat =
-            static_cast<float>(datalayer.battery2.status.current_dA) / 10.0f;       // Convert to float and divide by 10
-        powerFloat = static_cast<float>(datalayer.battery2.status.active_power_W);  // Convert to float
-        tempMaxFloat = static_cast<float>(datalayer.battery2.status.temperature_max_dC) / 10.0f;  // Convert to float
-        tempMinFloat = static_cast<float>(datalayer.battery2.status.temperature_min_dC) / 10.0f;  // Convert to float
-        cell_delta_mv = datalayer.battery2.status.cell_max_voltage_mV - datalayer.battery2.status.cell_min_voltage_mV;
-
-        if (datalayer.battery.settings.soc_scaling_active)
-          content += "<h4 style='color: white;'>Scaled SOC: " + String(socScaledFloat, 2) +
-                     "&percnt; (real: " + String(socRealFloat, 2) + "&percnt;)</h4>";
-        else
-          content += "<h4 style='color: white;'>SOC: " + String(socRealFloat, 2) + "&percnt;</h4>";
-
-        content += "<h4 style='color: white;'>SOH: " + String(sohFloat, 2) + "&percnt;</h4>";
-        content += "<h4 style='color: white;'>Voltage: " + String(voltageFloat, 1) +
-                   " V &nbsp; Current: " + String(currentFloat, 1) + " A</h4>";
-        content += formatPowerValue("Power", powerFloat, "", 1);
-
-        if (datalayer.battery.settings.soc_scaling_active)
-          content += "<h4 style='color: white;'>Scaled total capacity: " +
-                     formatPowerValue(datalayer.battery2.info.reported_total_capacity_Wh, "h", 1) +
-                     " (real: " + formatPowerValue(datalayer.battery2.info.total_capacity_Wh, "h", 1) + ")</h4>";
-        else
-          content += formatPowerValue("Total capacity", datalayer.battery2.info.total_capacity_Wh, "h", 1);
-
-        if (datalayer.battery.settings.soc_scaling_active)
-          content += "<h4 style='color: white;'>Scaled remaining capacity: " +
-                     formatPowerValue(datalayer.battery2.status.reported_remaining_capacity_Wh, "h", 1) +
-                     " (real: " + formatPowerValue(datalayer.battery2.status.remaining_capacity_Wh, "h", 1) + ")</h4>";
-        else
-          content += formatPowerValue("Remaining capacity", datalayer.battery2.status.remaining_capacity_Wh, "h", 1);
-
-        if (datalayer.system.info.equipment_stop_active) {
-          content +=
-              formatPowerValue("Max discharge power", datalayer.battery2.status.max_discharge_power_W, "", 1, "red");
-          content += formatPowerValue("Max charge power", datalayer.battery2.status.max_charge_power_W, "", 1, "red");
-          content +=
-              "<h4 style='color: red;'>Max discharge current: " + String(maxCurrentDischargeFloat, 1) + " A</h4>";
-          content += "<h4 style='color: red;'>Max charge current: " + String(maxCurrentChargeFloat, 1) + " A</h4>";
-        } else {
-          content += formatPowerValue("Max discharge power", datalayer.battery2.status.max_discharge_power_W, "", 1);
-          content += formatPowerValue("Max charge power", datalayer.battery2.status.max_charge_power_W, "", 1);
-          content +=
-              "<h4 style='color: white;'>Max discharge current: " + String(maxCurrentDischargeFloat, 1) + " A</h4>";
-          content += "<h4 style='color: white;'>Max charge current: " + String(maxCurrentChargeFloat, 1) + " A</h4>";
-        }
+void StatusPage::battery_capacity(HtmlStream& out, const DATALAYER_BATTERY_INFO_TYPE& info,
+                                  const DATALAYER_BATTERY_STATUS_TYPE& status, const char* suffix) {
+  if (datalayer.battery.settings.soc_scaling_active) {
+    out.print("<h4 style='color: white;'>Scaled total capacity: ");
+    print_power(out, info.reported_total_capacity_Wh, "h", 1);
+    out.print(" (real: ");
+    print_live_power(out, "total_capacity", suffix, info.total_capacity_Wh, "h");
+    out.print(")</h4>");
+  } else {
+    print_live_power(out, "Total capacity", "total_capacity", suffix, info.total_capacity_Wh, "h");
+  }
 
-        content += "<h4>Cell min/max: " + String(datalayer.battery2.status.cell_min_voltage_mV) + " mV / " +
-                   String(datalayer.battery2.status.cell_max_voltage_mV) + " mV</h4>";
-        if (cell_delta_mv > datalayer.battery2.info.max_cell_voltage_deviation_mV) {
-          content += "<h4 style='color: red;'>Cell delta: " + String(cell_delta_mv) + " mV</h4>";
-        } else {
-          content += "<h4>Cell delta: " + String(cell_delta_mv) + " mV</h4>";
-        }
-        content += "<h4>Temperature min/max: " + String(tempMinFloat, 1) + " &deg;C / " + String(tempMaxFloat, 1) +
-                   " &deg;C</h4>";
-        if (datalayer.battery.status.bms_status == ACTIVE) {
-          content += "<h4>System status: OK </h4>";
-        } else if (datalayer.battery.status.bms_status == UPDATING) {
-          content += "<h4>System status: UPDATING </h4>";
-        } else {
-          content += "<h4>System status: FAULT </h4>";
-        }
-        if (datalayer.battery2.status.current_dA == 0) {
-          content += "<h4>Battery idle</h4>";
-        } else if (datalayer.battery2.status.current_dA < 0) {
-          content += "<h4>Battery discharging!</h4>";
-        } else {  // > 0
-          content += "<h4>Battery charging!</h4>";
-        }
-        content += "</div>";
-        if (battery3) {
-          content += "<div style='flex: 1; background-color: ";
-          switch (datalayer.battery.status.bms_status) {
-            case ACTIVE:
-              content += "#2D3F2F;";
-              break;
-            case FAULT:
-              content += "#A70107;";
-              break;
-            default:
-              content += "#2D3F2F;";
-              break;
-          }
-          // Add the common style properties
-          content += "padding: 10px; margin-bottom: 10px; border-radius: 50px;'>";
-
-          // Display battery statistics within this block
-          socRealFloat =
-              static_cast<float>(datalayer.battery3.status.real_soc) / 100.0f;  // Convert to float and divide by 100
-          //socScaledFloat; // Same value used for bat2
-          sohFloat =
-              static_cast<float>(datalayer.battery3.status.soh_pptt) / 100.0f;  // Convert to float and divide by 100
-          voltageFloat =
-              static_cast<float>(datalayer.battery3.status.voltage_dV) / 10.0f;  // Convert to float and divide by 10
-          currentFloat =
-              static_cast<float>(datalayer.battery3.status.current_dA) / 10.0f;  // Convert to float and divide by 10
-          powerFloat = static_cast<float>(datalayer.battery3.status.active_power_W);                // Convert to float
-          tempMaxFloat = static_cast<float>(datalayer.battery3.status.temperature_max_dC) / 10.0f;  // Convert to float
-          tempMinFloat = static_cast<float>(datalayer.battery3.status.temperature_min_dC) / 10.0f;  // Convert to float
-          cell_delta_mv = datalayer.battery3.status.cell_max_voltage_mV - datalayer.battery3.status.cell_min_voltage_mV;
-
-          if (datalayer.battery.settings.soc_scaling_active)
-            content += "<h4 style='color: white;'>Scaled SOC: " + String(socScaledFloat, 2) +
-                       "&percnt; (real: " + String(socRealFloat, 2) + "&percnt;)</h4>";
-          else
-            content += "<h4 style='color: white;'>SOC: " + String(socRealFloat, 2) + "&percnt;</h4>";
-
-          content += "<h4 style='color: white;'>SOH: " + String(sohFloat, 2) + "&percnt;</h4>";
-          content += "<h4 style='color: white;'>Voltage: " + String(voltageFloat, 1) +
-                     " V &nbsp; Current: " + String(currentFloat, 1) + " A</h4>";
-          content += formatPowerValue("Power", powerFloat, "", 1);
-
-          if (datalayer.battery.settings.soc_scaling_active)
-            content += "<h4 style='color: white;'>Scaled total capacity: " +
-                       formatPowerValue(datalayer.battery3.info.reported_total_capacity_Wh, "h", 1) +
-                       " (real: " + formatPowerValue(datalayer.battery3.info.total_capacity_Wh, "h", 1) + ")</h4>";
-          else
-            content += formatPowerValue("Total capacity", datalayer.battery3.info.total_capacity_Wh, "h", 1);
-
-          if (datalayer.battery.settings.soc_scaling_active)
-            content += "<h4 style='color: white;'>Scaled remaining capacity: " +
-                       formatPowerValue(datalayer.battery3.status.reported_remaining_capacity_Wh, "h", 1) +
-                       " (real: " + formatPowerValue(datalayer.battery3.status.remaining_capacity_Wh, "h", 1) +
-                       ")</h4>";
-          else
-            content += formatPowerValue("Remaining capacity", datalayer.battery3.status.remaining_capacity_Wh, "h", 1);
-
-          if (datalayer.system.info.equipment_stop_active) {
-            content +=
-                formatPowerValue("Max discharge power", datalayer.battery3.status.max_discharge_power_W, "", 1, "red");
-            content += formatPowerValue("Max charge power", datalayer.battery3.status.max_charge_power_W, "", 1, "red");
-            content +=
-                "<h4 style='color: red;'>Max discharge current: " + String(maxCurrentDischargeFloat, 1) + " A</h4>";
-            content += "<h4 style='color: red;'>Max charge current: " + String(maxCurrentChargeFloat, 1) + " A</h4>";
-          } else {
-            content += formatPowerValue("Max discharge power", datalayer.battery3.status.max_discharge_power_W, "", 1);
-            content += formatPowerValue("Max charge power", datalayer.battery3.status.max_charge_power_W, "", 1);
-            content +=
-                "<h4 style='color: white;'>Max discharge current: " + String(maxCurrentDischargeFloat, 1) + " A</h4>";
-            content += "<h4 style='color: white;'>Max charge current: " + String(maxCurrentChargeFloat, 1) + " A</h4>";
-          }
+  if (datalayer.battery.settings.soc_scaling_active) {
+    out.print("<h4 style='color: white;'>Scaled remaining capacity: ");
+    print_live_power(out, "remaining_capacity", suffix, status.reported_remaining_capacity_Wh, "h");
+    out.print(" (real: ");
+    print_live_power(out, "remaining_capacity_real", suffix, status.remaining_capacity_Wh, "h");
+    out.print(")</h4>");
+  } else {
+    print_live_power(out, "Remaining capacity", "remaining_capacity_real", suffix, status.remaining_capacity_Wh, "h");
+  }
+}
 
-          content += "<h4>Cell min/max: " + String(datalayer.battery3.status.cell_min_voltage_mV) + " mV / " +
-                     String(datalayer.battery3.status.cell_max_voltage_mV) + " mV</h4>";
-          if (cell_delta_mv > datalayer.battery3.info.max_cell_voltage_deviation_mV) {
-            content += "<h4 style='color: red;'>Cell delta: " + String(cell_delta_mv) + " mV</h4>";
-          } else {
-            content += "<h4>Cell delta: " + String(cell_delta_mv) + " mV</h4>";
-          }
-          content += "<h4>Temperature min/max: " + String(tempMinFloat, 1) + " &deg;C / " + String(tempMaxFloat, 1) +
-                     " &deg;C</h4>";
-          if (datalayer.battery.status.bms_status == ACTIVE) {
-            content += "<h4>System status: OK </h4>";
-          } else if (datalayer.battery.status.bms_status == UPDATING) {
-            content += "<h4>System status: UPDATING </h4>";
-          } else {
-            content += "<h4>System status: FAULT </h4>";
-          }
-          if (datalayer.battery3.status.current_dA == 0) {
-            content += "<h4>Battery idle</h4>";
-          } else if (datalayer.battery3.status.current_dA < 0) {
-            content += "<h4>Battery discharging!</h4>";
-          } else {  // > 0
-            content += "<h4>Battery charging!</h4>";
-          }
-          content += "</div>";
-          content += "</div>";
-        }
-        content += "</div>";
-      }
-    }
-    // Block for Contactor status and component request status
-    // Start a new block with gray background color
-    content += "<div style='background-color: #333; padding: 10px; margin-bottom: 10px;border-radius: 50px'>";
+void StatusPage::battery_limits(HtmlStream& out) {
+  const DATALAYER_BATTERY_STATUS_TYPE& status = snapshot->status;
+  const float maxCurrentChargeFloat = status.max_charge_current_dA / 10.0f;
+  const float maxCurrentDischargeFloat = status.max_discharge_current_dA / 10.0f;
 
-    if (emulator_pause_status == NORMAL) {
-      content += "<h4>Power status: " + String(get_emulator_pause_status().c_str()) + " </h4>";
+  if (datalayer.system.info.equipment_stop_active) {
+    print_live_power(out, "Max discharge power", "max_discharge_power", "", status.max_discharge_power_W, "", true);
+    print_live_power(out, "Max charge power", "max_charge_power", "", status.max_charge_power_W, "", true);
+    out.printf("<h4 style='color: red;'>Max discharge current: %.1f A</h4>", maxCurrentDischargeFloat);
+    out.printf("<h4 style='color: red;'>Max charge current: %.1f A</h4>", maxCurrentChargeFloat);
+  } else {
+    print_live_power(out, "Max discharge power", "max_discharge_power", "", status.max_discharge_power_W, "");
+    print_live_power(out, "Max charge power", "max_charge_power", "", status.max_charge_power_W, "");
+    out.printf("<h4 style='color: white;'>Max discharge current: %.1f A", maxCurrentDischargeFloat);
+    if (datalayer.battery.settings.remote_settings_limit_discharge) {
+      out.print(" (Remote)</h4>");
+    } else if (datalayer.battery.settings.user_settings_limit_discharge) {
+      out.print(" (Manual)</h4>");
     } else {
-      content += "<h4 style='color: red;'>Power status: " + String(get_emulator_pause_status().c_str()) + " </h4>";
+      out.print(" (BMS)</h4>");
     }
-
-    content += "<h4>Emulator allows contactor closing: ";
-    if (datalayer.battery.status.bms_status == FAULT) {
-      content += "<span style='color: red;'>&#10005;</span>";
+    out.printf("<h4 style='color: white;'>Max charge current: %.1f A", maxCurrentChargeFloat);
+    if (datalayer.battery.settings.remote_settings_limit_charge) {
+      out.print(" (Remote)</h4>");
+    } else if (datalayer.battery.settings.user_settings_limit_charge) {
+      out.print(" (Manual)</h4>");
     } else {
-      content += "<span>&#10003;</span>";
+      out.print(" (BMS)</h4>");
     }
-    content += " Inverter allows contactor closing: ";
-    if (datalayer.system.status.inverter_allows_contactor_closing == true) {
-      content += "<span>&#10003;</span></h4>";
+  }
+}
+
+// Cell voltages and temperatures, the same for each battery
+static void cells_and_temperatures(HtmlStream& out, const DATALAYER_BATTERY_INFO_TYPE& info,
+                                   const DATALAYER_BATTERY_STATUS_TYPE& status, const char* suffix) {
+  const uint16_t cell_delta_mv = status.cell_max_voltage_mV - status.cell_min_voltage_mV;
+
+  out.print("<h4>Cell min/max: ");
+  live_value(out, "cell_min_voltage", suffix);
+  out.print(status.cell_min_voltage_mV);
+  out.print("</span> mV / ");
+  live_value(out, "cell_max_voltage", suffix);
+  out.print(status.cell_max_voltage_mV);
+  out.print("</span> mV</h4>");
+  out.print(cell_delta_mv > info.max_cell_voltage_deviation_mV ? "<h4 style='color: red;'>Cell delta: "
+                                                               : "<h4>Cell delta: ");
+  live_value(out, "cell_voltage_delta", suffix);
+  out.print(cell_delta_mv);
+  out.print("</span> mV</h4><h4>Temperature min/max: ");
+  live_value(out, "temperature_min", suffix);
+  out.printf("%.1f", status.temperature_min_dC / 10.0f);
+  out.print("</span> &deg;C / ");
+  live_value(out, "temperature_max", suffix);
+  out.printf("%.1f", status.temperature_max_dC / 10.0f);
+  out.print("</span> &deg;C</h4>");
+}
+
+void StatusPage::battery_state(HtmlStream& out) {
+  const DATALAYER_BATTERY_INFO_TYPE& info = snapshot->info;
+  const DATALAYER_BATTERY_STATUS_TYPE& status = snapshot->status;
+
+  cells_and_temperatures(out, info, status, "");
+
+  out.print("<h4>System status: ");
+  out.print(bms_status_text(status.bms_status));
+  out.print("</h4>");
+
+  if (battery && battery->supports_real_BMS_status()) {
+    out.print("<h4>Battery BMS status: ");
+    out.print(real_bms_status_text(status.real_bms_status));
+    out.print("</h4>");
+  }
+
+  if (status.current_dA == 0) {
+    out.print("<h4>Battery idle</h4>");
+  } else if (status.current_dA < 0) {
+    out.print("<h4>Battery discharging!");
+    if (datalayer.battery.settings.inverter_limits_discharge) {
+      out.print(" (Inverter limiting)</h4>");
     } else {
-      content += "<span style='color: red;'>&#10005;</span></h4>";
-    }
-    if (battery2) {
-      content += "<h4>Secondary battery allowed to join ";
-      if (datalayer.system.status.battery2_allowed_contactor_closing == true) {
-        content += "<span>&#10003;</span>";
+      if (datalayer.battery.settings.user_settings_limit_discharge) {
+        out.print(" (Settings limiting)</h4>");
       } else {
-        content += "<span style='color: red;'>&#10005; (voltage mismatch)</span>";
+        out.print(" (Battery limiting)</h4>");
       }
     }
-
-    if (!contactor_control_enabled) {
-      content += "<div class=\"tooltip\">";
-      content += "<h4>Contactors not fully controlled via emulator <span style=\"color:orange\">[?]</span></h4>";
-      content +=
-          "<span class=\"tooltiptext\">This means you are either running CAN controlled contactors OR manually "
-          "powering the contactors. Battery-Emulator will have limited amount of control over the contactors!</span>";
-      content += "</div>";
-    } else {  //contactor_control_enabled TRUE
-      content += "<div class=\"tooltip\"><h4>Contactors controlled by emulator, state: ";
-      if (datalayer.system.status.contactors_engaged == 0) {
-        content += "<span style='color: red;'>OFF (DISCONNECTED)</span>";
-      } else if (datalayer.system.status.contactors_engaged == 1) {
-        content += "<span style='color: green;'>ON</span>";
-      } else if (datalayer.system.status.contactors_engaged == 2) {
-        content += "<span style='color: red;'>OFF (FAULT)</span>";
-        content += "<span class=\"tooltip-icon\"> [!]</span>";
-        content +=
-            "<span class=\"tooltiptext\">Emulator spent too much time in critical FAULT event. Investigate event "
-            "causing this via Events page. Reboot required to resume operation!</span>";
-      } else if (datalayer.system.status.contactors_engaged == 3) {
-        content += "<span style='color: orange;'>PRECHARGE</span>";
-      }
-      content += "</h4></div>";
-      if (contactor_control_enabled_double_battery && battery2) {
-        content += "<h4>Secondary battery contactor, state: ";
-        if (pwm_contactor_control) {
-          if (datalayer.system.status.contactors_battery2_engaged) {
-            content += "<span style='color: green;'>Economized</span>";
-          } else {
-            content += "<span style='color: red;'>OFF</span>";
-          }
-        } else if (
-            esp32hal->SECOND_BATTERY_CONTACTORS_PIN() !=
-            GPIO_NUM_NC) {  // No PWM_CONTACTOR_CONTROL , we can read the pin and see feedback. Helpful if channel overloaded
-          if (digitalRead(esp32hal->SECOND_BATTERY_CONTACTORS_PIN()) == HIGH) {
-            content += "<span style='color: green;'>ON</span>";
-          } else {
-            content += "<span style='color: red;'>OFF</span>";
-          }
-        }  //no PWM_CONTACTOR_CONTROL
-        content += "</h4>";
+    out.print("</h4>");
+  } else {  // > 0 , positive current
+    out.print("<h4>Battery charging!");
+    if (datalayer.battery.settings.inverter_limits_charge) {
+      out.print(" (Inverter limiting)</h4>");
+    } else {
+      if (datalayer.battery.settings.user_settings_limit_charge) {
+        out.print(" (Settings limiting)</h4>");
+      } else {
+        out.print(" (Battery limiting)</h4>");
       }
     }
+  }
 
-    // Close the block
-    content += "</div>";
+  // Close the block
+  out.print("</div>");
+}
+
+// Battery 2 and 3. They show the scaled SOC, limits and system status of the first battery.
+void StatusPage::other_battery(HtmlStream& out, const DATALAYER_BATTERY_STATUS_TYPE& status, const char* suffix) {
+  out.print("<div style='flex: 1; background-color: ");
+  out.print(snapshot->status.bms_status == FAULT ? "#A70107;" : "#2D3F2F;");
+  // Add the common style properties
+  out.print("padding: 10px; margin-bottom: 10px; border-radius: 50px;'>");
+
+  // Display battery statistics within this block
+  if (datalayer.battery.settings.soc_scaling_active) {
+    out.printf("<h4 style='color: white;'>Scaled SOC: %.2f", snapshot->status.reported_soc / 100.0f);
+    out.print("&percnt; (real: ");
+  } else {
+    out.print("<h4 style='color: white;'>SOC: ");
+  }
+  live_value(out, "SOC_real", suffix);
+  out.printf("%.2f", status.real_soc / 100.0f);
+  out.print(datalayer.battery.settings.soc_scaling_active ? "</span>&percnt;)</h4>" : "</span>&percnt;</h4>");
+  battery_figures_common(out, status, suffix);
+}
 
-    if (charger) {
-      // Start a new block with orange background color
-      content += "<div style='background-color: #FF6E00; padding: 10px; margin-bottom: 10px;border-radius: 50px'>";
+void StatusPage::other_battery_state(HtmlStream& out, const DATALAYER_BATTERY_INFO_TYPE& info,
+                                     const DATALAYER_BATTERY_STATUS_TYPE& status, const char* suffix) {
+  const bool stop = datalayer.system.info.equipment_stop_active;
+
+  print_live_power(out, "Max discharge power", "max_discharge_power", suffix, status.max_discharge_power_W, "", stop);
+  print_live_power(out, "Max charge power", "max_charge_power", suffix, status.max_charge_power_W, "", stop);
+  out.print(stop ? "<h4 style='color: red;'>" : "<h4 style='color: white;'>");
+  out.printf("Max discharge current: %.1f A</h4>", snapshot->status.max_discharge_current_dA / 10.0f);
+  out.print(stop ? "<h4 style='color: red;'>" : "<h4 style='color: white;'>");
+  out.printf("Max charge current: %.1f A</h4>", snapshot->status.max_charge_current_dA / 10.0f);
+
+  cells_and_temperatures(out, info, status, suffix);
+  if (snapshot->status.bms_status == ACTIVE) {
+    out.print("<h4>System status: OK </h4>");
+  } else if (snapshot->status.bms_status == UPDATING) {
+    out.print("<h4>System status: UPDATING </h4>");
+  } else {
+    out.print("<h4>System status: FAULT </h4>");
+  }
+  if (status.current_dA == 0) {
+    out.print("<h4>Battery idle</h4>");
+  } else if (status.current_dA < 0) {
+    out.print("<h4>Battery discharging!</h4>");
+  } else {  // > 0
+    out.print("<h4>Battery charging!</h4>");
+  }
+  out.print("</div>");
+}
 
-      content += "<h4>Charger HV Enabled: ";
-      if (datalayer.charger.charger_HV_enabled) {
-        content += "<span>&#10003;</span>";
-      } else {
-        content += "<span style='color: red;'>&#10005;</span>";
-      }
-      content += "</h4>";
+void StatusPage::contactors(HtmlStream& out) {
+  std::unique_ptr<DATALAYER_SYSTEM_STATUS_TYPE> system_status(new DATALAYER_SYSTEM_STATUS_TYPE());
+  datalayer_snapshot.read_system(*system_status);
+
+  // Block for Contactor status and component request status
+  // Start a new block with gray background color
+  out.print("<div style='background-color: #333; padding: 10px; margin-bottom: 10px;border-radius: 50px'>");
+
+  out.print(emulator_pause_status == NORMAL ? "<h4>Power status: " : "<h4 style='color: red;'>Power status: ");
+  out.print(get_emulator_pause_status());
+  out.print(" </h4>");
+
+  out.print("<h4>Emulator allows contactor closing: ");
+  print_check(out, snapshot->status.bms_status != FAULT);
+  out.print(" Inverter allows contactor closing: ");
+  print_check(out, system_status->inverter_allows_contactor_closing == true);
+  out.print("</h4>");
+  if (battery2) {
+    out.print("<h4>Secondary battery allowed to join ");
+    if (system_status->battery2_allowed_contactor_closing == true) {
+      out.print("<span>&#10003;</span>");
+    } else {
+      out.print("<span style='color: red;'>&#10005; (voltage mismatch)</span>");
+    }
+  }
 
-      content += "<h4>Charger Aux12v Enabled: ";
-      if (datalayer.charger.charger_aux12V_enabled) {
-        content += "<span>&#10003;</span>";
-      } else {
-        content += "<span style='color: red;'>&#10005;</span>";
-      }
-      content += "</h4>";
+  if (!contactor_control_enabled) {
+    out.print("<div class=\"tooltip\">");
+    out.print("<h4>Contactors not fully controlled via emulator <span style=\"color:orange\">[?]</span></h4>");
+    out.print(
+        "<span class=\"tooltiptext\">This means you are either running CAN controlled contactors OR manually "
+        "powering the contactors. Battery-Emulator will have limited amount of control over the contactors!</span>");
+    out.print("</div>");
+  } else {  //contactor_control_enabled TRUE
+    out.print("<div class=\"tooltip\"><h4>Contactors controlled by emulator, state: ");
+    if (system_status->contactors_engaged == 0) {
+      out.print("<span style='color: red;'>OFF (DISCONNECTED)</span>");
+    } else if (system_status->contactors_engaged == 1) {
+      out.print("<span style='color: green;'>ON</span>");
+    } else if (system_status->contactors_engaged == 2) {
+      out.print("<span style='color: red;'>OFF (FAULT)</span>");
+      out.print("<span class=\"tooltip-icon\"> [!]</span>");
+      out.print(
+          "<span class=\"tooltiptext\">Emulator spent too much time in critical FAULT event. Investigate event "
+          "causing this via Events page. Reboot required to resume operation!</span>");
+    } else if (system_status->contactors_engaged == 3) {
+      out.print("<span style='color: orange;'>PRECHARGE</span>");
+    }
+    out.print("</h4></div>");
+    if (contactor_control_enabled_double_battery && battery2) {
+      out.print("<h4>Secondary battery contactor, state: ");
+      if (pwm_contactor_control) {
+        if (system_status->contactors_battery2_engaged) {
+          out.print("<span style='color: green;'>Economized</span>");
+        } else {
+          out.print("<span style='color: red;'>OFF</span>");
+        }
+      } else if (
+          esp32hal->SECOND_BATTERY_CONTACTORS_PIN() !=
+          GPIO_NUM_NC) {  // No PWM_CONTACTOR_CONTROL , we can read the pin and see feedback. Helpful if channel overloaded
+        if (digitalRead(esp32hal->SECOND_BATTERY_CONTACTORS_PIN()) == HIGH) {
+          out.print("<span style='color: green;'>ON</span>");
+        } else {
+          out.print("<span style='color: red;'>OFF</span>");
+        }
+      }  //no PWM_CONTACTOR_CONTROL
+      out.print("</h4>");
+    }
+  }
 
-      auto chgPwrDC = charger->outputPowerDC();
-      auto chgEff = charger->efficiency();
+  // Close the block
+  out.print("</div>");
+}
 
-      content += formatPowerValue("Charger Output Power", chgPwrDC, "", 1);
-      if (charger->efficiencySupported()) {
-        content += "<h4 style='color: white;'>Charger Efficiency: " + String(chgEff) + "%</h4>";
-      }
+void StatusPage::charger_block(HtmlStream& out) {
+  // Start a new block with orange background color
+  out.print("<div style='background-color: #FF6E00; padding: 10px; margin-bottom: 10px;border-radius: 50px'>");
 
-      float HVvol = charger->HVDC_output_voltage();
-      float HVcur = charger->HVDC_output_current();
-      float LVvol = charger->LVDC_output_voltage();
-      float LVcur = charger->LVDC_output_current();
+  out.print("<h4>Charger HV Enabled: ");
+  print_check(out, datalayer.charger.charger_HV_enabled);
+  out.print("</h4>");
 
-      content += "<h4 style='color: white;'>Charger HVDC Output V: " + String(HVvol, 2) + " V</h4>";
-      content += "<h4 style='color: white;'>Charger HVDC Output I: " + String(HVcur, 2) + " A</h4>";
-      content += "<h4 style='color: white;'>Charger LVDC Output I: " + String(LVcur, 2) + "</h4>";
-      content += "<h4 style='color: white;'>Charger LVDC Output V: " + String(LVvol, 2) + "</h4>";
+  out.print("<h4>Charger Aux12v Enabled: ");
+  print_check(out, datalayer.charger.charger_aux12V_enabled);
+  out.print("</h4>");
 
-      float ACcur = charger->AC_input_current();
-      float ACvol = charger->AC_input_voltage();
+  print_power(out, "Charger Output Power", charger->outputPowerDC(), "", 1);
+  if (charger->efficiencySupported()) {
+    out.printf("<h4 style='color: white;'>Charger Efficiency: %.2f%%</h4>", charger->efficiency());
+  }
 
-      content += "<h4 style='color: white;'>Charger AC Input V: " + String(ACvol, 2) + " VAC</h4>";
-      content += "<h4 style='color: white;'>Charger AC Input I: " + String(ACcur, 2) + " A</h4>";
+  out.printf("<h4 style='color: white;'>Charger HVDC Output V: %.2f V</h4>", charger->HVDC_output_voltage());
+  out.printf("<h4 style='color: white;'>Charger HVDC Output I: %.2f A</h4>", charger->HVDC_output_current());
+  out.printf("<h4 style='color: white;'>Charger LVDC Output I: %.2f</h4>", charger->LVDC_output_current());
+  out.printf("<h4 style='color: white;'>Charger LVDC Output V: %.2f</h4>", charger->LVDC_output_voltage());
 
-      content += "</div>";
-    }
+  out.printf("<h4 style='color: white;'>Charger AC Input V: %.2f VAC</h4>", charger->AC_input_voltage());
+  out.printf("<h4 style='color: white;'>Charger AC Input I: %.2f A</h4>", charger->AC_input_current());
 
-    if (emulator_pause_request_ON)
-      content += "<button onclick='PauseBattery(false)'>Resume charge/discharge</button> ";
-    else
-      content +=
-          "<button onclick=\"if(confirm('Are you sure you want to pause charging and discharging? This will set the "
-          "maximum charge and discharge values to zero, preventing any further power flow.')) { PauseBattery(true); "
-          "}\">Pause charge/discharge</button> ";
-
-    content += "<button onclick='OTA()'>Perform OTA update</button> ";
-    content += "<button onclick='Settings()'>Change Settings</button> ";
-    content += "<button onclick='Advanced()'>More Battery Info</button> ";
-    content += "<button onclick='CANlog()'>CAN logger</button> ";
-    content += "<button onclick='CANreplay()'>CAN replay</button> ";
-    if (datalayer.system.info.web_logging_active || datalayer.system.info.SD_logging_active) {
-      content += "<button onclick='Log()'>Log</button> ";
-    }
-    content += "<button onclick='Cellmon()'>Cellmonitor</button> ";
-    content += "<button onclick='Events()'>Events</button> ";
-    content += "<button onclick='askReboot()'>Reboot Emulator</button>";
-    if (webserver_auth)
-      content += "<button onclick='logout()'>Logout</button>";
-    if (!datalayer.system.info.equipment_stop_active)
-      content +=
-          "<br/><button style=\"background:red;color:white;cursor:pointer;\""
-          " onclick=\""
-          "if(confirm('This action will attempt to open contactors on the battery. Are you "
-          "sure?')) { estop(true); }\""
-          ">Open Contactors</button><br/>";
-    else
-      content +=
-          "<br/><button style=\"background:green;color:white;cursor:pointer;\""
-          "20px;font-size:16px;font-weight:bold;cursor:pointer;border-radius:5px; margin:10px;"
-          " onclick=\""
-          "if(confirm('This action will attempt to close contactors and enable power transfer. Are you sure?')) { "
-          "estop(false); }\""
-          ">Close Contactors</button><br/>";
-    content += "<script>";
-    content += "function OTA() { window.location.href = '/update'; }";
-    content += "function Cellmon() { window.location.href = '/cellmonitor'; }";
-    content += "function Settings() { window.location.href = '/settings'; }";
-    content += "function Advanced() { window.location.href = '/advanced'; }";
-    content += "function CANlog() { window.location.href = '/canlog'; }";
-    content += "function CANreplay() { window.location.href = '/canreplay'; }";
-    content += "function Log() { window.location.href = '/log'; }";
-    content += "function Events() { window.location.href = '/events'; }";
-    if (webserver_auth) {
-      content += "function logout() {";
-      content += "  var xhr = new XMLHttpRequest();";
-      content += "  xhr.open('GET', '/logout', true);";
-      content += "  xhr.send();";
-      content += "  setTimeout(function(){ window.open(\"/\",\"_self\"); }, 1000);";
-      content += "}";
-    }
-    content += "function PauseBattery(pause){";
-    content +=
-        "var xhr=new "
-        "XMLHttpRequest();xhr.onload=function() { "
-        "window.location.reload();};xhr.open('GET','/pause?value='+pause,true);xhr.send();";
-    content += "}";
-    content += "function estop(stop){";
-    content +=
-        "var xhr=new "
-        "XMLHttpRequest();xhr.onload=function() { "
-        "window.location.reload();};xhr.open('GET','/equipmentStop?value='+stop,true);xhr.send();";
-    content += "}";
-    content += "</script>";
-
-    //Script for refreshing page
-    content += "<script>";
-    content += "setTimeout(function(){ location.reload(true); }, 15000);";
-    content += "</script>";
+  out.print("</div>");
+}
 
-    return content;
+void StatusPage::buttons(HtmlStream& out) {
+  if (emulator_pause_request_ON)
+    out.print("<button onclick='PauseBattery(false)'>Resume charge/discharge</button> ");
+  else
+    out.print(
+        "<button onclick=\"if(confirm('Are you sure you want to pause charging and discharging? This will set the "
+        "maximum charge and discharge values to zero, preventing any further power flow.')) { PauseBattery(true); "
+        "}\">Pause charge/discharge</button> ");
+
+  out.print(
+      "<button onclick='OTA()'>Perform OTA update</button> "
+      "<button onclick='Settings()'>Change Settings</button> "
+      "<button onclick='Advanced()'>More Battery Info</button> "
+      "<button onclick='CANlog()'>CAN logger</button> "
+      "<button onclick='CANreplay()'>CAN replay</button> "
+      "<button onclick='CANstats()'>CAN stats</button> ");
+  if (datalayer.system.info.web_logging_active || datalayer.system.info.SD_logging_active) {
+    out.print("<button onclick='Log()'>Log</button> ");
   }
-  return String();
+  out.print(
+      "<button onclick='Cellmon()'>Cellmonitor</button> "
+      "<button onclick='Events()'>Events</button> "
+      "<button onclick='askReboot()'>Reboot Emulator</button>");
+  if (webserver_auth)
+    out.print("<button onclick='logout()'>Logout</button>");
+  if (!datalayer.system.info.equipment_stop_active)
+    out.print(
+        "<br/><button style=\"background:red;color:white;cursor:pointer;\""
+        " onclick=\""
+        "if(confirm('This action will attempt to open contactors on the battery. Are you "
+        "sure?')) { estop(true); }\""
+        ">Open Contactors</button><br/>");
+  else
+    out.print(
+        "<br/><button style=\"background:green;color:white;cursor:pointer;\""
+        "20px;font-size:16px;font-weight:bold;cursor:pointer;border-radius:5px; margin:10px;"
+        " onclick=\""
+        "if(confirm('This action will attempt to close contactors and enable power transfer. Are you sure?')) { "
+        "estop(false); }\""
+        ">Close Contactors</button><br/>");
+}
+
+void StatusPage::scripts(HtmlStream& out) {
+  // The buttons and the live updates of the values, see live_updates.h
+  out.print("<script src='");
+  out.print(web_asset_url("/assets/status.js"));
+  out.print("'></script>");
+}
+
+HtmlStream::Renderer status_page() {
+  auto page = std::make_shared<StatusPage>();
+  return [page](HtmlStream& out, uint16_t step) { return page->render(out, step); };
 }
 
 void onOTAStart() {
@@ -6,6 +6,7 @@
 #include "../../lib/ESP32Async-ESPAsyncWebServer/src/ESPAsyncWebServer.h"
 #include "../../lib/ayushsharma82-ElegantOTA/src/ElegantOTA.h"
 #include "../../lib/mathieucarbou-AsyncTCPSock/src/AsyncTCP.h"
+#include "html_stream.h"
 
 extern const char* version_number;  // The current software version, shown on webserver
 
@@ -51,13 +52,11 @@ void init_webserver();
 void init_ElegantOTA();
 
 /**
- * @brief Replaces placeholder with content section in web page
+ * @brief Renders the main status web page step by step
  *
- * @param[in] var
- *
- * @return String
+ * @return HtmlStream::Renderer
  */
-String processor(const String& var);
+HtmlStream::Renderer status_page();
 String get_firmware_info_processor(const String& var);
 
 /**
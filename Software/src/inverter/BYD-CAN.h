@@ -8,7 +8,7 @@ class BydCanInverter : public CanInverterProtocol {
  public:
   const char* name() override { return Name; }
   void transmit_can(unsigned long currentMillis);
-  void map_can_frame_to_variable(CAN_frame rx_frame);
+  void map_can_frame_to_variable(const CAN_frame& rx_frame);
   void update_values();
   bool provides_shunt() { return true; }
   void enable_shunt();
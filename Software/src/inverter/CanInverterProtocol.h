@@ -15,7 +15,7 @@ class CanInverterProtocol : public InverterProtocol, Transmitter, CanReceiver {
   InverterInterfaceType interface_type() { return InverterInterfaceType::Can; }
 
   virtual void transmit_can(unsigned long currentMillis) = 0;
-  virtual void map_can_frame_to_variable(CAN_frame rx_frame) = 0;
+  virtual void map_can_frame_to_variable(const CAN_frame& rx_frame) = 0;
 
   void transmit(unsigned long currentMillis) {
     if (allowed_to_send_CAN) {
@@ -23,7 +23,7 @@ class CanInverterProtocol : public InverterProtocol, Transmitter, CanReceiver {
     }
   }
 
-  void receive_can_frame(CAN_frame* frame) { map_can_frame_to_variable(*frame); }
+  void receive_can_frame(const CAN_frame& frame) { map_can_frame_to_variable(frame); }
 
  protected:
   CAN_Interface can_interface;
@@ -39,7 +39,14 @@ class CanInverterProtocol : public InverterProtocol, Transmitter, CanReceiver {
     logging.println(")");
   }
 
-  void transmit_can_frame(CAN_frame* frame) { transmit_can_frame_to_interface(frame, can_interface); }
+  void transmit_can_frame(CAN_frame* frame) {
+    transmit_can_frame_to_interface(frame, can_interface, CAN_TX_INVERTER);
+  }
+
+  // Cyclic frames registered here are sent by the CAN scheduler, staggered against other frames on the bus
+  void schedule_can_frame(CAN_frame* frame, uint16_t period_ms, std::function<bool(void)> before_send = nullptr) {
+    ::schedule_can_frame(frame, can_interface, period_ms, CAN_TX_INVERTER, before_send);
+  }
 };
 
 #endif
@@ -184,7 +184,7 @@ void SchneiderInverter::
   SE_320.data.u8[1] = 0x02;
 }
 
-void SchneiderInverter::map_can_frame_to_variable(CAN_frame rx_frame) {
+void SchneiderInverter::map_can_frame_to_variable(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x310:  // Still alive message from inverter, every 1s
       datalayer.system.status.CAN_inverter_still_alive = CAN_STILL_ALIVE;
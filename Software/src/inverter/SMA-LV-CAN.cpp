@@ -63,7 +63,7 @@ void SmaLvInverter::
   //TODO: Map error/warnings in 0x35A
 }
 
-void SmaLvInverter::map_can_frame_to_variable(CAN_frame rx_frame) {
+void SmaLvInverter::map_can_frame_to_variable(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x305:
       datalayer.system.status.CAN_inverter_still_alive = CAN_STILL_ALIVE;
@@ -86,23 +86,21 @@ void SmaLvInverter::map_can_frame_to_variable(CAN_frame rx_frame) {
 }
 
 void SmaLvInverter::transmit_can(unsigned long currentMillis) {
+  // All frames are cyclic and sent by the CAN scheduler, see setup()
+}
 
-  if (currentMillis - previousMillis100ms >= INTERVAL_100_MS) {
-    previousMillis100ms = currentMillis;
-
-    transmit_can_frame(&SMA_351);
-    transmit_can_frame(&SMA_355);
-    transmit_can_frame(&SMA_356);
-    transmit_can_frame(&SMA_35A);
-    transmit_can_frame(&SMA_35B);
-    transmit_can_frame(&SMA_35E);
-    transmit_can_frame(&SMA_35F);
+bool SmaLvInverter::setup() {
+  schedule_can_frame(&SMA_351, INTERVAL_100_MS);
+  schedule_can_frame(&SMA_355, INTERVAL_100_MS);
+  schedule_can_frame(&SMA_356, INTERVAL_100_MS);
+  schedule_can_frame(&SMA_35A, INTERVAL_100_MS);
+  schedule_can_frame(&SMA_35B, INTERVAL_100_MS);
+  schedule_can_frame(&SMA_35E, INTERVAL_100_MS);
+  schedule_can_frame(&SMA_35F, INTERVAL_100_MS);
 
-    //Remote quick stop (optional)
-    if (datalayer.battery.status.bms_status == FAULT) {
-      transmit_can_frame(&SMA_00F);
-      //After receiving this message, Sunny Island will immediately go into standby.
-      //Please send start command, to start again. Manual start is also possible.
-    }
-  }
+  //Remote quick stop (optional)
+  //After receiving this message, Sunny Island will immediately go into standby.
+  //Please send start command, to start again. Manual start is also possible.
+  schedule_can_frame(&SMA_00F, INTERVAL_100_MS, []() { return datalayer.battery.status.bms_status == FAULT; });
+  return true;
 }
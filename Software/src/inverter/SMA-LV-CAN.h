@@ -7,16 +7,15 @@ class SmaLvInverter : public CanInverterProtocol {
  public:
   const char* name() override { return Name; }
   void update_values();
+  bool setup() override;
   void transmit_can(unsigned long currentMillis);
-  void map_can_frame_to_variable(CAN_frame rx_frame);
+  void map_can_frame_to_variable(const CAN_frame& rx_frame);
   static constexpr const char* Name = "SMA Low Voltage (48V) protocol via CAN";
 
  private:
   static const int READY_STATE = 0x03;
   static const int STOP_STATE = 0x02;
 
-  unsigned long previousMillis100ms = 0;
-
   static const int VOLTAGE_OFFSET_DV = 40;  //Offset in deciVolt from max charge voltage and min discharge voltage
   static const int MAX_VOLTAGE_DV = 630;
   static const int MIN_VOLTAGE_DV = 41;
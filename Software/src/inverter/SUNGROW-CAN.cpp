@@ -377,7 +377,7 @@ void SungrowInverter::update_values() {
 #endif
 }
 
-void SungrowInverter::map_can_frame_to_variable(CAN_frame rx_frame) {
+void SungrowInverter::map_can_frame_to_variable(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x100:
       // SH10RS RUN @ ~1,250ms (group with one message every 250ms)
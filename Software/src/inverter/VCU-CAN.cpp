@@ -39,7 +39,7 @@ void VCUInverter::update_values() {  //Called every 1s
   LEAF_5BC.data.u8[4] = (datalayer.battery.status.soh_pptt / 100) << 1;
 }
 
-void VCUInverter::map_can_frame_to_variable(CAN_frame rx_frame) {
+void VCUInverter::map_can_frame_to_variable(const CAN_frame& rx_frame) {
   switch (rx_frame.ID) {
     case 0x1F2:
       datalayer.system.status.CAN_inverter_still_alive = CAN_STILL_ALIVE;
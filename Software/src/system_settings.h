@@ -22,6 +22,10 @@
  * Parameter: TASK_ACAN2515_PRIORITY
  * Description:
  * Defines the priority of ACAN2517FD CAN-FD handling
+ *
+ * Parameter: TASK_CAN_RX_PRIO
+ * Description:
+ * Defines the priority of the optional tasks that move received CAN frames from the drivers to the core task
 */
 #define TASK_CORE_PRIO 4
 #define TASK_CONNECTIVITY_PRIO 3
@@ -29,6 +33,7 @@
 #define TASK_MODBUS_PRIO 8
 #define TASK_ACAN2515_PRIORITY 10
 #define TASK_ACAN2517FD_PRIORITY 10
+#define TASK_CAN_RX_PRIO 6
 
 /** MAX AMOUNT OF CELLS
  * 
@@ -19,3 +19,41 @@ TEST(NissanLeafTests, ShouldReportVoltage) {
 
   EXPECT_EQ(datalayer.battery.status.voltage_dV, expected_dV);
 }
+
+TEST(NissanLeafTests, ShouldReadCellVoltagesInOneBurst) {
+  auto battery = new NissanLeafBattery();
+  battery->setup();
+
+  // Response to group 2: 61 02, then 96 cell voltages, sent as a first frame and consecutive frames
+  std::vector<uint8_t> response = {0x61, 0x02};
+  for (int i = 0; i < 96; i++) {
+    const uint16_t cell_mV = 3700 + i;
+    response.push_back(cell_mV >> 8);
+    response.push_back(cell_mV & 0xFF);
+  }
+
+  // Polling starts once the battery is seen, after the startup hold off, and a group request is sent every 10 s
+  CAN_frame alive = {.FD = false, .ext_ID = false, .DLC = 8, .ID = 0x5BC};
+  battery->handle_incoming_can_frame(alive);
+  for (unsigned long ms = 0; ms <= 40000; ms += 10000) {
+    battery->transmit_can(ms);
+  }
+
+  CAN_frame frame = {.FD = false, .ext_ID = false, .DLC = 8, .ID = 0x7BB};
+  frame.data.u8[0] = 0x10 | (response.size() >> 8);
+  frame.data.u8[1] = response.size() & 0xFF;
+  memcpy(&frame.data.u8[2], response.data(), 6);
+  battery->handle_incoming_can_frame(frame);
+
+  uint8_t sequence = 1;
+  for (size_t offset = 6; offset < response.size(); offset += 7) {
+    frame.data.u8[0] = 0x20 | (sequence++ & 0x0F);
+    memcpy(&frame.data.u8[1], response.data() + offset, std::min<size_t>(7, response.size() - offset));
+    battery->handle_incoming_can_frame(frame);
+  }
+
+  EXPECT_EQ(datalayer.battery.status.cell_voltages_mV[0], 3700);
+  EXPECT_EQ(datalayer.battery.status.cell_voltages_mV[95], 3795);
+  EXPECT_EQ(datalayer.battery.status.cell_min_voltage_mV, 3700);
+  EXPECT_EQ(datalayer.battery.status.cell_max_voltage_mV, 3795);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include "../Software/src/communication/can/CanReceiver.h"
+#include "../Software/src/communication/can/can_dispatch.h"
+#include "utils/utils.h"
+
+class RecordingReceiver : public CanReceiver {
+ public:
+  explicit RecordingReceiver(std::vector<uint32_t> ids = {}) : ids(ids) {}
+
+  void receive_can_frame(const CAN_frame& rx_frame) { received.push_back(rx_frame.ID); }
+  std::vector<uint32_t> can_ids() { return ids; }
+
+  std::vector<uint32_t> ids;
+  std::vector<uint32_t> received;
+};
+
+TEST(CanDispatchTests, DropsFramesNobodyHandles) {
+  CanDispatchTable table;
+  RecordingReceiver receiver({0x100, 0x18FF50E5});
+  table.add(&receiver, receiver.can_ids());
+
+  for (uint32_t id : {0x100u, 0x101u, 0x18FF50E5u, 0x18FF50E6u}) {
+    CAN_frame frame = frame_with_id(id);
+    table.dispatch(frame);
+  }
+
+  EXPECT_EQ(receiver.received, std::vector<uint32_t>({0x100, 0x18FF50E5}));
+  EXPECT_FALSE(table.is_wanted(0x101));
+  EXPECT_FALSE(table.accepts_all());
+}
+
+TEST(CanDispatchTests, ReceiverWithoutIdsGetsEverything) {
+  CanDispatchTable table;
+  RecordingReceiver filtered({0x200});
+  RecordingReceiver all;
+  table.add(&filtered, filtered.can_ids());
+  table.add(&all, all.can_ids());
+
+  for (uint32_t id : {0x200u, 0x300u, 0x1ABCDEFu}) {
+    CAN_frame frame = frame_with_id(id);
+    table.dispatch(frame);
+  }
+
+  EXPECT_EQ(filtered.received, std::vector<uint32_t>({0x200}));
+  EXPECT_EQ(all.received, std::vector<uint32_t>({0x200, 0x300, 0x1ABCDEF}));
+  EXPECT_TRUE(table.accepts_all());
+}
+
+TEST(CanDispatchTests, SharedIdReachesAllReceiversInOrder) {
+  CanDispatchTable table;
+  std::vector<int> order;
+
+  class OrderReceiver : public CanReceiver {
+   public:
+    OrderReceiver(std::vector<int>& order, int number) : order(order), number(number) {}
+    void receive_can_frame(const CAN_frame& rx_frame) { order.push_back(number); }
+    std::vector<int>& order;
+    int number;
+  };
+
+  OrderReceiver first(order, 1);
+  OrderReceiver second(order, 2);
+  table.add(&first, {0x7FF});
+  table.add(&second, {0x7FF});
+
+  CAN_frame frame = frame_with_id(0x7FF);
+  table.dispatch(frame);
+
+  EXPECT_EQ(order, std::vector<int>({1, 2}));
+}
+
+TEST(CanDispatchTests, RejectsReceiversWhenFull) {
+  CanDispatchTable table;
+  RecordingReceiver receiver({0x123});
+
+  for (int i = 0; i < CanDispatchTable::MAX_RECEIVERS; i++) {
+    EXPECT_TRUE(table.add(&receiver, receiver.can_ids()));
+  }
+  EXPECT_FALSE(table.add(&receiver, receiver.can_ids()));
+  EXPECT_EQ(table.receiver_count(), CanDispatchTable::MAX_RECEIVERS);
+
+  table.clear();
+  EXPECT_EQ(table.receiver_count(), 0);
+  EXPECT_FALSE(table.is_wanted(0x123));
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include "../Software/src/communication/can/can_filters.h"
+
+static bool passes(const std::vector<CanAcceptanceFilter>& filters, uint32_t id) {
+  const bool extended = id > CAN_MAX_STANDARD_ID;
+  for (const auto& filter : filters) {
+    if (filter.extended == extended && (id & filter.mask) == (filter.id & filter.mask)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static uint32_t passed_count(const std::vector<CanAcceptanceFilter>& filters) {
+  uint32_t count = 0;
+  for (uint32_t id = 0; id <= CAN_MAX_STANDARD_ID; id++) {
+    count += passes(filters, id);
+  }
+  return count;
+}
+
+TEST(CanFiltersTest, ExactFiltersWhenThereIsRoom) {
+  std::vector<CanAcceptanceFilter> filters;
+  ASSERT_TRUE(merge_can_filters({0x1DB, 0x55B, 0x1DB}, 2, filters));
+
+  ASSERT_EQ(filters.size(), 2);
+  EXPECT_EQ(passed_count(filters), 2);
+  EXPECT_TRUE(passes(filters, 0x1DB));
+  EXPECT_TRUE(passes(filters, 0x55B));
+}
+
+TEST(CanFiltersTest, MergesNeighbouringIdsFirst) {
+  std::vector<CanAcceptanceFilter> filters;
+  ASSERT_TRUE(merge_can_filters({0x100, 0x101, 0x700}, 2, filters));
+
+  ASSERT_EQ(filters.size(), 2);
+  // 0x100 and 0x101 differ in one bit, so merging them only lets those two through
+  EXPECT_EQ(passed_count(filters), 3);
+}
+
+TEST(CanFiltersTest, EveryWantedIdPasses) {
+  const std::vector<uint32_t> ids = {0x132, 0x20A, 0x212, 0x224, 0x252, 0x292, 0x2A4, 0x2B4, 0x2C4, 0x2D2,
+                                     0x300, 0x310, 0x312, 0x320, 0x332, 0x352, 0x392, 0x3AA, 0x3C4, 0x3D2,
+                                     0x401, 0x612, 0x72A, 0x7AA};
+  for (uint8_t max_filters : {1, 2, 6, 32}) {
+    std::vector<CanAcceptanceFilter> filters;
+    ASSERT_TRUE(merge_can_filters(ids, max_filters, filters));
+    EXPECT_LE(filters.size(), max_filters);
+    for (uint32_t id : ids) {
+      EXPECT_TRUE(passes(filters, id)) << std::hex << id << " with " << (int)max_filters << " filters";
+    }
+  }
+}
+
+TEST(CanFiltersTest, MoreFiltersLetFewerIdsThrough) {
+  const std::vector<uint32_t> ids = {0x1C2, 0x1DB, 0x1DC, 0x1ED, 0x380, 0x55B, 0x59E,
+                                     0x5BC, 0x5BF, 0x5C0, 0x5EB, 0x79B, 0x7BB};
+  uint32_t previous = CAN_MAX_STANDARD_ID + 1;
+  for (uint8_t max_filters = 1; max_filters <= ids.size(); max_filters++) {
+    std::vector<CanAcceptanceFilter> filters;
+    ASSERT_TRUE(merge_can_filters(ids, max_filters, filters));
+    EXPECT_LE(passed_count(filters), previous);
+    previous = passed_count(filters);
+  }
+  EXPECT_EQ(previous, ids.size());
+}
+
+TEST(CanFiltersTest, StandardAndExtendedAreKeptApart) {
+  std::vector<CanAcceptanceFilter> filters;
+  ASSERT_TRUE(merge_can_filters({0x100, 0x200, 0x18DAF110, 0x18DAF111}, 2, filters));
+
+  ASSERT_EQ(filters.size(), 2);
+  EXPECT_NE(filters[0].extended, filters[1].extended);
+  EXPECT_TRUE(passes(filters, 0x18DAF110));
+  EXPECT_TRUE(passes(filters, 0x18DAF111));
+  EXPECT_FALSE(passes(filters, 0x18DAF112));
+
+  EXPECT_FALSE(merge_can_filters({0x100, 0x18DAF110}, 1, filters));
+}
+
+TEST(CanFiltersTest, SharedMasksKeepOneMaskPerGroup) {
+  const std::vector<uint32_t> ids = {0x132, 0x20A, 0x212, 0x224, 0x252, 0x292, 0x2A4, 0x2B4,
+                                     0x2C4, 0x2D2, 0x300, 0x310, 0x401, 0x612, 0x72A, 0x7AA};
+  std::vector<CanAcceptanceFilter> first;
+  std::vector<CanAcceptanceFilter> second;
+  ASSERT_TRUE(merge_can_filters_shared_masks(ids, 2, 4, first, second));
+
+  ASSERT_GE(first.size(), 1);
+  ASSERT_LE(first.size(), 2);
+  ASSERT_GE(second.size(), 1);
+  ASSERT_LE(second.size(), 4);
+  for (const auto& filter : first) {
+    EXPECT_EQ(filter.mask, first[0].mask);
+  }
+  for (const auto& filter : second) {
+    EXPECT_EQ(filter.mask, second[0].mask);
+  }
+
+  std::vector<CanAcceptanceFilter> all(first);
+  all.insert(all.end(), second.begin(), second.end());
+  for (uint32_t id : ids) {
+    EXPECT_TRUE(passes(all, id)) << std::hex << id;
+  }
+  EXPECT_LT(passed_count(all), CAN_MAX_STANDARD_ID + 1);
+}
+
+TEST(CanFiltersTest, SharedMasksWithSingleId) {
+  std::vector<CanAcceptanceFilter> first;
+  std::vector<CanAcceptanceFilter> second;
+  ASSERT_TRUE(merge_can_filters_shared_masks({0x7BB}, 2, 4, first, second));
+
+  ASSERT_EQ(first.size(), 1);
+  ASSERT_EQ(second.size(), 1);
+  EXPECT_EQ(first[0].id, 0x7BB);
+  EXPECT_EQ(second[0].id, 0x7BB);
+  EXPECT_EQ(first[0].accepted_count(), 1);
+}
+
+TEST(CanFiltersTest, SharedMasksRejectMixedFormats) {
+  std::vector<CanAcceptanceFilter> first;
+  std::vector<CanAcceptanceFilter> second;
+  EXPECT_FALSE(merge_can_filters_shared_masks({0x100, 0x18DAF110}, 2, 4, first, second));
+  EXPECT_FALSE(merge_can_filters_shared_masks({}, 2, 4, first, second));
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include "../utils/utils.h"
+
+#include "../../Software/src/battery/BATTERIES.h"
+#include "../../Software/src/devboard/utils/events.h"
+
+#include <chrono>
+
+namespace fs = std::filesystem;
+
+// Measures what passing CAN frames by const reference saves per received frame,
+// by replaying the CAN logs through each battery both ways. Disabled by default as
+// timings are not meaningful on shared CI machines. Run with:
+//
+//   ./tests --gtest_also_run_disabled_tests --gtest_filter=CanLogBenchmark.*
+
+static const int BENCHMARK_ROUNDS = 20000;
+
+// The receive path as it was: the frame was copied into the handler's by-value
+// parameter once per receiver.
+__attribute__((noinline)) static void receive_by_value(CanBattery* receiver, CAN_frame frame) {
+  receiver->receive_can_frame(frame);
+}
+
+__attribute__((noinline)) static void receive_by_reference(CanBattery* receiver, const CAN_frame& frame) {
+  receiver->receive_can_frame(frame);
+}
+
+template <typename Receive>
+static double nanoseconds_per_frame(CanBattery* receiver, const std::vector<CAN_frame>& frames, Receive receive) {
+  auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+    for (const auto& frame : frames) {
+      receive(receiver, frame);
+    }
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() / (BENCHMARK_ROUNDS * frames.size());
+}
+
+TEST(CanLogBenchmark, DISABLED_ReceiveFrameByReferenceVsByValue) {
+  for (const auto& entry : fs::directory_iterator(TEST_CAN_LOG_DIR)) {
+    if (!entry.is_regular_file() || entry.path().extension().string() != ".txt") {
+      continue;
+    }
+
+    datalayer = DataLayer();
+    reset_all_events();
+    std::string filename = entry.path().filename().string();
+    user_selected_battery_type = (BatteryType)std::stoi(filename.substr(0, filename.find('_')));
+    setup_battery();
+    ASSERT_NE(battery, nullptr);
+
+    auto frames = parse_can_log_file(entry.path());
+    CanBattery* receiver = dynamic_cast<CanBattery*>(battery);
+    ASSERT_NE(receiver, nullptr);
+
+    double by_value = nanoseconds_per_frame(receiver, frames, receive_by_value);
+    double by_reference = nanoseconds_per_frame(receiver, frames, receive_by_reference);
+
+    std::cout << filename << ": " << frames.size() << " frames, by value " << by_value << " ns/frame, by reference "
+              << by_reference << " ns/frame, saved " << (by_value - by_reference) << " ns/frame" << std::endl;
+
+    delete battery;
+    battery = nullptr;
+  }
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include "../Software/src/communication/can/can_log_format.h"
+#include "utils/utils.h"
+
+static CAN_frame frame_with_data(uint32_t id, uint8_t dlc) {
+  CAN_frame frame = frame_with_id(id, dlc);
+  for (uint8_t i = 0; i < dlc; i++) {
+    frame.data.u8[i] = i + 1;
+  }
+  return frame;
+}
+
+class CanLogFormatTest : public testing::Test {
+ protected:
+  size_t append(const CAN_frame& frame, CAN_Interface interface, frameDirection direction, int64_t timestamp_us) {
+    uint8_t record[CanLogEncoder::MAX_RECORD_SIZE];
+    const size_t size = encoder.encode(frame, interface, direction, timestamp_us, record);
+    log.insert(log.end(), record, record + size);
+    return size;
+  }
+
+  std::vector<CanLogRecord> decode_all() {
+    std::vector<CanLogRecord> records;
+    CanLogDecoder decoder;
+    CanLogRecord record;
+    size_t offset = 0;
+    size_t used;
+    while ((used = decoder.next(log.data() + offset, log.size() - offset, record)) != 0) {
+      records.push_back(record);
+      offset += used;
+    }
+    EXPECT_FALSE(decoder.failed());
+    EXPECT_EQ(offset, log.size());
+    return records;
+  }
+
+  CanLogEncoder encoder;
+  std::vector<uint8_t> log;
+};
+
+TEST_F(CanLogFormatTest, RoundTrip) {
+  append(frame_with_data(0x1DB, 8), CAN_NATIVE, MSG_RX, 12345678);
+  append(frame_with_data(0x18DAF110, 3), CAN_ADDON_MCP2515, MSG_TX, 12345700);
+  CAN_frame fd = frame_with_data(0x2A0, 64);
+  fd.FD = true;
+  append(fd, CANFD_ADDON_MCP2518, MSG_RX, 12400000);
+
+  auto records = decode_all();
+  ASSERT_EQ(records.size(), 3);
+
+  EXPECT_EQ(records[0].frame.ID, 0x1DB);
+  EXPECT_EQ(records[0].frame.DLC, 8);
+  EXPECT_EQ(records[0].frame.data.u8[7], 8);
+  EXPECT_EQ(records[0].interface, CAN_NATIVE);
+  EXPECT_EQ(records[0].direction, MSG_RX);
+  EXPECT_EQ(records[0].timestamp_us, 12345678);
+
+  EXPECT_EQ(records[1].frame.ID, 0x18DAF110);
+  EXPECT_TRUE(records[1].frame.ext_ID);
+  EXPECT_EQ(records[1].interface, CAN_ADDON_MCP2515);
+  EXPECT_EQ(records[1].direction, MSG_TX);
+  EXPECT_EQ(records[1].timestamp_us, 12345700);
+
+  EXPECT_TRUE(records[2].frame.FD);
+  EXPECT_EQ(records[2].frame.DLC, 64);
+  EXPECT_EQ(records[2].frame.data.u8[63], 64);
+  EXPECT_EQ(records[2].interface, CANFD_ADDON_MCP2518);
+  EXPECT_EQ(records[2].timestamp_us, 12400000);
+}
+
+TEST_F(CanLogFormatTest, TimeBaseOnlyWhenNeeded) {
+  // The first frame carries its absolute time
+  EXPECT_EQ(append(frame_with_data(0x100, 8), CAN_NATIVE, MSG_RX, 1000000), CAN_LOG_TIME_BASE_SIZE + 16);
+  // Close frames only a delta
+  EXPECT_EQ(append(frame_with_data(0x100, 8), CAN_NATIVE, MSG_RX, 1010000), 16);
+  // Gaps too long for the delta get a new time base
+  EXPECT_EQ(append(frame_with_data(0x100, 8), CAN_NATIVE, MSG_RX, 2000000), CAN_LOG_TIME_BASE_SIZE + 16);
+  // As do frames after records were lost
+  encoder.resync();
+  EXPECT_EQ(append(frame_with_data(0x100, 8), CAN_NATIVE, MSG_RX, 2000100), CAN_LOG_TIME_BASE_SIZE + 16);
+
+  auto records = decode_all();
+  ASSERT_EQ(records.size(), 4);
+  EXPECT_EQ(records[1].timestamp_us, 1010000);
+  EXPECT_EQ(records[2].timestamp_us, 2000000);
+  EXPECT_EQ(records[3].timestamp_us, 2000100);
+}
+
+TEST_F(CanLogFormatTest, IncompleteAndInvalidRecords) {
+  append(frame_with_data(0x100, 8), CAN_NATIVE, MSG_RX, 1000);
+
+  CanLogDecoder decoder;
+  CanLogRecord record;
+  EXPECT_EQ(decoder.next(log.data(), log.size() - 1, record), 0);
+  EXPECT_FALSE(decoder.failed());
+  EXPECT_EQ(decoder.next(log.data(), log.size(), record), log.size());
+
+  const uint8_t garbage[] = {0x40, 0, 0, 0, 0, 0, 0, 0};
+  EXPECT_EQ(decoder.next(garbage, sizeof(garbage), record), 0);
+  EXPECT_TRUE(decoder.failed());
+}
+
+TEST_F(CanLogFormatTest, FormatsLikeTheWebserverLog) {
+  CanLogRecord record = {frame_with_data(0x1DB, 3), CAN_NATIVE, MSG_RX, 12000045};
+  char line[256];
+  size_t length = format_can_log_line(record, line, sizeof(line));
+  EXPECT_EQ(std::string(line, length), "(12.000045) RX0 1DB [3] 01 02 03\n");
+
+  record = {frame_with_data(0x18DAF110, 0), CAN_ADDON_MCP2515, MSG_TX, 5};
+  length = format_can_log_line(record, line, sizeof(line));
+  EXPECT_EQ(std::string(line, length), "(0.000005) TX5 18DAF110 [0] \n");
+}
+
+TEST_F(CanLogFormatTest, ParsesWhatItFormats) {
+  CanLogRecord original = {frame_with_data(0x18DAF110, 8), CAN_ADDON_MCP2515, MSG_TX, 1234567890};
+  char line[256];
+  const size_t length = format_can_log_line(original, line, sizeof(line));
+
+  CanLogRecord parsed;
+  ASSERT_TRUE(parse_can_log_line(line, length - 1, parsed));
+  EXPECT_EQ(parsed.frame.ID, 0x18DAF110);
+  EXPECT_TRUE(parsed.frame.ext_ID);
+  EXPECT_EQ(parsed.frame.DLC, 8);
+  EXPECT_EQ(parsed.frame.data.u8[7], 8);
+  EXPECT_EQ(parsed.interface, CAN_ADDON_MCP2515);
+  EXPECT_EQ(parsed.direction, MSG_TX);
+  EXPECT_EQ(parsed.timestamp_us, 1234567890);
+}
+
+TEST_F(CanLogFormatTest, ParsesLogLines) {
+  CanLogRecord record;
+  const std::string short_time = "(1.5) RX0 7E8 [2] 0a FF\r";
+  ASSERT_TRUE(parse_can_log_line(short_time.data(), short_time.size(), record));
+  EXPECT_EQ(record.timestamp_us, 1500000);
+  EXPECT_EQ(record.frame.ID, 0x7E8);
+  EXPECT_FALSE(record.frame.ext_ID);
+  EXPECT_EQ(record.frame.data.u8[0], 0x0A);
+  EXPECT_EQ(record.frame.data.u8[1], 0xFF);
+
+  for (const std::string bad : {"", "garbage", "(1.0) RX0 100 [2] 01", "(1.0) RX0 [1] 01", "(1.0) XX0 100 [0]"}) {
+    EXPECT_FALSE(parse_can_log_line(bad.data(), bad.size(), record)) << bad;
+  }
+}
+
+TEST_F(CanLogFormatTest, ImportsTextInPieces) {
+  const std::string text =
+      "(1.000000) RX0 100 [1] 01\n\nnot a frame\n(1.000100) TX1 200 [2] 02 03\r\n(1.0002) RX4 300 [0]";
+  std::vector<CanLogRecord> records;
+  CanLogTextImporter importer;
+
+  // Split lines at every possible place
+  for (size_t i = 0; i < text.size(); i += 3) {
+    importer.feed(text.data() + i, std::min<size_t>(3, text.size() - i),
+                  [&](const CanLogRecord& record) { records.push_back(record); });
+  }
+  importer.finish([&](const CanLogRecord& record) { records.push_back(record); });
+
+  ASSERT_EQ(records.size(), 3);
+  EXPECT_EQ(records[0].frame.ID, 0x100);
+  EXPECT_EQ(records[1].frame.ID, 0x200);
+  EXPECT_EQ(records[1].direction, MSG_TX);
+  EXPECT_EQ(records[2].frame.ID, 0x300);
+  EXPECT_EQ(records[2].interface, CAN_ADDON_MCP2515);
+  EXPECT_EQ(records[2].timestamp_us, 1000200);
+  EXPECT_EQ(importer.skipped_lines(), 1);
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include "../Software/src/communication/can/can_log_ring.h"
+#include "utils/utils.h"
+
+// Tagged with its ID, to tell the records apart
+static CAN_frame tagged_frame(uint32_t id, uint8_t dlc = 8) {
+  CAN_frame frame = frame_with_id(id, dlc);
+  frame.data.u8[0] = (uint8_t)id;
+  return frame;
+}
+
+template <size_t SIZE>
+static std::vector<CanLogRecord> decode(const CanLogRing<SIZE>& ring) {
+  std::vector<uint8_t> records;
+  int64_t start_us;
+  const uint32_t frames = ring.copy(records, start_us);
+
+  std::vector<CanLogRecord> decoded;
+  CanLogDecoder decoder(start_us);
+  CanLogRecord record;
+  size_t offset = 0;
+  size_t used;
+  while ((used = decoder.next(records.data() + offset, records.size() - offset, record)) > 0) {
+    decoded.push_back(record);
+    offset += used;
+  }
+  EXPECT_EQ(offset, records.size());
+  EXPECT_EQ(decoded.size(), frames);
+  return decoded;
+}
+
+TEST(CanLogRingTest, KeepsFramesInOrder) {
+  CanLogRing<1024> ring;
+  ring.push(tagged_frame(0x100), CAN_NATIVE, MSG_RX, 1000);
+  ring.push(tagged_frame(0x200), CAN_ADDON_MCP2515, MSG_TX, 1500);
+
+  auto records = decode(ring);
+  ASSERT_EQ(records.size(), 2);
+  EXPECT_EQ(records[0].frame.ID, 0x100);
+  EXPECT_EQ(records[0].timestamp_us, 1000);
+  EXPECT_EQ(records[1].frame.ID, 0x200);
+  EXPECT_EQ(records[1].interface, CAN_ADDON_MCP2515);
+  EXPECT_EQ(records[1].direction, MSG_TX);
+  EXPECT_EQ(records[1].timestamp_us, 1500);
+}
+
+TEST(CanLogRingTest, DropsOldestFramesWhenFull) {
+  CanLogRing<256> ring;
+  // 16 bytes per frame after the first, far more than fit
+  for (uint32_t i = 0; i < 100; i++) {
+    ring.push(tagged_frame(i), CAN_NATIVE, MSG_RX, 1000000 + i * 10);
+  }
+
+  auto records = decode(ring);
+  ASSERT_GT(records.size(), 10);
+  EXPECT_LE(records.size(), 256 / 16);
+  // The newest frames survive, with their original timestamps
+  for (size_t i = 0; i < records.size(); i++) {
+    const uint32_t id = 100 - records.size() + i;
+    EXPECT_EQ(records[i].frame.ID, id);
+    EXPECT_EQ(records[i].timestamp_us, 1000000 + id * 10);
+  }
+}
+
+TEST(CanLogRingTest, MixedSizesAndTimeBasesAcrossWraps) {
+  CanLogRing<512> ring;
+  int64_t timestamp_us = 0;
+  for (uint32_t i = 0; i < 500; i++) {
+    CAN_frame frame = tagged_frame(i, i % 9);
+    if (i % 7 == 0) {
+      frame.FD = true;
+      frame.DLC = 64;
+    }
+    // Every fifth gap is too long for a delta
+    timestamp_us += (i % 5 == 0) ? 100000 : 100;
+    ring.push(frame, CAN_NATIVE, MSG_RX, timestamp_us);
+
+    auto records = decode(ring);
+    ASSERT_FALSE(records.empty());
+    EXPECT_EQ(records.back().frame.ID, i);
+    EXPECT_EQ(records.back().timestamp_us, timestamp_us);
+  }
+}
+
+TEST(CanLogRingTest, Clear) {
+  CanLogRing<256> ring;
+  ring.push(tagged_frame(0x100), CAN_NATIVE, MSG_RX, 1000);
+  ring.clear();
+  EXPECT_EQ(ring.frames(), 0);
+
+  ring.push(tagged_frame(0x200), CAN_NATIVE, MSG_RX, 2000);
+  auto records = decode(ring);
+  ASSERT_EQ(records.size(), 1);
+  EXPECT_EQ(records[0].timestamp_us, 2000);
+}
+
+TEST(CanLogRingTest, TextReaderFillsChunks) {
+  CanLogRing<1024> ring;
+  ring.push(tagged_frame(0x1DB, 3), CAN_NATIVE, MSG_RX, 12000045);
+  ring.push(tagged_frame(0x1DC, 0), CAN_NATIVE, MSG_TX, 12000100);
+
+  std::vector<uint8_t> records;
+  int64_t start_us;
+  ring.copy(records, start_us);
+  CanLogTextReader reader(std::move(records), start_us);
+
+  // Lines continue across reads of any size
+  std::string text;
+  char chunk[7];
+  size_t length;
+  while ((length = reader.read(chunk, sizeof(chunk))) > 0) {
+    text.append(chunk, length);
+  }
+  EXPECT_EQ(text, "(12.000045) RX0 1DB [3] DB 00 00\n(12.000100) TX1 1DC [0] \n");
+}
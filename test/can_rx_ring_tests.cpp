@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include "../Software/src/communication/can/can_rx_ring.h"
+#include "utils/utils.h"
+
+TEST(CanRxRingTest, FramesComeOutInOrderWithTimestamps) {
+  CanRxRing<4> ring;
+  CAN_rx_frame entry;
+
+  EXPECT_FALSE(ring.pop(entry));
+  EXPECT_TRUE(ring.push(frame_with_id(0x100), 1000));
+  EXPECT_TRUE(ring.push(frame_with_id(0x200), 2000));
+  EXPECT_EQ(ring.count(), 2);
+
+  ASSERT_TRUE(ring.pop(entry));
+  EXPECT_EQ(entry.frame.ID, 0x100);
+  EXPECT_EQ(entry.timestamp_us, 1000);
+  ASSERT_TRUE(ring.pop(entry));
+  EXPECT_EQ(entry.frame.ID, 0x200);
+  EXPECT_EQ(entry.timestamp_us, 2000);
+  EXPECT_FALSE(ring.pop(entry));
+  EXPECT_EQ(ring.count(), 0);
+}
+
+TEST(CanRxRingTest, FullRingDropsNewFrames) {
+  CanRxRing<4> ring;
+  CAN_rx_frame entry;
+
+  for (uint32_t id = 1; id <= 4; id++) {
+    EXPECT_TRUE(ring.push(frame_with_id(id), id));
+  }
+  EXPECT_FALSE(ring.push(frame_with_id(5), 5));
+  EXPECT_EQ(ring.dropped(), 1);
+  EXPECT_EQ(ring.count(), 4);
+
+  // The oldest frames are kept
+  ASSERT_TRUE(ring.pop(entry));
+  EXPECT_EQ(entry.frame.ID, 1);
+}
+
+TEST(CanRxRingTest, WrapsAround) {
+  CanRxRing<4> ring;
+  CAN_rx_frame entry;
+
+  for (uint32_t id = 0; id < 100; id++) {
+    ASSERT_TRUE(ring.push(frame_with_id(id), id));
+    ASSERT_TRUE(ring.pop(entry));
+    EXPECT_EQ(entry.frame.ID, id);
+  }
+  EXPECT_EQ(ring.dropped(), 0);
+}
+
+TEST(CanRxRingTest, ProducerAndConsumerOnSeparateThreads) {
+  static CanRxRing<64> ring;
+  const uint32_t frames = 100000;
+
+  std::thread producer([&]() {
+    for (uint32_t id = 0; id < frames; id++) {
+      while (!ring.push(frame_with_id(id & 0x7FF), id)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  CAN_rx_frame entry;
+  for (uint32_t expected = 0; expected < frames;) {
+    if (ring.pop(entry)) {
+      ASSERT_EQ(entry.timestamp_us, expected);
+      ASSERT_EQ(entry.frame.ID, expected & 0x7FF);
+      expected++;
+    }
+  }
+  producer.join();
+  EXPECT_EQ(ring.count(), 0);
+}
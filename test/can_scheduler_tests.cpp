@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include "../Software/src/communication/can/can_scheduler.h"
+#include "utils/utils.h"
+
+struct SentFrame {
+  unsigned long millis;
+  uint32_t id;
+  CAN_Interface interface;
+};
+
+static std::vector<SentFrame> sent;
+static unsigned long now = 0;
+
+static bool record_frame(const CAN_frame* frame, CAN_Interface interface, CAN_TX_Priority priority) {
+  sent.push_back({now, frame->ID, interface});
+  return true;
+}
+
+class CanSchedulerTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    sent.clear();
+    now = 1000;
+  }
+
+  void run_until(CanScheduler& scheduler, unsigned long end) {
+    for (; now < end; now++) {
+      scheduler.transmit(now, record_frame);
+    }
+  }
+};
+
+TEST_F(CanSchedulerTest, FramesOfSamePeriodGetDifferentPhases) {
+  CanScheduler scheduler;
+  CAN_frame frames[5] = {frame_with_id(1), frame_with_id(2), frame_with_id(3), frame_with_id(4), frame_with_id(5)};
+
+  for (auto& frame : frames) {
+    scheduler.add(&frame, CAN_NATIVE, 10, CAN_TX_SAFETY);
+  }
+
+  for (uint16_t slot = 0; slot < CanScheduler::WHEEL_MS; slot++) {
+    EXPECT_LE(scheduler.load_at(CAN_NATIVE, slot), 1);
+  }
+}
+
+TEST_F(CanSchedulerTest, InterfacesArePlannedSeparately) {
+  CanScheduler scheduler;
+  CAN_frame battery = frame_with_id(0x100);
+  CAN_frame inverter = frame_with_id(0x351);
+
+  EXPECT_EQ(scheduler.add(&battery, CAN_NATIVE, 100, CAN_TX_SAFETY), 0);
+  EXPECT_EQ(scheduler.add(&inverter, CAN_ADDON_MCP2515, 100, CAN_TX_INVERTER), 0);
+}
+
+TEST_F(CanSchedulerTest, LoadStaysFlatWithMixedPeriods) {
+  CanScheduler scheduler;
+  std::vector<CAN_frame> frames;
+  const uint16_t periods[] = {10, 10, 10, 20, 50, 50, 100, 100, 100, 100, 1000, 1000};
+  frames.reserve(sizeof(periods) / sizeof(periods[0]));
+
+  for (uint16_t period : periods) {
+    frames.push_back(frame_with_id(frames.size()));
+    scheduler.add(&frames.back(), CAN_NATIVE, period, CAN_TX_SAFETY);
+  }
+
+  // Naively all frames would be sent together on every 1000th millisecond
+  for (uint16_t slot = 0; slot < CanScheduler::WHEEL_MS; slot++) {
+    EXPECT_LE(scheduler.load_at(CAN_NATIVE, slot), 1) << "slot " << slot;
+  }
+}
+
+TEST_F(CanSchedulerTest, SendsAtPeriod) {
+  CanScheduler scheduler;
+  CAN_frame first = frame_with_id(1);
+  CAN_frame second = frame_with_id(2);
+  scheduler.add(&first, CAN_NATIVE, 10, CAN_TX_SAFETY);
+  uint16_t phase = scheduler.add(&second, CAN_NATIVE, 10, CAN_TX_SAFETY);
+  EXPECT_NE(phase, 0);
+
+  run_until(scheduler, 1100);
+
+  int count_first = 0;
+  int count_second = 0;
+  for (const auto& frame : sent) {
+    if (frame.id == 1) {
+      EXPECT_EQ((frame.millis - 1000) % 10, 0);
+      count_first++;
+    } else {
+      EXPECT_EQ((frame.millis - 1000) % 10, phase);
+      count_second++;
+    }
+  }
+  EXPECT_EQ(count_first, 10);
+  EXPECT_EQ(count_second, 10);
+}
+
+TEST_F(CanSchedulerTest, BeforeSendCanUpdateOrSkip) {
+  CanScheduler scheduler;
+  CAN_frame frame = frame_with_id(0x400);
+  int calls = 0;
+
+  scheduler.add(&frame, CAN_NATIVE, 100, CAN_TX_SAFETY, [&]() {
+    frame.data.u8[0] = ++calls;
+    return calls % 2 == 1;
+  });
+
+  run_until(scheduler, 1400);
+
+  EXPECT_EQ(calls, 4);
+  EXPECT_EQ(sent.size(), 2);
+  EXPECT_EQ(frame.data.u8[0], 4);
+}
+
+TEST_F(CanSchedulerTest, StalledLoopDoesNotBurst) {
+  CanScheduler scheduler;
+  CAN_frame frame = frame_with_id(1);
+  scheduler.add(&frame, CAN_NATIVE, 10, CAN_TX_SAFETY);
+
+  scheduler.transmit(now, record_frame);
+  now += 55;
+  scheduler.transmit(now, record_frame);
+  scheduler.transmit(now, record_frame);
+
+  EXPECT_EQ(sent.size(), 2);
+}
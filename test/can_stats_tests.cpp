@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include "../Software/src/communication/can/can_stats.h"
+#include "utils/utils.h"
+
+static const CanTrafficStats::Entry* find_entry(const CanTrafficStats& stats, uint32_t id, CAN_Interface interface,
+                                                frameDirection direction) {
+  for (uint16_t i = 0; i < CanTrafficStats::TABLE_SIZE; i++) {
+    const CanTrafficStats::Entry& entry = stats.entry(i);
+    if (entry.used && entry.id == id && entry.interface == interface && entry.direction == direction) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+class CanTrafficStatsTest : public testing::Test {
+ protected:
+  CanTrafficStats stats;
+};
+
+TEST_F(CanTrafficStatsTest, TracksCountAndInterArrivalTimes) {
+  stats.record(frame_with_id(0x1DB), CAN_NATIVE, MSG_RX, 1000000);
+  stats.record(frame_with_id(0x1DB), CAN_NATIVE, MSG_RX, 1010000);
+  stats.record(frame_with_id(0x1DB), CAN_NATIVE, MSG_RX, 1030000);
+
+  const CanTrafficStats::Entry* entry = find_entry(stats, 0x1DB, CAN_NATIVE, MSG_RX);
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(entry->count, 3);
+  EXPECT_EQ(entry->min_gap_us, 10000);
+  EXPECT_EQ(entry->max_gap_us, 20000);
+  EXPECT_EQ(entry->mean_gap_us(), 15000);
+  EXPECT_EQ(entry->last_us, 1030000);
+}
+
+TEST_F(CanTrafficStatsTest, KeepsInterfacesAndDirectionsApart) {
+  stats.record(frame_with_id(0x100), CAN_NATIVE, MSG_RX, 1000);
+  stats.record(frame_with_id(0x100), CAN_NATIVE, MSG_TX, 1000);
+  stats.record(frame_with_id(0x100), CAN_ADDON_MCP2515, MSG_RX, 1000);
+
+  EXPECT_EQ(stats.size(), 3);
+  EXPECT_NE(find_entry(stats, 0x100, CAN_NATIVE, MSG_RX), nullptr);
+  EXPECT_NE(find_entry(stats, 0x100, CAN_NATIVE, MSG_TX), nullptr);
+  EXPECT_NE(find_entry(stats, 0x100, CAN_ADDON_MCP2515, MSG_RX), nullptr);
+}
+
+TEST_F(CanTrafficStatsTest, RateAndBusLoadPerWindow) {
+  stats.set_bit_rate(CAN_NATIVE, 500000);
+  stats.update(1);
+
+  // 100 frames of 8 bytes in one second, 135 bits each with worst-case stuffing
+  for (int i = 0; i < 100; i++) {
+    stats.record(frame_with_id(0x200), CAN_NATIVE, MSG_RX, 1 + i * 10000);
+  }
+  stats.update(1 + CanTrafficStats::WINDOW_US);
+
+  EXPECT_EQ(find_entry(stats, 0x200, CAN_NATIVE, MSG_RX)->rate_hz, 100);
+  EXPECT_EQ(stats.bus_load_percent(CAN_NATIVE), 100 * 135 * 100 / 500000);
+
+  // Nothing in the next window
+  stats.update(1 + 2 * CanTrafficStats::WINDOW_US);
+  EXPECT_EQ(find_entry(stats, 0x200, CAN_NATIVE, MSG_RX)->rate_hz, 0);
+  EXPECT_EQ(stats.bus_load_percent(CAN_NATIVE), 0);
+}
+
+TEST_F(CanTrafficStatsTest, FrameBits) {
+  EXPECT_EQ(CanTrafficStats::frame_bits(frame_with_id(0x100, 8)), 135);
+  EXPECT_EQ(CanTrafficStats::frame_bits(frame_with_id(0x100, 0)), 55);
+  EXPECT_EQ(CanTrafficStats::frame_bits(frame_with_id(0x18DAF110, 8)), 160);
+
+  CAN_frame fd = frame_with_id(0x100, 64);
+  fd.FD = true;
+  // The data phase at four times the bit rate makes a 64 byte FD frame cheaper than eight classic ones
+  EXPECT_LT(CanTrafficStats::frame_bits(fd), 8 * 135);
+}
+
+TEST_F(CanTrafficStatsTest, FullTableCountsUntrackedFrames) {
+  for (uint32_t id = 0; id < CanTrafficStats::TABLE_SIZE + 10; id++) {
+    stats.record(frame_with_id(id), CAN_NATIVE, MSG_RX, 1000);
+  }
+
+  EXPECT_EQ(stats.size(), CanTrafficStats::TABLE_SIZE);
+  EXPECT_EQ(stats.untracked_frames(), 10);
+  // Already tracked IDs are still found
+  stats.record(frame_with_id(5), CAN_NATIVE, MSG_RX, 2000);
+  EXPECT_EQ(find_entry(stats, 5, CAN_NATIVE, MSG_RX)->count, 2);
+
+  stats.clear();
+  EXPECT_EQ(stats.size(), 0);
+  EXPECT_EQ(stats.untracked_frames(), 0);
+}
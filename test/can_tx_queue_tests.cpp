@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include "../Software/src/communication/can/can_tx_queue.h"
+#include "utils/utils.h"
+
+TEST(CanTxQueueTest, HigherPriorityGoesFirst) {
+  CanTxQueue<4> queue;
+
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(queue.front(), nullptr);
+
+  EXPECT_TRUE(queue.push(frame_with_id(0x7E0), CAN_TX_DIAGNOSTIC, 1));
+  EXPECT_TRUE(queue.push(frame_with_id(0x351), CAN_TX_INVERTER, 2));
+  EXPECT_TRUE(queue.push(frame_with_id(0x118), CAN_TX_SAFETY, 3));
+  EXPECT_TRUE(queue.push(frame_with_id(0x221), CAN_TX_SAFETY, 4));
+
+  const uint32_t expected[] = {0x118, 0x221, 0x351, 0x7E0};
+  for (uint32_t id : expected) {
+    ASSERT_NE(queue.front(), nullptr);
+    EXPECT_EQ(queue.front()->frame.ID, id);
+    queue.pop();
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(CanTxQueueTest, KeepsQueueTimeAndPriority) {
+  CanTxQueue<4> queue;
+
+  queue.push(frame_with_id(0x351), CAN_TX_INVERTER, 12345);
+
+  EXPECT_EQ(queue.front()->queued_us, 12345);
+  EXPECT_EQ(queue.front()->priority, CAN_TX_INVERTER);
+}
+
+TEST(CanTxQueueTest, FullClassRejectsWithoutAffectingOthers) {
+  CanTxQueue<2> queue;
+
+  EXPECT_TRUE(queue.push(frame_with_id(1), CAN_TX_DIAGNOSTIC, 0));
+  EXPECT_TRUE(queue.push(frame_with_id(2), CAN_TX_DIAGNOSTIC, 0));
+  EXPECT_FALSE(queue.push(frame_with_id(3), CAN_TX_DIAGNOSTIC, 0));
+  EXPECT_EQ(queue.count(CAN_TX_DIAGNOSTIC), 2);
+
+  // Polling filling its queue leaves room for safety frames
+  EXPECT_TRUE(queue.push(frame_with_id(4), CAN_TX_SAFETY, 0));
+  EXPECT_EQ(queue.front()->frame.ID, 4);
+}
+
+TEST(CanTxQueueTest, WrapsAround) {
+  CanTxQueue<3> queue;
+
+  for (uint32_t id = 0; id < 20; id++) {
+    ASSERT_TRUE(queue.push(frame_with_id(id), CAN_TX_SAFETY, id));
+    ASSERT_EQ(queue.front()->frame.ID, id);
+    queue.pop();
+  }
+  EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+
+#include "../Software/src/battery/Battery.h"
+#include "../Software/src/datalayer/datalayer_extended.h"
+
+TEST(DataLayerExtendedTest, SelectConstructsDefaults) {
+  DataLayerExtended extended;
+
+  extended.select(BatteryType::VolvoSpa);
+  extended.VolvoPolestar.soc_bms = 500;
+  extended.VolvoPolestar.BECMsupplyVoltage = 11000;
+  extended.select(BatteryType::TeslaModel3Y);
+  extended.tesla.BMS_info_bootGitHash = UINT64_MAX;
+  extended.tesla.PCS_info_bootGitHash = UINT64_MAX;
+
+  // Storage is shared, the values of the previous battery types must not show through
+  extended.select(BatteryType::VolvoSpa);
+  EXPECT_EQ(extended.VolvoPolestar.BECMsupplyVoltage, 12000);
+  EXPECT_EQ(extended.VolvoPolestar.soc_bms, 0);
+
+  extended.select(BatteryType::KiaHyundai64);
+  extended.KiaHyundai64[1].total_cell_count = 96;
+  extended.select(BatteryType::TeslaModel3Y);
+  extended.select(BatteryType::KiaHyundai64);
+  EXPECT_EQ(extended.KiaHyundai64[1].total_cell_count, 0);
+}
+
+TEST(DataLayerExtendedTest, SharedStorageFitsEveryBatteryType) {
+  size_t largest = 0;
+  for (int i = 0; i < (int)BatteryType::Highest; i++) {
+    largest = std::max(largest, DataLayerExtended::size_for((BatteryType)i));
+  }
+  EXPECT_EQ(sizeof(DataLayerExtended), largest);
+  EXPECT_LT(sizeof(DataLayerExtended), DataLayerExtended::unshared_size());
+  EXPECT_EQ(DataLayerExtended::size_for(BatteryType::Pylon), 0);
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include "../Software/src/datalayer/datalayer_snapshot.h"
+
+TEST(DataLayerSnapshotTest, NothingBeforeFirstPublish) {
+  DataLayerSnapshot snapshot;
+  DATALAYER_SYSTEM_STATUS_TYPE system;
+
+  EXPECT_EQ(snapshot.read_battery(0), nullptr);
+  EXPECT_FALSE(snapshot.read_system(system));
+}
+
+TEST(DataLayerSnapshotTest, ReadsWhatWasPublished) {
+  DataLayerSnapshot snapshot;
+  datalayer.battery.info.number_of_cells = 96;
+  datalayer.battery.status.voltage_dV = 3700;
+  datalayer.battery.status.cell_voltages_mV[95] = 3850;
+  datalayer.system.status.contactors_engaged = 1;
+
+  snapshot.publish(1);
+
+  // Later changes only show after the next publish
+  datalayer.battery.status.voltage_dV = 3800;
+
+  auto battery = snapshot.read_battery(0);
+  ASSERT_NE(battery, nullptr);
+  EXPECT_EQ(battery->info.number_of_cells, 96);
+  EXPECT_EQ(battery->status.voltage_dV, 3700);
+  EXPECT_EQ(battery->status.cell_voltages_mV[95], 3850);
+
+  DATALAYER_SYSTEM_STATUS_TYPE system;
+  ASSERT_TRUE(snapshot.read_system(system));
+  EXPECT_EQ(system.contactors_engaged, 1);
+}
+
+TEST(DataLayerSnapshotTest, OnlyPublishedBatteriesAreAvailable) {
+  DataLayerSnapshot snapshot;
+  datalayer.battery2.status.voltage_dV = 3650;
+
+  snapshot.publish(1);
+  EXPECT_NE(snapshot.read_battery(0), nullptr);
+  EXPECT_EQ(snapshot.read_battery(1), nullptr);
+  EXPECT_EQ(snapshot.read_battery(3), nullptr);
+
+  snapshot.publish(2);
+  auto battery2 = snapshot.read_battery(1);
+  ASSERT_NE(battery2, nullptr);
+  EXPECT_EQ(battery2->status.voltage_dV, 3650);
+  EXPECT_EQ(snapshot.read_battery(2), nullptr);
+}
+
+TEST(DataLayerSnapshotTest, GenerationsCountChangedGroups) {
+  DataLayerSnapshot snapshot;
+  datalayer.battery.status.voltage_dV = 3700;
+  snapshot.publish(1);
+  auto before = snapshot.read_battery(0);
+
+  snapshot.publish(1);
+  auto unchanged = snapshot.read_battery(0);
+  for (int group = 0; group < SNAPSHOT_GROUP_COUNT; group++) {
+    EXPECT_EQ(unchanged->generation[group], before->generation[group]);
+  }
+
+  datalayer.battery.status.cell_voltages_mV[10]++;
+  snapshot.publish(1);
+  auto cells_changed = snapshot.read_battery(0);
+  EXPECT_EQ(cells_changed->generation[SNAPSHOT_VALUES], before->generation[SNAPSHOT_VALUES]);
+  EXPECT_EQ(cells_changed->generation[SNAPSHOT_CELL_VOLTAGES], before->generation[SNAPSHOT_CELL_VOLTAGES] + 1);
+  EXPECT_EQ(cells_changed->generation[SNAPSHOT_CELL_BALANCING], before->generation[SNAPSHOT_CELL_BALANCING]);
+
+  datalayer.battery.status.voltage_dV = 3710;
+  datalayer.battery.status.cell_balancing_status[3] = !datalayer.battery.status.cell_balancing_status[3];
+  snapshot.publish(1);
+  auto values_changed = snapshot.read_battery(0);
+  EXPECT_EQ(values_changed->generation[SNAPSHOT_VALUES], before->generation[SNAPSHOT_VALUES] + 1);
+  EXPECT_EQ(values_changed->generation[SNAPSHOT_CELL_VOLTAGES], before->generation[SNAPSHOT_CELL_VOLTAGES] + 1);
+  EXPECT_EQ(values_changed->generation[SNAPSHOT_CELL_BALANCING], before->generation[SNAPSHOT_CELL_BALANCING] + 1);
+}
+
+TEST(DataLayerSnapshotTest, ReaderOnOtherThreadNeverSeesHalfAnUpdate) {
+  DataLayerSnapshot snapshot;
+  const uint16_t updates = 2000;
+  datalayer.battery.info.number_of_cells = 96;
+  for (auto& cell : datalayer.battery.status.cell_voltages_mV) {
+    cell = 0;
+  }
+  datalayer.battery.status.voltage_dV = 0;
+  snapshot.publish(1);
+
+  // Every update writes the same value to all cells, a mix of two updates would show as differing cells
+  std::thread writer([&]() {
+    for (uint16_t update = 1; update <= updates; update++) {
+      for (auto& cell : datalayer.battery.status.cell_voltages_mV) {
+        cell = update;
+      }
+      datalayer.battery.status.voltage_dV = update;
+      snapshot.publish(1);
+    }
+  });
+
+  uint16_t last = 0;
+  while (last < updates) {
+    auto battery = snapshot.read_battery(0);
+    ASSERT_NE(battery, nullptr);
+    const uint16_t value = battery->status.voltage_dV;
+    for (auto cell : battery->status.cell_voltages_mV) {
+      ASSERT_EQ(cell, value);
+    }
+    ASSERT_GE(value, last);
+    last = value;
+  }
+  writer.join();
+}
@@ -17,6 +17,7 @@ class Preferences {
   size_t putBool(const char* key, bool value) { return 0; }
   size_t putString(const char* key, const char* value) { return 0; }
   size_t putString(const char* key, String value) { return 0; }
+  size_t putBytes(const char* key, const void* value, size_t len) { return 0; }
 
   bool isKey(const char* key) { return false; }
 
@@ -24,5 +25,7 @@ class Preferences {
   bool getBool(const char* key, bool defaultValue = false) { return false; }
   size_t getString(const char* key, char* value, size_t maxLen) { return 0; }
   String getString(const char* key, String defaultValue = String()) { return String(); }
+  size_t getBytesLength(const char* key) { return 0; }
+  size_t getBytes(const char* key, void* buf, size_t maxLen) { return 0; }
 };
 #endif
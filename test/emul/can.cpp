@@ -1,10 +1,15 @@
 #include "../../Software/src/communication/Transmitter.h"
 #include "../../Software/src/communication/can/comm_can.h"
 
-void transmit_can_frame_to_interface(const CAN_frame* tx_frame, CAN_Interface interface) {}
+bool transmit_can_frame_to_interface(const CAN_frame* tx_frame, CAN_Interface interface, CAN_TX_Priority priority) {
+  return true;
+}
 
 void register_can_receiver(CanReceiver* receiver, CAN_Interface interface, CAN_Speed speed) {}
 
+void schedule_can_frame(CAN_frame* frame, CAN_Interface interface, uint16_t period_ms, CAN_TX_Priority priority,
+                        std::function<bool(void)> before_send) {}
+
 bool change_can_speed(CAN_Interface interface, CAN_Speed speed) {
   return true;
 }
@@ -19,4 +24,4 @@ char const* getCANInterfaceName(CAN_Interface) {
 
 void register_transmitter(Transmitter* transmitter) {}
 
-void dump_can_frame(CAN_frame& frame, CAN_Interface interface, frameDirection msgDir) {}
+void dump_can_frame(const CAN_frame& frame, CAN_Interface interface, frameDirection msgDir, int64_t timestamp_us) {}
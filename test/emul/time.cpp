@@ -14,6 +14,10 @@ uint64_t millis64(void) {
   return current_time;
 }
 
+int64_t esp_timer_get_time() {
+  return static_cast<int64_t>(current_time * 1000);
+}
+
 void set_millis64(uint64_t time) {
   current_time = time;
 }
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include "../Software/src/devboard/webserver/html_stream.h"
+
+// Reads the whole page, maxLen bytes at a time
+static std::string read_all(HtmlStream& stream, size_t maxLen) {
+  std::string page;
+  char buffer[64];
+  size_t length;
+  while ((length = stream.read(buffer, maxLen)) > 0) {
+    EXPECT_LE(length, maxLen);
+    page.append(buffer, length);
+  }
+  return page;
+}
+
+static bool example_page(HtmlStream& out, uint16_t step) {
+  switch (step) {
+    case 0:
+      out.print("<h4>Voltage: ");
+      out.print(3.7f, 2);
+      out.print(" V</h4>");
+      return true;
+    case 1:
+      // A block that is not shown
+      return true;
+    case 2:
+      out.print("<h4>Cells: ");
+      out.print(96);
+      out.print(String(", balancing"));
+      out.printf(" %d%%", 5);
+      out.print("</h4>");
+      return true;
+    default:
+      return false;
+  }
+}
+
+TEST(HtmlStreamTest, RendersAllSteps) {
+  HtmlStream stream(example_page);
+  EXPECT_EQ(read_all(stream, 64), "<h4>Voltage: 3.70 V</h4><h4>Cells: 96, balancing 5%</h4>");
+  EXPECT_FALSE(stream.overflowed());
+}
+
+TEST(HtmlStreamTest, SmallReadsGiveTheSamePage) {
+  HtmlStream stream(example_page);
+  EXPECT_EQ(read_all(stream, 3), "<h4>Voltage: 3.70 V</h4><h4>Cells: 96, balancing 5%</h4>");
+}
+
+TEST(HtmlStreamTest, ReturnsZeroOnceComplete) {
+  HtmlStream stream(example_page);
+  read_all(stream, 64);
+  char buffer[8];
+  EXPECT_EQ(stream.read(buffer, sizeof(buffer)), 0u);
+  EXPECT_EQ(stream.read(buffer, sizeof(buffer)), 0u);
+}
+
+TEST(HtmlStreamTest, EmptyPage) {
+  HtmlStream stream([](HtmlStream& out, uint16_t step) { return false; });
+  EXPECT_EQ(read_all(stream, 64), "");
+}
+
+TEST(HtmlStreamTest, ValuesAreReusedForEachStep) {
+  // More values in total than the buffer holds, but few in each step
+  HtmlStream stream([](HtmlStream& out, uint16_t step) {
+    if (step == 100) {
+      return false;
+    }
+    out.printf("%05u,", step);
+    return true;
+  });
+  const std::string page = read_all(stream, 17);
+  EXPECT_EQ(page.size(), 600u);
+  EXPECT_EQ(page.substr(0, 12), "00000,00001,");
+  EXPECT_EQ(page.substr(588), "00098,00099,");
+  EXPECT_FALSE(stream.overflowed());
+}
+
+TEST(HtmlStreamTest, AdjacentValuesShareAFragment) {
+  // Each value alone would need a fragment of its own, beyond what a step can hold
+  HtmlStream stream([](HtmlStream& out, uint16_t step) {
+    if (step > 0) {
+      return false;
+    }
+    for (int i = 0; i < HtmlStream::MAX_FRAGMENTS * 2; i++) {
+      out.print(i % 10);
+    }
+    return true;
+  });
+  EXPECT_EQ(read_all(stream, 64).size(), HtmlStream::MAX_FRAGMENTS * 2u);
+  EXPECT_FALSE(stream.overflowed());
+}
+
+TEST(HtmlStreamTest, TooManyFragmentsOverflow) {
+  HtmlStream stream([](HtmlStream& out, uint16_t step) {
+    if (step > 0) {
+      return false;
+    }
+    for (int i = 0; i < HtmlStream::MAX_FRAGMENTS + 1; i++) {
+      out.print("x");
+    }
+    return true;
+  });
+  EXPECT_EQ(read_all(stream, 64).size(), HtmlStream::MAX_FRAGMENTS);
+  EXPECT_TRUE(stream.overflowed());
+}
+
+TEST(HtmlStreamTest, TooLargeValueIsCut) {
+  HtmlStream stream([](HtmlStream& out, uint16_t step) {
+    if (step > 0) {
+      return false;
+    }
+    const String value(std::string(HtmlStream::VALUE_BUFFER_SIZE + 10, 'v').c_str());
+    out.print(value);
+    return true;
+  });
+  EXPECT_EQ(read_all(stream, 64).size(), HtmlStream::VALUE_BUFFER_SIZE);
+  EXPECT_TRUE(stream.overflowed());
+}
+
+TEST(HtmlStreamTest, LargeTemporaryIsHeldForTheStep) {
+  HtmlStream stream([](HtmlStream& out, uint16_t step) {
+    if (step > 1) {
+      return false;
+    }
+    out.print("<div>");
+    out.print(String(std::string(1000, 'a' + step).c_str()));
+    out.print("</div>");
+    return true;
+  });
+  const std::string page = read_all(stream, 50);
+  EXPECT_EQ(page, "<div>" + std::string(1000, 'a') + "</div><div>" + std::string(1000, 'b') + "</div>");
+  EXPECT_FALSE(stream.overflowed());
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include "../Software/src/communication/can/isotp.h"
+
+static CAN_frame frame_with_data(uint32_t id, std::initializer_list<uint8_t> data) {
+  CAN_frame frame = {.FD = false, .ext_ID = false, .DLC = 8, .ID = id};
+  uint8_t i = 0;
+  for (uint8_t byte : data) {
+    frame.data.u8[i++] = byte;
+  }
+  return frame;
+}
+
+class IsoTpSessionTest : public testing::Test {
+ protected:
+  IsoTpSessionTest()
+      : session(0x79B, 0x7BB, buffer, sizeof(buffer), [this](const CAN_frame& frame) { sent.push_back(frame); }) {
+    session.on_response([this](const uint8_t* data, size_t length) { response.assign(data, data + length); });
+  }
+
+  uint8_t buffer[64];
+  std::vector<CAN_frame> sent;
+  std::vector<uint8_t> response;
+  IsoTpSession session;
+};
+
+TEST_F(IsoTpSessionTest, SingleFrameRequestAndResponse) {
+  const uint8_t request[] = {0x22, 0xF1, 0x90};
+  ASSERT_TRUE(session.request(request, sizeof(request), 0));
+  ASSERT_EQ(sent.size(), 1);
+  EXPECT_EQ(sent[0].ID, 0x79B);
+  EXPECT_EQ(sent[0].DLC, 8);
+  EXPECT_EQ(sent[0].data.u8[0], 0x03);
+  EXPECT_EQ(sent[0].data.u8[1], 0x22);
+  EXPECT_TRUE(session.busy());
+
+  // Frames of other IDs are not ours
+  EXPECT_FALSE(session.handle_frame(frame_with_data(0x7BC, {0x02, 0x62, 0x01}), 5));
+  EXPECT_TRUE(session.handle_frame(frame_with_data(0x7BB, {0x04, 0x62, 0xF1, 0x90, 0x42}), 5));
+  EXPECT_FALSE(session.busy());
+  EXPECT_EQ(response, std::vector<uint8_t>({0x62, 0xF1, 0x90, 0x42}));
+  EXPECT_EQ(session.responses(), 1);
+}
+
+TEST_F(IsoTpSessionTest, MultiFrameResponseInOneBurst) {
+  const uint8_t request[] = {0x21, 0x02};
+  session.request(request, sizeof(request), 0);
+
+  // 19 bytes: first frame with 6, then 7 and 6
+  session.handle_frame(frame_with_data(0x7BB, {0x10, 19, 0x61, 0x02, 1, 2, 3, 4}), 10);
+  ASSERT_EQ(sent.size(), 2);
+  // Block size 0: a single flow control for the whole response
+  EXPECT_EQ(sent[1].data.u8[0], 0x30);
+  EXPECT_EQ(sent[1].data.u8[1], 0);
+  EXPECT_EQ(sent[1].data.u8[2], 0);
+
+  session.handle_frame(frame_with_data(0x7BB, {0x21, 5, 6, 7, 8, 9, 10, 11}), 11);
+  EXPECT_TRUE(response.empty());
+  session.handle_frame(frame_with_data(0x7BB, {0x22, 12, 13, 14, 15, 16, 17, 0xFF}), 12);
+
+  EXPECT_EQ(sent.size(), 2);
+  ASSERT_EQ(response.size(), 19);
+  EXPECT_EQ(response[0], 0x61);
+  EXPECT_EQ(response[18], 17);
+}
+
+TEST_F(IsoTpSessionTest, FlowControlPerBlock) {
+  session.set_flow_control(2, 5);
+  const uint8_t request[] = {0x21, 0x02};
+  session.request(request, sizeof(request), 0);
+
+  session.handle_frame(frame_with_data(0x7BB, {0x10, 30, 0x61, 0x02, 1, 2, 3, 4}), 10);
+  EXPECT_EQ(sent.size(), 2);
+  EXPECT_EQ(sent[1].data.u8[1], 2);
+  EXPECT_EQ(sent[1].data.u8[2], 5);
+
+  session.handle_frame(frame_with_data(0x7BB, {0x21}), 11);
+  EXPECT_EQ(sent.size(), 2);
+  session.handle_frame(frame_with_data(0x7BB, {0x22}), 12);
+  EXPECT_EQ(sent.size(), 3);  // Next block please
+  session.handle_frame(frame_with_data(0x7BB, {0x23}), 13);
+  session.handle_frame(frame_with_data(0x7BB, {0x24}), 14);
+  EXPECT_EQ(response.size(), 30);
+}
+
+TEST_F(IsoTpSessionTest, SegmentedRequestFollowsEcuFlowControl) {
+  uint8_t request[27];
+  for (uint8_t i = 0; i < sizeof(request); i++) {
+    request[i] = i;
+  }
+  session.request(request, sizeof(request), 0);
+  ASSERT_EQ(sent.size(), 1);
+  EXPECT_EQ(sent[0].data.u8[0], 0x10);
+  EXPECT_EQ(sent[0].data.u8[1], 27);
+
+  // Nothing more until the ECU sends flow control: one frame per block, 2 ms apart
+  session.update(5);
+  EXPECT_EQ(sent.size(), 1);
+  session.handle_frame(frame_with_data(0x7BB, {0x30, 1, 2}), 10);
+  EXPECT_EQ(sent.size(), 2);
+  EXPECT_EQ(sent[1].data.u8[0], 0x21);
+  EXPECT_EQ(sent[1].data.u8[1], 6);
+
+  session.handle_frame(frame_with_data(0x7BB, {0x30, 0, 2}), 20);
+  EXPECT_EQ(sent.size(), 3);
+  session.update(21);
+  EXPECT_EQ(sent.size(), 3);
+  session.update(22);
+  ASSERT_EQ(sent.size(), 4);
+  EXPECT_EQ(sent[3].data.u8[0], 0x23);
+  EXPECT_EQ(sent[3].data.u8[1], 20);
+
+  // Request complete, now waiting for the response
+  session.handle_frame(frame_with_data(0x7BB, {0x02, 0x7E, 0x00}), 30);
+  EXPECT_EQ(response, std::vector<uint8_t>({0x7E, 0x00}));
+}
+
+TEST_F(IsoTpSessionTest, TimeoutsAndErrors) {
+  const uint8_t request[] = {0x21, 0x01};
+  session.request(request, sizeof(request), 0);
+  EXPECT_FALSE(session.request(request, sizeof(request), 1));  // Still busy
+  session.update(IsoTpSession::DEFAULT_TIMEOUT_MS);
+  EXPECT_FALSE(session.busy());
+  EXPECT_EQ(session.timeouts(), 1);
+
+  // Lost consecutive frame
+  session.request(request, sizeof(request), 2000);
+  session.handle_frame(frame_with_data(0x7BB, {0x10, 20, 0x61, 0x01, 1, 2, 3, 4}), 2001);
+  session.handle_frame(frame_with_data(0x7BB, {0x22}), 2002);
+  EXPECT_FALSE(session.busy());
+  EXPECT_EQ(session.errors(), 1);
+
+  // Too long for the buffer
+  session.request(request, sizeof(request), 3000);
+  session.handle_frame(frame_with_data(0x7BB, {0x10, 200, 0x61, 0x01, 1, 2, 3, 4}), 3001);
+  EXPECT_EQ(sent.back().data.u8[0], 0x32);
+  EXPECT_EQ(session.errors(), 2);
+  EXPECT_TRUE(response.empty());
+}
+
+TEST_F(IsoTpSessionTest, ResponsePendingExtendsTimeout) {
+  const uint8_t request[] = {0x31, 0x01};
+  session.request(request, sizeof(request), 0);
+  session.handle_frame(frame_with_data(0x7BB, {0x03, 0x7F, 0x31, 0x78}), 900);
+  session.update(1500);
+  EXPECT_TRUE(session.busy());
+  EXPECT_TRUE(response.empty());
+  session.handle_frame(frame_with_data(0x7BB, {0x02, 0x71, 0x01}), 1600);
+  EXPECT_EQ(response, std::vector<uint8_t>({0x71, 0x01}));
+}
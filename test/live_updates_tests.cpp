@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include "../Software/src/datalayer/datalayer_snapshot.h"
+#include "../Software/src/devboard/webserver/live_updates.h"
+
+static std::string read_all(LiveUpdateStream& stream, unsigned long currentMillis, size_t chunk = 256) {
+  std::string text;
+  char buffer[256];
+  size_t length;
+  while ((length = stream.read(buffer, chunk, currentMillis)) > 0) {
+    text.append(buffer, length);
+  }
+  return text;
+}
+
+class LiveUpdatesTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    datalayer = DataLayer();
+    datalayer.battery.info.number_of_cells = 3;
+    datalayer.battery.status.cell_voltages_mV[0] = 3700;
+    datalayer.battery.status.cell_voltages_mV[1] = 3712;
+    datalayer.battery.status.cell_voltages_mV[2] = 3705;
+    datalayer.battery.status.cell_balancing_status[1] = true;
+    datalayer.battery.status.voltage_dV = 3712;
+  }
+};
+
+TEST_F(LiveUpdatesTest, FirstMessagesCarryEverything) {
+  datalayer_snapshot.publish(1);
+  LiveUpdateStream stream;
+
+  const std::string text = read_all(stream, 1000);
+  EXPECT_EQ(text.rfind("event: status\ndata: {\"SOC\":", 0), 0u) << text;
+  EXPECT_NE(text.find("\"battery_voltage\":371.2"), std::string::npos) << text;
+  EXPECT_EQ(text.find("charged_energy"), std::string::npos) << text;
+  EXPECT_NE(text.find("}\n\nevent: cells\ndata: {\"cell_base_mV\":3700,\"cell_delta_mV\":[0,12,5]}\n\n"
+                      "event: balancing\ndata: {\"cell_balancing_mask\":\"02\"}\n\n"),
+            std::string::npos)
+      << text;
+  EXPECT_EQ(text.substr(text.size() - 2), "\n\n");
+}
+
+TEST_F(LiveUpdatesTest, OnlyChangesAfterThat) {
+  datalayer_snapshot.publish(1);
+  LiveUpdateStream stream;
+  read_all(stream, 1000);
+
+  // Nothing new until the next publish
+  EXPECT_EQ(read_all(stream, 2000), "");
+  datalayer_snapshot.publish(1);
+  EXPECT_EQ(read_all(stream, 2000), "");
+
+  datalayer.battery.status.voltage_dV = 3800;
+  datalayer_snapshot.publish(1);
+  EXPECT_EQ(read_all(stream, 3000), "event: status\ndata: {\"battery_voltage\":380}\n\n");
+
+  datalayer.battery.status.cell_balancing_status[1] = false;
+  datalayer_snapshot.publish(1);
+  EXPECT_EQ(read_all(stream, 4000),
+            "event: status\ndata: {\"balancing_active_cells\":0}\n\n"
+            "event: balancing\ndata: {\"cell_balancing_mask\":\"00\"}\n\n");
+}
+
+TEST_F(LiveUpdatesTest, OtherBatteriesHaveSuffixes) {
+  datalayer.battery2.info.number_of_cells = 2;
+  datalayer.battery2.status.cell_voltages_mV[0] = 3650;
+  datalayer.battery2.status.cell_voltages_mV[1] = 3651;
+  datalayer.battery2.status.voltage_dV = 3700;
+  datalayer_snapshot.publish(2);
+  LiveUpdateStream stream;
+
+  const std::string text = read_all(stream, 1000);
+  EXPECT_NE(text.find("event: status\ndata: {\"SOC_2\":"), std::string::npos) << text;
+  EXPECT_NE(text.find("\"battery_voltage_2\":370"), std::string::npos) << text;
+  EXPECT_NE(text.find("event: cells_2\ndata: {\"cell_base_mV\":3650,\"cell_delta_mV\":[0,1]}\n\n"),
+            std::string::npos)
+      << text;
+  EXPECT_NE(text.find("event: balancing_2\n"), std::string::npos) << text;
+}
+
+TEST_F(LiveUpdatesTest, SmallReadsGiveTheSameStream) {
+  datalayer_snapshot.publish(1);
+  LiveUpdateStream whole;
+  LiveUpdateStream pieces;
+
+  EXPECT_EQ(read_all(pieces, 1000, 7), read_all(whole, 1000));
+}
+
+TEST_F(LiveUpdatesTest, KeepaliveWhenIdle) {
+  datalayer_snapshot.publish(1);
+  LiveUpdateStream stream;
+  read_all(stream, 1000);
+
+  EXPECT_EQ(read_all(stream, 1000 + LiveUpdateStream::KEEPALIVE_INTERVAL_MS - 1), "");
+  EXPECT_EQ(read_all(stream, 1000 + LiveUpdateStream::KEEPALIVE_INTERVAL_MS), ": keepalive\n\n");
+  EXPECT_EQ(read_all(stream, 1000 + LiveUpdateStream::KEEPALIVE_INTERVAL_MS + 1), "");
+}
+
+TEST_F(LiveUpdatesTest, LargestBatteryFits) {
+  datalayer.battery.info.number_of_cells = MAX_AMOUNT_CELLS;
+  for (int i = 0; i < MAX_AMOUNT_CELLS; i++) {
+    // Up to 3 digits per delta
+    datalayer.battery.status.cell_voltages_mV[i] = 3000 + (i * 37) % 1000;
+    datalayer.battery.status.cell_balancing_status[i] = true;
+  }
+  datalayer_snapshot.publish(1);
+  LiveUpdateStream stream;
+
+  const std::string text = read_all(stream, 1000);
+  EXPECT_NE(text.find("event: cells\n"), std::string::npos);
+  EXPECT_NE(text.find("event: balancing\n"), std::string::npos);
+}
+
+TEST_F(LiveUpdatesTest, LargestBatteryFitsBeforeAllCellsAreRead) {
+  // A cell still at 0 mV makes the base 0, so every delta is a whole voltage
+  datalayer.battery.info.number_of_cells = MAX_AMOUNT_CELLS;
+  for (int i = 0; i < MAX_AMOUNT_CELLS; i++) {
+    datalayer.battery.status.cell_voltages_mV[i] = i == 0 ? 0 : 65535;
+  }
+  datalayer_snapshot.publish(1);
+  const uint32_t dropped = LiveUpdateStream::dropped_messages();
+  LiveUpdateStream stream;
+
+  const std::string text = read_all(stream, 1000);
+  EXPECT_NE(text.find("event: cells\ndata: {\"cell_base_mV\":0,\"cell_delta_mV\":[0,65535,"), std::string::npos);
+  EXPECT_EQ(LiveUpdateStream::dropped_messages(), dropped);
+}
+
+TEST_F(LiveUpdatesTest, CountsOpenStreams) {
+  const uint8_t before = LiveUpdateStream::clients();
+  {
+    LiveUpdateStream first;
+    LiveUpdateStream second;
+    EXPECT_EQ(LiveUpdateStream::clients(), before + 2);
+  }
+  EXPECT_EQ(LiveUpdateStream::clients(), before);
+}
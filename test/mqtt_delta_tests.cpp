@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include "../Software/src/devboard/mqtt/mqtt_delta.h"
+
+TEST(MqttDeltaTest, FirstCycleSendsEverything) {
+  float last[2];
+  MqttDeltaTracker delta(last, 2);
+
+  EXPECT_TRUE(delta.begin(1000));
+  EXPECT_TRUE(delta.changed(0, 12.5f, 1.0f));
+  EXPECT_TRUE(delta.changed(1, 0.0f));
+}
+
+TEST(MqttDeltaTest, OnlyChangesBeyondDeadbandAreSent) {
+  float last[2];
+  MqttDeltaTracker delta(last, 2);
+  delta.begin(0);
+  delta.changed(0, 12.5f, 0.1f);
+  delta.changed(1, 3.0f);
+
+  EXPECT_FALSE(delta.begin(5000));
+  EXPECT_FALSE(delta.changed(0, 12.55f, 0.1f));
+  EXPECT_FALSE(delta.changed(1, 3.0f));
+
+  // Small steps add up, as they are compared to the value last published
+  EXPECT_TRUE(delta.changed(0, 12.65f, 0.1f));
+  EXPECT_FALSE(delta.changed(0, 12.6f, 0.1f));
+  EXPECT_TRUE(delta.changed(1, 4.0f));
+}
+
+TEST(MqttDeltaTest, FieldsNeverSentBeforeAreSent) {
+  float last[2];
+  MqttDeltaTracker delta(last, 2);
+  delta.begin(0);
+  delta.changed(0, 1.0f);
+
+  delta.begin(5000);
+  EXPECT_TRUE(delta.changed(1, 0.0f, 10.0f));
+}
+
+TEST(MqttDeltaTest, PeriodicAndRequestedFullRefresh) {
+  float last[1];
+  MqttDeltaTracker delta(last, 1);
+  delta.begin(0);
+  delta.changed(0, 1.0f);
+
+  EXPECT_FALSE(delta.begin(MqttDeltaTracker::FULL_REFRESH_INTERVAL_MS - 1));
+  EXPECT_FALSE(delta.changed(0, 1.0f));
+
+  EXPECT_TRUE(delta.begin(MqttDeltaTracker::FULL_REFRESH_INTERVAL_MS));
+  EXPECT_TRUE(delta.refreshing());
+  EXPECT_TRUE(delta.changed(0, 1.0f));
+
+  EXPECT_FALSE(delta.begin(MqttDeltaTracker::FULL_REFRESH_INTERVAL_MS + 5000));
+  delta.invalidate();
+  EXPECT_TRUE(delta.begin(MqttDeltaTracker::FULL_REFRESH_INTERVAL_MS + 10000));
+}
+
+TEST(MqttDeltaTest, CellVoltagesChangedBeyondDeadband) {
+  uint16_t cells[4] = {3700, 3701, 3702, 3703};
+  uint16_t published[4] = {3700, 3701, 3702, 3703};
+
+  cells[2] = 3707;
+  EXPECT_FALSE(cell_voltages_changed(cells, published, 4, 5));
+  EXPECT_EQ(published[2], 3702);
+
+  cells[3] = 3697;
+  EXPECT_TRUE(cell_voltages_changed(cells, published, 4, 5));
+  EXPECT_EQ(published[2], 3707);
+  EXPECT_EQ(published[3], 3697);
+  EXPECT_FALSE(cell_voltages_changed(cells, published, 4, 5));
+}
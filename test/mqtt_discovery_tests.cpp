@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include "../Software/src/devboard/mqtt/mqtt_discovery.h"
+
+TEST(MqttDiscoveryTest, HashIsStableAndNeverZero) {
+  EXPECT_EQ(DiscoveryCache::hash("topic", "payload"), DiscoveryCache::hash("topic", "payload"));
+  EXPECT_NE(DiscoveryCache::hash("topic", "payload"), DiscoveryCache::hash("topic", "payload2"));
+  EXPECT_NE(DiscoveryCache::hash(""), 0u);
+  EXPECT_NE(DiscoveryCache::hash("topic", ""), 0u);
+}
+
+TEST(MqttDiscoveryTest, HashSeparatesTexts) {
+  EXPECT_NE(DiscoveryCache::hash("ab", "c"), DiscoveryCache::hash("a", "bc"));
+}
+
+TEST(MqttDiscoveryTest, FirstPassPublishesEverything) {
+  uint32_t hashes[3];
+  DiscoveryCache cache(hashes, 3);
+  EXPECT_FALSE(cache.pass_active());
+  EXPECT_FALSE(cache.modified());
+
+  cache.begin_pass();
+  int published = 0;
+  while (cache.pass_active()) {
+    const uint32_t hash = DiscoveryCache::hash("topic", cache.position() == 1 ? "b" : "a");
+    if (cache.changed(hash)) {
+      published++;
+    }
+    cache.advance(hash);
+  }
+  EXPECT_EQ(published, 3);
+  EXPECT_TRUE(cache.modified());
+  EXPECT_EQ(cache.size(), 3 * sizeof(uint32_t));
+}
+
+TEST(MqttDiscoveryTest, OnlyChangedEntriesAreRepublished) {
+  uint32_t hashes[3];
+  DiscoveryCache cache(hashes, 3);
+  cache.begin_pass();
+  while (cache.pass_active()) {
+    cache.advance(DiscoveryCache::hash("topic", "a"));
+  }
+  cache.saved();
+
+  // Restored from the saved hashes, as after a restart
+  uint32_t restored[3];
+  DiscoveryCache loaded(restored, 3);
+  memcpy(restored, cache.data(), cache.size());
+
+  loaded.begin_pass();
+  EXPECT_FALSE(loaded.changed(DiscoveryCache::hash("topic", "a")));
+  loaded.advance(DiscoveryCache::hash("topic", "a"));
+  EXPECT_TRUE(loaded.changed(DiscoveryCache::hash("topic", "changed")));
+  loaded.advance(DiscoveryCache::hash("topic", "changed"));
+  // No longer used, removed with an empty config
+  EXPECT_TRUE(loaded.changed(0));
+  loaded.advance(0);
+  EXPECT_FALSE(loaded.pass_active());
+  EXPECT_TRUE(loaded.modified());
+  EXPECT_EQ(restored[2], 0u);
+}
+
+TEST(MqttDiscoveryTest, UnchangedPassLeavesHashesUnmodified) {
+  uint32_t hashes[2];
+  DiscoveryCache cache(hashes, 2);
+  cache.begin_pass();
+  cache.advance(0);
+  cache.advance(0);
+  EXPECT_FALSE(cache.modified());
+}
+
+TEST(MqttDiscoveryTest, ForgetRepublishesEverything) {
+  uint32_t hashes[2];
+  DiscoveryCache cache(hashes, 2);
+  const uint32_t hash = DiscoveryCache::hash("topic", "a");
+  cache.begin_pass();
+  cache.advance(hash);
+  cache.advance(hash);
+  cache.saved();
+
+  cache.forget();
+  EXPECT_TRUE(cache.modified());
+  cache.begin_pass();
+  EXPECT_TRUE(cache.changed(hash));
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include "../Software/src/devboard/mqtt/mqtt_outbox.h"
+
+struct SentMessage {
+  std::string topic;
+  std::string payload;
+  bool retain;
+};
+
+class MqttOutboxTest : public ::testing::Test {
+ protected:
+  std::vector<SentMessage> sent;
+  bool broker_reachable = true;
+  MqttOutbox::Sender send = [this](const char* topic, const uint8_t* data, size_t length, bool retain) {
+    if (!broker_reachable) {
+      return false;
+    }
+    sent.push_back({topic, std::string((const char*)data, length), retain});
+    return true;
+  };
+
+  static bool push(MqttOutbox& outbox, const char* topic, const char* payload, bool coalesce = true,
+                   bool retain = false) {
+    return outbox.push(topic, (const uint8_t*)payload, strlen(payload), retain, coalesce);
+  }
+};
+
+TEST_F(MqttOutboxTest, MessagesAreSentInOrder) {
+  MqttOutbox outbox(256, 8);
+  push(outbox, "BE/status", "online");
+  push(outbox, "BE/info", "{\"SOC\":50}");
+  push(outbox, "homeassistant/sensor/soc/config", "{}", true, true);
+
+  EXPECT_EQ(outbox.flush(0, send), 3);
+  ASSERT_EQ(sent.size(), 3u);
+  EXPECT_EQ(sent[0].topic, "BE/status");
+  EXPECT_EQ(sent[1].payload, "{\"SOC\":50}");
+  EXPECT_TRUE(sent[2].retain);
+  EXPECT_EQ(outbox.size(), 0);
+  EXPECT_EQ(outbox.bytes(), 0u);
+}
+
+TEST_F(MqttOutboxTest, NewerStateReplacesQueuedState) {
+  MqttOutbox outbox(256, 8);
+  push(outbox, "BE/info", "{\"SOC\":50}");
+  push(outbox, "BE/events", "first", false);
+  push(outbox, "BE/events", "second", false);
+  push(outbox, "BE/info", "{\"SOC\":51}");
+
+  EXPECT_EQ(outbox.size(), 3);
+  EXPECT_EQ(outbox.coalesced(), 1u);
+  outbox.flush(0, send);
+  ASSERT_EQ(sent.size(), 3u);
+  EXPECT_EQ(sent[0].payload, "first");
+  EXPECT_EQ(sent[1].payload, "second");
+  EXPECT_EQ(sent[2].payload, "{\"SOC\":51}");
+}
+
+TEST_F(MqttOutboxTest, FullOutboxRefusesMessages) {
+  MqttOutbox outbox(32, 2);
+  EXPECT_TRUE(push(outbox, "a", "1", false));
+  EXPECT_TRUE(push(outbox, "b", "2"));
+  EXPECT_FALSE(push(outbox, "c", "3", false));
+
+  // Replacing a queued message needs no extra slot
+  EXPECT_TRUE(push(outbox, "b", "4"));
+
+  // Too large for the data left, the queued message it would replace is kept
+  EXPECT_FALSE(push(outbox, "b", "a payload longer than the outbox"));
+  outbox.flush(0, send);
+  ASSERT_EQ(sent.size(), 2u);
+  EXPECT_EQ(sent[1].payload, "4");
+}
+
+TEST_F(MqttOutboxTest, RateIsLimitedByTokenBucket) {
+  MqttOutbox outbox(1024, 32);
+  outbox.set_rate(10, 3);
+  for (int i = 0; i < 20; i++) {
+    push(outbox, "BE/events", "event", false);
+  }
+
+  // The burst goes out at once, then one message per 100 ms
+  EXPECT_EQ(outbox.flush(1000, send), 3);
+  EXPECT_EQ(outbox.flush(1050, send), 0);
+  EXPECT_EQ(outbox.flush(1100, send), 1);
+  EXPECT_EQ(outbox.flush(1350, send), 2);
+  // The 50 ms left over count towards the next message
+  EXPECT_EQ(outbox.flush(1400, send), 1);
+  // After a pause, no more than the burst
+  EXPECT_EQ(outbox.flush(10000, send), 3);
+}
+
+TEST_F(MqttOutboxTest, MessagesStayQueuedWhileBrokerIsUnreachable) {
+  MqttOutbox outbox(256, 8);
+  push(outbox, "BE/info", "{\"SOC\":50}");
+  push(outbox, "BE/events", "event", false);
+
+  broker_reachable = false;
+  EXPECT_EQ(outbox.flush(0, send), 0);
+  push(outbox, "BE/info", "{\"SOC\":49}");
+  EXPECT_EQ(outbox.size(), 2);
+
+  broker_reachable = true;
+  EXPECT_EQ(outbox.flush(100, send), 2);
+  ASSERT_EQ(sent.size(), 2u);
+  EXPECT_EQ(sent[0].payload, "event");
+  EXPECT_EQ(sent[1].payload, "{\"SOC\":49}");
+}
+
+TEST_F(MqttOutboxTest, BinaryPayloads) {
+  MqttOutbox outbox(64, 4);
+  const uint8_t data[] = {1, 0, 3, 0, 0x74, 0x0E};
+  outbox.push("BE/cell_data", data, sizeof(data), false, true);
+
+  outbox.flush(0, send);
+  ASSERT_EQ(sent.size(), 1u);
+  EXPECT_EQ(sent[0].payload, std::string((const char*)data, sizeof(data)));
+}
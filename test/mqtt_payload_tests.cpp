@@ -0,0 +1,257 @@
+#include <gtest/gtest.h>
+
+#include <new>
+#include <string>
+#include "../Software/src/devboard/mqtt/mqtt_payload.h"
+#include "../Software/src/devboard/safety/safety.h"
+
+// Counts heap allocations while enabled, to check that building payloads does not allocate
+static bool count_allocations = false;
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+  if (count_allocations) {
+    allocations++;
+  }
+  void* p = malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void* p) noexcept {
+  free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  free(p);
+}
+
+static DATALAYER_BATTERY_SNAPSHOT test_battery() {
+  DATALAYER_BATTERY_SNAPSHOT battery = {};
+  battery.info.number_of_cells = 3;
+  battery.info.total_capacity_Wh = 30000;
+  battery.status.reported_soc = 9550;
+  battery.status.real_soc = 9000;
+  battery.status.soh_pptt = 9900;
+  battery.status.temperature_min_dC = -25;
+  battery.status.temperature_max_dC = 150;
+  battery.status.active_power_W = -1200;
+  battery.status.current_dA = -32;
+  battery.status.voltage_dV = 3751;
+  battery.status.cell_max_voltage_mV = 3712;
+  battery.status.cell_min_voltage_mV = 3700;
+  battery.status.cell_voltages_mV[0] = 3700;
+  battery.status.cell_voltages_mV[1] = 3712;
+  battery.status.cell_voltages_mV[2] = 3705;
+  battery.status.cell_balancing_status[1] = true;
+  battery.status.balancing_status = BALANCING_STATUS_ACTIVE;
+  return battery;
+}
+
+TEST(MqttPayloadTest, NumbersAreWrittenAsFixedPoint) {
+  char buffer[128];
+  MqttPayloadWriter writer(buffer, sizeof(buffer));
+
+  writer.begin_array();
+  writer.number(3712, 3);
+  writer.number(9550, 2);
+  writer.number(-32, 1);
+  writer.number(-5, 2);
+  writer.number(3000, 3);
+  writer.number(0, 2);
+  writer.number(4000000000LL);
+  writer.end_array();
+
+  EXPECT_STREQ(buffer, "[3.712,95.5,-3.2,-0.05,3,0,4000000000]");
+}
+
+TEST(MqttPayloadTest, ObjectsWithKeysTextAndFlags) {
+  char buffer[128];
+  MqttPayloadWriter writer(buffer, sizeof(buffer));
+
+  writer.begin_object();
+  EXPECT_TRUE(writer.empty());
+  writer.key("SOC", "_2");
+  writer.number(50);
+  writer.key("status");
+  writer.text("say \"hi\"");
+  writer.key("cells");
+  writer.begin_array();
+  writer.flag(true);
+  writer.flag(false);
+  writer.end_array();
+  EXPECT_FALSE(writer.empty());
+  writer.end_object();
+
+  EXPECT_STREQ(buffer, "{\"SOC_2\":50,\"status\":\"say \\\"hi\\\"\",\"cells\":[true,false]}");
+  EXPECT_FALSE(writer.overflowed());
+}
+
+TEST(MqttPayloadTest, OverflowIsReportedAndBufferStaysTerminated) {
+  char buffer[8];
+  MqttPayloadWriter writer(buffer, sizeof(buffer));
+
+  writer.begin_object();
+  writer.key("battery_voltage");
+  writer.number(3751, 1);
+  writer.end_object();
+
+  EXPECT_TRUE(writer.overflowed());
+  EXPECT_EQ(strlen(buffer), sizeof(buffer) - 1);
+}
+
+TEST(MqttPayloadTest, BatteryInfo) {
+  char buffer[1024];
+  MqttPayloadWriter writer(buffer, sizeof(buffer));
+  datalayer.system.info.CPU_temperature = 45.0f;
+
+  writer.begin_object();
+  write_battery_info(writer, nullptr, test_battery(), "_2", INFO_BATTERY_FIELD_COUNT, false);
+  writer.end_object();
+
+  EXPECT_STREQ(buffer,
+               "{\"SOC_2\":95.5,\"SOC_real_2\":90,\"state_of_health_2\":99,\"temperature_min_2\":-2.5,"
+               "\"temperature_max_2\":15,\"cpu_temp_2\":45,\"stat_batt_power_2\":-1200,\"battery_current_2\":-3.2,"
+               "\"battery_voltage_2\":375.1,\"cell_max_voltage_2\":3.712,\"cell_min_voltage_2\":3.7,"
+               "\"cell_voltage_delta_2\":12,\"total_capacity_2\":30000,\"remaining_capacity_real_2\":0,"
+               "\"remaining_capacity_2\":0,\"max_discharge_power_2\":0,\"max_charge_power_2\":0,"
+               "\"balancing_active_cells_2\":1,\"balancing_status_2\":\"Active\"}");
+}
+
+TEST(MqttPayloadTest, DeltaLeavesOutUnchangedValues) {
+  char buffer[1024];
+  float last[INFO_FIELD_COUNT];
+  MqttDeltaTracker delta(last, INFO_FIELD_COUNT);
+  DATALAYER_BATTERY_SNAPSHOT battery = test_battery();
+
+  delta.begin(0);
+  MqttPayloadWriter full(buffer, sizeof(buffer));
+  full.begin_object();
+  write_battery_info(full, &delta, battery, "", 0, false);
+
+  battery.status.current_dA = -45;
+  battery.status.voltage_dV = 3753;  // Within the deadband
+  delta.begin(5000);
+  MqttPayloadWriter writer(buffer, sizeof(buffer));
+  writer.begin_object();
+  write_battery_info(writer, &delta, battery, "", 0, false);
+  writer.end_object();
+
+  EXPECT_STREQ(buffer, "{\"battery_current\":-4.5}");
+}
+
+TEST(MqttPayloadTest, CellPayloads) {
+  char buffer[256];
+  MqttPayloadWriter voltages(buffer, sizeof(buffer));
+  write_cell_voltages(voltages, test_battery());
+  EXPECT_STREQ(buffer, "{\"cell_voltages\":[3.7,3.712,3.705]}");
+
+  MqttPayloadWriter balancing(buffer, sizeof(buffer));
+  write_cell_balancing(balancing, test_battery());
+  EXPECT_STREQ(buffer, "{\"cell_balancing\":[false,true,false]}");
+}
+
+TEST(MqttPayloadTest, CompactCellPayloads) {
+  char buffer[256];
+  MqttPayloadWriter voltages(buffer, sizeof(buffer));
+  write_cell_voltages_compact(voltages, test_battery());
+  EXPECT_STREQ(buffer, "{\"cell_base_mV\":3700,\"cell_delta_mV\":[0,12,5]}");
+
+  DATALAYER_BATTERY_SNAPSHOT battery = test_battery();
+  battery.info.number_of_cells = 10;
+  battery.status.cell_balancing_status[9] = true;
+  MqttPayloadWriter balancing(buffer, sizeof(buffer));
+  write_cell_balancing_compact(balancing, battery);
+  EXPECT_STREQ(buffer, "{\"cell_balancing_mask\":\"0202\"}");
+}
+
+TEST(MqttPayloadTest, CellDataUsesOneByteDeltas) {
+  uint8_t data[CELL_DATA_MAX_SIZE];
+  ASSERT_EQ(encode_cell_data(test_battery(), data, sizeof(data)), 10u);
+
+  const uint8_t expected[] = {CELL_DATA_VERSION, 0, 3, 0, 0x74, 0x0E, 0, 12, 5, 0x02};
+  EXPECT_EQ(memcmp(data, expected, sizeof(expected)), 0);
+}
+
+TEST(MqttPayloadTest, CellDataWidensDeltasWhenCellsAreFarApart) {
+  DATALAYER_BATTERY_SNAPSHOT battery = test_battery();
+  battery.status.cell_voltages_mV[2] = 4000;
+  uint8_t data[CELL_DATA_MAX_SIZE];
+  ASSERT_EQ(encode_cell_data(battery, data, sizeof(data)), 13u);
+
+  const uint8_t expected[] = {CELL_DATA_VERSION, CELL_DATA_WIDE_DELTAS, 3, 0, 0x74, 0x0E, 0, 0, 12, 0, 0x2C, 0x01,
+                              0x02};
+  EXPECT_EQ(memcmp(data, expected, sizeof(expected)), 0);
+}
+
+TEST(MqttPayloadTest, CellDataOfAFullPackFits) {
+  DATALAYER_BATTERY_SNAPSHOT battery = test_battery();
+  battery.info.number_of_cells = MAX_AMOUNT_CELLS;
+  for (uint16_t i = 0; i < MAX_AMOUNT_CELLS; i++) {
+    battery.status.cell_voltages_mV[i] = 3000 + i * 5;
+  }
+  uint8_t data[CELL_DATA_MAX_SIZE];
+  EXPECT_EQ(encode_cell_data(battery, data, sizeof(data)), CELL_DATA_MAX_SIZE);
+  EXPECT_EQ(encode_cell_data(battery, data, CELL_DATA_MAX_SIZE - 1), 0u);
+}
+
+TEST(MqttPayloadTest, Base64) {
+  const uint8_t data[] = {'f', 'o', 'o', 'b', 'a', 'r'};
+  char text[16];
+  EXPECT_EQ(encode_base64(data, 0, text, sizeof(text)), 0u);
+  EXPECT_STREQ(text, "");
+  EXPECT_EQ(encode_base64(data, 1, text, sizeof(text)), 4u);
+  EXPECT_STREQ(text, "Zg==");
+  EXPECT_EQ(encode_base64(data, 2, text, sizeof(text)), 4u);
+  EXPECT_STREQ(text, "Zm8=");
+  EXPECT_EQ(encode_base64(data, 6, text, sizeof(text)), 8u);
+  EXPECT_STREQ(text, "Zm9vYmFy");
+
+  // No room for the terminating zero
+  EXPECT_EQ(encode_base64(data, 6, text, 8), 0u);
+}
+
+TEST(MqttPayloadTest, PublishingDoesNotAllocate) {
+  static char buffer[2048];
+  static float last[INFO_FIELD_COUNT];
+  static MqttDeltaTracker delta(last, INFO_FIELD_COUNT);
+  static DATALAYER_BATTERY_SNAPSHOT battery = test_battery();
+  battery.info.number_of_cells = MAX_AMOUNT_CELLS;
+
+  // Make sure allocations are seen at all
+  allocations = 0;
+  count_allocations = true;
+  std::string long_text(100, 'x');
+  count_allocations = false;
+  ASSERT_EQ(allocations, 1);
+
+  allocations = 0;
+  count_allocations = true;
+  for (MqttDeltaTracker* tracker : {(MqttDeltaTracker*)nullptr, &delta}) {
+    MqttPayloadWriter info(buffer, sizeof(buffer));
+    info.begin_object();
+    // The texts as publish_common_info() in mqtt.cpp gets them
+    write_info_text(info, tracker, "bms_status", INFO_BMS_STATUS, ACTIVE, getBMSStatus(ACTIVE));
+    write_info_text(info, tracker, "pause_status", INFO_PAUSE_STATUS, 0, get_emulator_pause_status());
+    write_battery_info(info, tracker, battery, "", 0, true);
+    write_battery_info(info, tracker, battery, "_2", INFO_BATTERY_FIELD_COUNT, true);
+    info.end_object();
+
+    MqttPayloadWriter voltages(buffer, sizeof(buffer));
+    write_cell_voltages(voltages, battery);
+    MqttPayloadWriter balancing(buffer, sizeof(buffer));
+    write_cell_balancing(balancing, battery);
+
+    MqttPayloadWriter compact_voltages(buffer, sizeof(buffer));
+    write_cell_voltages_compact(compact_voltages, battery);
+    MqttPayloadWriter compact_balancing(buffer, sizeof(buffer));
+    write_cell_balancing_compact(compact_balancing, battery);
+    uint8_t cell_data[CELL_DATA_MAX_SIZE];
+    encode_base64(cell_data, encode_cell_data(battery, cell_data, sizeof(cell_data)), buffer, sizeof(buffer));
+  }
+  count_allocations = false;
+
+  EXPECT_EQ(allocations, 0);
+}
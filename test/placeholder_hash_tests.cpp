@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../Software/src/devboard/webserver/placeholder_hash.h"
+
+static_assert(placeholder_hash("") == 2166136261u, "FNV-1a offset basis");
+static_assert(placeholder_hash("a") == 0xe40c292cu, "FNV-1a reference value");
+
+// All %PLACEHOLDER% names in the settings page template, in page order
+static std::vector<std::string> settings_placeholders() {
+  std::ifstream file(TEST_SETTINGS_HTML);
+  std::stringstream source;
+  source << file.rdbuf();
+  const std::string text = source.str();
+
+  std::vector<std::string> names;
+  const std::regex placeholder("%([A-Z0-9_]+)%");
+  for (auto it = std::sregex_iterator(text.begin(), text.end(), placeholder); it != std::sregex_iterator(); ++it) {
+    names.push_back((*it)[1]);
+  }
+  return names;
+}
+
+TEST(PlaceholderHashTest, StringMatchesCompileTimeHash) {
+  constexpr uint32_t hostname = placeholder_hash("HOSTNAME");
+  EXPECT_EQ(placeholder_hash(String("HOSTNAME")), hostname);
+  EXPECT_NE(placeholder_hash(String("HOSTNAME2")), hostname);
+}
+
+TEST(PlaceholderHashTest, SettingsPlaceholdersHaveDistinctHashes) {
+  const std::vector<std::string> names = settings_placeholders();
+  ASSERT_GT(names.size(), 100u);
+
+  // A name that is not handled must not share a hash with one that is either, or it would get its value
+  std::set<std::string> unique(names.begin(), names.end());
+  std::set<uint32_t> hashes;
+  for (const auto& name : unique) {
+    EXPECT_TRUE(hashes.insert(placeholder_hash(name.c_str())).second) << name;
+  }
+}
+
+// Compares resolving every placeholder of the settings page by comparing it against the known names in
+// turn, as the processor did, with switching on its hash, which the compiler turns into a search over the
+// sorted case values. The page itself can only be rendered on the device, so this measures the dispatch.
+// Disabled by default as timings are not meaningful on shared CI machines. Run with:
+//
+//   ./tests --gtest_also_run_disabled_tests --gtest_filter=PlaceholderHashTest.*
+
+static const int BENCHMARK_ROUNDS = 2000;
+
+TEST(PlaceholderHashTest, DISABLED_SettingsPageDispatch) {
+  const std::vector<std::string> page = settings_placeholders();
+  const std::set<std::string> unique(page.begin(), page.end());
+  const std::vector<String> known(unique.begin(), unique.end());
+  std::vector<uint32_t> known_hashes;
+  for (const auto& name : known) {
+    known_hashes.push_back(placeholder_hash(name));
+  }
+  std::sort(known_hashes.begin(), known_hashes.end());
+
+  std::vector<String> vars(page.begin(), page.end());
+  size_t found = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+    for (const auto& var : vars) {
+      for (const auto& name : known) {
+        if (var == name) {
+          found++;
+          break;
+        }
+      }
+    }
+  }
+  const double compared = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+  start = std::chrono::steady_clock::now();
+  for (int round = 0; round < BENCHMARK_ROUNDS; round++) {
+    for (const auto& var : vars) {
+      if (std::binary_search(known_hashes.begin(), known_hashes.end(), placeholder_hash(var))) {
+        found++;
+      }
+    }
+  }
+  const double hashed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+  EXPECT_EQ(found, 2 * BENCHMARK_ROUNDS * vars.size());
+  std::cout << vars.size() << " placeholders, " << known.size() << " names: compared " << compared / BENCHMARK_ROUNDS
+            << " us/page, hashed " << hashed / BENCHMARK_ROUNDS << " us/page" << std::endl;
+}
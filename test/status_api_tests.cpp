@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include "../Software/src/battery/BATTERIES.h"
+#include "../Software/src/battery/TEST-FAKE-BATTERY.h"
+#include "../Software/src/datalayer/datalayer_snapshot.h"
+#include "../Software/src/devboard/utils/events.h"
+#include "../Software/src/devboard/webserver/status_api.h"
+
+static std::string render(ApiResponse& api) {
+  HtmlStream stream(api.body);
+  std::string body;
+  char buffer[100];
+  size_t length;
+  while ((length = stream.read(buffer, sizeof(buffer))) > 0) {
+    body.append(buffer, length);
+  }
+  EXPECT_FALSE(stream.overflowed());
+  return body;
+}
+
+class StatusApiTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    datalayer = DataLayer();
+    init_events();
+    reset_all_events();
+    battery = new TestFakeBattery();
+  }
+
+  void TearDown() override {
+    delete battery;
+    battery = nullptr;
+  }
+};
+
+TEST(ApiEtagTest, ContainsBootIdAndGenerations) {
+  const uint32_t generations[] = {12, 7};
+  EXPECT_EQ(std::string(api_etag(0x5f3a9c01, generations, 2).c_str()), "W/\"5f3a9c01-12-7\"");
+  EXPECT_EQ(std::string(api_etag(1, generations, 0).c_str()), "W/\"00000001\"");
+}
+
+TEST(ApiEtagTest, MatchesIfNoneMatch) {
+  const char* etag = "W/\"5f3a9c01-12-7\"";
+  EXPECT_TRUE(etag_matches("W/\"5f3a9c01-12-7\"", etag));
+  EXPECT_TRUE(etag_matches("\"5f3a9c01-12-7\"", etag));
+  EXPECT_TRUE(etag_matches("\"other\", W/\"5f3a9c01-12-7\" ", etag));
+  EXPECT_TRUE(etag_matches("*", etag));
+  EXPECT_FALSE(etag_matches("", etag));
+  EXPECT_FALSE(etag_matches("W/\"5f3a9c01-12\"", etag));
+  EXPECT_FALSE(etag_matches("W/\"5f3a9c01-12-77\"", etag));
+  EXPECT_FALSE(etag_matches("W/\"00000000-12-7\"", etag));
+}
+
+TEST_F(StatusApiTest, StatusHasEachBattery) {
+  datalayer.battery.status.voltage_dV = 3712;
+  datalayer.battery.status.CAN_battery_still_alive = 60;
+  datalayer_snapshot.publish(1);
+
+  ApiResponse api = api_status(1);
+  const std::string body = render(api);
+  EXPECT_EQ(body.rfind("{\"bms_status\":", 0), 0u) << body;
+  EXPECT_NE(body.find("\"event_level\":\"INFO\",\"emulator_status\":\"OK\",\"batteries\":[{\"alive\":true,"),
+            std::string::npos)
+      << body;
+  EXPECT_NE(body.find("\"battery_voltage\":371.2"), std::string::npos) << body;
+  EXPECT_EQ(body.substr(body.size() - 3), "}]}");
+}
+
+TEST_F(StatusApiTest, StatusEtagChangesWithValues) {
+  datalayer.battery.status.voltage_dV = 3712;
+  datalayer_snapshot.publish(1);
+  const String etag = api_status(1).etag;
+
+  datalayer_snapshot.publish(1);
+  EXPECT_EQ(api_status(1).etag, etag);
+  EXPECT_NE(api_status(2).etag, etag);
+
+  datalayer.battery.status.voltage_dV = 3713;
+  datalayer_snapshot.publish(1);
+  EXPECT_NE(api_status(1).etag, etag);
+
+  const String before_event = api_status(1).etag;
+  set_event(EVENT_CAN_BATTERY_MISSING, 0);
+  EXPECT_NE(api_status(1).etag, before_event);
+}
+
+TEST_F(StatusApiTest, CellsAreWrittenInChunks) {
+  // More cells than one step writes
+  datalayer.battery.info.number_of_cells = 40;
+  std::string voltages;
+  std::string balancing;
+  for (int i = 0; i < 40; i++) {
+    datalayer.battery.status.cell_voltages_mV[i] = 3600 + i;
+    datalayer.battery.status.cell_balancing_status[i] = i == 33;
+    voltages += (i > 0 ? "," : "") + std::to_string(3600 + i);
+    balancing += std::string(i > 0 ? "," : "") + (i == 33 ? "true" : "false");
+  }
+  datalayer_snapshot.publish(1);
+
+  ApiResponse api = api_cells(1);
+  EXPECT_EQ(render(api), "{\"batteries\":[{\"number_of_cells\":40,\"cell_voltages_mV\":[" + voltages +
+                             "],\"cell_balancing\":[" + balancing + "]}]}");
+}
+
+TEST_F(StatusApiTest, CellsEtagOnlyChangesWithCells) {
+  datalayer.battery.info.number_of_cells = 2;
+  datalayer.battery.status.cell_voltages_mV[0] = 3600;
+  datalayer_snapshot.publish(1);
+  const String etag = api_cells(1).etag;
+
+  datalayer.battery.status.current_dA = 50;
+  datalayer_snapshot.publish(1);
+  EXPECT_EQ(api_cells(1).etag, etag);
+
+  datalayer.battery.status.cell_voltages_mV[1] = 3601;
+  datalayer_snapshot.publish(1);
+  EXPECT_NE(api_cells(1).etag, etag);
+}
+
+TEST_F(StatusApiTest, NoBatteries) {
+  delete battery;
+  battery = nullptr;
+
+  ApiResponse cells = api_cells(1);
+  EXPECT_EQ(render(cells), "{\"batteries\":[]}");
+  ApiResponse status = api_status(1);
+  EXPECT_EQ(render(status), "{\"event_level\":\"INFO\",\"emulator_status\":\"OK\",\"batteries\":[]}");
+}
+
+TEST_F(StatusApiTest, EventsListsWhatOccurred) {
+  ApiResponse none = api_events(1);
+  EXPECT_EQ(render(none), "{\"events\":[]}");
+
+  set_event(EVENT_CAN_BATTERY_MISSING, 3);
+  ApiResponse api = api_events(1);
+  const std::string body = render(api);
+  EXPECT_EQ(body.rfind("{\"events\":[{\"type\":\"CAN_BATTERY_MISSING\",\"severity\":\"ERROR\",\"active\":true,"
+                       "\"count\":1,\"data\":3,",
+                       0),
+            0u)
+      << body;
+  EXPECT_EQ(body.substr(body.size() - 4), "\"}]}");
+}
+
+TEST_F(StatusApiTest, EventsEtagIgnoresRepeatedSets) {
+  set_event(EVENT_CAN_BATTERY_MISSING, 0);
+  const String etag = api_events(1).etag;
+
+  set_event(EVENT_CAN_BATTERY_MISSING, 0);
+  EXPECT_EQ(api_events(1).etag, etag);
+
+  set_event(EVENT_CAN_BATTERY_MISSING, 1);
+  const String changed = api_events(1).etag;
+  EXPECT_NE(changed, etag);
+
+  clear_event(EVENT_CAN_BATTERY_MISSING);
+  EXPECT_NE(api_events(1).etag, changed);
+}
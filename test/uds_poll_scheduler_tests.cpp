@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include "../Software/src/communication/can/uds_poll_scheduler.h"
+
+class UdsPollSchedulerTest : public testing::Test {
+ protected:
+  UdsPollScheduler::Entry entries[8];
+  UdsPollScheduler poller{entries, 8, 10};
+
+  // Requests whatever is due at now and answers it right away
+  bool poll(unsigned long now, uint16_t& pid) {
+    if (!poller.next(now, pid)) {
+      return false;
+    }
+    poller.response(pid, now);
+    return true;
+  }
+};
+
+TEST_F(UdsPollSchedulerTest, HighPriorityGoesFirst) {
+  poller.add(0x0100, 60000, UdsPollScheduler::PRIORITY_LOW);
+  poller.add(0x0200, 1000, UdsPollScheduler::PRIORITY_HIGH);
+  poller.add(0x0300, 5000, UdsPollScheduler::PRIORITY_NORMAL);
+
+  uint16_t pid;
+  ASSERT_TRUE(poll(0, pid));
+  EXPECT_EQ(pid, 0x0200);
+  ASSERT_TRUE(poll(100, pid));
+  EXPECT_EQ(pid, 0x0300);
+  ASSERT_TRUE(poll(200, pid));
+  EXPECT_EQ(pid, 0x0100);
+  // Nothing is due until the high priority PID is again
+  EXPECT_FALSE(poll(300, pid));
+  ASSERT_TRUE(poll(1000, pid));
+  EXPECT_EQ(pid, 0x0200);
+}
+
+TEST_F(UdsPollSchedulerTest, StaysWithinRequestBudget) {
+  for (uint16_t pid = 1; pid <= 8; pid++) {
+    poller.add(pid, 100);
+  }
+
+  // Everything wants 10 requests/s, but the budget allows 10 requests/s in total
+  uint16_t pid;
+  int requests = 0;
+  for (unsigned long now = 0; now < 10000; now++) {
+    if (poll(now, pid)) {
+      requests++;
+    }
+  }
+  EXPECT_EQ(requests, 100);
+  // Equal priorities share it
+  for (uint16_t i = 0; i < poller.size(); i++) {
+    EXPECT_NEAR(poller.entry(i).responses, 100 / 8, 1);
+  }
+}
+
+TEST_F(UdsPollSchedulerTest, WaitsForResponseOrTimeout) {
+  poller.add(0x0001, 100);
+  poller.add(0x0002, 100);
+
+  uint16_t pid;
+  ASSERT_TRUE(poller.next(0, pid));
+  EXPECT_EQ(pid, 0x0001);
+  // Still outstanding
+  EXPECT_FALSE(poller.next(200, pid));
+  ASSERT_TRUE(poller.next(UdsPollScheduler::DEFAULT_TIMEOUT_MS, pid));
+  EXPECT_EQ(pid, 0x0002);
+  EXPECT_EQ(poller.entry(0).timeouts, 1);
+  EXPECT_EQ(poller.entry(0).responses, 0);
+
+  poller.response(0x0002, UdsPollScheduler::DEFAULT_TIMEOUT_MS + 20);
+  EXPECT_TRUE(poller.next(UdsPollScheduler::DEFAULT_TIMEOUT_MS + 100, pid));
+}
+
+TEST_F(UdsPollSchedulerTest, HoldsOffForAnotherTester) {
+  poller.add(0x0001, 100);
+
+  uint16_t pid;
+  ASSERT_TRUE(poller.next(0, pid));
+  poller.hold_off(50, 10000);
+  EXPECT_TRUE(poller.holding_off(5000));
+  EXPECT_FALSE(poller.next(5000, pid));
+  // The request given up does not count as a timeout
+  ASSERT_TRUE(poller.next(10050, pid));
+  EXPECT_EQ(poller.entry(0).timeouts, 0);
+}
+
+TEST_F(UdsPollSchedulerTest, TracksAchievedPeriod) {
+  poller.add(0x0001, 1000, UdsPollScheduler::PRIORITY_HIGH);
+  poller.add(0x0002, 1000, UdsPollScheduler::PRIORITY_LOW);
+
+  uint16_t pid;
+  for (unsigned long now = 0; now <= 10000; now += 10) {
+    poll(now, pid);
+  }
+  EXPECT_EQ(poller.entry(0).achieved_period_ms, 1000);
+  EXPECT_EQ(poller.entry(1).achieved_period_ms, 1000);
+  EXPECT_EQ(poller.entry(0).responses, 11);
+}
+
+TEST_F(UdsPollSchedulerTest, DisabledAndReconfiguredPids) {
+  EXPECT_TRUE(poller.add(0x0001, 1000, UdsPollScheduler::PRIORITY_LOW));
+  EXPECT_TRUE(poller.add(0x0002, 1000, UdsPollScheduler::PRIORITY_LOW));
+  poller.set_enabled(0x0001, false);
+  // Registering again changes the existing entry
+  EXPECT_TRUE(poller.add(0x0002, 2000, UdsPollScheduler::PRIORITY_HIGH));
+  EXPECT_EQ(poller.size(), 2);
+  EXPECT_EQ(poller.entry(1).period_ms, 2000);
+
+  uint16_t pid;
+  ASSERT_TRUE(poll(0, pid));
+  EXPECT_EQ(pid, 0x0002);
+  EXPECT_FALSE(poll(1000, pid));
+
+  for (uint16_t i = 3; i <= 8; i++) {
+    EXPECT_TRUE(poller.add(i, 1000));
+  }
+  EXPECT_FALSE(poller.add(9, 1000));
+}
+
+TEST_F(UdsPollSchedulerTest, PeriodsLongerThanAMinute) {
+  // Serial numbers and such are polled every few minutes
+  poller.add(0x0001, 300000, UdsPollScheduler::PRIORITY_LOW);
+  EXPECT_EQ(poller.entry(0).period_ms, 300000u);
+
+  uint16_t pid;
+  ASSERT_TRUE(poll(0, pid));
+  EXPECT_FALSE(poll(65536, pid));
+  EXPECT_FALSE(poll(299999, pid));
+  EXPECT_TRUE(poll(300000, pid));
+}
+
+TEST_F(UdsPollSchedulerTest, RequestBudgetIsLimited) {
+  poller.set_request_budget(0);
+  EXPECT_EQ(poller.request_budget(), 1);
+  poller.set_request_budget(5000);
+  EXPECT_EQ(poller.request_budget(), 1000);
+  poller.set_request_budget(1000);
+  EXPECT_EQ(poller.request_budget(), 1000);
+
+  UdsPollScheduler unlimited(entries, 8, 0);
+  EXPECT_EQ(unlimited.request_budget(), 1);
+}
@@ -0,0 +1,55 @@
+// Converts a binary CAN log written to the SD card (canlog.bin) to the candump-style
+// text the webserver CAN logger produces, which SavvyCAN and the tests in can_log_based read.
+//
+//   canlog_convert canlog.bin > canlog.txt
+
+#include "../../Software/src/communication/can/can_log_format.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " canlog.bin" << std::endl;
+    return 1;
+  }
+
+  std::ifstream file(argv[1], std::ios::binary);
+  if (!file) {
+    std::cerr << "Cannot open " << argv[1] << std::endl;
+    return 1;
+  }
+  const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  if (data.size() < CAN_LOG_MAGIC_SIZE || memcmp(data.data(), CAN_LOG_MAGIC, CAN_LOG_MAGIC_SIZE) != 0) {
+    std::cerr << argv[1] << " is not a binary CAN log" << std::endl;
+    return 1;
+  }
+
+  CanLogDecoder decoder;
+  CanLogRecord record;
+  char line[256];
+  size_t offset = CAN_LOG_MAGIC_SIZE;
+
+  while (offset < data.size()) {
+    const size_t used = decoder.next(data.data() + offset, data.size() - offset, record);
+    if (used == 0) {
+      break;
+    }
+    offset += used;
+    std::cout.write(line, format_can_log_line(record, line, sizeof(line)));
+  }
+
+  if (decoder.failed()) {
+    std::cerr << "Invalid record at offset " << offset << ", stopping" << std::endl;
+    return 1;
+  }
+  if (offset < data.size()) {
+    // The card was removed or power lost while a frame was written
+    std::cerr << "Ignoring " << data.size() - offset << " bytes of an incomplete record at the end" << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,28 @@
+// Lists the DRAM the battery specific part of the datalayer takes for every battery type that has one,
+// and what sharing the storage between battery types saves compared to giving each struct its own.
+// Runs after it is built, so the numbers show up in the build output.
+//
+// The sizes are those of the host compiler. The ESP32 has 32-bit pointers and aligns 64-bit members
+// differently, so its numbers differ somewhat. Treat these as an estimate of the target's.
+
+#include "../../Software/src/battery/Battery.h"
+#include "../../Software/src/datalayer/datalayer_extended.h"
+
+#include <cstdio>
+
+int main() {
+  const size_t shared = sizeof(DataLayerExtended);
+  const size_t unshared = DataLayerExtended::unshared_size();
+
+  printf("Extended datalayer, host layout, the ESP32 differs: %zu bytes, %zu with storage per battery type, %zu bytes "
+         "reclaimed\n",
+         shared, unshared, unshared - shared);
+  printf("%-12s %8s %12s\n", "BatteryType", "Bytes", "Unused");
+  for (int i = 0; i < (int)BatteryType::Highest; i++) {
+    const size_t used = DataLayerExtended::size_for((BatteryType)i);
+    if (used > 0) {
+      printf("%-12d %8zu %12zu\n", i, used, shared - used);
+    }
+  }
+  return 0;
+}
@@ -8,6 +8,14 @@ bool ends_with(const std::string& str, const std::string& suffix) {
   return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
 }
 
+CAN_frame frame_with_id(uint32_t id, uint8_t dlc) {
+  CAN_frame frame = {};
+  frame.ext_ID = id > 0x7FF;
+  frame.DLC = dlc;
+  frame.ID = id;
+  return frame;
+}
+
 std::vector<std::string> split(const std::string& text, char sep) {
   std::vector<std::string> tokens;
   std::size_t start = 0, end = 0;
@@ -10,3 +10,6 @@ std::vector<std::string> split(const std::string& text, char sep);
 std::string snake_case_to_camel_case(const std::string& str);
 
 std::vector<CAN_frame> parse_can_log_file(const fs::path& filePath);
+
+// A classic CAN frame with all data bytes zero, extended if the ID does not fit in 11 bits
+CAN_frame frame_with_id(uint32_t id, uint8_t dlc = 8);
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "../Software/src/devboard/webserver/web_assets.h"
+
+static std::string read_source(const char* path) {
+  // path is /assets/<file>
+  std::ifstream file(std::string(TEST_WEB_ASSETS_DIR) + (path + strlen("/assets")), std::ios::binary);
+  std::stringstream source;
+  source << file.rdbuf();
+  return source.str();
+}
+
+static uint32_t crc32(const std::string& data) {
+  uint32_t crc = 0xffffffff;
+  for (unsigned char c : data) {
+    crc ^= c;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+static uint32_t read_le32(const uint8_t* data) {
+  return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+TEST(WebAssetsTest, FindsAssetsByPath) {
+  ASSERT_GT(web_asset_count, 0u);
+  for (size_t i = 0; i < web_asset_count; i++) {
+    EXPECT_EQ(find_web_asset(web_assets[i].path), &web_assets[i]);
+  }
+  EXPECT_EQ(find_web_asset("/assets/missing.css"), nullptr);
+  EXPECT_NE(find_web_asset("/assets/status.css"), nullptr);
+  EXPECT_NE(find_web_asset("/assets/settings.js"), nullptr);
+}
+
+TEST(WebAssetsTest, UrlsCarryTheVersion) {
+  const WebAsset* asset = find_web_asset("/assets/status.js");
+  ASSERT_NE(asset, nullptr);
+  EXPECT_STREQ(web_asset_url("/assets/status.js"), asset->url);
+  EXPECT_EQ(std::string(asset->url), std::string(asset->path) + "?v=" +
+                                         std::string(asset->etag + 1, strlen(asset->etag) - 2));
+  EXPECT_STREQ(web_asset_url("/assets/missing.js"), "/assets/missing.js");
+}
+
+// The embedded data is the gzip of the file in assets/ as it is now, so it was regenerated after the last change
+TEST(WebAssetsTest, DataMatchesTheSources) {
+  for (size_t i = 0; i < web_asset_count; i++) {
+    const WebAsset& asset = web_assets[i];
+    const std::string source = read_source(asset.path);
+    ASSERT_FALSE(source.empty()) << asset.path;
+    ASSERT_GT(asset.length, 18u) << asset.path;
+
+    EXPECT_EQ(asset.data[0], 0x1f) << asset.path;
+    EXPECT_EQ(asset.data[1], 0x8b) << asset.path;
+    EXPECT_EQ(asset.data[2], 0x08) << asset.path;  // Deflate
+    EXPECT_LT(asset.length, source.size()) << asset.path;
+
+    // The gzip trailer holds the CRC-32 and size of the uncompressed data
+    const uint32_t crc = crc32(source);
+    EXPECT_EQ(read_le32(asset.data + asset.length - 8), crc) << asset.path;
+    EXPECT_EQ(read_le32(asset.data + asset.length - 4), source.size()) << asset.path;
+
+    char etag[16];
+    snprintf(etag, sizeof(etag), "\"%08x\"", crc);
+    EXPECT_STREQ(asset.etag, etag) << asset.path;
+  }
+}